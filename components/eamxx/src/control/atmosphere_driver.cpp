@@ -7,10 +7,13 @@
 #include "share/atm_process/atmosphere_process_group.hpp"
 #include "share/atm_process/atmosphere_process_dag.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/field/field_workspace_arena.hpp"
 #include "share/util/eamxx_time_stamp.hpp"
 #include "share/util/eamxx_timing.hpp"
 #include "share/util/eamxx_utils.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 #include "share/io/eamxx_io_utils.hpp"
+#include "share/remap/horiz_interp_remapper_data.hpp"
 #include "share/property_checks/mass_and_energy_conservation_check.hpp"
 #include "share/core/eamxx_config.hpp"
 #include "eamxx_version.h"
@@ -268,9 +271,17 @@ void AtmosphereDriver::create_grids()
   start_timer("EAMxx::create_grids");
   m_atm_logger->flush(); // During init, flush often (to help debug crashes)
 
+  MemoryTracker::OwnerScope owner("grids");
+
   // Must have procs created by now (and comm/params set)
   check_ad_status (s_procs_created | s_comm_set | s_params_set | s_ts_inited);
 
+  // Horiz remap data only depends on map file and grids decomposition, so it can be
+  // saved to disk and reloaded in later runs, to speed up init (if a dir is set)
+  const auto remap_cache_dir = m_atm_params.sublist("driver_options").get<std::string>("horiz_remap_cache_dir","NONE");
+  HorizRemapperDataRepo::instance().set_cache_dir(remap_cache_dir=="NONE" ? "" : remap_cache_dir);
+  HorizRemapperDataRepo::instance().set_logger(m_atm_logger);
+
   // Create the grids manager
   auto& gm_params = m_atm_params.sublist("grids_manager");
   const std::string& gm_type = gm_params.get<std::string>("type");
@@ -545,6 +556,8 @@ void AtmosphereDriver::create_fields()
   // Must have grids and procs at this point
   check_ad_status (s_procs_created | s_grids_created);
 
+  MemoryTracker::OwnerScope owner("field manager");
+
   // Create FM
   m_field_mgr = std::make_shared<field_mgr_type>(m_grids_manager);
 
@@ -1636,6 +1649,8 @@ initialize (const ekat::Comm& atm_comm,
   reset_accumulated_fields();
 
   initialize_output_managers ();
+
+  report_memory_by_owner ("init");
 }
 
 void AtmosphereDriver::run (const int dt) {
@@ -1727,6 +1742,9 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
 
   m_atm_logger->info("[EAMxx] Finalize ...");
 
+  // Report before destroying anything, so that the current usage is that of the run phase
+  report_memory_by_owner ("finalize");
+
   // Finalize and destroy output streams, make sure files are closed
   if (m_restart_output_manager) {
     m_restart_output_manager->finalize();
@@ -1759,6 +1777,17 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
   // Destroy all the fields manager
   m_field_mgr->clean_up();
 
+  // Report how much memory the temporaries of remappers, diagnostics, and I/O needed, then release it
+  auto& arena = FieldWorkspaceArena::instance();
+  for (auto lt : {ArenaLifetime::ProcessRun, ArenaLifetime::OutputStep}) {
+    long long my_high_water = arena.get_high_water_bytes(lt);
+    long long max_high_water;
+    m_atm_comm.all_reduce(&my_high_water,&max_high_water,1,MPI_MAX);
+    m_atm_logger->info("[EAMxx::finalize] workspace arena high-water mark (" + e2str(lt) + "): "
+                       + std::to_string(max_high_water/1e6) + "MB");
+  }
+  arena.clear();
+
   // Write all timers to file, and possibly finalize gptl
   if (not m_gptl_externally_handled) {
     write_timers_to_file (m_atm_comm,"eamxx_timing.txt");
@@ -1865,5 +1894,13 @@ void AtmosphereDriver::report_res_dep_memory_footprint () const {
 #endif
 }
 
+void AtmosphereDriver::report_memory_by_owner (const std::string& phase) const {
+  // Collective call: all ranks must get here, but only root gets the table
+  const auto report = MemoryTracker::instance().get_report(m_atm_comm);
+  if (m_atm_comm.am_i_root()) {
+    m_atm_logger->info("[EAMxx::" + phase + "] device memory by owner (min/max across ranks):\n" + report);
+  }
+}
+
 }  // namespace control
 }  // namespace scream
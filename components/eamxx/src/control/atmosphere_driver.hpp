@@ -177,6 +177,9 @@ protected:
 
   void report_res_dep_memory_footprint () const;
 
+  // Log the device memory tracked by MemoryTracker, by owner (phase is "init" or "finalize")
+  void report_memory_by_owner (const std::string& phase) const;
+
   void create_logger ();
   void set_initial_conditions ();
   void restart_model ();
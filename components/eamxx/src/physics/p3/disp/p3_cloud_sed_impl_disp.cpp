@@ -32,19 +32,21 @@ void Functions<Real,DefaultDevice>
     const uview_2d<Pack>& nc_tend,
     const uview_1d<Scalar>& precip_liq_surf,
     const uview_1d<bool>& nucleationPossible,
-    const uview_1d<bool>& hydrometeorsPresent)
+    const uview_1d<bool>& hydrometeorsPresent,
+    const uview_1d<const Int>& sed_cols)
 {
   using ExeSpace = typename KT::ExeSpace;
   using TPF      = ekat::TeamPolicyFactory<ExeSpace>;
 
   const Int nk_pack = ekat::npack<Pack>(nk);
-  const auto policy = TPF::get_default_team_policy(nj, nk_pack);
+
+  // If a list of columns is provided, only process those
+  const bool use_sed_cols = sed_cols.size()>0;
+
   // p3_cloud_sedimentation loop
-  Kokkos::parallel_for(
-    "p3_cloud_sedimentation",
-    policy, KOKKOS_LAMBDA(const MemberType& team) {
+  const auto cloud_sed = KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = use_sed_cols ? sed_cols(team.league_rank()) : team.league_rank();
     auto workspace = workspace_mgr.get_workspace(team);
     if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
       return;
@@ -57,7 +59,13 @@ void Functions<Real,DefaultDevice>
       ekat::subview(qc, i), ekat::subview(nc, i), ekat::subview(nc_incld, i), ekat::subview(mu_c, i), ekat::subview(lamc, i), ekat::subview(qc_tend, i),
       ekat::subview(nc_tend, i),
       precip_liq_surf(i));
-  });
+  };
+
+  if (use_sed_cols) {
+    Kokkos::parallel_for("p3_cloud_sedimentation", get_sed_team_policy(sed_cols.size(), nk_pack), cloud_sed);
+  } else {
+    Kokkos::parallel_for("p3_cloud_sedimentation", TPF::get_default_team_policy(nj, nk_pack), cloud_sed);
+  }
 
 }
 
@@ -30,18 +30,21 @@ void Functions<Real,DefaultDevice>
   const uview_1d<Scalar>& precip_ice_surf,
   const uview_1d<bool>& nucleationPossible,
   const uview_1d<bool>& hydrometeorsPresent,
+  const uview_1d<const Int>& sed_cols,
   const P3Runtime& runtime_options)
 {
   using ExeSpace = typename KT::ExeSpace;
   using TPF      = ekat::TeamPolicyFactory<ExeSpace>;
 
   const Int nk_pack = ekat::npack<Pack>(nk);
-  const auto policy = TPF::get_default_team_policy(nj, nk_pack);
+
+  // If a list of columns is provided, only process those
+  const bool use_sed_cols = sed_cols.size()>0;
+
   // p3_ice_sedimentation loop
-  Kokkos::parallel_for("p3_ice_sedimentation",
-    policy, KOKKOS_LAMBDA(const MemberType& team) {
+  const auto ice_sed = KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = use_sed_cols ? sed_cols(team.league_rank()) : team.league_rank();
     if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
       return;
     }
@@ -55,7 +58,13 @@ void Functions<Real,DefaultDevice>
       ekat::subview(qm, i), ekat::subview(qm_incld, i), ekat::subview(bm, i), ekat::subview(bm_incld, i), ekat::subview(qi_tend, i), ekat::subview(ni_tend, i),
       ice_table_vals, precip_ice_surf(i), runtime_options);
 
- });
+  };
+
+  if (use_sed_cols) {
+    Kokkos::parallel_for("p3_ice_sedimentation", get_sed_team_policy(sed_cols.size(), nk_pack), ice_sed);
+  } else {
+    Kokkos::parallel_for("p3_ice_sedimentation", TPF::get_default_team_policy(nj, nk_pack), ice_sed);
+  }
 }
 
 template <>
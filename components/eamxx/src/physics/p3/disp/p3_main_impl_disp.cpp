@@ -300,27 +300,41 @@ Int Functions<Real,DefaultDevice>
   // ==========================================================================================!
   // Sedimentation:
 
-  // Cloud sedimentation:  (adaptive substepping)
-  cloud_sedimentation_disp(
-      qc_incld, rho, inv_rho, cld_frac_l, acn, inv_dz, lookup_tables.dnu_table_vals, workspace_mgr,
-      nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, infrastructure.predictNc,
-      qc, nc, nc_incld, mu_c, lamc, qc_sed, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent);
-
-
-  // Rain sedimentation:  (adaptive substepping)
-  rain_sedimentation_disp(
-      rho, inv_rho, rhofacr, cld_frac_r, inv_dz, qr_incld, workspace_mgr,
-      lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, qr,
-      nr, nr_incld, mu_r, lamr, precip_liq_flux, qr_sed, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, runtime_options);
-
-  // Ice sedimentation:  (adaptive substepping)
-  ice_sedimentation_disp(
-      rho, inv_rho, rhofaci, cld_frac_i, inv_dz, workspace_mgr, nj, nk, ktop, kbot,
-      kdir, infrastructure.dt, inv_dt, qi, qi_incld, ni, ni_incld,
-      qm, qm_incld, bm, bm_incld, qi_sed, ntend_ignore,
-      lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, nucleationPossible, hydrometeorsPresent, runtime_options);
+  // Optionally, only process the columns with hydrometeors, most expensive first,
+  // so that a few heavily precipitating columns do not serialize the launch
+  uview_1d<const Int> sed_cols;
+  bool do_sedimentation = true;
+  if (runtime_options.compact_sedimentation_columns) {
+    const Int num_sed_cols = get_sedimentation_columns_disp(
+        qc, nc, qr, nr, qi, ni, rhofacr, rhofaci, inv_dz, nj, nk, infrastructure.dt, inv_dt,
+        qc_sed, qr_sed, qi_sed, ntend_ignore, nucleationPossible, hydrometeorsPresent,
+        temporaries.sed_cost, temporaries.sed_keys, temporaries.sed_cols);
+    sed_cols = Kokkos::subview(temporaries.sed_cols, Kokkos::make_pair(0, num_sed_cols));
+    do_sedimentation = num_sed_cols > 0;
+  }
+
+  if (do_sedimentation) {
+    // Cloud sedimentation:  (adaptive substepping)
+    cloud_sedimentation_disp(
+        qc_incld, rho, inv_rho, cld_frac_l, acn, inv_dz, lookup_tables.dnu_table_vals, workspace_mgr,
+        nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, infrastructure.predictNc,
+        qc, nc, nc_incld, mu_c, lamc, qc_sed, ntend_ignore,
+        diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, sed_cols);
+
+    // Rain sedimentation:  (adaptive substepping)
+    rain_sedimentation_disp(
+        rho, inv_rho, rhofacr, cld_frac_r, inv_dz, qr_incld, workspace_mgr,
+        lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, qr,
+        nr, nr_incld, mu_r, lamr, precip_liq_flux, qr_sed, ntend_ignore,
+        diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, sed_cols, runtime_options);
+
+    // Ice sedimentation:  (adaptive substepping)
+    ice_sedimentation_disp(
+        rho, inv_rho, rhofaci, cld_frac_i, inv_dz, workspace_mgr, nj, nk, ktop, kbot,
+        kdir, infrastructure.dt, inv_dt, qi, qi_incld, ni, ni_incld,
+        qm, qm_incld, bm, bm_incld, qi_sed, ntend_ignore,
+        lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, nucleationPossible, hydrometeorsPresent, sed_cols, runtime_options);
+  }
 
   // homogeneous freezing f cloud and rain
   if(do_ice_production) {
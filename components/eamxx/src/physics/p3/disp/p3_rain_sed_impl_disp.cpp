@@ -29,18 +29,21 @@ void Functions<Real,DefaultDevice>
   const uview_1d<Scalar>& precip_liq_surf,
   const uview_1d<bool>& nucleationPossible,
   const uview_1d<bool>& hydrometeorsPresent,
+  const uview_1d<const Int>& sed_cols,
   const P3Runtime& runtime_options)
 {
   using ExeSpace = typename KT::ExeSpace;
   using TPF      = ekat::TeamPolicyFactory<ExeSpace>;
 
   const Int nk_pack = ekat::npack<Pack>(nk);
-  const auto policy = TPF::get_default_team_policy(nj, nk_pack);
+
+  // If a list of columns is provided, only process those
+  const bool use_sed_cols = sed_cols.size()>0;
+
   // p3_rain_sedimentation loop
-  Kokkos::parallel_for("p3_rain_sed_disp",
-    policy, KOKKOS_LAMBDA(const MemberType& team) {
+  const auto rain_sed = KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = use_sed_cols ? sed_cols(team.league_rank()) : team.league_rank();
     auto workspace = workspace_mgr.get_workspace(team);
     if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
       return;
@@ -54,7 +57,13 @@ void Functions<Real,DefaultDevice>
       ekat::subview(qr, i), ekat::subview(nr, i), ekat::subview(nr_incld, i), ekat::subview(mu_r, i),
       ekat::subview(lamr, i), ekat::subview(precip_liq_flux, i),
       ekat::subview(qr_tend, i), ekat::subview(nr_tend, i), precip_liq_surf(i), runtime_options);
-  });
+  };
+
+  if (use_sed_cols) {
+    Kokkos::parallel_for("p3_rain_sed_disp", get_sed_team_policy(sed_cols.size(), nk_pack), rain_sed);
+  } else {
+    Kokkos::parallel_for("p3_rain_sed_disp", TPF::get_default_team_policy(nj, nk_pack), rain_sed);
+  }
 
 }
 } // namespace p3
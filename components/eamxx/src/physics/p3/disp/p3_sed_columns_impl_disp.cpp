@@ -0,0 +1,146 @@
+#include "p3_functions.hpp" // for ETI only but harmless for GPU
+
+#include <ekat_subview_utils.hpp>
+#include <ekat_team_policy_utils.hpp>
+
+#include <Kokkos_Sort.hpp>
+
+namespace scream {
+namespace p3 {
+
+/*
+ * Implementation of the selection/ordering of the columns that need sedimentation.
+ * Clients should NOT #include this file, #include p3_functions.hpp instead.
+ */
+
+template <>
+typename Functions<Real,DefaultDevice>::SedTeamPolicy
+Functions<Real,DefaultDevice>
+::get_sed_team_policy(const Int& ncols, const Int& nk_pack)
+{
+  using ExeSpace = typename KT::ExeSpace;
+  using TPF      = ekat::TeamPolicyFactory<ExeSpace>;
+
+  // Use the same team size as the default policy, but with dynamic scheduling
+  const auto default_policy = TPF::get_default_team_policy(ncols, nk_pack);
+  return SedTeamPolicy(ncols, default_policy.team_size());
+}
+
+template <>
+Int Functions<Real,DefaultDevice>
+::get_sedimentation_columns_disp(
+  const uview_2d<const Pack>& qc,
+  const uview_2d<const Pack>& nc,
+  const uview_2d<const Pack>& qr,
+  const uview_2d<const Pack>& nr,
+  const uview_2d<const Pack>& qi,
+  const uview_2d<const Pack>& ni,
+  const uview_2d<const Pack>& rhofacr,
+  const uview_2d<const Pack>& rhofaci,
+  const uview_2d<const Pack>& inv_dz,
+  const Int& nj, const Int& nk, const Scalar& dt, const Scalar& inv_dt,
+  const uview_2d<Pack>& qc_tend,
+  const uview_2d<Pack>& qr_tend,
+  const uview_2d<Pack>& qi_tend,
+  const uview_2d<Pack>& n_tend,
+  const uview_1d<bool>& nucleationPossible,
+  const uview_1d<bool>& hydrometeorsPresent,
+  const view_1d<Scalar>& cost,
+  const view_1d<std::uint64_t>& keys,
+  const view_1d<Int>& sed_cols)
+{
+  using ExeSpace    = typename KT::ExeSpace;
+  using TPF         = ekat::TeamPolicyFactory<ExeSpace>;
+  using RangePolicy = typename KT::RangePolicy;
+
+  EKAT_REQUIRE_MSG (cost.extent_int(0)>=nj && keys.extent_int(0)>=nj && sed_cols.extent_int(0)>=nj,
+      "Error! The sedimentation columns work views must have at least nj=" << nj << " entries.\n");
+
+  constexpr Scalar qsmall = C::QSMALL;
+
+  // Rough upper bounds of the fall speeds [m s-1], only used to estimate the number of substeps
+  constexpr Scalar vmax_cloud = 0.1;
+  constexpr Scalar vmax_rain  = 9.1;
+  constexpr Scalar vmax_ice   = 5.0;
+
+  const Int nk_pack = ekat::npack<Pack>(nk);
+  const auto policy = TPF::get_default_team_policy(nj, nk_pack);
+
+  Kokkos::parallel_for("p3_sed_columns",
+    policy, KOKKOS_LAMBDA(const MemberType& team) {
+
+    const Int i = team.league_rank();
+    if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
+      Kokkos::single(Kokkos::PerTeam(team), [&] () { cost(i) = 0; });
+      return;
+    }
+
+    const auto sqc      = ekat::scalarize(ekat::subview(qc, i));
+    const auto sqr      = ekat::scalarize(ekat::subview(qr, i));
+    const auto sqi      = ekat::scalarize(ekat::subview(qi, i));
+    const auto srhofacr = ekat::scalarize(ekat::subview(rhofacr, i));
+    const auto srhofaci = ekat::scalarize(ekat::subview(rhofaci, i));
+    const auto sinv_dz  = ekat::scalarize(ekat::subview(inv_dz, i));
+
+    // Each level with hydrometeors is processed once per substep, and the number
+    // of substeps is roughly bounded by 1 + max Courant number
+    Scalar col_cost = 0;
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(team, nk), [&] (int k, Scalar& lcost) {
+      if (sqc(k) >= qsmall) {
+        lcost += 1 + vmax_cloud * dt * sinv_dz(k);
+      }
+      if (sqr(k) >= qsmall) {
+        lcost += 1 + vmax_rain * srhofacr(k) * dt * sinv_dz(k);
+      }
+      if (sqi(k) >= qsmall) {
+        lcost += 1 + vmax_ice * srhofaci(k) * dt * sinv_dz(k);
+      }
+    }, col_cost);
+
+    if (col_cost == 0) {
+      // Nothing to sediment. Finalize the tendencies like the sedimentation routines
+      // would (in the same order), so that answers do not change.
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(team, nk_pack), [&] (int pk) {
+        qc_tend(i,pk) = (qc(i,pk) - qc_tend(i,pk)) * inv_dt;
+        n_tend(i,pk)  = (nc(i,pk) - n_tend(i,pk)) * inv_dt;
+        qr_tend(i,pk) = (qr(i,pk) - qr_tend(i,pk)) * inv_dt;
+        n_tend(i,pk)  = (nr(i,pk) - n_tend(i,pk)) * inv_dt;
+        qi_tend(i,pk) = (qi(i,pk) - qi_tend(i,pk)) * inv_dt;
+        n_tend(i,pk)  = (ni(i,pk) - n_tend(i,pk)) * inv_dt;
+      });
+    }
+
+    Kokkos::single(Kokkos::PerTeam(team), [&] () { cost(i) = col_cost; });
+  });
+
+  // Compact the active columns into sort keys, with the (truncated) cost in the high bits,
+  // complemented so that an ascending sort gives decreasing cost, and the column index in
+  // the low bits, which breaks ties by increasing column index.
+  constexpr std::uint64_t max_key = 0xFFFFFFFF;
+  Int num_active = 0;
+  Kokkos::parallel_scan("p3_sed_columns_compact",
+    RangePolicy(0, nj), KOKKOS_LAMBDA(const Int i, Int& offset, const bool final) {
+    if (cost(i) > 0) {
+      if (final) {
+        const auto icost = static_cast<std::uint64_t>(Kokkos::min(cost(i), static_cast<Scalar>(max_key)));
+        keys(offset) = ((max_key - icost) << 32) | static_cast<std::uint64_t>(i);
+      }
+      ++offset;
+    }
+  }, num_active);
+
+  if (num_active > 0) {
+    Kokkos::sort(keys, 0, num_active);
+    Kokkos::parallel_for("p3_sed_columns_decode",
+      RangePolicy(0, num_active), KOKKOS_LAMBDA(const Int k) {
+      sed_cols(k) = static_cast<Int>(keys(k) & max_key);
+    });
+  }
+
+  return num_active;
+}
+
+} // namespace p3
+} // namespace scream
@@ -37,6 +37,19 @@ void P3Microphysics::create_requests()
   // Gather runtime options from file
   runtime_options.load_runtime_options_from_file(m_params);
 
+  // Select the implementation of p3_main: monolithic or small kernels (or auto-tune)
+  using Variant = physics::KernelVariantSelector::Variant;
+  m_kernel_selector.setup(m_params.get<std::string>("kernel_variant","default"),
+                          m_params.get<int>("kernel_autotune_nsteps",3),
+                          runtime_options.use_small_kernels ? Variant::SmallKernels : Variant::Monolithic,
+                          m_comm);
+  runtime_options.use_small_kernels = m_kernel_selector.get_variant()==Variant::SmallKernels;
+  if (runtime_options.compact_sedimentation_columns and not m_kernel_selector.may_use_small_kernels()) {
+    m_atm_logger->warn(
+        "[P3Microphysics::create_requests] Warning! compact_sedimentation_columns=true has no effect\n"
+        " when P3 runs with monolithic kernels (kernel_variant=" + m_kernel_selector.get_mode() + ").");
+  }
+
   // --Infrastructure
   // dt is passed as an argument to run_impl
   infrastructure.it  = 0;
@@ -169,12 +182,16 @@ size_t P3Microphysics::requested_buffer_size_in_bytes() const
   const Int nk_pack    = ekat::npack<Pack>(m_num_levs);
   const Int nk_pack_p1 = ekat::npack<Pack>(m_num_levs+1);
 
+  // The temporaries of the small kernels are only needed if they may be used
+  const int num_2d_vector = Buffer::num_2d_vector +
+                            (m_kernel_selector.may_use_small_kernels() ? Buffer::num_2d_vector_sk : 0);
+
   // Number of Reals needed by local views in the interface
   const size_t interface_request =
       // 1d view scalar, size (ncol)
       Buffer::num_1d_scalar*m_num_cols*sizeof(Real) +
       // 2d view packed, size (ncol, nlev_packs)
-      Buffer::num_2d_vector*m_num_cols*nk_pack*sizeof(Pack) +
+      num_2d_vector*m_num_cols*nk_pack*sizeof(Pack) +
       Buffer::num_2dp1_vector*m_num_cols*nk_pack_p1*sizeof(Pack) +
       // 2d view scalar, size (ncol, 3)
       m_num_cols*3*sizeof(Real);
@@ -219,8 +236,14 @@ void P3Microphysics::init_buffers(const ATMBufferManager &buffer_manager)
   spack_2d_view_t* _2d_spack_mid_view_ptrs[Buffer::num_2d_vector] = {
     &m_buffer.inv_exner, &m_buffer.th_atm, &m_buffer.cld_frac_l, &m_buffer.cld_frac_i,
     &m_buffer.dz, &m_buffer.qv2qi_depos_tend, &m_buffer.rho_qi, &m_buffer.unused
-#ifdef SCREAM_P3_SMALL_KERNELS
-    , &m_buffer.mu_r, &m_buffer.T_atm, &m_buffer.lamr, &m_buffer.logn0r, &m_buffer.nu,
+  };
+  for (int i=0; i<Buffer::num_2d_vector; ++i) {
+    *_2d_spack_mid_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nk_pack);
+    s_mem += _2d_spack_mid_view_ptrs[i]->size();
+  }
+
+  spack_2d_view_t* _2d_spack_mid_sk_view_ptrs[Buffer::num_2d_vector_sk] = {
+    &m_buffer.mu_r, &m_buffer.T_atm, &m_buffer.lamr, &m_buffer.logn0r, &m_buffer.nu,
     &m_buffer.cdist, &m_buffer.cdist1, &m_buffer.cdistr, &m_buffer.inv_cld_frac_i,
     &m_buffer.inv_cld_frac_l, &m_buffer.inv_cld_frac_r, &m_buffer.qc_incld, &m_buffer.qr_incld,
     &m_buffer.qi_incld, &m_buffer.qm_incld, &m_buffer.nc_incld, &m_buffer.nr_incld,
@@ -233,11 +256,12 @@ void P3Microphysics::init_buffers(const ATMBufferManager &buffer_manager)
     &m_buffer.v_nc, &m_buffer.flux_qx, &m_buffer.flux_nx, &m_buffer.v_qit, &m_buffer.v_nit,
     &m_buffer.flux_nit, &m_buffer.flux_bir, &m_buffer.flux_qir, &m_buffer.flux_qit, &m_buffer.v_qr,
     &m_buffer.v_nr
-#endif
   };
-  for (int i=0; i<Buffer::num_2d_vector; ++i) {
-    *_2d_spack_mid_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nk_pack);
-    s_mem += _2d_spack_mid_view_ptrs[i]->size();
+  if (m_kernel_selector.may_use_small_kernels()) {
+    for (int i=0; i<Buffer::num_2d_vector_sk; ++i) {
+      *_2d_spack_mid_sk_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nk_pack);
+      s_mem += _2d_spack_mid_sk_view_ptrs[i]->size();
+    }
   }
 
   spack_2d_view_t* _2d_spack_int_view_ptrs[Buffer::num_2dp1_vector] = {
@@ -287,8 +311,7 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
   add_postcondition_check<FieldWithinIntervalCheck>(get_field_out("eff_radius_qr"),m_grid,0.0,5.0e3,false);
 
   // Initialize p3
-  lookup_tables = P3F::p3_init(/* write_tables = */ false,
-                               this->get_comm().am_i_root());
+  lookup_tables = P3F::p3_init(/* write_tables = */ false, this->get_comm());
 
   // Initialize all of the structures that are passed to p3_main in run_impl.
   // Note: Some variables in the structures are not stored in the field manager.  For these
@@ -437,8 +460,8 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
     history_only.qc_sed = m_buffer.unused;
     history_only.qi_sed = m_buffer.unused;
   }
-#ifdef SCREAM_P3_SMALL_KERNELS
-  // Temporaries
+
+  // Temporaries (only allocated if small kernels may be used)
   temporaries.mu_r                    = m_buffer.mu_r;
   temporaries.T_atm                   = m_buffer.T_atm;
   temporaries.lamr                    = m_buffer.lamr;
@@ -494,7 +517,12 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
   temporaries.flux_qit                = m_buffer.flux_qit;
   temporaries.v_qr                    = m_buffer.v_qr;
   temporaries.v_nr                    = m_buffer.v_nr;
-#endif
+  if (runtime_options.compact_sedimentation_columns and m_kernel_selector.may_use_small_kernels()) {
+    // Work views for the selection of the sedimentation columns, allocated once here
+    temporaries.sed_cost = P3F::view_1d<Real>("sed_cost",m_num_cols);
+    temporaries.sed_keys = P3F::view_1d<std::uint64_t>("sed_keys",m_num_cols);
+    temporaries.sed_cols = P3F::view_1d<Int>("sed_cols",m_num_cols);
+  }
 
   // -- Set values for the post-amble structure
   p3_postproc.set_variables(m_num_cols,nk_pack,
@@ -4,6 +4,7 @@
 #include "share/atm_process/atmosphere_process.hpp"
 #include "physics/p3/p3_functions.hpp"
 #include "share/physics/eamxx_common_physics_functions.hpp"
+#include "share/physics/eamxx_kernel_variant_selector.hpp"
 
 #include <ekat_parameter_list.hpp>
 
@@ -390,11 +391,9 @@ public:
     // 1d view scalar, size (ncol)
     static constexpr int num_1d_scalar = 2; //no 2d vars now, but keeping 1d struct for future expansion
     // 2d view packed, size (ncol, nlev_packs)
-#ifdef SCREAM_P3_SMALL_KERNELS
-    static constexpr int num_2d_vector = 63;
-#else
     static constexpr int num_2d_vector = 8;
-#endif
+    // 2d view packed, size (ncol, nlev_packs), only needed by small kernels
+    static constexpr int num_2d_vector_sk = 55;
     static constexpr int num_2dp1_vector = 2;
 
     uview_1d precip_liq_surf_flux;
@@ -410,7 +409,7 @@ public:
     uview_2d precip_ice_flux; //nlev+1
     uview_2d unused;
 
-#ifdef SCREAM_P3_SMALL_KERNELS
+    // Temporaries of the small kernels implementation
     uview_2d
       mu_r, T_atm, lamr, logn0r, nu, cdist, cdist1, cdistr,
       inv_cld_frac_i, inv_cld_frac_l, inv_cld_frac_r,
@@ -423,7 +422,6 @@ public:
       mu_c, lamc, qr_evap_tend, v_qc, v_nc, flux_qx, flux_nx,
       v_qit, v_nit, flux_nit, flux_bir, flux_qir, flux_qit,
       v_qr, v_nr;
-#endif
 
     suview_2d col_location;
 
@@ -458,9 +456,7 @@ protected:
   P3F::P3DiagnosticOutputs diag_outputs;
   P3F::P3HistoryOnly       history_only;
   P3F::P3LookupTables      lookup_tables;
-#ifdef SCREAM_P3_SMALL_KERNELS
   P3F::P3Temporaries       temporaries;
-#endif
   P3F::P3Infrastructure    infrastructure;
   P3F::P3Runtime           runtime_options;
   p3_preamble              p3_preproc;
@@ -469,6 +465,9 @@ protected:
   // WSM for internal local variables
   ekat::WorkspaceManager<Pack, KT::Device> workspace_mgr;
 
+  // Selects the monolithic or small kernels implementation of p3_main
+  physics::KernelVariantSelector m_kernel_selector;
+
   std::shared_ptr<const AbstractGrid>   m_grid;
   // Iteration count is internal to P3 and keeps track of the number of times p3_main has been called.
   // infrastructure.it is passed as an arguement to p3_main and is used for identifying which iteration an error occurs.
@@ -55,12 +55,18 @@ void P3Microphysics::run_impl (const double dt)
     get_field_out("qi_sed").deep_copy(0.0);
   }
 
-  P3F::p3_main(runtime_options, prog_state, diag_inputs, diag_outputs, infrastructure,
-               history_only, lookup_tables,
-#ifdef SCREAM_P3_SMALL_KERNELS
-               temporaries,
-#endif
-               workspace_mgr, m_num_cols, m_num_levs);
+  using Variant = physics::KernelVariantSelector::Variant;
+  runtime_options.use_small_kernels = m_kernel_selector.get_variant()==Variant::SmallKernels;
+  const auto elapsed_microsec =
+    P3F::p3_main(runtime_options, prog_state, diag_inputs, diag_outputs, infrastructure,
+                 history_only, lookup_tables, temporaries,
+                 workspace_mgr, m_num_cols, m_num_levs);
+
+  // While auto-tuning, time both implementations, then log the choice
+  if (m_kernel_selector.is_tuning() and m_kernel_selector.record_time(elapsed_microsec)) {
+    m_atm_logger->info("[P3Microphysics] kernel variant " + m_kernel_selector.get_tuning_summary() +
+                       ", times in us");
+  }
 
   // Conduct the post-processing of the p3_main output.
   Kokkos::parallel_for(
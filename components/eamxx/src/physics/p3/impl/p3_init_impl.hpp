@@ -3,36 +3,112 @@
 
 #include "p3_functions.hpp" // for ETI only but harmless for GPU
 
+#include <ekat_comm.hpp>
+
 #include <fstream>
+#include <string>
+#include <vector>
 
 namespace scream {
 namespace p3 {
 
 namespace {
 
-template <typename S, typename IceT, typename CollT>
-void read_ice_lookup_tables(const bool masterproc, const char* p3_lookup_base, const char* p3_version, IceT& ice_table_vals, CollT& collect_table_vals, int densize, int rimsize, int isize, int rcollsize)
+inline std::string precision_extension ()
 {
-  using DeviceIcetable = typename IceT::non_const_type;
-  using DeviceColtable = typename CollT::non_const_type;
+  return
+#ifdef SCREAM_DOUBLE_PRECISION
+    "8"
+#else
+    "4"
+#endif
+    ;
+}
 
-  const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
-  const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
+// The binary cache of the ice tables holds the tables exactly as they are stored in
+// memory (i.e., after dropping unused entries and taking log10 of the collection table),
+// so that it can be loaded with a couple of read calls, rather than parsing the ascii file.
+// The cache starts with a small header, used to validate it against the expected
+// table version, table sizes, and floating point precision.
+inline std::string ice_tables_cache_filename (const std::string& filename)
+{
+  return filename + ".bin" + precision_extension();
+}
 
-  const auto ice_table_vals_h    = Kokkos::create_mirror_view(ice_table_vals_d);
-  const auto collect_table_vals_h = Kokkos::create_mirror_view(collect_table_vals_d);
+constexpr char ice_tables_cache_magic[8] = "P3ICETB";
 
-  //
-  // read in ice microphysics table into host views. We always read these as doubles.
-  //
+inline std::vector<int> ice_tables_cache_dims (const int densize, const int rimsize, const int isize, const int rcollsize,
+                                              const int ice_size, const int coll_size, const int scalar_size)
+{
+  return {densize, rimsize, isize, rcollsize, ice_size, coll_size, scalar_size};
+}
 
-  std::string filename = std::string(p3_lookup_base) + std::string(p3_version);
+// Returns false if the cache does not exist or does not match the expected version/sizes
+template <typename IceH, typename CollH>
+bool read_ice_tables_cache (const std::string& filename, const char* p3_version,
+                            const std::vector<int>& dims, const IceH& ice_h, const CollH& coll_h)
+{
+  using S = typename IceH::value_type;
 
-  if (masterproc) {
-    std::cout << "Reading ice lookup tables in file: " << filename << std::endl;
+  std::ifstream in(filename, std::ios::binary);
+  if (not in.good()) {
+    return false;
   }
 
+  char magic[sizeof(ice_tables_cache_magic)];
+  in.read(magic,sizeof(magic));
+  if (not in.good() or std::string(magic,sizeof(magic)-1)!=std::string(ice_tables_cache_magic)) {
+    return false;
+  }
+
+  int version_len;
+  in.read(reinterpret_cast<char*>(&version_len),sizeof(int));
+  if (not in.good() or version_len<0 or version_len>256) {
+    return false;
+  }
+  std::string version(version_len,' ');
+  in.read(&version.front(),version_len);
+  if (not in.good() or version!=p3_version) {
+    return false;
+  }
+
+  std::vector<int> file_dims(dims.size());
+  in.read(reinterpret_cast<char*>(file_dims.data()),sizeof(int)*file_dims.size());
+  if (not in.good() or file_dims!=dims) {
+    return false;
+  }
+
+  in.read(reinterpret_cast<char*>(ice_h.data()),sizeof(S)*ice_h.size());
+  in.read(reinterpret_cast<char*>(coll_h.data()),sizeof(S)*coll_h.size());
+  return in.good();
+}
+
+template <typename IceH, typename CollH>
+void write_ice_tables_cache (const std::string& filename, const char* p3_version,
+                             const std::vector<int>& dims, const IceH& ice_h, const CollH& coll_h)
+{
+  using S = typename IceH::value_type;
+
+  std::ofstream out(filename, std::ios::binary);
+  EKAT_REQUIRE_MSG (out.good(), "Error! Could not open " << filename << " for writing.\n");
+
+  const std::string version(p3_version);
+  const int version_len = version.size();
+  out.write(ice_tables_cache_magic,sizeof(ice_tables_cache_magic));
+  out.write(reinterpret_cast<const char*>(&version_len),sizeof(int));
+  out.write(version.data(),version_len);
+  out.write(reinterpret_cast<const char*>(dims.data()),sizeof(int)*dims.size());
+  out.write(reinterpret_cast<const char*>(ice_h.data()),sizeof(S)*ice_h.size());
+  out.write(reinterpret_cast<const char*>(coll_h.data()),sizeof(S)*coll_h.size());
+  EKAT_REQUIRE_MSG (out.good(), "Error! Something went wrong while writing " << filename << ".\n");
+}
+
+template <typename IceH, typename CollH>
+void read_ice_tables_text (const std::string& filename, const char* p3_version, const IceH& ice_table_vals_h, const CollH& collect_table_vals_h,
+                           int densize, int rimsize, int isize, int rcollsize)
+{
   std::ifstream in(filename);
+  EKAT_REQUIRE_MSG (in.good(), "Error! Could not open " << filename << "\n");
 
   // read header
   std::string version, version_val;
@@ -69,6 +145,60 @@ void read_ice_lookup_tables(const bool masterproc, const char* p3_lookup_base, c
       }
     }
   }
+}
+
+// If comm is not null, only its root rank touches the file system, and the tables
+// are broadcast to all other ranks. Otherwise, each rank reads the tables on its own.
+// If write_cache=true, the ascii file is always parsed, and the binary cache is (re)generated.
+template <typename S, typename IceT, typename CollT>
+void read_ice_lookup_tables(const bool masterproc, const ekat::Comm* comm, const bool write_cache,
+                            const char* p3_lookup_base, const char* p3_version, IceT& ice_table_vals, CollT& collect_table_vals,
+                            int densize, int rimsize, int isize, int rcollsize)
+{
+  using DeviceIcetable = typename IceT::non_const_type;
+  using DeviceColtable = typename CollT::non_const_type;
+
+  const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
+  const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
+
+  const auto ice_table_vals_h    = Kokkos::create_mirror_view(ice_table_vals_d);
+  const auto collect_table_vals_h = Kokkos::create_mirror_view(collect_table_vals_d);
+
+  //
+  // read in ice microphysics table into host views. We always read these as doubles.
+  //
+
+  std::string filename = std::string(p3_lookup_base) + std::string(p3_version);
+  std::string cache_filename = ice_tables_cache_filename(filename);
+  const auto dims = ice_tables_cache_dims(densize,rimsize,isize,rcollsize,
+                                          ice_table_vals_d.extent_int(3),
+                                          collect_table_vals_d.extent_int(4),
+                                          sizeof(S));
+
+  if (comm==nullptr or comm->am_i_root()) {
+    if (not write_cache and read_ice_tables_cache(cache_filename,p3_version,dims,ice_table_vals_h,collect_table_vals_h)) {
+      if (masterproc) {
+        std::cout << "Reading ice lookup tables in file: " << cache_filename << std::endl;
+      }
+    } else {
+      if (masterproc) {
+        std::cout << "Reading ice lookup tables in file: " << filename << std::endl;
+      }
+      read_ice_tables_text(filename,p3_version,ice_table_vals_h,collect_table_vals_h,densize,rimsize,isize,rcollsize);
+
+      if (write_cache) {
+        if (masterproc) {
+          std::cout << "Writing ice lookup tables in file: " << cache_filename << std::endl;
+        }
+        write_ice_tables_cache(cache_filename,p3_version,dims,ice_table_vals_h,collect_table_vals_h);
+      }
+    }
+  }
+
+  if (comm!=nullptr and comm->size()>1) {
+    comm->broadcast(ice_table_vals_h.data(),ice_table_vals_h.size(),comm->root_rank());
+    comm->broadcast(collect_table_vals_h.data(),collect_table_vals_h.size(),comm->root_rank());
+  }
 
   // deep copy to device
   Kokkos::deep_copy(ice_table_vals_d, ice_table_vals_h);
@@ -210,20 +340,16 @@ static void action(StreamT& stream, S* data, const size_t size)
   }
 }
 
+// If comm is not null, only its root rank touches the file system. When reading,
+// the tables are then broadcast to all other ranks.
 template <bool IsRead, typename MuRT, typename VNT, typename VMT, typename RevapT>
-void io_impl(const bool masterproc, const char* dir, MuRT& mu_r_table_vals, VNT& vn_table_vals, VMT& vm_table_vals, RevapT& revap_table_vals)
+void io_impl(const bool masterproc, const ekat::Comm* comm, const char* dir, MuRT& mu_r_table_vals, VNT& vn_table_vals, VMT& vm_table_vals, RevapT& revap_table_vals)
 {
   if (masterproc) {
     std::cout << (IsRead ? "Reading" : "Writing") << " lookup (non-ice) tables in dir " << dir << std::endl;
   }
 
-  std::string extension =
-#ifdef SCREAM_DOUBLE_PRECISION
-    "8"
-#else
-    "4"
-#endif
-    ;
+  std::string extension = precision_extension();
 
   // Get host views
   auto mu_r_table_vals_h  = Kokkos::create_mirror_view(mu_r_table_vals);
@@ -238,18 +364,30 @@ void io_impl(const bool masterproc, const char* dir, MuRT& mu_r_table_vals, VNT&
   std::string vn_filename    = std::string(dir) + "/vn_table_vals_v2.dat" + extension;
   std::string vm_filename    = std::string(dir) + "/vm_table_vals_v2.dat" + extension;
 
-  using stream_t = std::conditional_t<IsRead,std::ifstream,std::ofstream>;
+  if (comm==nullptr or comm->am_i_root()) {
+    using stream_t = std::conditional_t<IsRead,std::ifstream,std::ofstream>;
+
+    stream_t mu_r_file(mu_r_filename.c_str(), std::ios::binary);
+    stream_t revap_file(revap_filename.c_str(), std::ios::binary);
+    stream_t vn_file(vn_filename.c_str(), std::ios::binary);
+    stream_t vm_file(vm_filename, std::ios::binary);
 
-  stream_t mu_r_file(mu_r_filename.c_str(), std::ios::binary);
-  stream_t revap_file(revap_filename.c_str(), std::ios::binary);
-  stream_t vn_file(vn_filename.c_str(), std::ios::binary);
-  stream_t vm_file(vm_filename, std::ios::binary);
+    // Read files
+    action(mu_r_file, mu_r_table_vals_h.data(), mu_r_table_vals.size());
+    action(revap_file, revap_table_vals_h.data(), revap_table_vals.size());
+    action(vn_file, vn_table_vals_h.data(), vn_table_vals.size());
+    action(vm_file, vm_table_vals_h.data(), vm_table_vals.size());
+  }
 
-  // Read files
-  action(mu_r_file, mu_r_table_vals_h.data(), mu_r_table_vals.size());
-  action(revap_file, revap_table_vals_h.data(), revap_table_vals.size());
-  action(vn_file, vn_table_vals_h.data(), vn_table_vals.size());
-  action(vm_file, vm_table_vals_h.data(), vm_table_vals.size());
+  if constexpr (IsRead) {
+    if (comm!=nullptr and comm->size()>1) {
+      const int root = comm->root_rank();
+      comm->broadcast(mu_r_table_vals_h.data(), mu_r_table_vals_h.size(), root);
+      comm->broadcast(revap_table_vals_h.data(), revap_table_vals_h.size(), root);
+      comm->broadcast(vn_table_vals_h.data(), vn_table_vals_h.size(), root);
+      comm->broadcast(vm_table_vals_h.data(), vm_table_vals_h.size(), root);
+    }
+  }
 
   // Copy back to device
   if constexpr (IsRead) {
@@ -261,7 +399,7 @@ void io_impl(const bool masterproc, const char* dir, MuRT& mu_r_table_vals, VNT&
 }
 
 template <typename MuRT, typename VNT, typename VMT, typename RevapT>
-void read_computed_tables(const bool masterproc, const char* dir, MuRT& mu_r_table_vals, VNT& vn_table_vals, VMT& vm_table_vals, RevapT& revap_table_vals)
+void read_computed_tables(const bool masterproc, const ekat::Comm* comm, const char* dir, MuRT& mu_r_table_vals, VNT& vn_table_vals, VMT& vm_table_vals, RevapT& revap_table_vals)
 {
   using MuRT_NC   = typename MuRT::non_const_type;
   using VNT_NC    = typename VNT::non_const_type;
@@ -273,7 +411,7 @@ void read_computed_tables(const bool masterproc, const char* dir, MuRT& mu_r_tab
   VMT_NC    vm_table_vals_nc("vm_table_vals");
   RevapT_NC revap_table_vals_nc("revap_table_vals");
 
-  io_impl<true>(masterproc, dir, mu_r_table_vals_nc, vn_table_vals_nc, vm_table_vals_nc, revap_table_vals_nc);
+  io_impl<true>(masterproc, comm, dir, mu_r_table_vals_nc, vn_table_vals_nc, vm_table_vals_nc, revap_table_vals_nc);
 
   mu_r_table_vals = mu_r_table_vals_nc;
   vn_table_vals = vn_table_vals_nc;
@@ -282,9 +420,9 @@ void read_computed_tables(const bool masterproc, const char* dir, MuRT& mu_r_tab
 }
 
 template <typename MuRT, typename VNT, typename VMT, typename RevapT>
-void write_computed_tables(const bool masterproc, const char* dir, const MuRT& mu_r_table_vals, const VNT& vn_table_vals, const VMT& vm_table_vals, const RevapT& revap_table_vals)
+void write_computed_tables(const bool masterproc, const ekat::Comm* comm, const char* dir, const MuRT& mu_r_table_vals, const VNT& vn_table_vals, const VMT& vm_table_vals, const RevapT& revap_table_vals)
 {
-  io_impl<false>(masterproc, dir, mu_r_table_vals, vn_table_vals, vm_table_vals, revap_table_vals);
+  io_impl<false>(masterproc, comm, dir, mu_r_table_vals, vn_table_vals, vm_table_vals, revap_table_vals);
 }
 
 template <typename S, typename DnuT>
@@ -312,28 +450,21 @@ void compute_dnu(DnuT& dnu_table_vals)
   dnu_table_vals = DnuT(dnu_table_vals_non_const);
 }
 
-}
-
-/*
- * Implementation of p3 init. Clients should NOT #include
- * this file, #include p3_functions.hpp instead.
- */
-template <typename S, typename D>
-typename Functions<S,D>::P3LookupTables Functions<S,D>
-::p3_init (const bool write_tables, const bool masterproc) {
+template <typename S, typename P3C, typename P3LookupTables>
+P3LookupTables p3_init_impl (const bool write_tables, const bool masterproc, const ekat::Comm* comm) {
   P3LookupTables lookup_tables; // This struct could be our global singleton
   auto version = P3C::p3_version;
   auto p3_lookup_base = P3C::p3_lookup_base;
   static const char* dir = SCREAM_DATA_DIR "/tables";
   // p3_init_a (reads ice_table, collect_table)
-  read_ice_lookup_tables<S>(masterproc, p3_lookup_base, version, lookup_tables.ice_table_vals, lookup_tables.collect_table_vals, P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize);
+  read_ice_lookup_tables<S>(masterproc, comm, write_tables, p3_lookup_base, version, lookup_tables.ice_table_vals, lookup_tables.collect_table_vals, P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize);
   if (write_tables) {
     //p3_init_b (computes tables mu_r_table, revap_table, vn_table, vm_table)
     compute_tables<S, P3C>(masterproc, lookup_tables.mu_r_table_vals, lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, lookup_tables.revap_table_vals);
-    write_computed_tables(masterproc, dir, lookup_tables.mu_r_table_vals, lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, lookup_tables.revap_table_vals);
+    write_computed_tables(masterproc, comm, dir, lookup_tables.mu_r_table_vals, lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, lookup_tables.revap_table_vals);
   }
   else {
-    read_computed_tables(masterproc, dir, lookup_tables.mu_r_table_vals, lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, lookup_tables.revap_table_vals);
+    read_computed_tables(masterproc, comm, dir, lookup_tables.mu_r_table_vals, lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, lookup_tables.revap_table_vals);
   }
   // dnu is always computed/hardcoded
   compute_dnu<S>(lookup_tables.dnu_table_vals);
@@ -341,6 +472,24 @@ typename Functions<S,D>::P3LookupTables Functions<S,D>
   return lookup_tables;
 }
 
+}
+
+/*
+ * Implementation of p3 init. Clients should NOT #include
+ * this file, #include p3_functions.hpp instead.
+ */
+template <typename S, typename D>
+typename Functions<S,D>::P3LookupTables Functions<S,D>
+::p3_init (const bool write_tables, const bool masterproc) {
+  return p3_init_impl<S,P3C,P3LookupTables>(write_tables, masterproc, nullptr);
+}
+
+template <typename S, typename D>
+typename Functions<S,D>::P3LookupTables Functions<S,D>
+::p3_init (const bool write_tables, const ekat::Comm& comm) {
+  return p3_init_impl<S,P3C,P3LookupTables>(write_tables, comm.am_i_root(), &comm);
+}
+
 } // namespace p3
 } // namespace scream
 
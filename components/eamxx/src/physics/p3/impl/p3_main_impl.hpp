@@ -366,35 +366,33 @@ Int Functions<S,D>
   const P3Infrastructure& infrastructure,
   const P3HistoryOnly& history_only,
   const P3LookupTables& lookup_tables,
-#ifdef SCREAM_P3_SMALL_KERNELS
   const P3Temporaries& temporaries,
-#endif
   const WorkspaceManager& workspace_mgr,
   Int nj,
   Int nk)
 {
-#ifdef SCREAM_P3_SMALL_KERNELS
-  return p3_main_internal_disp(runtime_options,
-                               prognostic_state,
-                               diagnostic_inputs,
-                               diagnostic_outputs,
-                               infrastructure,
-                               history_only,
-                               lookup_tables,
-                               temporaries,
-                               workspace_mgr,
-                               nj, nk);
-#else
-  return p3_main_internal(runtime_options,
-                          prognostic_state,
-                          diagnostic_inputs,
-                          diagnostic_outputs,
-                          infrastructure,
-                          history_only,
-                          lookup_tables,
-                          workspace_mgr,
-                          nj, nk);
-#endif
+  if (runtime_options.use_small_kernels) {
+    return p3_main_internal_disp(runtime_options,
+                                 prognostic_state,
+                                 diagnostic_inputs,
+                                 diagnostic_outputs,
+                                 infrastructure,
+                                 history_only,
+                                 lookup_tables,
+                                 temporaries,
+                                 workspace_mgr,
+                                 nj, nk);
+  } else {
+    return p3_main_internal(runtime_options,
+                            prognostic_state,
+                            diagnostic_inputs,
+                            diagnostic_outputs,
+                            infrastructure,
+                            history_only,
+                            lookup_tables,
+                            workspace_mgr,
+                            nj, nk);
+  }
 }
 } // namespace p3
 } // namespace scream
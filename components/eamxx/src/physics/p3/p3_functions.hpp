@@ -5,10 +5,13 @@
 
 #include "share/core/eamxx_types.hpp"
 
+#include <ekat_comm.hpp>
 #include <ekat_pack_kokkos.hpp>
 #include <ekat_parameter_list.hpp>
 #include <ekat_workspace.hpp>
 
+#include <cstdint>
+
 namespace scream
 {
 namespace p3
@@ -132,6 +135,16 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     bool use_hetfrz_classnuc                    = false;
     bool use_separate_ice_liq_frac              = false;
     bool extra_p3_diags                         = false;
+    // Run sedimentation only over columns with hydrometeors, most expensive first.
+    // Only has an effect with small kernels (see use_small_kernels).
+    bool compact_sedimentation_columns          = false;
+    // Use the small kernels implementation of p3_main, rather than the monolithic one.
+    // The default is set at build time, but the process interface can change it.
+#ifdef SCREAM_P3_SMALL_KERNELS
+    bool use_small_kernels                      = true;
+#else
+    bool use_small_kernels                      = false;
+#endif
 
     void
     load_runtime_options_from_file(ekat::ParameterList &params)
@@ -174,6 +187,8 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       use_separate_ice_liq_frac =
           params.get<bool>("use_separate_ice_liq_frac", use_separate_ice_liq_frac);
       extra_p3_diags = params.get<bool>("extra_p3_diags", extra_p3_diags);
+      compact_sedimentation_columns =
+          params.get<bool>("compact_sedimentation_columns", compact_sedimentation_columns);
     }
   };
 
@@ -328,7 +343,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     view_dnu_table dnu_table_vals;
   };
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   struct P3Temporaries {
     // shape parameter of rain
     view_2d<Pack> mu_r;
@@ -363,8 +377,11 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     view_2d<Pack> flux_qir, flux_qit;
     // rain sedimentation
     view_2d<Pack> v_qr, v_nr;
+    // selection of the sedimentation columns, size nj (only needed if compact_sedimentation_columns=true)
+    view_1d<Scalar> sed_cost;
+    view_1d<std::uint64_t> sed_keys;
+    view_1d<Int> sed_cols;
   };
-#endif
 
   // -- Table3 --
 
@@ -397,6 +414,11 @@ template <typename ScalarT, typename DeviceT> struct Functions {
 
   static P3LookupTables p3_init(const bool write_tables = false, const bool masterproc = false);
 
+  // Same as above, but only the root rank of comm reads the tables from file (using
+  // the binary cache of the ice tables, if available), and broadcasts them to all other ranks.
+  // If write_tables=true, the binary cache of the ice tables is (re)generated as well.
+  static P3LookupTables p3_init(const bool write_tables, const ekat::Comm& comm);
+
   // Map (mu_r, lamr) to Table3 data.
   KOKKOS_FUNCTION
   static void lookup(const Pack &mu_r, const Pack &lamr, Table3 &tab,
@@ -520,7 +542,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &nc_incld, const uview_1d<Pack> &mu_c, const uview_1d<Pack> &lamc,
       const uview_1d<Pack> &qc_tend, const uview_1d<Pack> &nc_tend, Scalar &precip_liq_surf);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void cloud_sedimentation_disp(
       const uview_2d<Pack> &qc_incld, const uview_2d<const Pack> &rho,
       const uview_2d<const Pack> &inv_rho, const uview_2d<const Pack> &cld_frac_l,
@@ -531,8 +552,7 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &nc, const uview_2d<Pack> &nc_incld, const uview_2d<Pack> &mu_c,
       const uview_2d<Pack> &lamc, const uview_2d<Pack> &qc_tend, const uview_2d<Pack> &nc_tend,
       const uview_1d<Scalar> &precip_liq_surf, const uview_1d<bool> &is_nucleat_possible,
-      const uview_1d<bool> &is_hydromet_present);
-#endif
+      const uview_1d<bool> &is_hydromet_present, const uview_1d<const Int> &sed_cols);
 
   // TODO: comment
   KOKKOS_FUNCTION
@@ -548,7 +568,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &qr_tend, const uview_1d<Pack> &nr_tend, Scalar &precip_liq_surf,
       const P3Runtime &runtime_options);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void rain_sedimentation_disp(
       const uview_2d<const Pack> &rho, const uview_2d<const Pack> &inv_rho,
       const uview_2d<const Pack> &rhofacr, const uview_2d<const Pack> &cld_frac_r,
@@ -561,8 +580,7 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &precip_liq_flux, const uview_2d<Pack> &qr_tend,
       const uview_2d<Pack> &nr_tend, const uview_1d<Scalar> &precip_liq_surf,
       const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present,
-      const P3Runtime &runtime_options);
-#endif
+      const uview_1d<const Int> &sed_cols, const P3Runtime &runtime_options);
 
   // TODO: comment
   KOKKOS_FUNCTION
@@ -578,7 +596,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const view_ice_table &ice_table_vals, Scalar &precip_ice_surf,
       const P3Runtime &runtime_options);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void ice_sedimentation_disp(
       const uview_2d<const Pack> &rho, const uview_2d<const Pack> &inv_rho,
       const uview_2d<const Pack> &rhofaci, const uview_2d<const Pack> &cld_frac_i,
@@ -590,8 +607,31 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &qi_tend, const uview_2d<Pack> &ni_tend,
       const view_ice_table &ice_table_vals, const uview_1d<Scalar> &precip_ice_surf,
       const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present,
-      const P3Runtime &runtime_options);
-#endif
+      const uview_1d<const Int> &sed_cols, const P3Runtime &runtime_options);
+
+  // Team policy used by the *_sedimentation_disp functions when looping over a list of
+  // columns. Uses dynamic scheduling, so that teams pick columns in the order of the list.
+  using SedTeamPolicy = Kokkos::TeamPolicy<typename KT::ExeSpace, Kokkos::Schedule<Kokkos::Dynamic>>;
+  static SedTeamPolicy get_sed_team_policy(const Int &ncols, const Int &nk_pack);
+
+  // Fill sed_cols with the columns that have some hydrometeor mass above QSMALL, sorted by
+  // decreasing estimated sedimentation cost, and return their number. The cost estimate is
+  // the number of levels with hydrometeors times a rough upper bound of the number of substeps.
+  // For the columns that are left out (and would be processed by p3 otherwise), the
+  // sedimentation tendencies are finalized here, exactly as the *_sedimentation functions do.
+  // The compaction and the sort are done on device; sed_cost and sed_keys are work views of
+  // size nj, and only the number of selected columns is copied back to host.
+  static Int get_sedimentation_columns_disp(
+      const uview_2d<const Pack> &qc, const uview_2d<const Pack> &nc,
+      const uview_2d<const Pack> &qr, const uview_2d<const Pack> &nr,
+      const uview_2d<const Pack> &qi, const uview_2d<const Pack> &ni,
+      const uview_2d<const Pack> &rhofacr, const uview_2d<const Pack> &rhofaci,
+      const uview_2d<const Pack> &inv_dz, const Int &nj, const Int &nk, const Scalar &dt,
+      const Scalar &inv_dt, const uview_2d<Pack> &qc_tend, const uview_2d<Pack> &qr_tend,
+      const uview_2d<Pack> &qi_tend, const uview_2d<Pack> &n_tend,
+      const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present,
+      const view_1d<Scalar> &sed_cost, const view_1d<std::uint64_t> &sed_keys,
+      const view_1d<Int> &sed_cols);
 
   // homogeneous freezing of cloud and rain
   KOKKOS_FUNCTION
@@ -604,7 +644,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                                    const uview_1d<Pack> &qm, const uview_1d<Pack> &bm,
                                    const uview_1d<Pack> &th_atm);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void homogeneous_freezing_disp(
       const uview_2d<const Pack> &T_atm, const uview_2d<const Pack> &inv_exner, const Int &nj,
       const Int &nk, const Int &ktop, const Int &kbot, const Int &kdir, const uview_2d<Pack> &qc,
@@ -612,7 +651,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &qi, const uview_2d<Pack> &ni, const uview_2d<Pack> &qm,
       const uview_2d<Pack> &bm, const uview_2d<Pack> &th_atm,
       const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present);
-#endif
 
   // -- Find layers
 
@@ -911,13 +949,11 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                            const bool &force_abort, const Int &source_ind, const MemberType &team,
                            const uview_1d<const Scalar> &col_loc);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void check_values_disp(const uview_2d<const Pack> &qv, const uview_2d<const Pack> &temp,
                                 const Int &ktop, const Int &kbot, const Int &timestepcount,
                                 const bool &force_abort, const Int &source_ind,
                                 const uview_2d<const Scalar> &col_loc, const Int &nj,
                                 const Int &nk);
-#endif
 
   KOKKOS_FUNCTION
   static void calculate_incloud_mixingratios(
@@ -945,7 +981,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                const uview_1d<Pack> &qv, const uview_1d<Pack> &inv_dz, Scalar &precip_liq_surf,
                Scalar &precip_ice_surf, view_1d_ptr_array<Pack, 36> &zero_init);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void p3_main_init_disp(
       const Int &nj, const Int &nk_pack, const uview_2d<const Pack> &cld_frac_i,
       const uview_2d<const Pack> &cld_frac_l, const uview_2d<const Pack> &cld_frac_r,
@@ -972,7 +1007,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &rho_qi, const uview_2d<Pack> &qv2qi_depos_tend,
       const uview_2d<Pack> &precip_total_tend, const uview_2d<Pack> &nevapr,
       const uview_2d<Pack> &precip_liq_flux, const uview_2d<Pack> &precip_ice_flux);
-#endif
 
   KOKKOS_FUNCTION
   static void p3_main_part1(
@@ -995,7 +1029,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &ni_incld, const uview_1d<Pack> &bm_incld, bool &is_nucleat_possible,
       bool &is_hydromet_present, const P3Runtime &runtime_options);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void p3_main_part1_disp(
       const Int &nj, const Int &nk, const bool &do_predict_nc, const bool &do_prescribed_CCN,
       const Scalar &dt, const uview_2d<const Pack> &pres, const uview_2d<const Pack> &dpres,
@@ -1016,7 +1049,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &ni_incld, const uview_2d<Pack> &bm_incld,
       const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present,
       const P3Runtime &runtime_options);
-#endif
 
   KOKKOS_FUNCTION
   static void p3_main_part2(
@@ -1061,7 +1093,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &prctot, bool &is_hydromet_present, const Int &nk,
       const P3Runtime &runtime_options);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void p3_main_part2_disp(
       const Int &nj, const Int &nk, const Scalar &max_total_ni, const bool &do_predict_nc,
       const bool &do_prescribed_CCN, const Scalar &dt, const Scalar &inv_dt,
@@ -1103,7 +1134,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &qi2qr_melt, const uview_2d<Pack> &pratot,
       const uview_2d<Pack> &prctot, const uview_1d<bool> &is_nucleat_possible,
       const uview_1d<bool> &is_hydromet_present, const P3Runtime &runtime_options);
-#endif
 
   KOKKOS_FUNCTION
   static void
@@ -1125,7 +1155,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                 const uview_1d<Pack> &diag_eff_radius_qc,
                 const uview_1d<Pack> &diag_eff_radius_qr, const P3Runtime &runtime_options);
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static void p3_main_part3_disp(
       const Int &nj, const Int &nk_pack, const Scalar &max_total_ni, const view_dnu_table &dnu,
       const view_ice_table &ice_table_vals, const uview_2d<const Pack> &inv_exner,
@@ -1144,7 +1173,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_2d<Pack> &diag_eff_radius_qc, const uview_2d<Pack> &diag_eff_radius_qr,
       const uview_1d<bool> &is_nucleat_possible, const uview_1d<bool> &is_hydromet_present,
       const P3Runtime &runtime_options);
-#endif
 
   // Return microseconds elapsed
   static Int p3_main(const P3Runtime &runtime_options, const P3PrognosticState &prognostic_state,
@@ -1152,9 +1180,7 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                      const P3DiagnosticOutputs &diagnostic_outputs,
                      const P3Infrastructure &infrastructure, const P3HistoryOnly &history_only,
                      const P3LookupTables &lookup_tables,
-#ifdef SCREAM_P3_SMALL_KERNELS
                      const P3Temporaries &temporaries,
-#endif
                      const WorkspaceManager &workspace_mgr,
                      Int nj,  // number of columns
                      Int nk); // number of vertical cells per column
@@ -1168,7 +1194,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                    Int nj,  // number of columns
                    Int nk); // number of vertical cells per column
 
-#ifdef SCREAM_P3_SMALL_KERNELS
   static Int
   p3_main_internal_disp(const P3Runtime &runtime_options, const P3PrognosticState &prognostic_state,
                         const P3DiagnosticInputs &diagnostic_inputs,
@@ -1178,7 +1203,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                         const WorkspaceManager &workspace_mgr,
                         Int nj,  // number of columns
                         Int nk); // number of vertical cells per column
-#endif
 
   KOKKOS_FUNCTION
   static void ice_supersat_conservation(Pack &qidep, Pack &qinuc, Pack &qinuc_cnt,
@@ -1466,7 +1466,6 @@ Int p3_main_host(
   };
 
   const Int nk_pack = ekat::npack<Pack>(nk);
-#ifdef SCREAM_P3_SMALL_KERNELS
   view_2d
     mu_r("mu_r", nj, nk_pack), T_atm("T_atm", nj, nk_pack), lamr("lamr", nj, nk_pack), logn0r("logn0r", nj, nk_pack), nu("nu", nj, nk_pack),
     cdist("cdist", nj, nk_pack), cdist1("cdist1", nj, nk_pack), cdistr("cdistr", nj, nk_pack), inv_cld_frac_i("inv_cld_frac_i", nj, nk_pack),
@@ -1493,21 +1492,21 @@ Int p3_main_host(
     v_qc, v_nc, flux_qx, flux_nx, v_qit, v_nit, flux_nit, flux_bir, flux_qir,
     flux_qit, v_qr, v_nr
   };
-#endif
 
   // load tables
   auto lookup_tables = P3F::p3_init();
   P3F::P3Runtime runtime_options{740.0e3};
+  // Tests can force the small kernels, regardless of the build default
+  if (ekat::TestSession::get().flags["sk"]) {
+    runtime_options.use_small_kernels = true;
+  }
 
   // Create local workspace
   const auto policy = TPF::get_default_team_policy(nj, nk_pack);
   ekat::WorkspaceManager<Pack, KT::Device> workspace_mgr(nk_pack, 52, policy);
 
   auto elapsed_microsec = P3F::p3_main(runtime_options, prog_state, diag_inputs, diag_outputs, infrastructure,
-                                       history_only, lookup_tables,
-#ifdef SCREAM_P3_SMALL_KERNELS
-                                       temporaries,
-#endif
+                                       history_only, lookup_tables, temporaries,
                                        workspace_mgr, nj, nk);
 
   Kokkos::parallel_for(nj, KOKKOS_LAMBDA(const Int& i) {
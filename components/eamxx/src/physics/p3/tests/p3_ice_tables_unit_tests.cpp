@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 
 #include "p3_functions.hpp"
+#include "p3_init_impl.hpp" // for the ice tables cache utilities
 #include "p3_test_data.hpp"
 #include "p3_unit_tests_common.hpp"
 
@@ -10,6 +11,9 @@
 #include <array>
 #include <algorithm>
 #include <random>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
 
 namespace scream {
 namespace p3 {
@@ -282,6 +286,131 @@ struct UnitWrap::UnitTest<D>::TestTableIce : public UnitWrap::UnitTest<D>::Base
     }
   }
 
+  template <typename View1, typename View2>
+  static bool same_table (const View1& v1, const View2& v2)
+  {
+    const auto v1_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v1);
+    const auto v2_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v2);
+    if (v1_h.size()!=v2_h.size()) {
+      return false;
+    }
+    for (size_t i=0; i<v1_h.size(); ++i) {
+      if (v1_h.data()[i]!=v2_h.data()[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void run_bcast()
+  {
+    // Tables read by the root rank and broadcast must match the ones read by each rank
+    ekat::Comm comm(MPI_COMM_WORLD);
+    const auto tables       = Functions::p3_init();
+    const auto tables_bcast = Functions::p3_init(/* write_tables = */ false, comm);
+
+    REQUIRE (same_table(tables.ice_table_vals,tables_bcast.ice_table_vals));
+    REQUIRE (same_table(tables.collect_table_vals,tables_bcast.collect_table_vals));
+    REQUIRE (same_table(tables.mu_r_table_vals,tables_bcast.mu_r_table_vals));
+    REQUIRE (same_table(tables.vn_table_vals,tables_bcast.vn_table_vals));
+    REQUIRE (same_table(tables.vm_table_vals,tables_bcast.vm_table_vals));
+    REQUIRE (same_table(tables.revap_table_vals,tables_bcast.revap_table_vals));
+  }
+
+  static std::vector<char> read_bytes (const std::string& filename)
+  {
+    std::ifstream in(filename, std::ios::binary);
+    REQUIRE (in.good());
+    return std::vector<char>(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+  }
+
+  static void write_bytes (const std::string& filename, const std::vector<char>& bytes)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(bytes.data(),bytes.size());
+    REQUIRE (out.good());
+  }
+
+  void run_cache()
+  {
+    using P3C       = typename Functions::P3C;
+    using IceTable  = typename view_ice_table::non_const_type;
+    using CollTable = typename view_collect_table::non_const_type;
+
+    // Work on a per-rank copy of the ascii table, so that we never touch
+    // the cache in the data dir, and ranks do not step on each other
+    ekat::Comm comm(MPI_COMM_WORLD);
+    const std::string base = "p3_ice_tables_cache_test_" + std::to_string(comm.rank()) + ".dat-v";
+    const std::string filename = base + P3C::p3_version;
+    const std::string cache_filename = ice_tables_cache_filename(filename);
+    const auto text_bytes = read_bytes(std::string(P3C::p3_lookup_base) + P3C::p3_version);
+    write_bytes(filename,text_bytes);
+
+    auto read_tables = [&](const bool write_cache, view_ice_table& ice, view_collect_table& coll) {
+      read_ice_lookup_tables<Scalar>(false, nullptr, write_cache, base.c_str(), P3C::p3_version, ice, coll,
+                                     P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize);
+    };
+
+    // Reference tables, from the ascii file
+    const auto ice_text  = Kokkos::create_mirror_view(IceTable("ice_text"));
+    const auto coll_text = Kokkos::create_mirror_view(CollTable("coll_text"));
+    read_ice_tables_text(filename, P3C::p3_version, ice_text, coll_text,
+                         P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize);
+    const auto dims = ice_tables_cache_dims(P3C::densize, P3C::rimsize, P3C::isize, P3C::rcollsize,
+                                            ice_text.extent_int(3), coll_text.extent_int(4), sizeof(Scalar));
+
+    // Writing the cache must not alter the tables, and the cache must hold them bit for bit
+    view_ice_table ice;
+    view_collect_table coll;
+    read_tables(true, ice, coll);
+    REQUIRE (same_table(ice,ice_text));
+    REQUIRE (same_table(coll,coll_text));
+
+    const auto ice_cache  = Kokkos::create_mirror_view(IceTable("ice_cache"));
+    const auto coll_cache = Kokkos::create_mirror_view(CollTable("coll_cache"));
+    REQUIRE (read_ice_tables_cache(cache_filename, P3C::p3_version, dims, ice_cache, coll_cache));
+    REQUIRE (same_table(ice_cache,ice_text));
+    REQUIRE (same_table(coll_cache,coll_text));
+
+    // A valid cache is used in place of the ascii file: break the latter, and check we still get the tables
+    write_bytes(filename,std::vector<char>(text_bytes.begin(),text_bytes.begin()+text_bytes.size()/2));
+    read_tables(false, ice, coll);
+    REQUIRE (same_table(ice,ice_text));
+    REQUIRE (same_table(coll,coll_text));
+    write_bytes(filename,text_bytes);
+
+    // A cache that does not match the expected version/sizes/precision is rejected
+    auto bad_dims = dims;
+    ++bad_dims[0];
+    REQUIRE (not read_ice_tables_cache(cache_filename, "0.0.0", dims, ice_cache, coll_cache));
+    REQUIRE (not read_ice_tables_cache(cache_filename, P3C::p3_version, bad_dims, ice_cache, coll_cache));
+    bad_dims = dims;
+    bad_dims.back() = sizeof(Scalar)==sizeof(float) ? sizeof(double) : sizeof(float);
+    REQUIRE (not read_ice_tables_cache(cache_filename, P3C::p3_version, bad_dims, ice_cache, coll_cache));
+
+    // A stale/corrupted cache is rejected, and we fall back to the ascii file.
+    // The header is: magic, version length, version string, dims.
+    const auto cache_bytes = read_bytes(cache_filename);
+    const int version_pos = sizeof(ice_tables_cache_magic) + sizeof(int);
+    const int dims_pos = version_pos + std::string(P3C::p3_version).size();
+    std::vector<std::vector<char>> bad_caches(4,cache_bytes);
+    bad_caches[0][0] = 'X';                    // wrong magic
+    bad_caches[1][version_pos] += 1;           // stale version
+    bad_caches[2][dims_pos] += 1;              // wrong table sizes
+    bad_caches[3].resize(cache_bytes.size()-1); // truncated data
+    for (const auto& bytes : bad_caches) {
+      write_bytes(cache_filename,bytes);
+      REQUIRE (not read_ice_tables_cache(cache_filename, P3C::p3_version, dims, ice_cache, coll_cache));
+
+      read_tables(false, ice, coll);
+      REQUIRE (same_table(ice,ice_text));
+      REQUIRE (same_table(coll,coll_text));
+    }
+
+    std::remove(filename.c_str());
+    std::remove(cache_filename.c_str());
+  }
+
   void run_phys()
   {
 #if 0
@@ -336,6 +465,8 @@ TEST_CASE("p3_ice_tables", "[p3_functions]")
   T t;
   t.run_phys();
   t.run_bfb();
+  t.run_bcast();
+  t.run_cache();
 }
 
 }
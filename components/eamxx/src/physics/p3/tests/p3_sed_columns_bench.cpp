@@ -0,0 +1,292 @@
+// This is a small program to benchmark P3 sedimentation over all columns vs over
+// the compacted list of columns with hydrometeors, sorted by decreasing cost
+// (see P3Runtime::compact_sedimentation_columns). It requires small kernels.
+//
+// Usage: p3_sed_columns_bench [ncols [nlevs [nreps]]]
+
+#include "physics/p3/p3_functions.hpp"
+#include "share/core/eamxx_session.hpp"
+
+#include <ekat_team_policy_utils.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using P3F      = scream::p3::Functions<scream::Real, ekat::DefaultDevice>;
+using Real     = scream::Real;
+using Int      = scream::Int;
+using Pack     = P3F::Pack;
+using KT       = P3F::KT;
+using view_2d  = P3F::view_2d<Pack>;
+using sview_1d = P3F::view_1d<Real>;
+using bview_1d = P3F::view_1d<bool>;
+using TPF      = ekat::TeamPolicyFactory<KT::ExeSpace>;
+
+// The 2d fields used/updated by the sedimentation routines
+enum Fields {
+  rho, inv_rho, rhofacr, rhofaci, cld_frac_l, cld_frac_r, cld_frac_i, acn, inv_dz,
+  qc, nc, qr, nr, qi, ni, qm, bm,
+  qc_incld, nc_incld, qr_incld, nr_incld, qi_incld, ni_incld, qm_incld, bm_incld,
+  mu_c, lamc, mu_r, lamr, precip_liq_flux,
+  qc_tend, qr_tend, qi_tend, n_tend,
+  num_fields
+};
+
+struct SedState {
+  std::vector<view_2d> f;
+  sview_1d precip_liq_surf, precip_ice_surf;
+
+  SedState (const int ncols, const int nlevs) {
+    for (int i=0; i<num_fields; ++i) {
+      // The precip flux is defined at interfaces
+      const int nk = i==precip_liq_flux ? nlevs+1 : nlevs;
+      f.emplace_back("f"+std::to_string(i), ncols, ekat::npack<Pack>(nk));
+    }
+    precip_liq_surf = sview_1d("precip_liq_surf", ncols);
+    precip_ice_surf = sview_1d("precip_ice_surf", ncols);
+  }
+
+  void copy_from (const SedState& src) {
+    for (int i=0; i<num_fields; ++i) {
+      Kokkos::deep_copy(f[i], src.f[i]);
+    }
+    Kokkos::deep_copy(precip_liq_surf, src.precip_liq_surf);
+    Kokkos::deep_copy(precip_ice_surf, src.precip_ice_surf);
+  }
+};
+
+// Init columns: a fraction precip_frac of the columns precipitates, with a
+// lognormal distribution of intensity and depth of the rain shaft. Non-precipitating
+// columns may have some cloud liquid, and the upper troposphere may have some ice.
+void init_state (SedState& s, const int ncols, const int nlevs, const double precip_frac, const int seed)
+{
+  using C = scream::physics::Constants<Real>;
+
+  std::mt19937_64 engine(seed);
+  std::uniform_real_distribution<double> unif(0,1);
+  std::lognormal_distribution<double> qr_dist(std::log(2e-4),1.0);
+  std::lognormal_distribution<double> qi_dist(std::log(5e-5),1.0);
+
+  std::vector<decltype(Kokkos::create_mirror_view(s.f[0]))> h;
+  for (int i=0; i<num_fields; ++i) {
+    h.push_back(Kokkos::create_mirror_view(s.f[i]));
+    Kokkos::deep_copy(h.back(),0);
+  }
+  auto sh = [&](const int fid, const int icol, const int k) -> Real& {
+    return h[fid](icol,k/Pack::n)[k%Pack::n];
+  };
+
+  const double rhosui  = 60000/(287.15*253.15);
+  const double rho1000 = 100000/(287.15*273.15);
+  const double mu_air  = 1.8e-5;
+  for (int icol=0; icol<ncols; ++icol) {
+    const bool precip = unif(engine) < precip_frac;
+    const bool cloud  = precip or unif(engine) < precip_frac;
+    const bool ice    = unif(engine) < 0.5;
+    const int  k_rain = nlevs/3 + static_cast<int>(unif(engine)*nlevs/3);
+    const int  k_ice  = nlevs/4;
+    const double qr_max = std::min(qr_dist(engine),5e-3);
+    const double qi_max = std::min(qi_dist(engine),1e-3);
+
+    double z = 0;
+    for (int k=nlevs-1; k>=0; --k) {
+      // Stretched grid, from 50m at the surface to 500m at the top
+      const double dz = 50 + 450.0*(nlevs-1-k)/std::max(nlevs-1,1);
+      z += dz;
+      const double r = 1.2*std::exp(-z/8000);
+      sh(rho,icol,k)        = r;
+      sh(inv_rho,icol,k)    = 1/r;
+      sh(rhofacr,icol,k)    = std::pow(rho1000/r,0.54);
+      sh(rhofaci,icol,k)    = std::pow(rhosui/r,0.54);
+      sh(cld_frac_l,icol,k) = 1;
+      sh(cld_frac_r,icol,k) = 1;
+      sh(cld_frac_i,icol,k) = 1;
+      sh(acn,icol,k)        = C::gravit.value*C::RHO_H2O.value/(18*mu_air);
+      sh(inv_dz,icol,k)     = 1/dz;
+
+      if (precip and k>=k_rain) {
+        const double q = qr_max*(k-k_rain+1)/(nlevs-k_rain);
+        sh(qr,icol,k) = q;
+        sh(nr,icol,k) = q/(C::PIOV6*C::RHO_H2O.value*1e-9);
+      }
+      if (cloud and k>=k_rain-nlevs/10 and k<k_rain+nlevs/10) {
+        sh(qc,icol,k) = 1e-4;
+        sh(nc,icol,k) = 1e8;
+      }
+      if (ice and k>=k_ice and k<k_rain) {
+        const double q = precip ? qi_max : 0.1*qi_max;
+        sh(qi,icol,k) = q;
+        sh(ni,icol,k) = q/1e-10;
+        sh(qm,icol,k) = 0.2*q;
+        sh(bm,icol,k) = 0.2*q/400;
+      }
+      sh(qc_incld,icol,k) = sh(qc,icol,k);
+      sh(nc_incld,icol,k) = sh(nc,icol,k);
+      sh(qr_incld,icol,k) = sh(qr,icol,k);
+      sh(nr_incld,icol,k) = sh(nr,icol,k);
+      sh(qi_incld,icol,k) = sh(qi,icol,k);
+      sh(ni_incld,icol,k) = sh(ni,icol,k);
+      sh(qm_incld,icol,k) = sh(qm,icol,k);
+      sh(bm_incld,icol,k) = sh(bm,icol,k);
+    }
+  }
+  for (int i=0; i<num_fields; ++i) {
+    Kokkos::deep_copy(s.f[i],h[i]);
+  }
+  Kokkos::deep_copy(s.precip_liq_surf,0);
+  Kokkos::deep_copy(s.precip_ice_surf,0);
+}
+
+// Run cloud/rain/ice sedimentation, and return the elapsed time in seconds
+double run_sed (SedState& s, const P3F::P3LookupTables& tables, const P3F::P3Runtime& runtime_options,
+                const P3F::WorkspaceManager& wsm, const bview_1d& nucleationPossible, const bview_1d& hydrometeorsPresent,
+                const P3F::P3Temporaries& sed_work, const int ncols, const int nlevs, const Real dt)
+{
+  const Real inv_dt = 1/dt;
+  constexpr Int kdir = -1;
+  const Int ktop = 0;
+  const Int kbot = nlevs-1;
+  auto& f = s.f;
+
+  Kokkos::fence();
+  const auto start = std::chrono::steady_clock::now();
+
+  P3F::uview_1d<const Int> sed_cols;
+  bool do_sed = true;
+  if (runtime_options.compact_sedimentation_columns) {
+    const Int num_sed_cols = P3F::get_sedimentation_columns_disp(
+        f[qc], f[nc], f[qr], f[nr], f[qi], f[ni], f[rhofacr], f[rhofaci], f[inv_dz],
+        ncols, nlevs, dt, inv_dt, f[qc_tend], f[qr_tend], f[qi_tend], f[n_tend],
+        nucleationPossible, hydrometeorsPresent, sed_work.sed_cost, sed_work.sed_keys, sed_work.sed_cols);
+    sed_cols = Kokkos::subview(sed_work.sed_cols, Kokkos::make_pair(0, num_sed_cols));
+    do_sed = num_sed_cols > 0;
+  }
+
+  if (do_sed) {
+    P3F::cloud_sedimentation_disp(
+        f[qc_incld], f[rho], f[inv_rho], f[cld_frac_l], f[acn], f[inv_dz], tables.dnu_table_vals, wsm,
+        ncols, nlevs, ktop, kbot, kdir, dt, inv_dt, true,
+        f[qc], f[nc], f[nc_incld], f[mu_c], f[lamc], f[qc_tend], f[n_tend],
+        s.precip_liq_surf, nucleationPossible, hydrometeorsPresent, sed_cols);
+
+    P3F::rain_sedimentation_disp(
+        f[rho], f[inv_rho], f[rhofacr], f[cld_frac_r], f[inv_dz], f[qr_incld], wsm,
+        tables.vn_table_vals, tables.vm_table_vals, ncols, nlevs, ktop, kbot, kdir, dt, inv_dt,
+        f[qr], f[nr], f[nr_incld], f[mu_r], f[lamr], f[precip_liq_flux], f[qr_tend], f[n_tend],
+        s.precip_liq_surf, nucleationPossible, hydrometeorsPresent, sed_cols, runtime_options);
+
+    P3F::ice_sedimentation_disp(
+        f[rho], f[inv_rho], f[rhofaci], f[cld_frac_i], f[inv_dz], wsm, ncols, nlevs, ktop, kbot,
+        kdir, dt, inv_dt, f[qi], f[qi_incld], f[ni], f[ni_incld], f[qm], f[qm_incld], f[bm], f[bm_incld],
+        f[qi_tend], f[n_tend], tables.ice_table_vals, s.precip_ice_surf,
+        nucleationPossible, hydrometeorsPresent, sed_cols, runtime_options);
+  }
+
+  Kokkos::fence();
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(finish-start).count();
+}
+
+bool same_state (const SedState& s1, const SedState& s2)
+{
+  auto same = [](const auto& v1, const auto& v2) {
+    const auto v1h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v1);
+    const auto v2h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v2);
+    const auto n = v1h.size()*sizeof(typename decltype(v1h)::value_type)/sizeof(Real);
+    const Real* d1 = reinterpret_cast<const Real*>(v1h.data());
+    const Real* d2 = reinterpret_cast<const Real*>(v2h.data());
+    for (size_t i=0; i<n; ++i) {
+      if (d1[i]!=d2[i]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Skip the in-cloud/dsd temporaries and the ignored number tendency
+  const std::vector<int> to_check = {
+    qc, nc, qr, nr, qi, ni, qm, bm, precip_liq_flux, qc_tend, qr_tend, qi_tend
+  };
+  for (int fid : to_check) {
+    if (not same(s1.f[fid],s2.f[fid])) {
+      return false;
+    }
+  }
+  return same(s1.precip_liq_surf,s2.precip_liq_surf) and
+         same(s1.precip_ice_surf,s2.precip_ice_surf);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+  const int ncols = argc>1 ? std::stoi(argv[1]) : 2048;
+  const int nlevs = argc>2 ? std::stoi(argv[2]) : 128;
+  const int nreps = argc>3 ? std::stoi(argv[3]) : 10;
+  const Real dt   = 300;
+
+  int nerr = 0;
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    const auto tables = P3F::p3_init();
+    const int nk_pack = ekat::npack<Pack>(nlevs);
+
+    const auto policy = TPF::get_default_team_policy(ncols, nk_pack);
+    P3F::WorkspaceManager wsm(nk_pack, 52, policy);
+
+    // Assume the worst case from part1/part2: all columns may have something to do
+    bview_1d nucleationPossible("nucleationPossible", ncols);
+    bview_1d hydrometeorsPresent("hydrometeorsPresent", ncols);
+    Kokkos::deep_copy(nucleationPossible, true);
+    Kokkos::deep_copy(hydrometeorsPresent, true);
+
+    P3F::P3Runtime all_cols, compact_cols;
+    compact_cols.compact_sedimentation_columns = true;
+
+    P3F::P3Temporaries sed_work;
+    sed_work.sed_cost = sview_1d("sed_cost", ncols);
+    sed_work.sed_keys = P3F::view_1d<std::uint64_t>("sed_keys", ncols);
+    sed_work.sed_cols = P3F::view_1d<Int>("sed_cols", ncols);
+
+    SedState init(ncols,nlevs), s_all(ncols,nlevs), s_compact(ncols,nlevs);
+
+    std::cout << "P3 sedimentation benchmark: " << ncols << " cols, " << nlevs << " levs, "
+              << nreps << " reps, " << Kokkos::DefaultExecutionSpace().concurrency() << " threads\n";
+    std::cout << std::setw(14) << "precip frac"
+              << std::setw(16) << "all cols [ms]"
+              << std::setw(16) << "compact [ms]"
+              << std::setw(10) << "speedup"
+              << std::setw(8)  << "BFB" << "\n";
+
+    for (double frac : {0.01, 0.05, 0.1, 0.25, 0.5, 1.0}) {
+      init_state(init, ncols, nlevs, frac, 42);
+
+      double t_all = 0, t_compact = 0;
+      bool bfb = true;
+      for (int rep=0; rep<nreps; ++rep) {
+        s_all.copy_from(init);
+        s_compact.copy_from(init);
+        t_all     += run_sed(s_all,     tables, all_cols,     wsm, nucleationPossible, hydrometeorsPresent, sed_work, ncols, nlevs, dt);
+        t_compact += run_sed(s_compact, tables, compact_cols, wsm, nucleationPossible, hydrometeorsPresent, sed_work, ncols, nlevs, dt);
+        bfb = bfb and same_state(s_all,s_compact);
+      }
+      nerr += bfb ? 0 : 1;
+
+      std::cout << std::setw(14) << frac
+                << std::setw(16) << std::fixed << std::setprecision(3) << 1e3*t_all/nreps
+                << std::setw(16) << 1e3*t_compact/nreps
+                << std::setw(10) << std::setprecision(2) << t_all/t_compact
+                << std::setw(8)  << (bfb ? "yes" : "NO") << "\n";
+      std::cout.unsetf(std::ios::fixed);
+    }
+  }
+  scream::finalize_eamxx_session();
+
+  return nerr;
+}
@@ -14,9 +14,11 @@
 #include "examples/all-sky/mo_load_cloud_coefficients.h"
 
 #include "rrtmgp_utils.hpp"
+#include "eamxx_rrtmgp_sw_load_balancer.hpp"
 
 #include "share/physics/physics_constants.hpp"
 
+#include <ekat_assert.hpp>
 #include <ekat_comm.hpp>
 #include <ekat_logger.hpp>
 #include <ekat_math_utils.hpp>
@@ -261,7 +263,8 @@ static void rrtmgp_main(
   const real3dk &lw_bnd_flux_up, const real3dk &lw_bnd_flux_dn,
   const Real tsi_scaling,
   const std::shared_ptr<spdlog::logger>& logger,
-  const bool extra_clnclrsky_diag = false, const bool extra_clnsky_diag = false)
+  const bool extra_clnclrsky_diag = false, const bool extra_clnsky_diag = false,
+  SWLoadBalancer* sw_load_balancer = nullptr)
 {
   const int sw_nband = k_dist_sw_k->get_nband();
   const int lw_nband = k_dist_lw_k->get_nband();
@@ -423,15 +426,27 @@ static void rrtmgp_main(
   check_range_k(clouds_sw.tau,  0, std::numeric_limits<RealT>::max(), "rrtmgp_main:clouds_sw.tau");
 #endif
 
-  // Do shortwave
-  rrtmgp_sw(
-    ncol, nlay,
-    *k_dist_sw_k, p_lay, t_lay, p_lev, t_lev, gas_concs,
-    sfc_alb_dir, sfc_alb_dif, mu0, aerosol_sw, clouds_sw_gpt,
-    fluxes_sw, clnclrsky_fluxes_sw, clrsky_fluxes_sw, clnsky_fluxes_sw,
-    tsi_scaling, logger,
-    extra_clnclrsky_diag, extra_clnsky_diag
-            );
+  // Do shortwave (possibly moving daylit columns across ranks)
+  if (sw_load_balancer) {
+    rrtmgp_sw_balanced(
+      ncol, nlay,
+      *k_dist_sw_k, p_lay, t_lay, p_lev, t_lev, gas_concs,
+      sfc_alb_dir, sfc_alb_dif, mu0, aerosol_sw, clouds_sw_gpt,
+      fluxes_sw, clnclrsky_fluxes_sw, clrsky_fluxes_sw, clnsky_fluxes_sw,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag,
+      *sw_load_balancer
+              );
+  } else {
+    rrtmgp_sw(
+      ncol, nlay,
+      *k_dist_sw_k, p_lay, t_lay, p_lev, t_lev, gas_concs,
+      sfc_alb_dir, sfc_alb_dif, mu0, aerosol_sw, clouds_sw_gpt,
+      fluxes_sw, clnclrsky_fluxes_sw, clrsky_fluxes_sw, clnsky_fluxes_sw,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag
+              );
+  }
 
   // Do longwave
   rrtmgp_lw(
@@ -838,6 +853,424 @@ static void rrtmgp_sw(
   pool_t::dealloc(sw_noaero_gpt2band_mem);
 }
 
+/*
+ * Shortwave driver with cross-rank redistribution of the daylit columns (called by
+ * rrtmgp_main if a load balancer is provided). Overloaded ranks ship their excess
+ * daylit columns (all SW inputs, packed per column) to underloaded ranks, which run
+ * rrtmgp_sw on them after their own columns, and send the fluxes back.
+ * NOTE: this is a collective call.
+ */
+static void rrtmgp_sw_balanced(
+  const int ncol, const int nlay,
+  gas_optics_t &k_dist,
+  const creal2dk &p_lay, const creal2dk &t_lay, const creal2dk &p_lev, const creal2dk &t_lev,
+  gas_concs_t &gas_concs,
+  const creal2dk &sfc_alb_dir, const creal2dk &sfc_alb_dif, const real1dk &mu0,
+  optical_props2_t &aerosol, optical_props2_t &clouds,
+  fluxes_t &fluxes, fluxes_broadband_t &clnclrsky_fluxes, fluxes_broadband_t &clrsky_fluxes, fluxes_broadband_t &clnsky_fluxes,
+  const Real tsi_scaling,
+  const std::shared_ptr<spdlog::logger>& logger,
+  const bool extra_clnclrsky_diag, const bool extra_clnsky_diag,
+  SWLoadBalancer& balancer)
+{
+  // Get problem sizes
+  const int nbnd = k_dist.get_nband();
+  const int ngpt = k_dist.get_ngpt();
+  const int ngas = gas_concs.get_num_gases();
+  auto gas_names = gas_concs.get_gas_names();
+
+  // Get daytime indices, and build the redistribution plan
+  auto dayIndices = pool_t::template alloc<int>(ncol);
+  Kokkos::deep_copy(dayIndices, -1);
+
+  int nday = 0;
+  // Serialized for now.
+  Kokkos::parallel_reduce(1, KOKKOS_LAMBDA(int, int& nday_inner) {
+    for (int icol = 0; icol < ncol; ++icol) {
+      if (mu0(icol) > 0) {
+        dayIndices(nday_inner++) = icol;
+      }
+    }
+  }, Kokkos::Sum<int>(nday));
+
+  balancer.setup_plan(nday);
+  const int nsend = balancer.num_sends();
+  const int nrecv = balancer.num_recvs();
+
+  // Size of a packed column, for the SW inputs and for the SW fluxes
+  const int in_size  = 1 + 2*nlay + 2*(nlay+1) + ngas*nlay + 3*nlay*nbnd + 3*nlay*ngpt + 2*nbnd;
+  const int out_size = 12*(nlay+1) + 3*(nlay+1)*nbnd;
+
+  if (nsend>0) {
+    // Ship our last nsend daylit columns
+    int1dk sendIndices (dayIndices, std::make_pair(nday-nsend, nday));
+
+    auto buf_in = pool_t::template alloc<RealT>(nsend*in_size);
+    auto vmr = pool_t::template alloc<RealT>(ncol, nlay);
+
+    int offset = 0;
+    pack_columns(sendIndices, mu0,   buf_in, in_size, offset);
+    pack_columns(sendIndices, p_lay, buf_in, in_size, offset);
+    pack_columns(sendIndices, t_lay, buf_in, in_size, offset);
+    pack_columns(sendIndices, p_lev, buf_in, in_size, offset);
+    pack_columns(sendIndices, t_lev, buf_in, in_size, offset);
+    for (int igas = 0; igas < ngas; igas++) {
+      gas_concs.get_vmr(gas_names[igas], vmr);
+      pack_columns(sendIndices, vmr, buf_in, in_size, offset);
+    }
+    pack_columns(sendIndices, aerosol.tau, buf_in, in_size, offset);
+    pack_columns(sendIndices, aerosol.ssa, buf_in, in_size, offset);
+    pack_columns(sendIndices, aerosol.g,   buf_in, in_size, offset);
+    pack_columns(sendIndices, clouds.tau,  buf_in, in_size, offset);
+    pack_columns(sendIndices, clouds.ssa,  buf_in, in_size, offset);
+    pack_columns(sendIndices, clouds.g,    buf_in, in_size, offset);
+    pack_columns(sendIndices, sfc_alb_dir, buf_in, in_size, offset);
+    pack_columns(sendIndices, sfc_alb_dif, buf_in, in_size, offset);
+    EKAT_ASSERT_MSG (offset==in_size, "Error! Packed SW inputs size mismatch.\n");
+    exchange_columns(balancer, buf_in, real1dk(), in_size, true);
+
+    // Run on the columns we kept, treating the shipped ones as night columns
+    auto mu0_local = pool_t::template alloc<RealT>(ncol);
+    TIMED_KERNEL(Kokkos::parallel_for(ncol, KOKKOS_LAMBDA(int icol) {
+      mu0_local(icol) = mu0(icol);
+    }));
+    TIMED_KERNEL(Kokkos::parallel_for(nsend, KOKKOS_LAMBDA(int j) {
+      mu0_local(sendIndices(j)) = 0;
+    }));
+    rrtmgp_sw(
+      ncol, nlay,
+      k_dist, p_lay, t_lay, p_lev, t_lev, gas_concs,
+      sfc_alb_dir, sfc_alb_dif, mu0_local, aerosol, clouds,
+      fluxes, clnclrsky_fluxes, clrsky_fluxes, clnsky_fluxes,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag);
+
+    // Get the fluxes of the shipped columns back
+    auto buf_out = pool_t::template alloc<RealT>(nsend*out_size);
+    exchange_columns(balancer, real1dk(), buf_out, out_size, false);
+
+    offset = 0;
+    unpack_fluxes(sendIndices, buf_out, out_size, offset,
+                  fluxes, clnclrsky_fluxes, clrsky_fluxes, clnsky_fluxes);
+    EKAT_ASSERT_MSG (offset==out_size, "Error! Packed SW fluxes size mismatch.\n");
+
+    pool_t::dealloc(buf_in);
+    pool_t::dealloc(vmr);
+    pool_t::dealloc(mu0_local);
+    pool_t::dealloc(buf_out);
+  } else if (nrecv>0) {
+    // Get the columns shipped to us first, so senders can move on
+    auto buf_in = pool_t::template alloc<RealT>(nrecv*in_size);
+    exchange_columns(balancer, real1dk(), buf_in, in_size, true);
+
+    // Run on our own columns
+    rrtmgp_sw(
+      ncol, nlay,
+      k_dist, p_lay, t_lay, p_lev, t_lev, gas_concs,
+      sfc_alb_dir, sfc_alb_dif, mu0, aerosol, clouds,
+      fluxes, clnclrsky_fluxes, clrsky_fluxes, clnsky_fluxes,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag);
+
+    // Unpack the received columns, and run on them
+    auto recvIndices = pool_t::template alloc<int>(nrecv);
+    TIMED_KERNEL(Kokkos::parallel_for(nrecv, KOKKOS_LAMBDA(int j) {
+      recvIndices(j) = j;
+    }));
+
+    auto mu0_recv = pool_t::template alloc<RealT>(nrecv);
+    auto p_lay_recv = pool_t::template alloc<RealT>(nrecv, nlay);
+    auto t_lay_recv = pool_t::template alloc<RealT>(nrecv, nlay);
+    auto p_lev_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto t_lev_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto vmr_recv = pool_t::template alloc<RealT>(nrecv, nlay);
+    auto concs_mem = pool_t::template alloc<RealT>(nrecv, nlay, ngas);
+    auto sfc_alb_dir_recv = pool_t::template alloc<RealT>(nrecv, nbnd);
+    auto sfc_alb_dif_recv = pool_t::template alloc<RealT>(nrecv, nbnd);
+
+    auto sw_aero_tau_mem = pool_t::template alloc<RealT>(nrecv, nlay, nbnd);
+    auto sw_aero_ssa_mem = pool_t::template alloc<RealT>(nrecv, nlay, nbnd);
+    auto sw_aero_g_mem = pool_t::template alloc<RealT>(nrecv, nlay, nbnd);
+    auto sw_cloud_tau_mem = pool_t::template alloc<RealT>(nrecv, nlay, ngpt);
+    auto sw_cloud_ssa_mem = pool_t::template alloc<RealT>(nrecv, nlay, ngpt);
+    auto sw_cloud_g_mem = pool_t::template alloc<RealT>(nrecv, nlay, ngpt);
+    auto sw_aero_band2gpt_mem = pool_t::template alloc<int>(2, nbnd);
+    auto sw_aero_gpt2band_mem = pool_t::template alloc<int>(   nbnd);
+    auto sw_cloud_band2gpt_mem = pool_t::template alloc<int>(2, nbnd);
+    auto sw_cloud_gpt2band_mem = pool_t::template alloc<int>(   ngpt);
+
+    auto flux_up_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto flux_dn_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto flux_dn_dir_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto bnd_flux_up_recv = pool_t::template alloc<RealT>(nrecv, nlay+1, nbnd);
+    auto bnd_flux_dn_recv = pool_t::template alloc<RealT>(nrecv, nlay+1, nbnd);
+    auto bnd_flux_dn_dir_recv = pool_t::template alloc<RealT>(nrecv, nlay+1, nbnd);
+    auto clnclrsky_flux_up_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clnclrsky_flux_dn_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clnclrsky_flux_dn_dir_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clrsky_flux_up_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clrsky_flux_dn_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clrsky_flux_dn_dir_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clnsky_flux_up_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clnsky_flux_dn_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+    auto clnsky_flux_dn_dir_recv = pool_t::template alloc<RealT>(nrecv, nlay+1);
+
+    int offset = 0;
+    unpack_columns(recvIndices, buf_in, in_size, offset, mu0_recv);
+    unpack_columns(recvIndices, buf_in, in_size, offset, p_lay_recv);
+    unpack_columns(recvIndices, buf_in, in_size, offset, t_lay_recv);
+    unpack_columns(recvIndices, buf_in, in_size, offset, p_lev_recv);
+    unpack_columns(recvIndices, buf_in, in_size, offset, t_lev_recv);
+
+    gas_concs_t gas_concs_recv;
+    gas_concs_recv.init_no_alloc(gas_names, nrecv, nlay, concs_mem);
+    for (int igas = 0; igas < ngas; igas++) {
+      unpack_columns(recvIndices, buf_in, in_size, offset, vmr_recv);
+      gas_concs_recv.set_vmr(gas_names[igas], vmr_recv);
+    }
+
+    optical_props2_t aerosol_recv;
+    aerosol_recv.init_no_alloc(k_dist.get_band_lims_wavenumber(), sw_aero_band2gpt_mem, sw_aero_gpt2band_mem);
+    aerosol_recv.alloc_2str_no_alloc(nrecv, nlay, sw_aero_tau_mem, sw_aero_ssa_mem, sw_aero_g_mem);
+    unpack_columns(recvIndices, buf_in, in_size, offset, aerosol_recv.tau);
+    unpack_columns(recvIndices, buf_in, in_size, offset, aerosol_recv.ssa);
+    unpack_columns(recvIndices, buf_in, in_size, offset, aerosol_recv.g);
+
+    optical_props2_t clouds_recv;
+    clouds_recv.init_no_alloc(k_dist.get_band_lims_wavenumber(), k_dist.get_band_lims_gpoint(), sw_cloud_band2gpt_mem, sw_cloud_gpt2band_mem);
+    clouds_recv.alloc_2str_no_alloc(nrecv, nlay, sw_cloud_tau_mem, sw_cloud_ssa_mem, sw_cloud_g_mem);
+    unpack_columns(recvIndices, buf_in, in_size, offset, clouds_recv.tau);
+    unpack_columns(recvIndices, buf_in, in_size, offset, clouds_recv.ssa);
+    unpack_columns(recvIndices, buf_in, in_size, offset, clouds_recv.g);
+
+    unpack_columns(recvIndices, buf_in, in_size, offset, sfc_alb_dir_recv);
+    unpack_columns(recvIndices, buf_in, in_size, offset, sfc_alb_dif_recv);
+    EKAT_ASSERT_MSG (offset==in_size, "Error! Packed SW inputs size mismatch.\n");
+
+    fluxes_t fluxes_recv;
+    fluxes_recv.flux_up         = flux_up_recv;
+    fluxes_recv.flux_dn         = flux_dn_recv;
+    fluxes_recv.flux_dn_dir     = flux_dn_dir_recv;
+    fluxes_recv.bnd_flux_up     = bnd_flux_up_recv;
+    fluxes_recv.bnd_flux_dn     = bnd_flux_dn_recv;
+    fluxes_recv.bnd_flux_dn_dir = bnd_flux_dn_dir_recv;
+    fluxes_broadband_t clnclrsky_fluxes_recv;
+    clnclrsky_fluxes_recv.flux_up     = clnclrsky_flux_up_recv;
+    clnclrsky_fluxes_recv.flux_dn     = clnclrsky_flux_dn_recv;
+    clnclrsky_fluxes_recv.flux_dn_dir = clnclrsky_flux_dn_dir_recv;
+    fluxes_broadband_t clrsky_fluxes_recv;
+    clrsky_fluxes_recv.flux_up     = clrsky_flux_up_recv;
+    clrsky_fluxes_recv.flux_dn     = clrsky_flux_dn_recv;
+    clrsky_fluxes_recv.flux_dn_dir = clrsky_flux_dn_dir_recv;
+    fluxes_broadband_t clnsky_fluxes_recv;
+    clnsky_fluxes_recv.flux_up     = clnsky_flux_up_recv;
+    clnsky_fluxes_recv.flux_dn     = clnsky_flux_dn_recv;
+    clnsky_fluxes_recv.flux_dn_dir = clnsky_flux_dn_dir_recv;
+
+    rrtmgp_sw(
+      nrecv, nlay,
+      k_dist, p_lay_recv, t_lay_recv, p_lev_recv, t_lev_recv, gas_concs_recv,
+      sfc_alb_dir_recv, sfc_alb_dif_recv, mu0_recv, aerosol_recv, clouds_recv,
+      fluxes_recv, clnclrsky_fluxes_recv, clrsky_fluxes_recv, clnsky_fluxes_recv,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag);
+
+    // Send the fluxes back to the owners
+    auto buf_out = pool_t::template alloc<RealT>(nrecv*out_size);
+    offset = 0;
+    pack_fluxes(recvIndices, buf_out, out_size, offset,
+                fluxes_recv, clnclrsky_fluxes_recv, clrsky_fluxes_recv, clnsky_fluxes_recv);
+    EKAT_ASSERT_MSG (offset==out_size, "Error! Packed SW fluxes size mismatch.\n");
+    exchange_columns(balancer, buf_out, real1dk(), out_size, false);
+
+    pool_t::dealloc(buf_in);
+    pool_t::dealloc(recvIndices);
+
+    pool_t::dealloc(mu0_recv);
+    pool_t::dealloc(p_lay_recv);
+    pool_t::dealloc(t_lay_recv);
+    pool_t::dealloc(p_lev_recv);
+    pool_t::dealloc(t_lev_recv);
+    pool_t::dealloc(vmr_recv);
+    pool_t::dealloc(concs_mem);
+    pool_t::dealloc(sfc_alb_dir_recv);
+    pool_t::dealloc(sfc_alb_dif_recv);
+
+    pool_t::dealloc(sw_aero_tau_mem);
+    pool_t::dealloc(sw_aero_ssa_mem);
+    pool_t::dealloc(sw_aero_g_mem);
+    pool_t::dealloc(sw_cloud_tau_mem);
+    pool_t::dealloc(sw_cloud_ssa_mem);
+    pool_t::dealloc(sw_cloud_g_mem);
+    pool_t::dealloc(sw_aero_band2gpt_mem);
+    pool_t::dealloc(sw_aero_gpt2band_mem);
+    pool_t::dealloc(sw_cloud_band2gpt_mem);
+    pool_t::dealloc(sw_cloud_gpt2band_mem);
+
+    pool_t::dealloc(flux_up_recv);
+    pool_t::dealloc(flux_dn_recv);
+    pool_t::dealloc(flux_dn_dir_recv);
+    pool_t::dealloc(bnd_flux_up_recv);
+    pool_t::dealloc(bnd_flux_dn_recv);
+    pool_t::dealloc(bnd_flux_dn_dir_recv);
+    pool_t::dealloc(clnclrsky_flux_up_recv);
+    pool_t::dealloc(clnclrsky_flux_dn_recv);
+    pool_t::dealloc(clnclrsky_flux_dn_dir_recv);
+    pool_t::dealloc(clrsky_flux_up_recv);
+    pool_t::dealloc(clrsky_flux_dn_recv);
+    pool_t::dealloc(clrsky_flux_dn_dir_recv);
+    pool_t::dealloc(clnsky_flux_up_recv);
+    pool_t::dealloc(clnsky_flux_dn_recv);
+    pool_t::dealloc(clnsky_flux_dn_dir_recv);
+
+    pool_t::dealloc(buf_out);
+  } else {
+    // Nothing to move in or out of this rank
+    rrtmgp_sw(
+      ncol, nlay,
+      k_dist, p_lay, t_lay, p_lev, t_lev, gas_concs,
+      sfc_alb_dir, sfc_alb_dif, mu0, aerosol, clouds,
+      fluxes, clnclrsky_fluxes, clrsky_fluxes, clnsky_fluxes,
+      tsi_scaling, logger,
+      extra_clnclrsky_diag, extra_clnsky_diag);
+  }
+
+  pool_t::dealloc(dayIndices);
+}
+
+/*
+ * Copy the columns cols(j) of v to (resp. from) the j-th column of a buffer of packed
+ * columns of size col_size, starting at entry offset. On output, offset is advanced
+ * by the number of entries in a column of v.
+ */
+template <typename ViewT>
+static void pack_columns(const int1dk& cols, const ViewT& v, const real1dk& buf, const int col_size, int& offset)
+{
+  const int n = cols.extent(0);
+  const int off = offset;
+  if constexpr (ViewT::rank==1) {
+    TIMED_KERNEL(Kokkos::parallel_for(n, KOKKOS_LAMBDA(int j) {
+      buf(j*col_size+off) = v(cols(j));
+    }));
+    offset += 1;
+  } else if constexpr (ViewT::rank==2) {
+    const int n1 = v.extent(1);
+    TIMED_KERNEL(Kokkos::parallel_for(n*n1, KOKKOS_LAMBDA(int idx) {
+      const int j = idx / n1;
+      const int k = idx % n1;
+      buf(j*col_size+off+k) = v(cols(j),k);
+    }));
+    offset += n1;
+  } else {
+    const int n1 = v.extent(1);
+    const int n2 = v.extent(2);
+    TIMED_KERNEL(Kokkos::parallel_for(n*n1*n2, KOKKOS_LAMBDA(int idx) {
+      const int j = idx / (n1*n2);
+      const int k = idx % (n1*n2);
+      buf(j*col_size+off+k) = v(cols(j),k/n2,k%n2);
+    }));
+    offset += n1*n2;
+  }
+}
+
+template <typename ViewT>
+static void unpack_columns(const int1dk& cols, const real1dk& buf, const int col_size, int& offset, const ViewT& v)
+{
+  const int n = cols.extent(0);
+  const int off = offset;
+  if constexpr (ViewT::rank==1) {
+    TIMED_KERNEL(Kokkos::parallel_for(n, KOKKOS_LAMBDA(int j) {
+      v(cols(j)) = buf(j*col_size+off);
+    }));
+    offset += 1;
+  } else if constexpr (ViewT::rank==2) {
+    const int n1 = v.extent(1);
+    TIMED_KERNEL(Kokkos::parallel_for(n*n1, KOKKOS_LAMBDA(int idx) {
+      const int j = idx / n1;
+      const int k = idx % n1;
+      v(cols(j),k) = buf(j*col_size+off+k);
+    }));
+    offset += n1;
+  } else {
+    const int n1 = v.extent(1);
+    const int n2 = v.extent(2);
+    TIMED_KERNEL(Kokkos::parallel_for(n*n1*n2, KOKKOS_LAMBDA(int idx) {
+      const int j = idx / (n1*n2);
+      const int k = idx % (n1*n2);
+      v(cols(j),k/n2,k%n2) = buf(j*col_size+off+k);
+    }));
+    offset += n1*n2;
+  }
+}
+
+// Pack/unpack all the SW fluxes of the given columns (same order on both ends)
+static void pack_fluxes(const int1dk& cols, const real1dk& buf, const int col_size, int& offset,
+                        const fluxes_t& fluxes, const fluxes_broadband_t& clnclrsky_fluxes,
+                        const fluxes_broadband_t& clrsky_fluxes, const fluxes_broadband_t& clnsky_fluxes)
+{
+  pack_columns(cols, fluxes.flux_up,              buf, col_size, offset);
+  pack_columns(cols, fluxes.flux_dn,              buf, col_size, offset);
+  pack_columns(cols, fluxes.flux_dn_dir,          buf, col_size, offset);
+  pack_columns(cols, fluxes.bnd_flux_up,          buf, col_size, offset);
+  pack_columns(cols, fluxes.bnd_flux_dn,          buf, col_size, offset);
+  pack_columns(cols, fluxes.bnd_flux_dn_dir,      buf, col_size, offset);
+  pack_columns(cols, clnclrsky_fluxes.flux_up,    buf, col_size, offset);
+  pack_columns(cols, clnclrsky_fluxes.flux_dn,    buf, col_size, offset);
+  pack_columns(cols, clnclrsky_fluxes.flux_dn_dir,buf, col_size, offset);
+  pack_columns(cols, clrsky_fluxes.flux_up,       buf, col_size, offset);
+  pack_columns(cols, clrsky_fluxes.flux_dn,       buf, col_size, offset);
+  pack_columns(cols, clrsky_fluxes.flux_dn_dir,   buf, col_size, offset);
+  pack_columns(cols, clnsky_fluxes.flux_up,       buf, col_size, offset);
+  pack_columns(cols, clnsky_fluxes.flux_dn,       buf, col_size, offset);
+  pack_columns(cols, clnsky_fluxes.flux_dn_dir,   buf, col_size, offset);
+}
+
+static void unpack_fluxes(const int1dk& cols, const real1dk& buf, const int col_size, int& offset,
+                          const fluxes_t& fluxes, const fluxes_broadband_t& clnclrsky_fluxes,
+                          const fluxes_broadband_t& clrsky_fluxes, const fluxes_broadband_t& clnsky_fluxes)
+{
+  unpack_columns(cols, buf, col_size, offset, fluxes.flux_up);
+  unpack_columns(cols, buf, col_size, offset, fluxes.flux_dn);
+  unpack_columns(cols, buf, col_size, offset, fluxes.flux_dn_dir);
+  unpack_columns(cols, buf, col_size, offset, fluxes.bnd_flux_up);
+  unpack_columns(cols, buf, col_size, offset, fluxes.bnd_flux_dn);
+  unpack_columns(cols, buf, col_size, offset, fluxes.bnd_flux_dn_dir);
+  unpack_columns(cols, buf, col_size, offset, clnclrsky_fluxes.flux_up);
+  unpack_columns(cols, buf, col_size, offset, clnclrsky_fluxes.flux_dn);
+  unpack_columns(cols, buf, col_size, offset, clnclrsky_fluxes.flux_dn_dir);
+  unpack_columns(cols, buf, col_size, offset, clrsky_fluxes.flux_up);
+  unpack_columns(cols, buf, col_size, offset, clrsky_fluxes.flux_dn);
+  unpack_columns(cols, buf, col_size, offset, clrsky_fluxes.flux_dn_dir);
+  unpack_columns(cols, buf, col_size, offset, clnsky_fluxes.flux_up);
+  unpack_columns(cols, buf, col_size, offset, clnsky_fluxes.flux_dn);
+  unpack_columns(cols, buf, col_size, offset, clnsky_fluxes.flux_dn_dir);
+}
+
+/*
+ * Move buffers of packed columns across ranks, according to the balancer plan
+ * (forward: from senders to receivers; backward: from receivers to senders).
+ * If MPI cannot use device pointers, go through host mirrors.
+ */
+static void exchange_columns(const SWLoadBalancer& balancer, const real1dk& send_buf, const real1dk& recv_buf,
+                             const int col_size, const bool forward)
+{
+#if SCREAM_MPI_ON_DEVICE
+  const auto send = send_buf;
+  const auto recv = recv_buf;
+#else
+  const auto send = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), send_buf);
+  const auto recv = Kokkos::create_mirror_view(recv_buf);
+#endif
+  if (forward) {
+    balancer.export_cols(send.data(), recv.data(), col_size);
+  } else {
+    balancer.import_cols(send.data(), recv.data(), col_size);
+  }
+#if !SCREAM_MPI_ON_DEVICE
+  Kokkos::deep_copy(recv_buf, recv);
+#endif
+}
+
 /*
  * Longwave driver (called by rrtmgp_main)
  */
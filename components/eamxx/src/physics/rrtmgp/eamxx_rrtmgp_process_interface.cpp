@@ -514,7 +514,23 @@ void RRTMGPRadiation::initialize_impl(const RunType /* run_type */) {
   std::string coefficients_file_lw = m_params.get<std::string>("rrtmgp_coefficients_file_lw");
   std::string cloud_optics_file_sw = m_params.get<std::string>("rrtmgp_cloud_optics_file_sw");
   std::string cloud_optics_file_lw = m_params.get<std::string>("rrtmgp_cloud_optics_file_lw");
-  const double multiplier = m_params.get<double>("pool_size_multiplier", 1.0);
+  double multiplier = m_params.get<double>("pool_size_multiplier", 1.0);
+
+  // Whether to move daylit columns across ranks, to balance the SW work
+  if (m_params.get<bool>("sw_load_balance",false)) {
+    // The migration plan is built collectively inside each rrtmgp_main call,
+    // so all ranks must go through the same number of chunks
+    EKAT_REQUIRE_MSG (m_num_col_chunks==1,
+        "Error! RRTMGP option 'sw_load_balance' requires a single column chunk on each rank.\n"
+        "  - num local cols: " + std::to_string(m_ncol) + "\n"
+        "  - column_chunk_size: " + std::to_string(m_col_chunk_size) + "\n"
+        "  - num col chunks: " + std::to_string(m_num_col_chunks) + "\n"
+        "Set column_chunk_size to (at least) the max number of columns per rank.\n");
+    m_sw_load_balancer = std::make_shared<rrtmgp::SWLoadBalancer>(m_comm);
+
+    // Receiving ranks run the SW on up to twice the columns they normally would
+    multiplier *= 2;
+  }
 
   m_gas_concs_k.init(gas_names_offset,m_col_chunk_size,m_nlay);
   interface_t::rrtmgp_initialize(
@@ -1028,10 +1044,25 @@ void RRTMGPRadiation::run_impl (const double dt) {
         lw_clnsky_flux_up_k, lw_clnsky_flux_dn_k,
         sw_bnd_flux_up_k, sw_bnd_flux_dn_k, sw_bnd_flux_dir_k, lw_bnd_flux_up_k, lw_bnd_flux_dn_k,
         eccf, m_atm_logger,
-        m_extra_clnclrsky_diag, m_extra_clnsky_diag
+        m_extra_clnclrsky_diag, m_extra_clnsky_diag,
+        m_sw_load_balancer.get()
       );
                    );
 
+      if (m_sw_load_balancer) {
+        const auto before = m_sw_load_balancer->imbalance_before();
+        const auto after  = m_sw_load_balancer->imbalance_after();
+        m_sw_lb_sum_imbalance_before += before;
+        m_sw_lb_sum_imbalance_after  += after;
+        ++m_sw_lb_num_steps;
+        this->log(LogLevel::debug,
+                  "[RRTMGP::run_impl] SW load imbalance (max/avg daylit cols per rank):\n"
+                  "  - before redistribution: " + std::to_string(before) + "\n"
+                  "  - after redistribution:  " + std::to_string(after) + "\n"
+                  "  - cols sent/received on this rank: " + std::to_string(m_sw_load_balancer->num_sends()) +
+                  "/" + std::to_string(m_sw_load_balancer->num_recvs()) + "\n");
+      }
+
       // Update heating tendency
       TIMED_INLINE_KERNEL(heating_tendency,
       auto sw_heating_k  = m_buffer.sw_heating_k;
@@ -1221,6 +1252,13 @@ void RRTMGPRadiation::finalize_impl  () {
   // This can happen if an atm proc that is inited before RRTMGP throws during init,
   // and the stack gets destroyed. The driver calls the 'finalize' method on all atm procs
   if (is_initialized()) {
+    if (m_sw_load_balancer and m_sw_lb_num_steps>0) {
+      this->log(LogLevel::info,
+                "[RRTMGP] SW load balancing stats (avg over " + std::to_string(m_sw_lb_num_steps) + " rad steps):\n"
+                "  - imbalance before redistribution: " + std::to_string(m_sw_lb_sum_imbalance_before/m_sw_lb_num_steps) + "\n"
+                "  - imbalance after redistribution:  " + std::to_string(m_sw_lb_sum_imbalance_after/m_sw_lb_num_steps) + "\n");
+    }
+
     m_gas_concs_k.reset();
     // Finalize the interface, passing a bool for rank 0
     // to print info about memory stats on that rank
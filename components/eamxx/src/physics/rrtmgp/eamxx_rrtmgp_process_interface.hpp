@@ -132,6 +132,13 @@ public:
   // Whether or not to do subcolumn sampling of cloud state for MCICA
   bool m_do_subcol_sampling;
 
+  // If set, daylit columns are moved across ranks to even out the SW work
+  std::shared_ptr<rrtmgp::SWLoadBalancer> m_sw_load_balancer;
+  // Running stats of the SW imbalance (max/avg daylit columns per rank)
+  int  m_sw_lb_num_steps = 0;
+  Real m_sw_lb_sum_imbalance_before = 0;
+  Real m_sw_lb_sum_imbalance_after  = 0;
+
   // Structure for storing local variables initialized using the ATMBufferManager
   struct Buffer {
     static constexpr int num_1d_ncol        = 8;
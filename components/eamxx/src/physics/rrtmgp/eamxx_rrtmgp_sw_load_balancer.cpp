@@ -0,0 +1,119 @@
+#include "physics/rrtmgp/eamxx_rrtmgp_sw_load_balancer.hpp"
+
+#include "share/util/eamxx_utils.hpp"  // For check_mpi_call
+
+#include <algorithm>
+#include <numeric>
+
+namespace scream {
+namespace rrtmgp {
+
+SWLoadBalancer::
+SWLoadBalancer (const ekat::Comm& comm)
+ : m_comm (comm)
+{
+  // Nothing to do here
+}
+
+void SWLoadBalancer::
+setup_plan (const int nday)
+{
+  const int nranks = m_comm.size();
+  const int me     = m_comm.rank();
+
+  m_send_pids.clear();
+  m_send_counts.clear();
+  m_recv_pids.clear();
+  m_recv_counts.clear();
+  m_num_sends = m_num_recvs = 0;
+
+  // Gather the daylit columns count from all ranks
+  int my_nday = nday;
+  std::vector<int> loads(nranks);
+  check_mpi_call(MPI_Allgather(&my_nday,1,MPI_INT,loads.data(),1,MPI_INT,m_comm.mpi_comm()),
+                 "SWLoadBalancer::setup_plan, gathering daylit columns counts");
+
+  const long long total = std::accumulate(loads.begin(),loads.end(),0LL);
+  if (total==0) {
+    // All ranks are in the dark, nothing to balance
+    m_imbalance_before = m_imbalance_after = 1;
+    return;
+  }
+
+  const Real avg = static_cast<Real>(total) / nranks;
+  const int target = (total + nranks - 1) / nranks;
+  m_imbalance_before = *std::max_element(loads.begin(),loads.end()) / avg;
+
+  // Ranks above target ship their excess to ranks below target. Since nranks*target>=total,
+  // the room on the receivers is always enough to absorb the excess of the senders.
+  // Walk both lists in pid order, so that all ranks compute the same matching.
+  std::vector<int> room(nranks);
+  for (int pid=0; pid<nranks; ++pid) {
+    room[pid] = std::max(target-loads[pid],0);
+  }
+  int recv_pid = 0;
+  for (int send_pid=0; send_pid<nranks; ++send_pid) {
+    int excess = loads[send_pid] - target;
+    while (excess>0) {
+      while (room[recv_pid]==0) {
+        ++recv_pid;
+      }
+      const int n = std::min(excess,room[recv_pid]);
+      if (send_pid==me) {
+        m_send_pids.push_back(recv_pid);
+        m_send_counts.push_back(n);
+        m_num_sends += n;
+      } else if (recv_pid==me) {
+        m_recv_pids.push_back(send_pid);
+        m_recv_counts.push_back(n);
+        m_num_recvs += n;
+      }
+      loads[send_pid] -= n;
+      loads[recv_pid] += n;
+      room[recv_pid]  -= n;
+      excess -= n;
+    }
+  }
+
+  m_imbalance_after = *std::max_element(loads.begin(),loads.end()) / avg;
+}
+
+void SWLoadBalancer::
+exchange (const void* send_buf, void* recv_buf, const int col_size,
+          const MPI_Datatype mpi_data_t, const bool forward) const
+{
+  // Use a different tag for the two directions, to be on the safe side
+  const int tag = forward ? 0 : 1;
+  const auto& send_pids   = forward ? m_send_pids   : m_recv_pids;
+  const auto& send_counts = forward ? m_send_counts : m_recv_counts;
+  const auto& recv_pids   = forward ? m_recv_pids   : m_send_pids;
+  const auto& recv_counts = forward ? m_recv_counts : m_send_counts;
+
+  int type_size;
+  MPI_Type_size(mpi_data_t,&type_size);
+  const auto col_bytes = static_cast<size_t>(col_size)*type_size;
+
+  auto mpi_comm = m_comm.mpi_comm();
+  std::vector<MPI_Request> reqs;
+  reqs.reserve(send_pids.size()+recv_pids.size());
+
+  auto recv_ptr = static_cast<char*>(recv_buf);
+  for (size_t i=0; i<recv_pids.size(); ++i) {
+    auto& req = reqs.emplace_back();
+    check_mpi_call(MPI_Irecv(recv_ptr,recv_counts[i]*col_size,mpi_data_t,recv_pids[i],tag,mpi_comm,&req),
+                   "SWLoadBalancer::exchange, creating recv request");
+    recv_ptr += recv_counts[i]*col_bytes;
+  }
+  auto send_ptr = static_cast<const char*>(send_buf);
+  for (size_t i=0; i<send_pids.size(); ++i) {
+    auto& req = reqs.emplace_back();
+    check_mpi_call(MPI_Isend(send_ptr,send_counts[i]*col_size,mpi_data_t,send_pids[i],tag,mpi_comm,&req),
+                   "SWLoadBalancer::exchange, creating send request");
+    send_ptr += send_counts[i]*col_bytes;
+  }
+  check_mpi_call(MPI_Waitall(reqs.size(),reqs.data(),MPI_STATUSES_IGNORE),
+                 "SWLoadBalancer::exchange, waiting on requests");
+}
+
+} // namespace rrtmgp
+} // namespace scream
@@ -0,0 +1,91 @@
+#ifndef EAMXX_RRTMGP_SW_LOAD_BALANCER_HPP
+#define EAMXX_RRTMGP_SW_LOAD_BALANCER_HPP
+
+#include "share/core/eamxx_types.hpp"
+
+#include <ekat_comm.hpp>
+#include <ekat_mpi_utils.hpp>
+
+#include <mpi.h>
+#include <vector>
+
+namespace scream {
+namespace rrtmgp {
+
+/*
+ * Cross-rank redistribution of daylit columns for the shortwave calculation.
+ *
+ * The SW solver only runs on columns with mu0>0, so at any given time the ranks
+ * owning the day side of the planet do all the SW work, while the ones owning
+ * the night side sit idle. Given the number of daylit columns on each rank,
+ * this class builds a plan that moves the excess daylit columns of overloaded
+ * ranks to ranks below the target load, and it performs the exchange of the
+ * packed column data (inputs forward, fluxes backward).
+ *
+ * All ranks build the plan from the same all-gathered counts, so no negotiation
+ * is needed. A rank is either a sender or a receiver (or neither), never both.
+ * By convention, a sender ships its LAST num_sends() daylit columns, in order,
+ * to its send pids (in increasing pid order), and a receiver stores received
+ * columns in increasing pid order. The same ordering is used to send fluxes back.
+ *
+ * Like GridImportExport, pack/unpack is left to the caller: this class only
+ * deals with the plan and with contiguous buffers of packed columns.
+ */
+
+class SWLoadBalancer {
+public:
+  explicit SWLoadBalancer (const ekat::Comm& comm);
+  ~SWLoadBalancer () = default;
+
+  // Build the migration plan, given the number of local daylit columns.
+  // NOTE: this is a collective call.
+  void setup_plan (const int nday);
+
+  int num_sends () const { return m_num_sends; }
+  int num_recvs () const { return m_num_recvs; }
+
+  // Ratio max/avg of the daylit columns per rank, before and after redistribution
+  // (as computed by the last call to setup_plan). A value of 1 means perfect balance.
+  Real imbalance_before () const { return m_imbalance_before; }
+  Real imbalance_after  () const { return m_imbalance_after; }
+
+  // Ship packed columns from senders to receivers. Each column takes col_size
+  // entries; send_buf has num_sends()*col_size entries, recv_buf has num_recvs()*col_size.
+  template<typename T>
+  void export_cols (const T* send_buf, T* recv_buf, const int col_size) const {
+    exchange (send_buf, recv_buf, col_size, ekat::get_mpi_type<T>(), true);
+  }
+
+  // Ship packed columns back from receivers to their owners. Each column takes col_size
+  // entries; send_buf has num_recvs()*col_size entries, recv_buf has num_sends()*col_size.
+  template<typename T>
+  void import_cols (const T* send_buf, T* recv_buf, const int col_size) const {
+    exchange (send_buf, recv_buf, col_size, ekat::get_mpi_type<T>(), false);
+  }
+
+  const ekat::Comm& get_comm () const { return m_comm; }
+
+protected:
+
+  void exchange (const void* send_buf, void* recv_buf, const int col_size,
+                 const MPI_Datatype mpi_data_t, const bool forward) const;
+
+  ekat::Comm  m_comm;
+
+  // Pids/counts of the columns we send to (resp. receive from) other ranks, sorted by pid
+  std::vector<int>  m_send_pids;
+  std::vector<int>  m_send_counts;
+  std::vector<int>  m_recv_pids;
+  std::vector<int>  m_recv_counts;
+
+  int   m_num_sends = 0;
+  int   m_num_recvs = 0;
+
+  Real  m_imbalance_before = 1;
+  Real  m_imbalance_after  = 1;
+};
+
+} // namespace rrtmgp
+} // namespace scream
+
+#endif // EAMXX_RRTMGP_SW_LOAD_BALANCER_HPP
@@ -0,0 +1,74 @@
+#include "catch2/catch.hpp"
+#include "physics/rrtmgp/eamxx_rrtmgp_sw_load_balancer.hpp"
+
+#include <ekat_comm.hpp>
+
+#include <vector>
+
+namespace {
+
+TEST_CASE("rrtmgp_sw_load_balancer") {
+  using namespace scream;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  const int rank = comm.rank();
+  const int size = comm.size();
+
+  rrtmgp::SWLoadBalancer lb(comm);
+
+  SECTION ("day_night_split") {
+    // Mimic the day/night split: the first half of the ranks is fully lit,
+    // while the other half is in the dark
+    const int ncol = 10;
+    int nday = rank<(size+1)/2 ? ncol : 0;
+    lb.setup_plan(nday);
+
+    int nsend = lb.num_sends();
+    int nrecv = lb.num_recvs();
+
+    // A rank is never both a sender and a receiver
+    REQUIRE ((nsend==0 or nrecv==0));
+
+    // Columns are neither created nor destroyed
+    int tot_send, tot_recv, tot_day;
+    comm.all_reduce(&nsend,&tot_send,1,MPI_SUM);
+    comm.all_reduce(&nrecv,&tot_recv,1,MPI_SUM);
+    comm.all_reduce(&nday,&tot_day,1,MPI_SUM);
+    REQUIRE (tot_send==tot_recv);
+
+    // Nobody ends up above the target load, and balance can only improve
+    const int target = (tot_day+size-1) / size;
+    REQUIRE (nday-nsend+nrecv<=target);
+    REQUIRE (lb.imbalance_after()<=lb.imbalance_before());
+    if (size>1) {
+      REQUIRE (lb.imbalance_after()<lb.imbalance_before());
+    }
+
+    // Round trip: ship some data, modify it on the receivers, and get it back
+    const int col_size = 3;
+    std::vector<Real> send(nsend*col_size), recv(nrecv*col_size), back(nsend*col_size);
+    for (int j=0; j<nsend; ++j) {
+      for (int k=0; k<col_size; ++k) {
+        send[j*col_size+k] = 1000*rank + 10*j + k;
+      }
+    }
+    lb.export_cols(send.data(),recv.data(),col_size);
+    for (auto& v : recv) {
+      v = -v;
+    }
+    lb.import_cols(recv.data(),back.data(),col_size);
+    for (int i=0; i<nsend*col_size; ++i) {
+      REQUIRE (back[i]==-send[i]);
+    }
+  }
+
+  SECTION ("all_dark") {
+    lb.setup_plan(0);
+    REQUIRE (lb.num_sends()==0);
+    REQUIRE (lb.num_recvs()==0);
+    REQUIRE (lb.imbalance_before()==1);
+    REQUIRE (lb.imbalance_after()==1);
+  }
+}
+
+} // anonymous namespace
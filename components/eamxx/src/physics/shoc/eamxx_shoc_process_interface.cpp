@@ -31,6 +31,15 @@ void SHOCMacrophysics::create_requests()
   m_num_cols = m_grid->get_num_local_dofs(); // Number of columns on this rank
   m_num_levs = m_grid->get_num_vertical_levels();  // Number of levels per column
 
+  // Select the implementation of shoc_main: monolithic or small kernels (or auto-tune).
+  // This must be known before the buffers are requested, since the temporaries of
+  // small kernels are only allocated if needed
+  using Variant = physics::KernelVariantSelector::Variant;
+  m_kernel_selector.setup(m_params.get<std::string>("kernel_variant","default"),
+                          m_params.get<int>("kernel_autotune_nsteps",3),
+                          runtime_options.use_small_kernels ? Variant::SmallKernels : Variant::Monolithic,
+                          m_comm);
+
   // Define the different field layouts that will be used for this process
 
   // Layout for 2D (1d horiz X 1d vertical) variable
@@ -155,11 +164,17 @@ size_t SHOCMacrophysics::requested_buffer_size_in_bytes() const
   const int nlevi_packs      = ekat::npack<Pack>(m_num_levs+1);
   const int num_tracer_packs = ekat::npack<Pack>(m_num_tracers);
 
+  // The temporaries of the small kernels are only needed if they may be used
+  const bool sk = m_kernel_selector.may_use_small_kernels();
+  const int num_1d_scalar_ncol = Buffer::num_1d_scalar_ncol + (sk ? Buffer::num_1d_scalar_ncol_sk : 0);
+  const int num_2d_vector_mid  = Buffer::num_2d_vector_mid  + (sk ? Buffer::num_2d_vector_mid_sk  : 0);
+  const int num_2d_vector_int  = Buffer::num_2d_vector_int  + (sk ? Buffer::num_2d_vector_int_sk  : 0);
+
   // Number of Reals needed by local views in the interface
-  const size_t interface_request = Buffer::num_1d_scalar_ncol*m_num_cols*sizeof(Real) +
+  const size_t interface_request = num_1d_scalar_ncol*m_num_cols*sizeof(Real) +
                                    Buffer::num_1d_scalar_nlev*nlev_packs*sizeof(Pack) +
-                                   Buffer::num_2d_vector_mid*m_num_cols*nlev_packs*sizeof(Pack) +
-                                   Buffer::num_2d_vector_int*m_num_cols*nlevi_packs*sizeof(Pack) +
+                                   num_2d_vector_mid*m_num_cols*nlev_packs*sizeof(Pack) +
+                                   num_2d_vector_int*m_num_cols*nlevi_packs*sizeof(Pack) +
                                    Buffer::num_2d_vector_tr*m_num_cols*num_tracer_packs*sizeof(Pack);
 
   // Number of Reals needed by the WorkspaceManager passed to shoc_main
@@ -183,18 +198,23 @@ void SHOCMacrophysics::init_buffers(const ATMBufferManager &buffer_manager)
   // 1d scalar views
   using scalar_view_t = decltype(m_buffer.wpthlp_sfc);
   scalar_view_t* _1d_scalar_view_ptrs[Buffer::num_1d_scalar_ncol] =
-    {&m_buffer.wpthlp_sfc, &m_buffer.wprtp_sfc, &m_buffer.upwp_sfc, &m_buffer.vpwp_sfc
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-     , &m_buffer.se_b, &m_buffer.ke_b, &m_buffer.wv_b, &m_buffer.wl_b
-     , &m_buffer.se_a, &m_buffer.ke_a, &m_buffer.wv_a, &m_buffer.wl_a
-     , &m_buffer.kbfs, &m_buffer.ustar2, &m_buffer.wstar
-#endif
-    };
+    {&m_buffer.wpthlp_sfc, &m_buffer.wprtp_sfc, &m_buffer.upwp_sfc, &m_buffer.vpwp_sfc};
   for (int i = 0; i < Buffer::num_1d_scalar_ncol; ++i) {
     *_1d_scalar_view_ptrs[i] = scalar_view_t(mem, m_num_cols);
     mem += _1d_scalar_view_ptrs[i]->size();
   }
 
+  // Temporaries of the small kernels, only allocated if they may be used
+  const bool sk = m_kernel_selector.may_use_small_kernels();
+  scalar_view_t* _1d_scalar_sk_view_ptrs[Buffer::num_1d_scalar_ncol_sk] =
+    {&m_buffer.se_b, &m_buffer.ke_b, &m_buffer.wv_b, &m_buffer.wl_b,
+     &m_buffer.se_a, &m_buffer.ke_a, &m_buffer.wv_a, &m_buffer.wl_a,
+     &m_buffer.kbfs, &m_buffer.ustar2, &m_buffer.wstar};
+  for (int i = 0; sk and i < Buffer::num_1d_scalar_ncol_sk; ++i) {
+    *_1d_scalar_sk_view_ptrs[i] = scalar_view_t(mem, m_num_cols);
+    mem += _1d_scalar_sk_view_ptrs[i]->size();
+  }
+
   Pack* s_mem = reinterpret_cast<Pack*>(mem);
 
   // 2d packed views
@@ -210,29 +230,37 @@ void SHOCMacrophysics::init_buffers(const ATMBufferManager &buffer_manager)
     &m_buffer.z_mid, &m_buffer.rrho, &m_buffer.thv, &m_buffer.dz, &m_buffer.zt_grid, &m_buffer.wm_zt, &m_buffer.unused,
     &m_buffer.inv_exner, &m_buffer.thlm, &m_buffer.qw, &m_buffer.dse, &m_buffer.tke_copy, &m_buffer.qc_copy,
     &m_buffer.shoc_ql2, &m_buffer.shoc_mix, &m_buffer.isotropy, &m_buffer.w_sec, &m_buffer.wqls_sec, &m_buffer.brunt
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-    , &m_buffer.rho_zt, &m_buffer.shoc_qv, &m_buffer.tabs, &m_buffer.dz_zt
-#endif
+  };
+  spack_2d_view_t* _2d_spack_mid_sk_view_ptrs[Buffer::num_2d_vector_mid_sk] = {
+    &m_buffer.rho_zt, &m_buffer.shoc_qv, &m_buffer.tabs, &m_buffer.dz_zt
   };
 
   spack_2d_view_t* _2d_spack_int_view_ptrs[Buffer::num_2d_vector_int] = {
     &m_buffer.z_int, &m_buffer.rrho_i, &m_buffer.zi_grid, &m_buffer.thl_sec, &m_buffer.qw_sec,
     &m_buffer.qwthl_sec, &m_buffer.wthl_sec, &m_buffer.wqw_sec, &m_buffer.wtke_sec, &m_buffer.uw_sec,
     &m_buffer.vw_sec, &m_buffer.w3
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-    , &m_buffer.dz_zi
-#endif
+  };
+  spack_2d_view_t* _2d_spack_int_sk_view_ptrs[Buffer::num_2d_vector_int_sk] = {
+    &m_buffer.dz_zi
   };
 
   for (int i = 0; i < Buffer::num_2d_vector_mid; ++i) {
     *_2d_spack_mid_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nlev_packs);
     s_mem += _2d_spack_mid_view_ptrs[i]->size();
   }
+  for (int i = 0; sk and i < Buffer::num_2d_vector_mid_sk; ++i) {
+    *_2d_spack_mid_sk_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nlev_packs);
+    s_mem += _2d_spack_mid_sk_view_ptrs[i]->size();
+  }
 
   for (int i = 0; i < Buffer::num_2d_vector_int; ++i) {
     *_2d_spack_int_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nlevi_packs);
     s_mem += _2d_spack_int_view_ptrs[i]->size();
   }
+  for (int i = 0; sk and i < Buffer::num_2d_vector_int_sk; ++i) {
+    *_2d_spack_int_sk_view_ptrs[i] = spack_2d_view_t(s_mem, m_num_cols, nlevi_packs);
+    s_mem += _2d_spack_int_sk_view_ptrs[i]->size();
+  }
   m_buffer.wtracer_sfc = decltype(m_buffer.wtracer_sfc)(s_mem, m_num_cols, num_tracer_packs);
   s_mem += m_buffer.wtracer_sfc.size();
 
@@ -392,7 +420,7 @@ void SHOCMacrophysics::initialize_impl (const RunType run_type)
   history_output.wqls_sec  = m_buffer.wqls_sec;
   history_output.brunt     = m_buffer.brunt;
 
-#ifdef SCREAM_SHOC_SMALL_KERNELS
+  // Temporaries (only allocated if small kernels may be used)
   temporaries.se_b = m_buffer.se_b;
   temporaries.ke_b = m_buffer.ke_b;
   temporaries.wv_b = m_buffer.wv_b;
@@ -410,7 +438,6 @@ void SHOCMacrophysics::initialize_impl (const RunType run_type)
   temporaries.tabs = m_buffer.tabs;
   temporaries.dz_zt = m_buffer.dz_zt;
   temporaries.dz_zi = m_buffer.dz_zi;
-#endif
 
   shoc_postprocess.set_variables(m_num_cols,m_num_levs,
                                  rrho,qv,qw,qc,qc_copy,tke,tke_copy,qtracers,shoc_ql2,
@@ -527,12 +554,18 @@ void SHOCMacrophysics::run_impl (const double dt)
   workspace_mgr.reset_internals();
 
   // Run shoc main
-  SHF::shoc_main(m_num_cols, m_num_levs, m_num_levs+1, m_npbl, m_nadv, m_num_tracers, dt,
-                 workspace_mgr,runtime_options,input,input_output,output,history_output
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-                 , temporaries
-#endif
-                 );
+  using Variant = physics::KernelVariantSelector::Variant;
+  runtime_options.use_small_kernels = m_kernel_selector.get_variant()==Variant::SmallKernels;
+  const auto elapsed_microsec =
+    SHF::shoc_main(m_num_cols, m_num_levs, m_num_levs+1, m_npbl, m_nadv, m_num_tracers, dt,
+                   workspace_mgr,runtime_options,input,input_output,output,history_output,
+                   temporaries);
+
+  // While auto-tuning, time both implementations, then log the choice
+  if (m_kernel_selector.is_tuning() and m_kernel_selector.record_time(elapsed_microsec)) {
+    m_atm_logger->info("[SHOCMacrophysics] kernel variant " + m_kernel_selector.get_tuning_summary() +
+                       ", times in us");
+  }
 
   // Postprocessing of SHOC outputs
   Kokkos::parallel_for("shoc_postprocess",
@@ -4,6 +4,7 @@
 #include "share/atm_process/atmosphere_process.hpp"
 #include "physics/shoc/shoc_functions.hpp"
 #include "share/physics/eamxx_common_physics_functions.hpp"
+#include "share/physics/eamxx_kernel_variant_selector.hpp"
 #include "share/atm_process/ATMBufferManager.hpp"
 
 #include <ekat_parameter_list.hpp>
@@ -378,26 +379,23 @@ public:
 
   // Structure for storing local variables initialized using the ATMBufferManager
   struct Buffer {
-#ifndef SCREAM_SHOC_SMALL_KERNELS
     static constexpr int num_1d_scalar_ncol = 4;
-#else
-    static constexpr int num_1d_scalar_ncol = 15;
-#endif
     static constexpr int num_1d_scalar_nlev = 1;
-#ifndef SCREAM_SHOC_SMALL_KERNELS
     static constexpr int num_2d_vector_mid  = 19;
     static constexpr int num_2d_vector_int  = 12;
-#else
-    static constexpr int num_2d_vector_mid  = 23;
-    static constexpr int num_2d_vector_int  = 13;
-#endif
     static constexpr int num_2d_vector_tr   = 1;
 
+    // Only needed by small kernels
+    static constexpr int num_1d_scalar_ncol_sk = 11;
+    static constexpr int num_2d_vector_mid_sk  = 4;
+    static constexpr int num_2d_vector_int_sk  = 1;
+
     uview_1d<Real> wpthlp_sfc;
     uview_1d<Real> wprtp_sfc;
     uview_1d<Real> upwp_sfc;
     uview_1d<Real> vpwp_sfc;
-#ifdef SCREAM_SHOC_SMALL_KERNELS
+
+    // Temporaries of the small kernels implementation
     uview_1d<Real> se_b;
     uview_1d<Real> ke_b;
     uview_1d<Real> wv_b;
@@ -409,7 +407,6 @@ public:
     uview_1d<Real> kbfs;
     uview_1d<Real> ustar2;
     uview_1d<Real> wstar;
-#endif
 
     uview_1d<Pack> pref_mid;
 
@@ -445,14 +442,14 @@ public:
     uview_2d<Pack> w3;
     uview_2d<Pack> wqls_sec;
     uview_2d<Pack> brunt;
-#ifdef SCREAM_SHOC_SMALL_KERNELS
+
+    // Temporaries of the small kernels implementation
     uview_2d<Pack> rho_zt;
     uview_2d<Pack> shoc_qv;
     uview_2d<Pack> tabs;
     uview_2d<Pack> dz_zt;
     uview_2d<Pack> dz_zi;
     uview_2d<Pack> tkh;
-#endif
 
     Pack* wsm_data;
   };
@@ -503,9 +500,10 @@ protected:
   SHF::SHOCOutput output;
   SHF::SHOCHistoryOutput history_output;
   SHF::SHOCRuntime runtime_options;
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   SHF::SHOCTemporaries temporaries;
-#endif
+
+  // Selects the monolithic or small kernels implementation of shoc_main
+  physics::KernelVariantSelector m_kernel_selector;
 
   // Structures which compute pre/post process
   SHOCPreprocess shoc_preprocess;
@@ -80,6 +80,13 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     Scalar Ckm;
     bool shoc_1p5tke;
     bool extra_diags;
+    // Use the small kernels implementation of shoc_main, rather than the monolithic one.
+    // The default is set at build time, but the process interface can change it.
+#ifdef SCREAM_SHOC_SMALL_KERNELS
+    bool use_small_kernels = true;
+#else
+    bool use_small_kernels = false;
+#endif
   };
 
   // This struct stores input views for shoc_main.
@@ -194,7 +201,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     view_2d<Pack> shoc_evap;
   };
 
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   struct SHOCTemporaries {
     view_1d<Scalar> se_b;
     view_1d<Scalar> ke_b;
@@ -215,7 +221,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
     view_2d<Pack> dz_zi;
     view_2d<Pack> tkh;
   };
-#endif
 
   //
   // --------- Functions ---------
@@ -252,13 +257,11 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                               const uview_1d<const Pack> &inv_exner,
                               const uview_1d<const Pack> &zt_grid, const Scalar &phis,
                               const uview_1d<Pack> &host_dse);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void
   update_host_dse_disp(const Int &shcol, const Int &nlev, const view_2d<const Pack> &thlm,
                        const view_2d<const Pack> &shoc_ql, const view_2d<const Pack> &inv_exner,
                        const view_2d<const Pack> &zt_grid, const view_1d<const Scalar> &phis,
                        const view_2d<Pack> &host_dse);
-#endif
 
   KOKKOS_FUNCTION
   static void compute_diag_third_shoc_moment(
@@ -283,9 +286,7 @@ template <typename ScalarT, typename DeviceT> struct Functions {
 
   KOKKOS_FUNCTION
   static void check_tke(const MemberType &team, const Int &nlev, const uview_1d<Pack> &tke);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void check_tke_disp(const Int &schol, const Int &nlev, const view_2d<Pack> &tke);
-#endif
 
   KOKKOS_FUNCTION
   static void clipping_diag_third_shoc_moments(const MemberType &team, const Int &nlevi,
@@ -305,7 +306,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                         const uview_1d<const Pack> &rtm, const uview_1d<const Pack> &rcm,
                         const uview_1d<const Pack> &u_wind, const uview_1d<const Pack> &v_wind,
                         Scalar &se_int, Scalar &ke_int, Scalar &wv_int, Scalar &wl_int);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void
   shoc_energy_integrals_disp(const Int &shcol, const Int &nlev,
                              const view_2d<const Pack> &host_dse, const view_2d<const Pack> &pdel,
@@ -314,7 +314,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                              const uview_2d<const Pack> &v_wind, const view_1d<Scalar> &se_b_slot,
                              const view_1d<Scalar> &ke_b_slot, const view_1d<Scalar> &wv_b_slot,
                              const view_1d<Scalar> &wl_b_slot);
-#endif
 
   KOKKOS_FUNCTION
   static void shoc_diag_second_moments_lbycond(const Scalar &wthl_sfc, const Scalar &wqw_sfc,
@@ -356,7 +355,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &wqw_sec, const uview_1d<Pack> &qwthl_sec,
       const uview_1d<Pack> &uw_sec, const uview_1d<Pack> &vw_sec, const uview_1d<Pack> &wtke_sec,
       const uview_1d<Pack> &w_sec);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void diag_second_shoc_moments_disp(
       const Int &shcol, const Int &nlev, const Int &nlevi, const Scalar &thl2tune,
       const Scalar &qw2tune, const Scalar &qwthl2tune, const Scalar &w2tune,
@@ -373,7 +371,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const view_2d<Pack> &qw_sec, const view_2d<Pack> &wthl_sec, const view_2d<Pack> &wqw_sec,
       const view_2d<Pack> &qwthl_sec, const view_2d<Pack> &uw_sec, const view_2d<Pack> &vw_sec,
       const view_2d<Pack> &wtke_sec, const view_2d<Pack> &w_sec);
-#endif
 
   KOKKOS_FUNCTION
   static void compute_brunt_shoc_length(const MemberType &team, const Int &nlev, const Int &nlevi,
@@ -398,7 +395,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                                const Scalar &wqw_sfc, const Scalar &thl_sfc,
                                const Scalar &cldliq_sfc, const Scalar &qv_sfc, Scalar &ustar,
                                Scalar &kbfs, Scalar &obklen);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void
   shoc_diag_obklen_disp(const Int &shcol, const Int &nlev, const view_1d<const Scalar> &uw_sfc,
                         const view_1d<const Scalar> &vw_sfc, const view_1d<const Scalar> &wthl_sfc,
@@ -406,7 +402,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                         const view_2d<const Scalar> &cldliq_sfc,
                         const view_2d<const Scalar> &qv_sfc, const view_1d<Scalar> &ustar,
                         const view_1d<Scalar> &kbfs, const view_1d<Scalar> &obklen);
-#endif
 
   KOKKOS_FUNCTION
   static void shoc_pblintd_cldcheck(const Scalar &zi, const Scalar &cldn, Scalar &pblh);
@@ -419,7 +414,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                           const uview_1d<const Pack> &tke, const uview_1d<const Pack> &thv,
                           const Workspace &workspace, const uview_1d<Pack> &brunt,
                           const uview_1d<Pack> &shoc_mix);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void shoc_length_disp(const Int &shcol, const Int &nlev, const Int &nlevi,
                                const Scalar &length_fac,
                                const view_1d<const Scalar> &dx, const view_1d<const Scalar> &dy,
@@ -429,7 +423,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                                const view_2d<const Pack> &thv,
                                const WorkspaceMgr &workspace_mgr, const view_2d<Pack> &brunt,
                                const view_2d<Pack> &shoc_mix);
-#endif
 
   KOKKOS_FUNCTION
   static void shoc_energy_fixer(const MemberType &team, const Int &nlev, const Int &nlevi,
@@ -442,7 +435,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                                 const uview_1d<const Pack> &rho_zt,
                                 const uview_1d<const Pack> &tke, const uview_1d<const Pack> &pint,
                                 const Workspace &workspace, const uview_1d<Pack> &host_dse);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void
   shoc_energy_fixer_disp(const Int &shcol, const Int &nlev, const Int &nlevi, const Scalar &dtime,
                          const Int &nadv, const view_2d<const Pack> &zt_grid,
@@ -454,17 +446,14 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                          const view_1d<const Scalar> &wqw_sfc, const view_2d<const Pack> &rho_zt,
                          const view_2d<const Pack> &tke, const view_2d<const Pack> &pint,
                          const WorkspaceMgr &workspace_mgr, const view_2d<Pack> &host_dse);
-#endif
 
   KOKKOS_FUNCTION
   static void compute_shoc_vapor(const MemberType &team, const Int &nlev,
                                  const uview_1d<const Pack> &qw, const uview_1d<const Pack> &ql,
                                  const uview_1d<Pack> &qv);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void compute_shoc_vapor_disp(const Int &shcol, const Int &nlev,
                                       const view_2d<const Pack> &qw,
                                       const view_2d<const Pack> &ql, const view_2d<Pack> &qv);
-#endif
 
   KOKKOS_FUNCTION
   static void compute_shoc_temperature(const MemberType &team, const Int &nlev,
@@ -472,13 +461,11 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                                        const uview_1d<const Pack> &ql,
                                        const uview_1d<const Pack> &inv_exner,
                                        const uview_1d<Pack> &tabs);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void compute_shoc_temperature_disp(const Int &shcol, const Int &nlev,
                                             const view_2d<const Pack> &thetal,
                                             const view_2d<const Pack> &ql,
                                             const view_2d<const Pack> &inv_exner,
                                             const view_2d<Pack> &tabs);
-#endif
 
   KOKKOS_FUNCTION
   static void update_prognostics_implicit(
@@ -491,7 +478,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const Workspace &workspace, const uview_1d<Pack> &thetal, const uview_1d<Pack> &qw,
       const uview_2d_strided<Pack> &tracer, const uview_1d<Pack> &tke,
       const uview_1d<Pack> &u_wind, const uview_1d<Pack> &v_wind);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void update_prognostics_implicit_disp(
       const Int &shcol, const Int &nlev, const Int &nlevi, const Int &num_tracer,
       const Scalar &dtime, const view_2d<const Pack> &dz_zt, const view_2d<const Pack> &dz_zi,
@@ -503,7 +489,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const WorkspaceMgr &workspace_mgr, const view_2d<Pack> &thetal, const view_2d<Pack> &qw,
       const view_3d_strided<Pack> &tracer, const view_2d<Pack> &tke, const view_2d<Pack> &u_wind,
       const view_2d<Pack> &v_wind);
-#endif
 
   KOKKOS_FUNCTION
   static void diag_third_shoc_moments(
@@ -515,7 +500,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<const Pack> &dz_zt, const uview_1d<const Pack> &dz_zi,
       const uview_1d<const Pack> &zt_grid, const uview_1d<const Pack> &zi_grid,
       const Workspace &workspace, const uview_1d<Pack> &w3);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void diag_third_shoc_moments_disp(
       const Int &shcol, const Int &nlev, const Int &nlevi, const Scalar &c_diag_3rd_mom,
       const bool &shoc_1p5tke, const view_2d<const Pack> &w_sec,
@@ -525,7 +509,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const view_2d<const Pack> &dz_zt, const view_2d<const Pack> &dz_zi,
       const view_2d<const Pack> &zt_grid, const view_2d<const Pack> &zi_grid,
       const WorkspaceMgr &workspace_mgr, const view_2d<Pack> &w3);
-#endif
 
   KOKKOS_FUNCTION
   static void adv_sgs_tke(const MemberType &team, const Int &nlev, const Real &dtime,
@@ -550,7 +533,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                    const uview_1d<Pack> &shoc_cldfrac, const uview_1d<Pack> &shoc_ql,
                    const uview_1d<Pack> &wqls, const uview_1d<Pack> &wthv_sec,
                    const uview_1d<Pack> &shoc_ql2);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void shoc_assumed_pdf_disp(
       const Int &shcol, const Int &nlev, const Int &nlevi, const view_2d<const Pack> &thetal,
       const view_2d<const Pack> &qw, const view_2d<const Pack> &w_field,
@@ -563,7 +545,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const view_2d<Pack> &shoc_cond, const view_2d<Pack> &shoc_evap,
       const view_2d<Pack> &shoc_cldfrac, const view_2d<Pack> &shoc_ql, const view_2d<Pack> &wqls,
       const view_2d<Pack> &wthv_sec, const view_2d<Pack> &shoc_ql2);
-#endif
 
   KOKKOS_INLINE_FUNCTION
   static void shoc_assumed_pdf_compute_buoyancy_flux(const Pack &wthlsec, const Pack &wqwsec,
@@ -668,7 +649,7 @@ template <typename ScalarT, typename DeviceT> struct Functions {
   static Int shoc_init(const Int &nbot_shoc, const Int &ntop_shoc,
                        const view_1d<const Pack> &pref_mid);
 
-#ifndef SCREAM_SHOC_SMALL_KERNELS
+  // Monolithic implementation: one team per column
   KOKKOS_FUNCTION
   static void shoc_main_internal(
       const MemberType &team,
@@ -711,7 +692,8 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const uview_1d<Pack> &wtke_sec, const uview_1d<Pack> &uw_sec, const uview_1d<Pack> &vw_sec,
       const uview_1d<Pack> &w3, const uview_1d<Pack> &wqls_sec, const uview_1d<Pack> &brunt,
       const uview_1d<Pack> &isotropy);
-#else
+
+  // Small kernels implementation: one kernel launch per sub-step, over all columns
   static void shoc_main_internal(
       const Int &shcol,        // Number of columns
       const Int &nlev,         // Number of levels
@@ -759,7 +741,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
       const view_1d<Scalar> &ustar2, const view_1d<Scalar> &wstar, const view_2d<Pack> &rho_zt,
       const view_2d<Pack> &shoc_qv, const view_2d<Pack> &tabs, const view_2d<Pack> &dz_zt,
       const view_2d<Pack> &dz_zi);
-#endif
 
   // Return microseconds elapsed
   static Int shoc_main(const Int &shcol,            // Number of SHOC columns in the array
@@ -774,12 +755,8 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                        const SHOCInput &shoc_input,                 // Input
                        const SHOCInputOutput &shoc_input_output,    // Input/Output
                        const SHOCOutput &shoc_output,               // Output
-                       const SHOCHistoryOutput &shoc_history_output // Output (diagnostic)
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-                       ,
-                       const SHOCTemporaries &shoc_temporaries // Temporaries for small kernels
-#endif
-  );
+                       const SHOCHistoryOutput &shoc_history_output, // Output (diagnostic)
+                       const SHOCTemporaries &shoc_temporaries); // Temporaries (small kernels only)
 
   KOKKOS_FUNCTION
   static void pblintd_height(const MemberType &team, const Int &nlev, const Int &npbl,
@@ -819,7 +796,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                       const uview_1d<const Pack> &v, const Scalar &ustar, const Scalar &obklen,
                       const Scalar &kbfs, const uview_1d<const Pack> &cldn,
                       const Workspace &workspace, Scalar &pblh);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void pblintd_disp(const Int &shcol, const Int &nlev, const Int &nlevi, const Int &npbl,
                            const view_2d<const Pack> &z, const view_2d<const Pack> &zi,
                            const view_2d<const Pack> &thl, const view_2d<const Pack> &ql,
@@ -828,20 +804,17 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                            const view_1d<const Scalar> &obklen, const view_1d<const Scalar> &kbfs,
                            const view_2d<const Pack> &cldn, const WorkspaceMgr &workspace_mgr,
                            const view_1d<Scalar> &pblh);
-#endif
 
   KOKKOS_FUNCTION
   static void shoc_grid(const MemberType &team, const Int &nlev, const Int &nlevi,
                         const uview_1d<const Pack> &zt_grid, const uview_1d<const Pack> &zi_grid,
                         const uview_1d<const Pack> &pdel, const uview_1d<Pack> &dz_zt,
                         const uview_1d<Pack> &dz_zi, const uview_1d<Pack> &rho_zt);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void shoc_grid_disp(const Int &shcol, const Int &nlev, const Int &nlevi,
                              const view_2d<const Pack> &zt_grid,
                              const view_2d<const Pack> &zi_grid, const view_2d<const Pack> &pdel,
                              const view_2d<Pack> &dz_zt, const view_2d<Pack> &dz_zi,
                              const view_2d<Pack> &rho_zt);
-#endif
 
   KOKKOS_FUNCTION
   static void
@@ -866,7 +839,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                        const Workspace &workspace, const uview_1d<Pack> &tke,
                        const uview_1d<Pack> &tk, const uview_1d<Pack> &tkh,
                        const uview_1d<Pack> &isotropy);
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   static void shoc_tke_disp(const Int &shcol, const Int &nlev, const Int &nlevi,
                             const Scalar &dtime, const Scalar &lambda_low,
                             const Scalar &lambda_high, const Scalar &lambda_slope,
@@ -881,7 +853,6 @@ template <typename ScalarT, typename DeviceT> struct Functions {
                             const WorkspaceMgr &workspace_mgr, const view_2d<Pack> &tke,
                             const view_2d<Pack> &tk, const view_2d<Pack> &tkh,
                             const view_2d<Pack> &isotropy);
-#endif
 }; // struct Functions
 
 } // namespace shoc
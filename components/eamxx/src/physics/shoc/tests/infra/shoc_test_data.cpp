@@ -2398,10 +2398,13 @@ Int shoc_main_host(Int shcol, Int nlev, Int nlevi, Real dtime, Int nadv, Int npb
                                              uw_sec_d,    vw_sec_d,   w3_d,      wqls_sec_d,
                                              brunt_d,     isotropy_d, shoc_cond_d, shoc_evap_d};
   SHF::SHOCRuntime shoc_runtime_options{0.001,0.04,2.65,0.02,1.0,1.0,1.0,1.0,0.5,7.0,0.1,0.1};
+  // Tests can force the small kernels, regardless of the build default
+  if (ekat::TestSession::get().flags["sk"]) {
+    shoc_runtime_options.use_small_kernels = true;
+  }
 
   const auto nlevi_packs = ekat::npack<Pack>(nlevi);
 
-#ifdef SCREAM_SHOC_SMALL_KERNELS
   view_1d
     se_b   ("se_b", shcol),
     ke_b   ("ke_b", shcol),
@@ -2425,7 +2428,6 @@ Int shoc_main_host(Int shcol, Int nlev, Int nlevi, Real dtime, Int nadv, Int npb
   SHF::SHOCTemporaries shoc_temporaries{
     se_b, ke_b, wv_b, wl_b, se_a, ke_a, wv_a, wl_a, kbfs, ustar2, wstar,
     rho_zt, shoc_qv, tabs, dz_zt, dz_zi};
-#endif
 
   // Create local workspace
   const int n_wind_slots = ekat::npack<Pack>(2)*Pack::n;
@@ -2434,11 +2436,8 @@ Int shoc_main_host(Int shcol, Int nlev, Int nlevi, Real dtime, Int nadv, Int npb
 
   const auto elapsed_microsec = SHF::shoc_main(shcol, nlev, nlevi, npbl, nadv, num_qtracers, dtime,
                                                workspace_mgr, shoc_runtime_options,
-                                               shoc_input, shoc_input_output, shoc_output, shoc_history_output
-#ifdef SCREAM_SHOC_SMALL_KERNELS
-                                               , shoc_temporaries
-#endif
-                                               );
+                                               shoc_input, shoc_input_output, shoc_output, shoc_history_output,
+                                               shoc_temporaries);
 
   // Copy wind back into separate views and
   // Transpose tracers
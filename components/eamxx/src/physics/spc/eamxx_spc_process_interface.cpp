@@ -90,6 +90,7 @@ void SPC::initialize_impl (const RunType /* run_type */)
   vremap_data.pname = "PS";
   vremap_data.pmid = pmid;
   m_data_interpolation->create_vert_remapper (vremap_data);
+  m_data_interpolation->set_prefetch (m_params.get<int>("data_prefetch_nsteps",0));
   m_data_interpolation->init_data_interval (start_of_step_ts());
 
   // Set property checks for fields in this process
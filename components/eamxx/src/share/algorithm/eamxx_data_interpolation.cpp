@@ -47,6 +47,25 @@ DataInterpolation (const std::shared_ptr<const AbstractGrid>& model_grid,
   m_logger = console_logger(ekat::logger::LogLevel::warn);
 }
 
+DataInterpolation::HorizData::
+~HorizData ()
+{
+  // The async read uses our reader, so make sure it's done.
+  // Note: errors in the read are irrelevant at this point, and we must not throw
+  if (prefetch_idx>=0 and not prefetch_ready) {
+    try {
+      scorpio::wait_async(prefetch_ticket);
+    } catch (...) {}
+  }
+}
+
+std::map<std::string,std::weak_ptr<DataInterpolation::HorizData>>&
+DataInterpolation::get_horiz_data_repo ()
+{
+  static std::map<std::string,std::weak_ptr<HorizData>> repo;
+  return repo;
+}
+
 void DataInterpolation::
 set_input_files_dimname (const std::string& name, const std::string& nc_name)
 {
@@ -60,33 +79,79 @@ set_logger (const std::shared_ptr<ekat::logger::LoggerBase>& logger)
   m_logger = logger;
 }
 
+void DataInterpolation::
+set_prefetch (const int nsteps_ahead)
+{
+  EKAT_REQUIRE_MSG (not m_data_initialized,
+      "[DataInterpolation] Error! Cannot call 'set_prefetch' after 'init_data_interval'.\n");
+  EKAT_REQUIRE_MSG (nsteps_ahead>=0,
+      "[DataInterpolation] Error! Invalid number of steps for prefetch.\n"
+      " - nsteps_ahead: " + std::to_string(nsteps_ahead) + "\n");
+
+  m_prefetch_nsteps = nsteps_ahead;
+  if (m_prefetch_nsteps>0) {
+    // The reads are done on the scorpio async thread, which makes MPI calls
+    int thread_level;
+    MPI_Query_thread(&thread_level);
+    if (thread_level!=MPI_THREAD_MULTIPLE) {
+      m_logger->warn("[DataInterpolation] Prefetch requires MPI_THREAD_MULTIPLE.\n"
+                     "  Falling back to synchronous reads for " + m_name + ".\n");
+      m_prefetch_nsteps = 0;
+    }
+  }
+}
+
+void DataInterpolation::
+set_share_data (const bool share)
+{
+  EKAT_REQUIRE_MSG (not m_data_initialized,
+      "[DataInterpolation] Error! Cannot call 'set_share_data' after 'init_data_interval'.\n");
+
+  m_share_data = share;
+}
+
 void DataInterpolation::run (const util::TimeStamp& ts)
 {
   EKAT_REQUIRE_MSG (m_data_initialized,
       "[DataInterpolation] Error! You must call 'init_data_interval' before calling 'run'.\n");
 
-  // If we went past the current interval end, we need to update the end state
-  if (not m_data_interval.contains(ts)) {
+  auto& hd = *m_hdata;
+
+  // If we went past the current interval end, we need to update the end state.
+  // NOTE: if the data is shared, another object may have already done it. Since the data
+  //       can only move forward, we don't shift if ts is before the last processed time
+  const bool is_new_ts = not hd.last_run_ts.is_valid() or hd.last_run_ts<ts;
+  if (not hd.data_interval.contains(ts) and is_new_ts) {
     shift_data_interval ();
   }
 
+  if (m_prefetch_nsteps>0) {
+    update_prefetch (ts);
+  }
+
   // Perform the time interpolation: f_out = f_beg*alpha + f_end*(1-alpha),
   // where alpha = (ts-t_beg) / (t_end-t_beg).
   // NOTE: pay attention to time strategy, since for YearlyPeriodic you may
   //       have t_beg>t_end
-  util::TimeInterval beg_to_ts (m_data_interval.beg,ts,m_data_interval.timeline);
-  double alpha = beg_to_ts.length / m_data_interval.length;
+  util::TimeInterval beg_to_ts (hd.data_interval.beg,ts,hd.data_interval.timeline);
+  double alpha = beg_to_ts.length / hd.data_interval.length;
   EKAT_REQUIRE_MSG (alpha>=0 and alpha<=1,
     "[DataInterpolation] Error! Input timestamp is outside the current data time interval.\n"
-    "  data interval beg  ; " + m_data_interval.beg.to_string() + "\n"
-    "  data interval end  ; " + m_data_interval.end.to_string() + "\n"
+    "  data interval beg  ; " + hd.data_interval.beg.to_string() + "\n"
+    "  data interval end  ; " + hd.data_interval.end.to_string() + "\n"
     "  input timestamp    ; " + ts.to_string() + "\n"
-    "  interval length    : " + std::to_string(m_data_interval.length) + "\n"
-    "  interpolation coeff: " + std::to_string(alpha) + "\n");
+    "  interval length    : " + std::to_string(hd.data_interval.length) + "\n"
+    "  interpolation coeff: " + std::to_string(alpha) + "\n"
+    "  num data consumers : " + std::to_string(get_num_data_consumers()) + "\n"
+    "If the data is shared, make sure all consumers are run at the same time stamps.\n");
+
+  if (is_new_ts) {
+    hd.last_run_ts = ts;
+  }
 
   for (int i=0; i<m_nfields; ++i) {
-    const auto& beg = m_horiz_remapper_beg->get_tgt_field(i);
-    const auto& end = m_horiz_remapper_end->get_tgt_field(i);
+    const auto& beg = hd.hremap_beg->get_tgt_field(i);
+    const auto& end = hd.hremap_end->get_tgt_field(i);
           auto  out = m_vert_remapper->get_src_field(i);
 
     if (m_time_interp_type==Linear) {
@@ -106,16 +171,16 @@ void DataInterpolation::run (const util::TimeStamp& ts)
   //       field in the vertical remapper (also, we need to use ad different ptr)
   if (m_vr_type==Dynamic3D) {
     // The pressure field is THE LAST registered in the horiz remappers
-    const auto p_beg = m_horiz_remapper_beg->get_tgt_field(m_nfields);
-    const auto p_end = m_horiz_remapper_end->get_tgt_field(m_nfields);
+    const auto p_beg = hd.hremap_beg->get_tgt_field(m_nfields);
+    const auto p_end = hd.hremap_end->get_tgt_field(m_nfields);
 
     auto p = m_helper_pressure_fields["p_data"];
     p.deep_copy(p_beg);
     p.update(p_end,alpha,1-alpha);
   } else if (m_vr_type==Dynamic3DRef) {
     // The surface pressure field is THE LAST registered in the horiz remappers
-    const auto ps_beg = m_horiz_remapper_beg->get_tgt_field(m_nfields);
-    const auto ps_end = m_horiz_remapper_end->get_tgt_field(m_nfields);
+    const auto ps_beg = hd.hremap_beg->get_tgt_field(m_nfields);
+    const auto ps_end = hd.hremap_end->get_tgt_field(m_nfields);
 
     auto p  = m_helper_pressure_fields["p_data"];
     auto ps = m_helper_pressure_fields["p_file"];
@@ -156,54 +221,145 @@ void DataInterpolation::run (const util::TimeStamp& ts)
 
 void DataInterpolation::shift_data_interval ()
 {
-  m_curr_interval_idx.first = m_curr_interval_idx.second;
-  m_curr_interval_idx.second = m_time_database.get_next_idx(m_curr_interval_idx.first);
+  auto& hd = *m_hdata;
+  hd.curr_interval_idx.first = hd.curr_interval_idx.second;
+  hd.curr_interval_idx.second = m_time_database.get_next_idx(hd.curr_interval_idx.first);
+
+  hd.data_interval.advance(m_time_database.slices[hd.curr_interval_idx.second].time);
+
+  if (hd.prefetch_idx>=0) {
+    // Wait for the prefetch (if not done yet), since it uses the reader
+    finish_prefetch ();
+    hd.prefetch_ready = false;
+    if (hd.prefetch_idx==hd.curr_interval_idx.second) {
+      // The new end slice is already loaded: simply rotate the remappers
+      hd.prefetch_idx = -1;
+      ++hd.num_prefetched;
+      auto old_beg = hd.hremap_beg;
+      hd.hremap_beg  = hd.hremap_end;
+      hd.hremap_end  = hd.hremap_next;
+      hd.hremap_next = old_beg;
+      return;
+    }
+    // We prefetched the wrong slice (can happen if run is called with a large time jump)
+    hd.prefetch_idx = -1;
+  }
 
-  m_data_interval.advance(m_time_database.slices[m_curr_interval_idx.second].time);
-  std::swap (m_horiz_remapper_beg,m_horiz_remapper_end);
+  std::swap (hd.hremap_beg,hd.hremap_end);
   update_end_fields ();
 }
 
 void DataInterpolation::
 update_end_fields ()
 {
+  auto& hd = *m_hdata;
+  const auto& slice_beg = m_time_database.slices[hd.curr_interval_idx.first];
+  const auto& slice_end = m_time_database.slices[hd.curr_interval_idx.second];
+
+  setup_reader (hd.hremap_end,slice_end.filename);
+
+  // Read and interpolate fields
+  m_logger->info("[DataInterpolation] Reading end of interval fields.");
+  m_logger->info(" - interval: [" + slice_beg.time.to_string() + ", " + slice_end.time.to_string() + "]");
+  m_logger->info(" - filename: " + slice_end.filename);
+  m_logger->info(" - file time idx: " + std::to_string(slice_end.time_idx));
+  hd.reader->read(slice_end.time_idx);
+  hd.hremap_end->remap_fwd();
+}
+
+void DataInterpolation::
+setup_reader (const std::shared_ptr<AbstractRemapper>& hremap, const std::string& filename)
+{
+  auto& hd = *m_hdata;
+
   // First, set the correct fields in the reader
   std::vector<Field> fields;
   for (int i=0; i<m_nfields; ++i) {
-    fields.push_back(m_horiz_remapper_end->get_src_field(i));
+    fields.push_back(hremap->get_src_field(i));
   }
   if (m_vr_type==Dynamic3D or m_vr_type==Dynamic3DRef) {
     // We also need to read the src pressure profile
-    fields.push_back(m_horiz_remapper_end->get_src_field(m_nfields));
+    fields.push_back(hremap->get_src_field(m_nfields));
   }
 
-  // If we're also changing the file, must (re)init the scorpio structures
-  const auto& slice_beg = m_time_database.slices[m_curr_interval_idx.first];
-  const auto& slice_end = m_time_database.slices[m_curr_interval_idx.second];
-
-  if (not m_reader) {
+  if (not hd.reader) {
     // NOTE: Sometimes the original data does not use the same field tags as eamxx.
     // For these cases, we need to perform a shallow clone of
     // io_grid because the tags are constant in this object.
     using namespace ShortFieldTagsNames;
-    auto grid = m_horiz_remapper_beg->get_src_grid()->clone(m_horiz_remapper_beg->get_src_grid()->name(), true);
+    auto grid = hd.hremap_beg->get_src_grid()->clone(hd.hremap_beg->get_src_grid()->name(), true);
 
     auto gids = grid->get_partitioned_dim_gids();
     auto comm = grid->get_comm();
-    m_reader = std::make_shared<FieldReader>();
-    m_reader->set_dim_decomp(gids,comm);
+    hd.reader = std::make_shared<FieldReader>();
+    hd.reader->set_dim_decomp(gids,comm);
   }
   // This triggers opening of a new file at read time ONLY if the filename/fields have changed
-  m_reader->set_file_specs(slice_end.filename,m_input_files_dimnames);
-  m_reader->set_fields(fields);
+  hd.reader->set_file_specs(filename,m_input_files_dimnames);
+  hd.reader->set_fields(fields);
+}
 
-  // Read and interpolate fields
-  m_logger->info("[DataInterpolation] Reading end of interval fields.");
-  m_logger->info(" - interval: [" + slice_beg.time.to_string() + ", " + slice_end.time.to_string() + "]");
-  m_logger->info(" - filename: " + slice_end.filename);
-  m_logger->info(" - file time idx: " + std::to_string(slice_end.time_idx));
-  m_reader->read(slice_end.time_idx);
-  m_horiz_remapper_end->remap_fwd();
+void DataInterpolation::
+update_prefetch (const util::TimeStamp& ts)
+{
+  auto& hd = *m_hdata;
+  if (hd.prefetch_idx<0) {
+    // Start the prefetch if the interval end is less than m_prefetch_nsteps steps away.
+    // NOTE: with a linear timeline, there may be no slice to prefetch
+    const bool has_next = m_time_database.timeline==util::TimeLine::YearlyPeriodic or
+                          hd.curr_interval_idx.second+1<m_time_database.size();
+    if (hd.prev_run_ts.is_valid() and has_next) {
+      const auto timeline = m_time_database.timeline;
+      const double dt = util::TimeInterval(hd.prev_run_ts,ts,timeline).length;
+      const double time_left = util::TimeInterval(ts,hd.data_interval.end,timeline).length;
+      if (dt>0 and time_left<=m_prefetch_nsteps*dt) {
+        start_prefetch ();
+      }
+    }
+  } else if (not hd.prefetch_ready and scorpio::is_async_done(hd.prefetch_ticket)) {
+    // Do the remaining (device) work now, rather than at the interval boundary
+    finish_prefetch ();
+  }
+
+  hd.prev_run_ts = ts;
+}
+
+void DataInterpolation::
+start_prefetch ()
+{
+  auto& hd = *m_hdata;
+  hd.prefetch_idx = m_time_database.get_next_idx(hd.curr_interval_idx.second);
+  hd.prefetch_ready = false;
+
+  const auto& slice = m_time_database.slices[hd.prefetch_idx];
+  setup_reader (hd.hremap_next,slice.filename);
+  hd.reader->prepare_read();
+
+  m_logger->info("[DataInterpolation] Prefetching next data slice.");
+  m_logger->info(" - slice time: " + slice.time.to_string());
+  m_logger->info(" - filename: " + slice.filename);
+  m_logger->info(" - file time idx: " + std::to_string(slice.time_idx));
+
+  // NOTE: the reader is not used by anyone else until finish_prefetch is called,
+  //       and the HorizData destructor waits for the read, so a raw ptr is safe to use.
+  auto reader = hd.reader.get();
+  hd.prefetch_ticket = scorpio::enqueue_async([reader,time_idx=slice.time_idx]() {
+    reader->read_to_host(time_idx);
+  },slice.filename);
+}
+
+void DataInterpolation::
+finish_prefetch ()
+{
+  auto& hd = *m_hdata;
+  if (hd.prefetch_ready) {
+    return;
+  }
+
+  scorpio::wait_async(hd.prefetch_ticket);
+  hd.reader->sync_to_device();
+  hd.hremap_next->remap_fwd();
+  hd.prefetch_ready = true;
 }
 
 void DataInterpolation::
@@ -214,6 +370,13 @@ init_data_interval (const util::TimeStamp& t0)
 
   register_fields_in_remappers ();
 
+  auto& hd = *m_hdata;
+  if (hd.data_interval.end.is_valid()) {
+    // We are sharing the data with another object, which already loaded it
+    m_data_initialized = true;
+    return;
+  }
+
   // Loop over all stored time slices to find an interval that contains t0
   auto t0_interval = m_time_database.find_interval(t0);
   const auto& t_beg = m_time_database.slices[t0_interval].time;
@@ -222,8 +385,8 @@ init_data_interval (const util::TimeStamp& t0)
   // framework can only load the end slice (since that's what we need at runtime).
   // So, load end state for t=t_beg, then call shift_data_interval
   // NOTE: don't compute length now, since beg time point is invalid (we don't need length yet).
-  m_data_interval = util::TimeInterval (util::TimeStamp(),t_beg,m_time_database.timeline,false);
-  m_curr_interval_idx.second = t0_interval;
+  hd.data_interval = util::TimeInterval (util::TimeStamp(),t_beg,m_time_database.timeline,false);
+  hd.curr_interval_idx.second = t0_interval;
   update_end_fields ();
   shift_data_interval ();
 
@@ -432,7 +595,7 @@ create_horiz_remappers (const std::string& map_file)
 {
   using namespace ShortFieldTagsNames;
 
-  EKAT_REQUIRE_MSG (m_horiz_remapper_beg==nullptr,
+  EKAT_REQUIRE_MSG (not m_horiz_remapper_factory,
       "[DataInterpolation] Error! Horizontal remappers were already setup.\n");
 
   int ncols_model = m_model_grid->get_num_global_dofs();
@@ -453,8 +616,10 @@ create_horiz_remappers (const std::string& map_file)
   m_grid_after_hremap->reset_vertical_configuration(nlevs_data, AbstractGrid::VKind::Model);
 
   if (map_file!="") {
-    m_horiz_remapper_beg = std::make_shared<HorizontalRemapper>(m_data_grid,m_grid_after_hremap,map_file);
-    m_horiz_remapper_end = std::make_shared<HorizontalRemapper>(m_data_grid,m_grid_after_hremap,map_file);
+    m_horiz_remap_descr = "map_file=" + map_file;
+    m_horiz_remapper_factory = [this,map_file]() {
+      return std::make_shared<HorizontalRemapper>(m_data_grid,m_grid_after_hremap,map_file);
+    };
   } else {
     // No hremap: 'ncols' from the data must match the model grid (nlev can differ; vremap is not set yet)
     EKAT_REQUIRE_MSG (ncols_data==ncols_model,
@@ -462,11 +627,12 @@ create_horiz_remappers (const std::string& map_file)
         " - model grid num global cols: " + std::to_string(ncols_model) + "\n"
         " - input data num global cols: " + std::to_string(ncols_data) + "\n");
 
-    using IDR = IdentityRemapper;
-    constexpr auto SAT = IDR::SrcAliasTgt;
-
-    m_horiz_remapper_beg = std::make_shared<IDR>(m_grid_after_hremap,SAT);
-    m_horiz_remapper_end = std::make_shared<IDR>(m_grid_after_hremap,SAT);
+    m_horiz_remap_descr = "identity";
+    m_horiz_remapper_factory = [this]() {
+      using IDR = IdentityRemapper;
+      constexpr auto SAT = IDR::SrcAliasTgt;
+      return std::make_shared<IDR>(m_grid_after_hremap,SAT);
+    };
   }
 }
 
@@ -475,7 +641,7 @@ create_horiz_remappers (const Real iop_lat, const Real iop_lon)
 {
   using namespace ShortFieldTagsNames;
 
-  EKAT_REQUIRE_MSG (m_horiz_remapper_beg==nullptr,
+  EKAT_REQUIRE_MSG (not m_horiz_remapper_factory,
       "[DataInterpolation] Error! Horizontal remappers were already setup.\n");
 
   EKAT_REQUIRE_MSG (not std::isnan(iop_lat) and not std::isnan(iop_lon),
@@ -501,8 +667,10 @@ create_horiz_remappers (const Real iop_lat, const Real iop_lon)
   // Create iop remap tgt grid
   m_grid_after_hremap = m_model_grid->clone(m_name+"_post_hremap",true);
   m_grid_after_hremap->reset_vertical_configuration(nlevs_data, AbstractGrid::VKind::Model);
-  m_horiz_remapper_beg = std::make_shared<IOPRemapper>(m_data_grid,m_grid_after_hremap,iop_lat,iop_lon);
-  m_horiz_remapper_end = std::make_shared<IOPRemapper>(m_data_grid,m_grid_after_hremap,iop_lat,iop_lon);
+  m_horiz_remap_descr = "iop=" + std::to_string(iop_lat) + "," + std::to_string(iop_lon);
+  m_horiz_remapper_factory = [this,iop_lat,iop_lon]() {
+    return std::make_shared<IOPRemapper>(m_data_grid,m_grid_after_hremap,iop_lat,iop_lon);
+  };
 }
 
 void DataInterpolation::
@@ -516,7 +684,7 @@ create_vert_remapper (const VertRemapData& data)
 {
   EKAT_REQUIRE_MSG (m_vert_remapper==nullptr,
       "[DataInterpolation] Error! Vertical remapper was already setup.\n");
-  EKAT_REQUIRE_MSG (m_horiz_remapper_beg!=nullptr,
+  EKAT_REQUIRE_MSG (m_horiz_remapper_factory,
       "[DataInterpolation] Error! You must call `create_horiz_remappers` before `create_vert_remapper`.\n");
 
   m_vr_type = data.vr_type;
@@ -660,18 +828,73 @@ void DataInterpolation::register_fields_in_remappers ()
   }
   m_vert_remapper->registration_ends();
 
+  // These are the fields we need after the horiz remap
+  std::vector<Field> hremap_tgt_fields;
   for (int i=0; i<m_nfields; ++i) {
-    const auto& f = m_vert_remapper->get_src_field(i);
-    m_horiz_remapper_beg->register_field_from_tgt(f.clone(f.name(), m_horiz_remapper_beg->get_src_grid()->name(), CloneFlags::MatchPacking));
-    m_horiz_remapper_end->register_field_from_tgt(f.clone(f.name(), m_horiz_remapper_end->get_src_grid()->name(), CloneFlags::MatchPacking));
+    hremap_tgt_fields.push_back(m_vert_remapper->get_src_field(i));
   }
   if (m_vr_type==Dynamic3D or m_vr_type==Dynamic3DRef) {
-    const auto& data_p = m_helper_pressure_fields["p_file"];
-    m_horiz_remapper_beg->register_field_from_tgt(data_p.clone(data_p.name(), m_horiz_remapper_beg->get_src_grid()->name(), CloneFlags::MatchPacking));
-    m_horiz_remapper_end->register_field_from_tgt(data_p.clone(data_p.name(), m_horiz_remapper_end->get_src_grid()->name(), CloneFlags::MatchPacking));
+    hremap_tgt_fields.push_back(m_helper_pressure_fields["p_file"]);
+  }
+
+  // If another object is already reading (and horiz remapping) the same data, use it
+  const auto key = compute_horiz_data_key(hremap_tgt_fields);
+  auto& repo = get_horiz_data_repo();
+  if (m_share_data) {
+    auto it = repo.find(key);
+    if (it!=repo.end() and not it->second.expired()) {
+      m_hdata = it->second.lock();
+      m_logger->debug("[DataInterpolation] Sharing input data for " + m_name + " with "
+                      + std::to_string(get_num_data_consumers()-1) + " other object(s).");
+      return;
+    }
+  }
+
+  m_hdata = std::make_shared<HorizData>();
+  m_hdata->hremap_beg = m_horiz_remapper_factory();
+  m_hdata->hremap_end = m_horiz_remapper_factory();
+
+  // With prefetch, we need a third horiz remapper, to store the next slice
+  std::vector<std::shared_ptr<AbstractRemapper>> hremaps = {m_hdata->hremap_beg,m_hdata->hremap_end};
+  if (m_prefetch_nsteps>0) {
+    m_hdata->hremap_next = m_horiz_remapper_factory();
+    hremaps.push_back(m_hdata->hremap_next);
+  }
+
+  for (auto& hremap : hremaps) {
+    for (const auto& f : hremap_tgt_fields) {
+      hremap->register_field_from_tgt(f.clone(f.name(), hremap->get_src_grid()->name(), CloneFlags::MatchPacking));
+    }
+    hremap->registration_ends();
+  }
+
+  if (m_share_data) {
+    repo[key] = m_hdata;
+  }
+}
+
+std::string DataInterpolation::
+compute_horiz_data_key (const std::vector<Field>& hremap_tgt_fields) const
+{
+  // Two objects can share the data if they read the same fields from the same
+  // slices of the same files, and horiz remap them in the same way
+  const auto& slices = m_time_database.slices;
+  std::string key = m_model_grid->name() + "(" + std::to_string(m_model_grid->get_num_global_dofs()) + ")";
+  key += ";" + m_horiz_remap_descr;
+  key += ";files=" + ekat::join(m_time_database.files,",");
+  key += ";timeline=" + std::string(m_time_database.timeline==util::TimeLine::Linear ? "linear" : "yearly_periodic");
+  key += ";slices=" + std::to_string(slices.size()) + "[" + slices.front().time.to_string() + ","
+                    + slices.back().time.to_string() + "]";
+  for (const auto& [name,nc_name] : m_input_files_dimnames) {
+    key += ";" + name + "=" + nc_name;
+  }
+  key += ";prefetch=" + std::string(m_prefetch_nsteps>0 ? "yes" : "no");
+  for (const auto& f : hremap_tgt_fields) {
+    const auto& fh = f.get_header();
+    key += ";" + f.name() + fh.get_identifier().get_layout().to_string()
+         + "/" + std::to_string(fh.get_alloc_properties().get_largest_pack_size());
   }
-  m_horiz_remapper_beg->registration_ends();
-  m_horiz_remapper_end->registration_ends();
+  return key;
 }
 
 } // namespace scream
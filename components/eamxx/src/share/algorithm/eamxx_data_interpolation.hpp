@@ -9,6 +9,8 @@
 
 #include <ekat_logger.hpp>
 
+#include <functional>
+
 namespace scream
 {
 
@@ -68,6 +70,33 @@ public:
 
   void register_fields_in_remappers ();
 
+  // If true (default), the read and horiz remap of the input data is shared with all other
+  // DataInterpolation objects that read the same fields from the same files, on the same grid,
+  // and with the same horiz remap, so that each slice is read and remapped only once.
+  // Time interpolation and vertical remap are still done separately by each object.
+  // NOTE: objects sharing the data must be run at the same time stamps (or, at least, no object
+  //       can lag behind the others by more than the current data interval).
+  // Must be called before init_data_interval.
+  void set_share_data (const bool share);
+
+  // Number of DataInterpolation objects using the same read+hremap data as this one
+  int get_num_data_consumers () const { return m_hdata.use_count(); }
+
+  // Read (and horiz remap) the next data slice in the background, starting when the end of the
+  // current data interval is less than nsteps_ahead time steps away (the time step is deduced from
+  // consecutive calls to run). The slice is read on the scorpio async thread, into a third set of
+  // horiz remapper fields, so that at the interval boundary we only need to swap pointers.
+  // Requires MPI_THREAD_MULTIPLE (otherwise, it is ignored). A value of 0 disables prefetch.
+  // Must be called before init_data_interval.
+  // NOTE: any scorpio call from the main thread (e.g., output, or other readers) waits for
+  //       the pending async ops, including the prefetch read. The overlap is therefore only
+  //       with non-I/O work done on the main thread before the next scorpio call.
+  void set_prefetch (const int nsteps_ahead);
+
+  // Whether prefetch is on, and the number of data slices obtained from a prefetch so far
+  bool prefetch_enabled () const { return m_prefetch_nsteps>0; }
+  int get_num_prefetched_slices () const { return m_hdata->num_prefetched; }
+
   void init_data_interval (const util::TimeStamp& t0);
 
   void run (const util::TimeStamp& ts);
@@ -81,8 +110,19 @@ protected:
   void shift_data_interval ();
   void update_end_fields ();
 
+  // Set the src fields of the given horiz remapper in the reader, as well as the file of the slice
+  void setup_reader (const std::shared_ptr<AbstractRemapper>& hremap, const std::string& filename);
+
+  // Prefetch of the slice after the current interval end
+  void update_prefetch (const util::TimeStamp& ts);
+  void start_prefetch ();
+  void finish_prefetch ();
+
   int get_input_files_dimlen (const std::string& dimname) const;
 
+  // Uniquely identifies the read+hremap work, so it can be shared with other objects
+  std::string compute_horiz_data_key (const std::vector<Field>& hremap_tgt_fields) const;
+
   // ----------- Internal data types ---------- //
 
   struct DataSlice {
@@ -103,9 +143,40 @@ protected:
     int find_interval (const util::TimeStamp& t) const;
   };
 
+  // The state of the read+hremap stage, which may be shared by several DataInterpolation objects
+  struct HorizData {
+    ~HorizData ();
+
+    std::shared_ptr<FieldReader> reader;
+
+    // Use two horiz remappers, so we only set them up once (it may be costly)
+    std::shared_ptr<AbstractRemapper> hremap_beg;
+    std::shared_ptr<AbstractRemapper> hremap_end;
+
+    // If prefetch is on, we need a third horiz remapper, to hold the next slice
+    std::shared_ptr<AbstractRemapper> hremap_next;
+
+    util::TimeInterval    data_interval;
+    std::pair<int,int>    curr_interval_idx;
+
+    // Last time stamp successfully processed by any of the users (the data can only move forward)
+    util::TimeStamp       last_run_ts;
+
+    // Prefetch status. A negative slice idx means no prefetch is in progress
+    int                   prefetch_idx    = -1;
+    long long             prefetch_ticket = -1;
+    bool                  prefetch_ready  = false;
+    int                   num_prefetched  = 0;
+    util::TimeStamp       prev_run_ts;
+  };
+
+  // All HorizData currently in use, so that they can be shared. Like in HorizRemapperDataRepo,
+  // we store weak ptrs, so that the data is released when the last user goes away
+  static std::map<std::string,std::weak_ptr<HorizData>>& get_horiz_data_repo ();
+
   // --------------- Internal data ------------- //
 
-  std::shared_ptr<FieldReader> m_reader;
+  std::shared_ptr<HorizData> m_hdata;
 
   std::shared_ptr<const AbstractGrid> m_model_grid;
 
@@ -115,11 +186,13 @@ protected:
 
   std::vector<Field>                  m_fields;
 
-  // Use two horiz remappers, so we only set them up once (it may be costly)
-  std::shared_ptr<AbstractRemapper> m_horiz_remapper_beg;
-  std::shared_ptr<AbstractRemapper> m_horiz_remapper_end;
   std::shared_ptr<AbstractRemapper> m_vert_remapper;
 
+  // The horiz remappers are created when the fields are registered, since we may end up
+  // using the ones of another object. So store how to create one, and a string describing it.
+  std::function<std::shared_ptr<AbstractRemapper>()> m_horiz_remapper_factory;
+  std::string                                        m_horiz_remap_descr;
+
   // These are inited as the usual "ncol" and "lev" at construction, but the user
   // can reset them in case the input files store funky dimensions
   std::map<std::string,std::string>    m_input_files_dimnames;
@@ -131,14 +204,14 @@ protected:
   VRemapType            m_vr_type;
   int                   m_nfields;
 
-  util::TimeInterval    m_data_interval;
-  std::pair<int,int>    m_curr_interval_idx;
-
   TimeDatabase          m_time_database;
   TimeInterpType        m_time_interp_type;
 
   ekat::Comm            m_comm;
 
+  int                   m_prefetch_nsteps = 0;
+  bool                  m_share_data      = true;
+
   bool                  m_time_db_created   = false;
   bool                  m_data_initialized  = false;
 
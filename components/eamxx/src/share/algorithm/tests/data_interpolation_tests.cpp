@@ -53,7 +53,8 @@ void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
                 const strvec_t& input_files, util::TimeStamp t_beg,
                 const util::TimeLine timeline,
                 const DataInterpolation::TimeInterpType time_interp_type,
-                const DataInterpolation::VRemapType vr_type = DataInterpolation::None)
+                const DataInterpolation::VRemapType vr_type = DataInterpolation::None,
+                const int prefetch_nsteps = 0)
 {
   auto t_end = t_beg + t_beg.days_in_curr_month()*spd;
   auto t0 = t_beg + (t_end-t_beg)/2;
@@ -128,6 +129,9 @@ void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
   interp->setup_time_database(input_files,util::TimeLine::YearlyPeriodic,time_interp_type);
   interp->create_horiz_remappers (map_file);
   interp->create_vert_remapper (vremap_data);
+  interp->set_prefetch (prefetch_nsteps);
+  // Make sure we are not silently testing the synchronous fallback
+  REQUIRE (interp->prefetch_enabled()==(prefetch_nsteps>0));
   interp->init_data_interval(t0);
 
   // We jump ahead by 2 months, but the shift interval logic cannot keep up with
@@ -225,6 +229,11 @@ void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
       REQUIRE (frobenius_norm(diff[i]).as<Real>()<tol);
     }
   }
+
+  if (prefetch_nsteps>0) {
+    // The async read path was actually used at (some of) the interval boundaries
+    REQUIRE (interp->get_num_prefetched_slices()>0);
+  }
 }
 
 TEST_CASE ("exceptions")
@@ -320,6 +329,18 @@ TEST_CASE ("interpolation")
           run_tests (hvfine_grid,files_no_ilev,t_beg,timeline,time_interp_type,P3D);
           root_print(comm,"  interp=LINEAR, timeline=PERIODIC, horiz_remap=YES, vert_remap=p3d ......... PASS\n");
         }
+        SECTION ("prefetch") {
+          // Prefetching reads data on a separate thread, which requires MPI_THREAD_MULTIPLE
+          int thread_level;
+          MPI_Query_thread(&thread_level);
+          if (thread_level!=MPI_THREAD_MULTIPLE) {
+            WARN ("MPI_THREAD_MULTIPLE not available: skipping the prefetch test.");
+            return;
+          }
+          root_print(comm,"  interp=LINEAR, timeline=PERIODIC, horiz_remap=YES, vert_remap=p3d, prefetch=YES ..........\n");
+          run_tests (hvfine_grid,files_no_ilev,t_beg,timeline,time_interp_type,P3D,1);
+          root_print(comm,"  interp=LINEAR, timeline=PERIODIC, horiz_remap=YES, vert_remap=p3d, prefetch=YES .......... PASS\n");
+        }
       }
     }
 
@@ -492,4 +513,63 @@ TEST_CASE ("interpolation")
   scorpio::finalize_subsystem();
 }
 
+TEST_CASE ("shared_data")
+{
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  set_use_leap_year(false);
+
+  scorpio::init_subsystem(comm);
+
+  auto grid = create_point_grid("pg_h",fine_ngcols,data_nlevs,comm,1);
+  strvec_t files = {"data_interpolation_0.nc","data_interpolation_1.nc"};
+  auto t0 = reset_year(get_last_slice_time(),2019) + 5*spd;
+
+  auto setup = [&](const std::vector<Field>& fields, const bool share) {
+    auto interp = create_interp(grid,fields);
+    interp->setup_time_database(files,util::TimeLine::YearlyPeriodic);
+    interp->create_horiz_remappers(map_file_name);
+    interp->create_vert_remapper();
+    interp->set_share_data(share);
+    interp->init_data_interval(t0);
+    return interp;
+  };
+
+  auto fields1 = create_fields(grid,false);
+  auto fields2 = create_fields(grid,false);
+  auto fields3 = create_fields(grid,false);
+  for (auto* fields : {&fields1, &fields2, &fields3}) {
+    fields->pop_back(); // We don't interpolate p1d...
+  }
+
+  auto interp1 = setup(fields1,true);
+  auto interp2 = setup(fields2,true);
+  auto interp3 = setup(fields3,false);
+
+  REQUIRE (interp1->get_num_data_consumers()==2);
+  REQUIRE (interp2->get_num_data_consumers()==2);
+  REQUIRE (interp3->get_num_data_consumers()==1);
+
+  // Cross a few data intervals, and check that all objects get the same answer
+  int dt = 10*spd;
+  for (auto time = t0+dt; time.days_from(t0)<100; time+=dt) {
+    interp1->run(time);
+    interp2->run(time);
+    interp3->run(time);
+    for (size_t i=0; i<fields1.size(); ++i) {
+      REQUIRE (views_are_equal(fields1[i],fields3[i]));
+      REQUIRE (views_are_equal(fields2[i],fields3[i]));
+    }
+  }
+
+  // The data cannot move backwards, so a consumer lagging behind the interval must fail
+  REQUIRE_THROWS (interp2->run(t0));
+
+  // Once one consumer is gone, the data is still available to the other
+  interp1 = nullptr;
+  REQUIRE (interp2->get_num_data_consumers()==1);
+
+  scorpio::finalize_subsystem();
+}
+
 } // anonymous namespace
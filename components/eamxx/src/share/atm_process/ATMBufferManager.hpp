@@ -2,6 +2,7 @@
 #define SCREAM_ATM_BUFFERS_MANAGER_HPP
 
 #include "share/core/eamxx_types.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 
 #include <ekat_assert.hpp>
 
@@ -43,15 +44,47 @@ struct ATMBufferManager {
 
     m_buffer = view_1d<Real>("",m_size);
     m_allocated = true;
+    m_mem_token = MemoryTracker::instance().track(allocated_bytes(),"ATMBufferManager");
   }
 
   bool allocated () const { return m_allocated; }
 
+  // Returns a manager that exposes only the bytes [offset,offset+num_bytes) of this
+  // buffer. Used when processes that run concurrently need non-overlapping memory.
+  ATMBufferManager subview (const size_t offset, const size_t num_bytes) const {
+    EKAT_REQUIRE_MSG (m_allocated, "Error! Cannot subview a buffer before it is allocated.\n");
+    EKAT_REQUIRE_MSG (offset%alignment==0,
+        "Error! Subview offset must be a multiple of " + std::to_string(alignment) + " bytes.\n");
+    EKAT_REQUIRE_MSG (num_bytes%sizeof(Real)==0,
+        "Error! Must request number of bytes which is divisible by sizeof(Real).\n");
+    EKAT_REQUIRE_MSG (offset+num_bytes<=allocated_bytes(),
+        "Error! Subview exceeds the buffer bounds.\n"
+        "  - buffer size: " + std::to_string(allocated_bytes()) + "\n"
+        "  - subview end: " + std::to_string(offset+num_bytes) + "\n");
+
+    const size_t beg = offset/sizeof(Real);
+    const size_t end = beg + num_bytes/sizeof(Real);
+
+    ATMBufferManager sub;
+    sub.m_buffer = Kokkos::subview(m_buffer,Kokkos::make_pair(beg,end));
+    sub.m_size = end-beg;
+    sub.m_allocated = true;
+    return sub;
+  }
+
+  // Round up num_bytes so that consecutive chunks are suitably aligned for packs
+  static constexpr size_t alignment = 128;
+  static size_t align (const size_t num_bytes) {
+    return ((num_bytes + alignment - 1) / alignment) * alignment;
+  }
+
 protected:
 
   view_1d<Real> m_buffer;
   size_t        m_size;
   bool          m_allocated;
+
+  MemoryTracker::token_t  m_mem_token;
 };
 
 } // scream
@@ -3,6 +3,7 @@
 #include "share/property_checks/mass_and_energy_conservation_check.hpp"
 #include "share/field/field_utils.hpp"
 #include "share/util/eamxx_utils.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 
 #ifdef EAMXX_HAS_PYTHON
 #include "share/field/field_pyutils.hpp"
@@ -118,6 +119,17 @@ void AtmosphereProcess::set_grids (const std::shared_ptr<const GridsManager> gri
 }
 
 void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type) {
+  // Register the timers used at every step, so we don't build their names every time
+  const auto timer_root = m_timer_prefix + this->name();
+  m_timers.run                        = register_timer(timer_root + "::run");
+  m_timers.precondition_checks        = register_timer(timer_root + "::run-precondition-checks");
+  m_timers.postcondition_checks       = register_timer(timer_root + "::run-postcondition-checks");
+  m_timers.column_conservation_checks = register_timer(timer_root + "::run-column-conservation-checks");
+  m_timers.compute_tendencies         = register_timer(timer_root + "::compute_tendencies");
+
+  // Same for the owner of the memory allocated by this process
+  m_mem_owner = "atm proc: " + name();
+
   if (this->type()!=AtmosphereProcessType::Group) {
     start_timer (m_timer_prefix + this->name() + "::init");
   }
@@ -127,7 +139,11 @@ void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type)
 
   set_fields_and_groups_pointers();
   m_start_of_step_ts = m_end_of_step_ts = t0;
-  initialize_impl(run_type);
+  {
+    // Attribute memory allocated by the derived class (e.g., internal fields) to this process
+    MemoryTracker::OwnerScope owner(m_mem_owner);
+    initialize_impl(run_type);
+  }
 
   log (LogLevel::info,"  Initializing " + name() + "... done!");
   m_atm_logger->flush(); // During init, flush often (to help debug crashes)
@@ -141,7 +157,8 @@ void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type)
 
 void AtmosphereProcess::run (const double dt) {
   m_atm_logger->debug("[EAMxx::" + this->name() + "] run...");
-  start_timer (m_timer_prefix + this->name() + "::run");
+  start_timer (m_timers.run);
+  MemoryTracker::OwnerScope owner(m_mem_owner);
   if (m_params.get("enable_precondition_checks", true)) {
     // Run 'pre-condition' property checks stored in this AP
     run_precondition_checks();
@@ -210,7 +227,7 @@ void AtmosphereProcess::run (const double dt) {
     // Update all output fields time stamps
     update_time_stamps ();
   }
-  stop_timer (m_timer_prefix + this->name() + "::run");
+  stop_timer (m_timers.run);
 }
 
 void AtmosphereProcess::finalize () {
@@ -251,7 +268,6 @@ void AtmosphereProcess::setup_step_tendencies (const std::string& default_grid)
     return std::make_pair(tokens[0],tokens.size()==2 ? tokens[1] : default_grid);
   };
 
-
   for (const auto& tn : tend_vec) {
     auto tokens = field_grid(tn);
     auto fn = tokens.first;
@@ -274,6 +290,15 @@ void AtmosphereProcess::setup_step_tendencies (const std::string& default_grid)
     add_internal_field(tend,{"ACCUMULATED","DIVIDE_BY_DT"});
     m_start_of_step_fields[fn_gn] = f.clone();
   }
+
+  // Resolve all fields once, so that at runtime we can update all tendencies at once
+  m_tendency_plan = StepTendencyPlan();
+  for (const auto& [fn_gn,tend] : m_proc_tendencies) {
+    const auto tokens = ekat::split(fn_gn,"@");
+    const auto& f = get_field_out(tokens[0],tokens[1]);
+    m_tendency_plan.add_field(f,m_start_of_step_fields.at(fn_gn),tend);
+  }
+  m_tendency_plan.setup();
 }
 
 void AtmosphereProcess::set_required_field (const Field& f) {
@@ -477,78 +502,95 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
   }
 }
 
+void AtmosphereProcess::
+run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                     const std::shared_ptr<PropertyCheckBatch>& batch,
+                     const PropertyCheckCategory property_check_category) const
+{
+  if (checks.empty()) {
+    return;
+  }
+
+  // Evaluate all batchable checks at once. Checks that pass there are guaranteed
+  // to pass, so we only need to run the others (which also builds their messages)
+  batch->run();
+
+  // If a check repairs a field, later checks on that field must see the repaired
+  // values, which the batch did not, so we run those individually.
+  std::list<Field> repaired;
+  auto was_repaired = [&](const prop_check_ptr& pc) {
+    for (const auto& f : pc->fields()) {
+      for (const auto& r : repaired) {
+        if (f.is_aliasing(r) or f.name()==r.name()) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  int i = 0;
+  for (const auto& it : checks) {
+    if (not batch->passed(i++) or was_repaired(it.second)) {
+      run_property_check(it.second, it.first, property_check_category);
+      for (const auto& ptr : it.second->repairable_fields()) {
+        repaired.push_back(*ptr);
+      }
+    }
+  }
+}
+
 void AtmosphereProcess::run_precondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...");
-  start_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
+  start_timer(m_timers.precondition_checks);
   // Run all pre-condition property checks
-  for (const auto& it : m_precondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Precondition);
-  }
-  stop_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
+  run_property_checks(m_precondition_checks, m_precondition_batch,
+                      PropertyCheckCategory::Precondition);
+  stop_timer(m_timers.precondition_checks);
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...done!");
 }
 
 void AtmosphereProcess::run_postcondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...");
-  start_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
+  start_timer(m_timers.postcondition_checks);
   // Run all post-condition property checks
-  for (const auto& it : m_postcondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Postcondition);
-  }
-  stop_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
+  run_property_checks(m_postcondition_checks, m_postcondition_batch,
+                      PropertyCheckCategory::Postcondition);
+  stop_timer(m_timers.postcondition_checks);
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...done!");
 }
 
 void AtmosphereProcess::run_column_conservation_check () const {
   m_atm_logger->debug("[" + this->name() + "] run_column_conservation_check...");
-  start_timer(m_timer_prefix + this->name() + "::run-column-conservation-checks");
+  start_timer(m_timers.column_conservation_checks);
   // Conservation check is run as a postcondition check
   run_property_check(m_conservation.second,
                      m_conservation.first,
                      PropertyCheckCategory::Postcondition);
-  stop_timer(m_timer_prefix + this->name() + "::run-column-conservation-checks");
+  stop_timer(m_timers.column_conservation_checks);
   m_atm_logger->debug("[" + this->name() + "] run_column-conservation_checks...done!");
 }
 
 void AtmosphereProcess::init_step_tendencies () {
-  if (m_start_of_step_fields.size()==0) {
+  if (m_tendency_plan.num_fields()==0) {
     return;
   }
 
-  start_timer(m_timer_prefix + this->name() + "::compute_tendencies");
-  for (auto& [fn_gn,f_beg] : m_start_of_step_fields) {
-    const auto fname = ekat::split(fn_gn,"@")[0];
-    const auto gname = ekat::split(fn_gn,"@")[1];
-    const auto& f     = get_field_out(fname,gname);
-    f_beg.deep_copy(f);
-  }
-  stop_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+  start_timer(m_timers.compute_tendencies);
+  m_tendency_plan.init_step();
+  stop_timer(m_timers.compute_tendencies);
 }
 
 void AtmosphereProcess::compute_step_tendencies () {
-  if (m_start_of_step_fields.size()==0) {
+  if (m_tendency_plan.num_fields()==0) {
     return;
   }
 
   m_atm_logger->debug("[" + this->name() + "] computing tendencies...");
-  start_timer(m_timer_prefix + this->name() + "::compute_tendencies");
-  for (auto& [fn_gn,tend] : m_proc_tendencies) {
-    const auto fname = ekat::split(fn_gn,"@")[0];
-    const auto gname = ekat::split(fn_gn,"@")[1];
-    // Note: f_beg is nonconst, so we can store step tendency in it
-          auto& f_beg = m_start_of_step_fields.at(fn_gn);
-    const auto& f_end = get_field_out(fname,gname);
-
-    // Compute tend from this atm proc step, then sum into overall atm timestep tendency
-    // Note: don't add -f_beg to tend during init_step_tendencies, b/c the field magnitude
-    // may be MUCH larger than the tend. Instead, compute step tend, and THEN add into tend
-    f_beg.update(f_end,1,-1);
-    tend.update(f_beg,1,1);
-    tend.get_header().get_tracking().update_time_stamp(m_end_of_step_ts);
-  }
-  stop_timer(m_timer_prefix + this->name() + "::compute_tendencies");
+  start_timer(m_timers.compute_tendencies);
+  // Compute tend from this atm proc step, then sum into overall atm timestep tendency
+  m_tendency_plan.compute_step(m_end_of_step_ts);
+  stop_timer(m_timers.compute_tendencies);
 }
 
 bool AtmosphereProcess::has_required_field (const FieldIdentifier& id) const {
@@ -763,6 +805,10 @@ add_precondition_check (const prop_check_ptr& pc, const CheckFailHandling cfh)
         "  - Property check name: " + pc->name() + "\n");
   }
   m_precondition_checks.push_back(std::make_pair(cfh,pc));
+  if (not m_precondition_batch) {
+    m_precondition_batch = std::make_shared<PropertyCheckBatch>();
+  }
+  m_precondition_batch->add_check(pc);
 }
 
 void AtmosphereProcess::
@@ -810,6 +856,10 @@ add_postcondition_check (const prop_check_ptr& pc, const CheckFailHandling cfh)
         "  - Property check name: " + pc->name() + "\n");
   }
   m_postcondition_checks.push_back(std::make_pair(cfh,pc));
+  if (not m_postcondition_batch) {
+    m_postcondition_batch = std::make_shared<PropertyCheckBatch>();
+  }
+  m_postcondition_batch->add_check(pc);
 }
 
 void AtmosphereProcess::
@@ -3,12 +3,14 @@
 
 #include "share/atm_process/atmosphere_process_utils.hpp"
 #include "share/atm_process/ATMBufferManager.hpp"
+#include "share/atm_process/step_tendency_plan.hpp"
 #include "share/data_managers/IOPDataManager.hpp"
 #include "share/data_managers/SCDataManager.hpp"
 #include "share/data_managers/grids_manager.hpp"
 #include "share/data_managers/field_manager.hpp"
 #include "share/data_managers/field_request.hpp"
 #include "share/property_checks/property_check.hpp"
+#include "share/property_checks/property_check_batch.hpp"
 #include "share/field/field_identifier.hpp"
 #include "share/field/field.hpp"
 #include "share/field/field_group.hpp"
@@ -487,6 +489,18 @@ protected:
   // A prefix to add to this atm proc timer
   std::string m_timer_prefix;
 
+  // Ids of the timers used during the run phase (registered at initialization)
+  struct TimerIds {
+    int run                        = -1;
+    int precondition_checks        = -1;
+    int postcondition_checks       = -1;
+    int column_conservation_checks = -1;
+    int compute_tendencies         = -1;
+  } m_timers;
+
+  // Owner of the memory allocated by this atm proc (see MemoryTracker::OwnerScope)
+  std::string m_mem_owner;
+
   // The logger for the whole atmosphere
   // WARNING: this is non-const, but you should *NOT* modify its
   //          log level and/or its sinks. If you just need to log
@@ -539,6 +553,11 @@ private:
                            const CheckFailHandling     check_fail_handling,
                            const PropertyCheckCategory property_check_category) const;
 
+  // Run a list of property checks, using the batch to skip the ones that pass
+  void run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                            const std::shared_ptr<PropertyCheckBatch>& batch,
+                            const PropertyCheckCategory property_check_category) const;
+
   // NOTE: all these members are private, so that derived classes cannot
   //       bypass checks from the base class by accessing the members directly.
   //       Instead, they are forced to use access function, which include
@@ -554,6 +573,7 @@ private:
   // Data structures necessary to compute tendencies of updated fields
   strmap_t<Field>    m_proc_tendencies;
   strmap_t<Field>    m_start_of_step_fields;
+  StepTendencyPlan   m_tendency_plan;
 
   // These maps help to retrieve a field/group stored in the lists above. E.g.,
   //   auto ptr = m_field_in_pointers[field_name][grid_name];
@@ -568,6 +588,11 @@ private:
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_precondition_checks;
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_postcondition_checks;
 
+  // Evaluate all (batchable) checks in the lists above in one pass, so that
+  // only the checks that do not pass need to be run individually.
+  std::shared_ptr<PropertyCheckBatch> m_precondition_batch;
+  std::shared_ptr<PropertyCheckBatch> m_postcondition_batch;
+
   // Column local mass and energy conservation check
   std::pair<CheckFailHandling,prop_check_ptr> m_conservation;
 
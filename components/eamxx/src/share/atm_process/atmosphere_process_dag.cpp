@@ -431,10 +431,9 @@ void AtmProcDAG::cleanup () {
 void AtmProcDAG::
 add_nodes (const group_type& atm_procs)
 {
+  // NOTE: the parallel schedule of an atm proc group only overlaps procs that have
+  //       no data hazard, so the dependencies are the same as in the sequential one.
   const int num_procs = atm_procs.get_num_processes();
-  const bool sequential = (atm_procs.get_schedule_type()==ScheduleType::Sequential);
-
-  EKAT_REQUIRE_MSG (sequential, "Error! Parallel splitting dag not yet supported.\n");
 
   for (int i=0; i<num_procs; ++i) {
     const auto proc = atm_procs.get_process(i);
@@ -2,12 +2,16 @@
 #include "share/field/field_utils.hpp"
 
 #include "share/property_checks/field_nan_check.hpp"
+#include "share/util/eamxx_timing.hpp"
 
 #include <ekat_std_utils.hpp>
 #include <ekat_string_utils.hpp>
 #include <ekat_assert.hpp>
 
+#include <chrono>
+#include <exception>
 #include <memory>
+#include <thread>
 
 namespace scream {
 
@@ -25,7 +29,6 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
       m_group_schedule_type = ScheduleType::Sequential;
     } else if (m_params.get<std::string>("schedule_type") == "parallel") {
       m_group_schedule_type = ScheduleType::Parallel;
-      EKAT_ERROR_MSG("Error! Parallel schedule not yet implemented.\n");
     } else {
       EKAT_ERROR_MSG("Error! Invalid 'schedule_type'. Available choices are 'parallel' and 'sequential'.\n");
     }
@@ -34,6 +37,20 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
     m_group_schedule_type = ScheduleType::Sequential;
   }
 
+  // A non-positive value means "no limit"
+  m_max_concurrent_procs = m_params.get<int>("max_concurrent_processes",-1);
+  if (m_max_concurrent_procs<=0) {
+    m_max_concurrent_procs = m_group_size;
+  }
+
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    // Processes in the same stage run on different threads. If they issue MPI calls,
+    // we need MPI to support concurrent calls from multiple threads.
+    int thread_level;
+    MPI_Query_thread(&thread_level);
+    m_mpi_thread_multiple = thread_level==MPI_THREAD_MULTIPLE;
+  }
+
   // Create the individual atmosphere processes
   m_group_name = params.name();
 
@@ -49,22 +66,15 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
   for (const auto& ap_name : group_list) {
     // The comm to be passed to the processes construction is
     //  - the same as the comm of this APG, if num_entries=1 or sched_type=Sequential
-    //  - a sub-comm of this APG's comm otherwise
+    //  - a duplicate of this APG's comm otherwise. Processes in the same stage
+    //    run concurrently, and collectives on the same comm issued from different
+    //    threads would have no well defined ordering.
     ekat::Comm proc_comm = m_comm;
     if (m_group_schedule_type==ScheduleType::Parallel) {
-      // This is what's going to happen when we implment this:
-      //  - the processes in the group are going to be run in parallel
-      //  - each rank is assigned ONE atm process
-      //  - all the atm processes not assigned to this rank will be filled with
-      //    an instance of "RemoteProcessStub" (to be implemented),
-      //    which is a do-nothing class, only responsible to keep track of dependencies
-      //  - the input parameter list should specify for each atm process the number
-      //    of mpi ranks dedicated to it. Obviously, these numbers should add up
-      //    to the size of the input communicator.
-      //  - this class is then responsible of 'combining' the results togehter,
-      //    including remapping input/output fields to/from the sub-comm
-      //    distribution.
-      EKAT_ERROR_MSG("Error! Parallel schedule type not yet implemented.\n");
+      MPI_Comm dup;
+      MPI_Comm_dup(m_comm.mpi_comm(),&dup);
+      m_proc_comms.push_back(dup);
+      proc_comm = ekat::Comm(dup);
     }
 
     // Get the params of this atm proc
@@ -151,10 +161,11 @@ void AtmosphereProcessGroup::create_requests () {
 
   // The atm process group (APG) simply 'concatenates' required/computed
   // fields of the stored process. There is a single exception to this
-  // rule, in case of sequential splitting: if an atm proc requires a
-  // field that is computed by a previous atm proc in the group, that
-  // field is not exposed as a required field of the group.
-  const bool seq_splitting = m_group_schedule_type==ScheduleType::Sequential;
+  // rule: if an atm proc requires a field that is computed by a previous
+  // atm proc in the group, that field is not exposed as a required field
+  // of the group.
+  // NOTE: the parallel schedule preserves the data dependencies of the
+  //       sequential one, so this applies to both schedule types.
   for (auto& atm_proc : m_atm_processes) {
     atm_proc->set_grids(m_grids_manager);
 
@@ -162,13 +173,13 @@ void AtmosphereProcessGroup::create_requests () {
     for (const auto& ap_req : atm_proc->get_field_requests()) {
       bool already_computed = has_computed_field(ap_req.fid);
       auto& req = m_field_requests.emplace_back(ap_req);
-      if (seq_splitting and req.usage & Required and already_computed)
+      if (req.usage & Required and already_computed)
         req.usage = Computed;
     }
     for (const auto& ap_req : atm_proc->get_group_requests()) {
       bool already_computed = has_computed_group(ap_req.name,ap_req.grid);
       auto& req = m_group_requests.emplace_back(ap_req);
-      if (seq_splitting and req.usage & Required and already_computed)
+      if (req.usage & Required and already_computed)
         req.usage = Computed;
     }
   }
@@ -413,6 +424,16 @@ void AtmosphereProcessGroup::pre_process_tracer_requests () {
 }
 
 void AtmosphereProcessGroup::initialize_impl (const RunType run_type) {
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    // All fields/groups have been set by now, so we can analyze data hazards
+    build_parallel_stages();
+
+    if (not m_mpi_thread_multiple) {
+      m_atm_logger->warn("[EAMxx::" + name() + "] MPI was not initialized with MPI_THREAD_MULTIPLE.\n"
+                         "  Processes in the same stage of the parallel schedule will run one at a time.");
+    }
+  }
+
   for (auto& atm_proc : m_atm_processes) {
     atm_proc->initialize(start_of_step_ts(),run_type);
 #ifdef SCREAM_HAS_MEMORY_USAGE
@@ -451,8 +472,176 @@ void AtmosphereProcessGroup::run_sequential (const double dt) {
   }
 }
 
-void AtmosphereProcessGroup::run_parallel (const double /* dt */) {
-  EKAT_REQUIRE_MSG (false,"Error! Parallel splitting not yet implemented.\n");
+void AtmosphereProcessGroup::run_parallel (const double dt) {
+  using clock = std::chrono::steady_clock;
+  using secs  = std::chrono::duration<double>;
+
+  // Same as in run_sequential
+  const bool do_update = do_update_time_stamp() &&
+                      (get_subcycle_iter()==get_num_subcycles()-1);
+
+  const int num_stages = m_stages.size();
+  for (int istage=0; istage<num_stages; ++istage) {
+    const auto& stage = m_stages[istage];
+    const int num_procs = stage.size();
+
+    start_timer(m_stage_timers[istage]);
+    const auto stage_beg = clock::now();
+
+    // Run time of each proc, and exceptions thrown by it (if any)
+    std::vector<double> run_time(num_procs,0);
+    std::vector<std::exception_ptr> errors(num_procs);
+    auto run_proc = [&](const int i) {
+      try {
+        const auto beg = clock::now();
+        m_atm_processes[stage[i]]->run(dt);
+        run_time[i] = secs(clock::now()-beg).count();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    };
+
+    for (const auto& iproc : stage) {
+      m_atm_processes[iproc]->set_update_time_stamps(do_update);
+    }
+
+    if (num_procs==1 or not m_mpi_thread_multiple) {
+      for (int i=0; i<num_procs; ++i) {
+        run_proc(i);
+      }
+    } else {
+      // Run batches of at most m_max_concurrent_procs procs. The first proc of
+      // each batch runs on this thread, the others on helper threads.
+      for (int ibeg=0; ibeg<num_procs; ibeg+=m_max_concurrent_procs) {
+        const int iend = std::min(ibeg+m_max_concurrent_procs,num_procs);
+        std::vector<std::thread> helpers;
+        for (int i=ibeg+1; i<iend; ++i) {
+          helpers.emplace_back([&,i](){
+            // GPTL timers are not safe on threads that GPTL does not know about
+            enable_timers_on_this_thread(false);
+            run_proc(i);
+          });
+        }
+        run_proc(ibeg);
+        for (auto& t : helpers) {
+          t.join();
+        }
+      }
+    }
+
+    for (const auto& e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+
+    m_stage_wall_time[istage] += secs(clock::now()-stage_beg).count();
+    for (auto t : run_time) {
+      m_stage_procs_time[istage] += t;
+    }
+    stop_timer(m_stage_timers[istage]);
+  }
+}
+
+void AtmosphereProcessGroup::build_parallel_stages ()
+{
+  // Two fields alias each other if they share the allocation properties of
+  // their root field (aliased headers share the alloc props, and subfields
+  // have a parent). We use the address of said alloc props as the field key.
+  using key_t = const FieldAllocProp*;
+  auto get_key = [](const Field& f) -> key_t {
+    auto h = f.get_header_ptr();
+    while (h->get_parent()) {
+      h = h->get_parent();
+    }
+    return &h->get_alloc_properties();
+  };
+  auto add_group = [&](const FieldGroup& g, std::set<key_t>& keys) {
+    if (g.m_monolithic_field) {
+      keys.insert(get_key(*g.m_monolithic_field));
+    }
+    for (const auto& it : g.m_individual_fields) {
+      keys.insert(get_key(*it.second));
+    }
+  };
+  auto intersect = [](const std::set<key_t>& lhs, const std::set<key_t>& rhs) {
+    for (auto k : lhs) {
+      if (rhs.count(k)==1) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<std::set<key_t>> reads(m_group_size), writes(m_group_size);
+  std::vector<bool> exclusive(m_group_size);
+  for (int i=0; i<m_group_size; ++i) {
+    const auto& ap = m_atm_processes[i];
+    for (const auto& f : ap->get_fields_in()) {
+      reads[i].insert(get_key(f));
+    }
+    for (const auto& f : ap->get_fields_out()) {
+      writes[i].insert(get_key(f));
+    }
+    for (const auto& g : ap->get_groups_in()) {
+      add_group(g,reads[i]);
+    }
+    for (const auto& g : ap->get_groups_out()) {
+      add_group(g,writes[i]);
+    }
+
+    // Dynamics, conservation checks, and energy fixer look at (and may touch)
+    // more than the process declared fields, so they must run alone.
+    auto apg = std::dynamic_pointer_cast<AtmosphereProcessGroup>(ap);
+    exclusive[i] = ap->type()==AtmosphereProcessType::Dynamics or
+                   (apg ? apg->are_conservation_checks_enabled()
+                        : ap->has_column_conservation_check() or ap->has_energy_fixer());
+  }
+
+  // Each proc goes in the stage after the last stage containing a proc (that
+  // comes before it in the list) with which there is a RAW, WAR, or WAW hazard.
+  // Exclusive procs get a stage on their own, and act as a barrier.
+  m_stages.clear();
+  std::vector<int> proc_stage(m_group_size);
+  int min_stage = 0;
+  for (int i=0; i<m_group_size; ++i) {
+    int s = min_stage;
+    for (int j=0; j<i; ++j) {
+      if (intersect(reads[i],writes[j]) or
+          intersect(writes[i],reads[j]) or
+          intersect(writes[i],writes[j])) {
+        s = std::max(s,proc_stage[j]+1);
+      }
+    }
+    if (exclusive[i]) {
+      s = m_stages.size();
+    }
+    proc_stage[i] = s;
+    if (s==static_cast<int>(m_stages.size())) {
+      m_stages.emplace_back();
+    }
+    m_stages[s].push_back(i);
+    if (exclusive[i]) {
+      min_stage = s+1;
+    }
+  }
+
+  m_stage_wall_time.assign(m_stages.size(),0);
+  m_stage_procs_time.assign(m_stages.size(),0);
+
+  m_stage_timers.clear();
+  for (size_t s=0; s<m_stages.size(); ++s) {
+    m_stage_timers.push_back(register_timer(m_timer_prefix + name() + "::stage_" + std::to_string(s)));
+  }
+
+  std::string msg = "[EAMxx::" + name() + "] parallel schedule:";
+  for (size_t s=0; s<m_stages.size(); ++s) {
+    msg += "\n  - stage " + std::to_string(s) + ":";
+    for (auto i : m_stages[s]) {
+      msg += " " + m_atm_processes[i]->name();
+    }
+  }
+  m_atm_logger->info(msg);
 }
 
 void AtmosphereProcessGroup::finalize_impl (/* what inputs? */) {
@@ -465,16 +654,40 @@ void AtmosphereProcessGroup::finalize_impl (/* what inputs? */) {
     m_atm_logger->debug("[EAMxx::finalize::"+atm_proc->name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
 #endif
   }
-}
 
-void AtmosphereProcessGroup::
-set_required_field (const Field& f) {
   if (m_group_schedule_type==ScheduleType::Parallel) {
-    // In parallel splitting, all required fields are *actual* inputs,
-    // and the base class impl is fine.
-    AtmosphereProcess::set_required_field(f);
+    // Report the achieved overlap, that is, the ratio between the time it would
+    // have taken to run the procs in sequence and the time it actually took.
+    double wall = 0, procs = 0;
+    std::string msg = "[EAMxx::" + name() + "] parallel schedule overlap (sum of procs run time / stage wall time):";
+    for (size_t s=0; s<m_stages.size(); ++s) {
+      const auto ratio = m_stage_wall_time[s]>0 ? m_stage_procs_time[s]/m_stage_wall_time[s] : 1.0;
+      msg += "\n  - stage " + std::to_string(s) + ": " + std::to_string(ratio);
+      wall  += m_stage_wall_time[s];
+      procs += m_stage_procs_time[s];
+    }
+    msg += "\n  - total  : " + std::to_string(wall>0 ? procs/wall : 1.0);
+    m_atm_logger->info(msg);
+  }
+}
+
+AtmosphereProcessGroup::~AtmosphereProcessGroup ()
+{
+  // The processes store a copy of their comm, so free the duplicated comms
+  // only once the processes are gone
+  m_atm_processes.clear();
+
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (not finalized) {
+    for (auto& c : m_proc_comms) {
+      MPI_Comm_free(&c);
+    }
   }
+}
 
+void AtmosphereProcessGroup::
+set_required_field (const Field& f) {
   // Find the first process that requires this group
   const auto& fid = f.get_header().get_identifier();
   int first_proc_that_needs_f = -1;
@@ -537,12 +750,6 @@ endloop:
 
 void AtmosphereProcessGroup::
 set_required_group (const FieldGroup& group) {
-  if (m_group_schedule_type==ScheduleType::Parallel) {
-    // In parallel splitting, all required group are *actual* inputs,
-    // and the base class impl is fine.
-    AtmosphereProcess::set_required_group(group);
-  }
-
   // Find the first process that requires this group
   int first_proc_that_needs_group = -1;
   for (int iproc=0; iproc<m_group_size; ++iproc) {
@@ -667,9 +874,16 @@ void AtmosphereProcessGroup::set_computed_field_impl (const Field& f) {
 
 size_t AtmosphereProcessGroup::requested_buffer_size_in_bytes () const
 {
+  // In sequential scheduling, procs can share the same memory. In parallel scheduling,
+  // procs in the same stage cannot, so give each proc its own (aligned) chunk.
+  // NOTE: stages are not known yet, so we can't just take the max over stages.
   size_t buf_size = 0;
   for (const auto& proc : m_atm_processes) {
-    buf_size = std::max(buf_size,proc->requested_buffer_size_in_bytes());
+    if (m_group_schedule_type==ScheduleType::Sequential) {
+      buf_size = std::max(buf_size,proc->requested_buffer_size_in_bytes());
+    } else {
+      buf_size += ATMBufferManager::align(proc->requested_buffer_size_in_bytes());
+    }
   }
 
   return buf_size;
@@ -677,8 +891,15 @@ size_t AtmosphereProcessGroup::requested_buffer_size_in_bytes () const
 
 void AtmosphereProcessGroup::
 init_buffers(const ATMBufferManager& buffer_manager) {
+  size_t offset = 0;
   for (auto& atm_proc : m_atm_processes) {
-    atm_proc->init_buffers(buffer_manager);
+    if (m_group_schedule_type==ScheduleType::Sequential) {
+      atm_proc->init_buffers(buffer_manager);
+    } else {
+      const auto nbytes = ATMBufferManager::align(atm_proc->requested_buffer_size_in_bytes());
+      atm_proc->init_buffers(buffer_manager.subview(offset,nbytes));
+      offset += nbytes;
+    }
   }
 }
 
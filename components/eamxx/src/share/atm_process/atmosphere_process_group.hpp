@@ -9,6 +9,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 
 namespace scream
 {
@@ -21,9 +22,24 @@ namespace scream
  *  All the calls to setup/run methods are simply forwarded to the stored list of
  *  atm processes, and the stored list of required/computed fields is simply a
  *  concatenation of the correspong lists in the underlying atm processes.
- *  The only caveat is required fields in sequential scheduling: if an atm proc
- *  requires a field that is computed by a previous atm proc in the group,
- *  that field is not exposed as a required field of the group.
+ *  The only caveat is required fields: if an atm proc requires a field that is
+ *  computed by a previous atm proc in the group, that field is not exposed as a
+ *  required field of the group.
+ *
+ *  With parallel scheduling, the processes are split in "stages", based on the
+ *  fields/groups they read and write. Processes in the same stage have no data
+ *  hazard among them, and are run concurrently (one host thread per process).
+ *  Stages are run in order, so that the result is the same as with sequential
+ *  scheduling. Processes that need exclusive access to the model state (the
+ *  dynamics, and processes with conservation checks or energy fixer) always
+ *  get a stage on their own.
+ *  NOTE: all processes launch their kernels on the default execution space instance.
+ *        Hence, kernels of concurrent processes do not overlap: they are serialized
+ *        by the instance lock (Serial/OpenMP) or queued on the same stream (GPU).
+ *        What overlaps is the host work of the processes, as well as their MPI
+ *        communication and I/O waits (e.g., data interpolation reads).
+ *        Concurrency also requires MPI_THREAD_MULTIPLE; without it, processes in
+ *        the same stage run one at a time (see runs_procs_concurrently).
  */
 
 class AtmosphereProcessGroup : public AtmosphereProcess
@@ -34,7 +50,7 @@ public:
   // Constructor(s)
   AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& params);
 
-  virtual ~AtmosphereProcessGroup () = default;
+  virtual ~AtmosphereProcessGroup ();
 
   // The type of the block (e.g., dynamics or physics)
   AtmosphereProcessType type () const { return AtmosphereProcessType::Group; }
@@ -68,6 +84,16 @@ public:
 
   ScheduleType get_schedule_type () const { return m_group_schedule_type; }
 
+  // The stages of the parallel schedule (empty for sequential scheduling,
+  // or if the group was not yet initialized). Each stage stores the indices
+  // of the processes that are run concurrently.
+  const std::vector<std::vector<int>>& get_parallel_stages () const { return m_stages; }
+
+  // Whether processes in the same stage are actually run on different threads
+  bool runs_procs_concurrently () const {
+    return m_group_schedule_type==ScheduleType::Parallel and m_mpi_thread_multiple;
+  }
+
   // Computes total number of bytes needed for local variables
   size_t requested_buffer_size_in_bytes () const;
 
@@ -127,6 +153,9 @@ protected:
   void run_sequential (const double dt);
   void run_parallel   (const double dt);
 
+  // Split the processes in stages of mutually independent processes
+  void build_parallel_stages ();
+
   // The methods to set the fields/groups in the right processes of the group
   void set_required_field_impl (const Field& f);
   void set_computed_field_impl (const Field& f);
@@ -142,6 +171,24 @@ protected:
 
   // The schedule type: Parallel vs Sequential
   ScheduleType   m_group_schedule_type;
+
+  // Parallel schedule data: the stages, the max number of processes that can run
+  // concurrently, and whether MPI allows to run processes on multiple threads
+  std::vector<std::vector<int>>   m_stages;
+  int                             m_max_concurrent_procs;
+  bool                            m_mpi_thread_multiple = false;
+
+  // In parallel scheduling, each process gets its own duplicate of the group comm,
+  // so that collectives issued concurrently by different processes cannot mix up
+  std::vector<MPI_Comm>           m_proc_comms;
+
+  // Accumulated wall time of each stage, and accumulated sum of the run times
+  // of the processes in the stage. Their ratio is the achieved overlap.
+  std::vector<double>             m_stage_wall_time;
+  std::vector<double>             m_stage_procs_time;
+
+  // Ids of the timers of each stage
+  std::vector<int>                m_stage_timers;
 };
 
 } // namespace scream
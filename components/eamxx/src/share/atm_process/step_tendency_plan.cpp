@@ -0,0 +1,211 @@
+#include "share/atm_process/step_tendency_plan.hpp"
+#include "share/util/eamxx_universal_constants.hpp"
+
+#include <ekat_team_policy_utils.hpp>
+
+#include <algorithm>
+
+namespace scream
+{
+
+namespace {
+
+template<int N, typename ST>
+ST* get_data_and_strides (const Field& f, int* strides)
+{
+  using data_t = typename ekat::DataND<ST,N>::type;
+  auto v = f.get_strided_view<data_t>();
+  for (int i=0; i<N; ++i) {
+    strides[i] = v.stride(i);
+  }
+  return v.data();
+}
+
+template<typename ST>
+ST* get_data_and_strides (const Field& f, int* strides)
+{
+  switch (f.rank()) {
+    case 1: return get_data_and_strides<1,ST>(f,strides);
+    case 2: return get_data_and_strides<2,ST>(f,strides);
+    case 3: return get_data_and_strides<3,ST>(f,strides);
+    case 4: return get_data_and_strides<4,ST>(f,strides);
+    case 5: return get_data_and_strides<5,ST>(f,strides);
+    case 6: return get_data_and_strides<6,ST>(f,strides);
+    default:
+      EKAT_ERROR_MSG ("Error! Unsupported field rank in StepTendencyPlan.\n"
+                      "  - field name: " + f.name() + "\n"
+                      "  - field rank: " + std::to_string(f.rank()) + "\n");
+  }
+  return nullptr;
+}
+
+} // anonymous namespace
+
+void StepTendencyPlan::
+add_field (const Field& f, const Field& f_beg, const Field& tend)
+{
+  EKAT_REQUIRE_MSG (not m_setup_done,
+      "Error! Cannot add fields to StepTendencyPlan after setup.\n");
+
+  const auto& fl = f.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (f_beg.get_header().get_identifier().get_layout()==fl and
+                    tend.get_header().get_identifier().get_layout()==fl,
+      "Error! Incompatible layouts in StepTendencyPlan::add_field.\n"
+      "  - field name: " + f.name() + "\n"
+      "  - field layout: " + fl.to_string() + "\n"
+      "  - start-of-step field layout: " + f_beg.get_header().get_identifier().get_layout().to_string() + "\n"
+      "  - tendency field layout: " + tend.get_header().get_identifier().get_layout().to_string() + "\n");
+
+  const auto dt = get_data_type<Real>();
+  const bool fused = f.data_type()==dt and f_beg.data_type()==dt and tend.data_type()==dt and
+                     f.rank()>=1 and f.rank()<=6;
+  m_fields.push_back(Entry{f,f_beg,tend,fused});
+}
+
+void StepTendencyPlan::setup ()
+{
+  std::vector<WorkItem> items;
+  for (int ie=0; ie<num_fields(); ++ie) {
+    const auto& e = m_fields[ie];
+    if (not e.fused) {
+      continue;
+    }
+
+    WorkItem item;
+    item.entry = ie;
+    item.rank  = e.f.rank();
+    item.f     = get_data_and_strides<const Real>(e.f,item.f_strides);
+    item.f_beg = get_data_and_strides<Real>(e.f_beg,item.beg_strides);
+    item.tend  = get_data_and_strides<Real>(e.tend,item.tend_strides);
+
+    const auto& fl = e.f.get_header().get_identifier().get_layout();
+    for (int i=0; i<item.rank; ++i) {
+      item.extents[i] = fl.dim(i);
+    }
+
+    const int size = fl.size();
+    for (int beg=0; beg<size; beg+=s_chunk_size) {
+      item.begin = beg;
+      item.end   = std::min(beg+s_chunk_size,size);
+      items.push_back(item);
+    }
+  }
+
+  m_items = view_1d<WorkItem>("StepTendencyPlan::items",items.size());
+  auto items_h = Kokkos::create_mirror_view(m_items);
+  for (size_t i=0; i<items.size(); ++i) {
+    items_h(i) = items[i];
+  }
+  Kokkos::deep_copy(m_items,items_h);
+
+  m_fill_flags   = view_1d<int>("StepTendencyPlan::fill_flags",m_fields.size());
+  m_fill_flags_h = Kokkos::create_mirror_view(m_fill_flags);
+  for (int ie=0; ie<num_fields(); ++ie) {
+    m_fill_flags_h(ie) = -1;
+  }
+
+  m_setup_done = true;
+}
+
+void StepTendencyPlan::init_step () const
+{
+  EKAT_REQUIRE_MSG (m_setup_done,
+      "Error! StepTendencyPlan::init_step called before setup.\n");
+
+  run_fused<true>();
+  for (const auto& e : m_fields) {
+    if (not e.fused) {
+      e.f_beg.deep_copy(e.f);
+    }
+  }
+}
+
+void StepTendencyPlan::compute_step (const util::TimeStamp& ts) const
+{
+  EKAT_REQUIRE_MSG (m_setup_done,
+      "Error! StepTendencyPlan::compute_step called before setup.\n");
+
+  update_fill_flags();
+  run_fused<false>();
+  for (const auto& e : m_fields) {
+    if (not e.fused) {
+      // Note: don't add -f_beg to tend during init_step, b/c the field magnitude
+      // may be MUCH larger than the tend. Instead, compute step tend, and THEN add into tend
+      e.f_beg.update(e.f,1,-1);
+      e.tend.update(e.f_beg,1,1);
+    }
+    e.tend.get_header().get_tracking().update_time_stamp(ts);
+  }
+}
+
+void StepTendencyPlan::update_fill_flags () const
+{
+  // Only copy to device if something changed (usually, never after the first step)
+  bool changed = false;
+  for (int ie=0; ie<num_fields(); ++ie) {
+    const auto& e = m_fields[ie];
+    const int flags = (e.f.get_header().may_be_filled() ? 1 : 0) +
+                      (e.f_beg.get_header().may_be_filled() ? 2 : 0);
+    if (flags!=m_fill_flags_h(ie)) {
+      m_fill_flags_h(ie) = flags;
+      changed = true;
+    }
+  }
+  if (changed) {
+    Kokkos::deep_copy(m_fill_flags,m_fill_flags_h);
+  }
+}
+
+template<bool Init>
+void StepTendencyPlan::run_fused () const
+{
+  using TeamPolicy = Kokkos::TeamPolicy<KT::ExeSpace>;
+  using TeamMember = typename TeamPolicy::member_type;
+  using TPF        = ekat::TeamPolicyFactory<KT::ExeSpace>;
+
+  const int nitems = m_items.size();
+  if (nitems==0) {
+    return;
+  }
+
+  constexpr auto fv = constants::fill_value<Real>;
+
+  auto items = m_items;
+  auto fill_flags = m_fill_flags;
+  auto policy = TPF::get_default_team_policy(nitems,s_chunk_size);
+  const std::string name = Init ? "StepTendencyPlan::init_step" : "StepTendencyPlan::compute_step";
+  Kokkos::parallel_for(name,policy,
+      KOKKOS_LAMBDA(const TeamMember& team) {
+        const auto& item = items(team.league_rank());
+        const int flags = Init ? 0 : fill_flags(item.entry);
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team,item.begin,item.end),
+            [&](const int idx) {
+              // Unflatten the index, and compute the offsets in the (possibly strided) data
+              int f_off = 0, beg_off = 0, tend_off = 0;
+              int rem = idx;
+              for (int d=item.rank-1; d>=0; --d) {
+                const int i = rem % item.extents[d];
+                rem /= item.extents[d];
+                f_off    += i*item.f_strides[d];
+                beg_off  += i*item.beg_strides[d];
+                tend_off += i*item.tend_strides[d];
+              }
+              const Real f = item.f[f_off];
+              Real& f_beg  = item.f_beg[beg_off];
+              if constexpr (Init) {
+                f_beg = f;
+              } else {
+                // Same operations as f_beg.update(f,1,-1) and tend.update(f_beg,1,1)
+                if (not (flags & 1) or f!=fv) {
+                  f_beg *= -1;
+                  f_beg += f;
+                }
+                if (not (flags & 2) or f_beg!=fv) {
+                  item.tend[tend_off] += f_beg;
+                }
+              }
+            });
+      });
+}
+
+} // namespace scream
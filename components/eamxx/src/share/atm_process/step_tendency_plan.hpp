@@ -0,0 +1,104 @@
+#ifndef EAMXX_STEP_TENDENCY_PLAN_HPP
+#define EAMXX_STEP_TENDENCY_PLAN_HPP
+
+#include "share/field/field.hpp"
+#include "share/util/eamxx_time_stamp.hpp"
+#include "share/core/eamxx_types.hpp"
+
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * Computation of the tendencies of an atm process
+ *
+ * For each field F whose tendency is requested, the atm process stores a copy
+ * F_beg of F at the beginning of the step, and then, at the end of the step,
+ *
+ *   F_beg = F - F_beg
+ *   F_tend += F_beg
+ *
+ * Doing this one field at a time means two kernels per field (plus the lookup
+ * of F by name). This class stores the fields once, at setup, and then processes
+ * all of them with a single kernel in init_step and one in compute_step.
+ * The arithmetic (and the handling of fill values) is the same as in
+ *
+ *   F_beg.update(F,1,-1);
+ *   F_tend.update(F_beg,1,1);
+ *
+ * so results are BFB with the field-by-field approach. Fields that are not
+ * of type Real are processed one at a time, using the calls above.
+ */
+
+class StepTendencyPlan {
+public:
+  // Track the tendency of field f. The fields f_beg and tend must have the same layout as f.
+  void add_field (const Field& f, const Field& f_beg, const Field& tend);
+
+  // Create the device data structures. No more fields can be added afterwards
+  void setup ();
+
+  // Store the start-of-step values: f_beg = f
+  void init_step () const;
+
+  // Update the tendencies (f_beg = f - f_beg; tend += f_beg), and their time stamp
+  void compute_step (const util::TimeStamp& ts) const;
+
+  int num_fields () const { return m_fields.size(); }
+  bool is_setup () const { return m_setup_done; }
+
+  // A contiguous range of entries of one field, processed by one team
+  struct WorkItem {
+    const Real* f;
+    Real* f_beg;
+    Real* tend;
+    int  rank;
+    int  extents[6];
+    int  f_strides[6];
+    int  beg_strides[6];
+    int  tend_strides[6];
+    int  begin;
+    int  end;
+    int  entry;
+  };
+
+#ifndef KOKKOS_ENABLE_CUDA
+protected:
+#endif
+  template<bool Init>
+  void run_fused () const;
+
+protected:
+  using KT = KokkosTypes<DefaultDevice>;
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+
+  // Number of field entries processed by one team
+  static constexpr int s_chunk_size = 4096;
+
+  struct Entry {
+    Field f;
+    Field f_beg;
+    Field tend;
+    bool  fused;
+  };
+
+  // Whether f (resp. f_beg) may contain fill values, for each fused entry.
+  // These are read from the field headers at every step, since they may change.
+  void update_fill_flags () const;
+
+  std::vector<Entry>    m_fields;
+
+  view_1d<WorkItem>     m_items;
+
+  // Bit 0: f may be filled, bit 1: f_beg may be filled
+  view_1d<int>                          m_fill_flags;
+  view_1d<int>::host_mirror_type        m_fill_flags_h;
+
+  bool m_setup_done = false;
+};
+
+} // namespace scream
+
+#endif // EAMXX_STEP_TENDENCY_PLAN_HPP
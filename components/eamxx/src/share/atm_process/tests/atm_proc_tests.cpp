@@ -12,6 +12,8 @@
 
 #include <ekat_parameter_list.hpp>
 
+#include <thread>
+
 namespace scream {
 
 ekat::ParameterList create_test_params ()
@@ -173,12 +175,53 @@ public:
   }
 protected:
     void run_impl (const double /* dt */) {
-    auto v = get_field_out("Field A", m_grid_name).get_view<Real*,Host>();
+    auto& f = get_field_out("Field A", m_grid_name);
+    f.sync_to_host();
+    auto v = f.get_view<Real*,Host>();
+
+    for (int i=0; i<v.extent_int(0); ++i) {
+      v[i] += Real(1.0);
+    }
+    f.sync_to_dev();
+  }
+};
+
+// Like AddOne, but the name of the updated field is read from the params
+class AddOneTo : public DummyProcess
+{
+public:
+  AddOneTo (const ekat::Comm& comm,const ekat::ParameterList& params)
+   : DummyProcess(comm,params)
+  {
+    m_field_name = params.get<std::string>("field_name");
+  }
+
+  // The type of the atm proc
+  AtmosphereProcessType type () const { return AtmosphereProcessType::Physics; }
+
+  void create_requests () {
+    using namespace ekat::units;
+
+    const auto grid = m_grids_manager->get_grid(m_grid_name);
+    const auto lt = grid->get_2d_scalar_layout ();
+
+    add_field<Updated>(m_field_name,lt,K,m_grid_name);
+  }
+protected:
+    void run_impl (const double /* dt */) {
+    m_run_thread = std::this_thread::get_id();
+    auto v = get_field_out(m_field_name, m_grid_name).get_view<Real*,Host>();
 
     for (int i=0; i<v.extent_int(0); ++i) {
       v[i] += Real(1.0);
     }
   }
+
+  std::string m_field_name;
+
+public:
+  // The thread that last ran this process
+  std::thread::id m_run_thread;
 };
 
 // ================================ TESTS ============================== //
@@ -389,15 +432,124 @@ TEST_CASE ("tendency_units") {
   REQUIRE (int_fields.size() > 0);
 
   const auto expected_units = K / s;
-  bool found_tend = false;
+  Field tend;
   for (const auto& f : int_fields) {
     const auto& fid = f.get_header().get_identifier();
     if (fid.name().find("_tend") != std::string::npos) {
-      found_tend = true;
+      tend = f;
       REQUIRE (fid.get_units() == expected_units);
     }
   }
-  REQUIRE (found_tend);
+  REQUIRE (tend.is_allocated());
+
+  // AddOne adds 1 to Field A at every run, and tendencies accumulate over runs
+  ap->initialize(t0,RunType::Initial);
+  tend.deep_copy(0);
+  const int nruns = 3;
+  for (int n=1; n<=nruns; ++n) {
+    ap->run(1);
+    tend.sync_to_host();
+    auto tend_h = tend.get_view<const Real*,Host>();
+    for (int i=0; i<tend_h.extent_int(0); ++i) {
+      REQUIRE (tend_h(i)==n);
+    }
+    REQUIRE (tend.get_header().get_tracking().get_time_stamp()==t0+n);
+  }
+}
+
+TEST_CASE ("parallel_schedule") {
+  using namespace scream;
+
+  // A world comm
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // A time stamp
+  util::TimeStamp t0 ({2022,1,1},{0,0,0});
+
+  // Create a grids manager
+  const int nlcols = 3;
+  const int nlevs = 10;
+  auto grid = create_point_grid ("point_grid",nlcols*comm.size(),nlevs,comm);
+  auto gm = std::make_shared<LibraryGridsManager>(grid);
+
+  auto& factory = AtmosphereProcessFactory::instance();
+  factory.register_product("AddOneTo",&create_atmosphere_process<AddOneTo>);
+  factory.register_product("group",&create_atmosphere_process<AtmosphereProcessGroup>);
+
+  // P1 and P2 touch different fields, while P3 touches the same field as P1.
+  // Hence, P1 and P2 can run concurrently, while P3 must wait for P1.
+  using strvec_t = std::vector<std::string>;
+  ekat::ParameterList params ("ParallelGroup");
+  params.set<std::string>("schedule_type","parallel");
+  params.set<strvec_t>("atm_procs_list",{"P1","P2","P3"});
+  const strvec_t fnames = {"Field A","Field B","Field A"};
+  for (int i=0; i<3; ++i) {
+    auto& pl = params.sublist("P"+std::to_string(i+1));
+    pl.set<std::string>("type","AddOneTo");
+    pl.set<std::string>("grid_name","point_grid");
+    pl.set<std::string>("field_name",fnames[i]);
+  }
+
+  auto group = std::dynamic_pointer_cast<AtmosphereProcessGroup>(factory.create("group",comm,params));
+  REQUIRE (group->get_schedule_type()==ScheduleType::Parallel);
+  group->set_grids(gm);
+
+  std::map<std::string,Field> fields;
+  for (const auto& req : group->get_field_requests()) {
+    const auto& name = req.fid.name();
+    if (fields.count(name)==0) {
+      fields[name] = Field(req.fid);
+      fields[name].allocate_view();
+      fields[name].deep_copy(0);
+      fields[name].get_header().get_tracking().update_time_stamp(t0);
+    }
+    if (req.usage & Required)
+      group->set_required_field(fields.at(name).get_const());
+    if (req.usage & Computed)
+      group->set_computed_field(fields.at(name));
+  }
+
+  ATMBufferManager buffer_manager;
+  buffer_manager.request_bytes(group->requested_buffer_size_in_bytes());
+  buffer_manager.allocate();
+  group->init_buffers(buffer_manager);
+
+  group->initialize(t0,RunType::Initial);
+
+  const auto& stages = group->get_parallel_stages();
+  REQUIRE (stages.size()==2);
+  REQUIRE (stages[0]==std::vector<int>{0,1});
+  REQUIRE (stages[1]==std::vector<int>{2});
+
+  // The test main requests MPI_THREAD_MULTIPLE. If MPI does not provide it,
+  // the group must fall back to running the processes of a stage one at a time
+  int thread_level;
+  MPI_Query_thread(&thread_level);
+  const bool threaded = thread_level==MPI_THREAD_MULTIPLE;
+  if (not threaded) {
+    WARN ("MPI_THREAD_MULTIPLE not available: testing the serial fallback of the parallel schedule.");
+  }
+  REQUIRE (group->runs_procs_concurrently()==threaded);
+
+  group->run(1);
+
+  // The first proc of a stage runs on the calling thread, the others on helper threads
+  auto run_thread = [&](const int i) {
+    return std::dynamic_pointer_cast<const AddOneTo>(group->get_process(i))->m_run_thread;
+  };
+  REQUIRE (run_thread(0)==std::this_thread::get_id());
+  REQUIRE ((run_thread(1)!=std::this_thread::get_id())==threaded);
+  REQUIRE (run_thread(2)==std::this_thread::get_id());
+
+  // Same result as a sequential run: Field A updated twice, Field B once
+  auto vA = fields.at("Field A").get_view<const Real*,Host>();
+  auto vB = fields.at("Field B").get_view<const Real*,Host>();
+  for (int i=0; i<vA.extent_int(0); ++i) {
+    REQUIRE (vA[i]==2);
+    REQUIRE (vB[i]==1);
+  }
+
+  group->finalize();
 }
 
 } // empty namespace
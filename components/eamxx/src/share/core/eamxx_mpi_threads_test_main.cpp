@@ -0,0 +1,47 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+#include <mpi.h>
+
+#include <iostream>
+
+/*
+ * Main for unit tests exercising code that makes MPI calls from multiple threads
+ * (async I/O, data prefetch, parallel schedule of atm procs). Such code falls back
+ * to a serial/synchronous path if MPI does not provide MPI_THREAD_MULTIPLE, so,
+ * unlike the default test main, we request it. If MPI does not provide it, we
+ * still run all tests: the ones that need the threaded path should check with
+ * MPI_Query_thread, and skip their threaded checks if it is not available.
+ *
+ * To use it, add this file to the test sources, and pass EXCLUDE_MAIN_CPP to CreateUnitTest.
+ */
+
+// Defined in eamxx_test_session.cpp
+void ekat_initialize_test_session (int argc, char** argv, const bool print_config);
+void ekat_finalize_test_session ();
+
+int main (int argc, char** argv)
+{
+  int provided;
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_MULTIPLE,&provided);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  const bool am_i_root = rank==0;
+
+  if (provided!=MPI_THREAD_MULTIPLE and am_i_root) {
+    std::cerr << "WARNING: the MPI library does not provide MPI_THREAD_MULTIPLE.\n"
+                 "  Tests exercising multi-threaded MPI code will skip their threaded checks.\n";
+  }
+
+  Catch::Session session;
+  int num_failed = session.applyCommandLine(argc,argv);
+  if (num_failed==0) {
+    ekat_initialize_test_session(argc,argv,am_i_root);
+    num_failed = session.run();
+    ekat_finalize_test_session();
+  }
+
+  MPI_Finalize();
+  return num_failed!=0 ? 1 : 0;
+}
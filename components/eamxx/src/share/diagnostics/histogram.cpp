@@ -3,9 +3,35 @@
 #include <ekat_team_policy_utils.hpp>
 #include <ekat_string_utils.hpp>
 
+#include <Kokkos_ScatterView.hpp>
 
 namespace scream {
 
+namespace {
+
+// Returns the index i of the bin such that bins(i) <= val < bins(i+1),
+// or -1 if val does not fall in any bin (e.g., if it is NaN)
+template<typename BinsView>
+KOKKOS_INLINE_FUNCTION
+int find_bin (const BinsView& bins, const int num_bins, const Real val)
+{
+  // Find the first bin edge strictly larger than val
+  int lo = 0;
+  int hi = num_bins+1;
+  while (lo<hi) {
+    const int mid = (lo+hi) / 2;
+    if (bins(mid) > val) {
+      hi = mid;
+    } else {
+      lo = mid+1;
+    }
+  }
+  const int bin = lo-1;
+  return (bin>=0 and bin<num_bins) ? bin : -1;
+}
+
+} // anonymous namespace
+
 Histogram::Histogram(const ekat::Comm &comm, const ekat::ParameterList &params,
                      const std::shared_ptr<const AbstractGrid>& grid)
  : AbstractDiagnostic(comm, params, grid)
@@ -26,6 +52,13 @@ Histogram::Histogram(const ekat::Comm &comm, const ekat::ParameterList &params,
   }
   m_bin_reals.push_back(std::numeric_limits<Real>::max());
 
+  const auto algorithm = m_params.get<std::string>("algorithm","single_pass");
+  EKAT_REQUIRE_MSG (algorithm=="single_pass" or algorithm=="per_bin",
+      "Error! Invalid choice for Histogram algorithm.\n"
+      " - algorithm: " + algorithm + "\n"
+      " - valid choices: single_pass, per_bin\n");
+  m_per_bin = algorithm=="per_bin";
+
   m_field_in_names.push_back(m_field_name);
 }
 
@@ -65,6 +98,109 @@ void Histogram::initialize_impl()
 }
 
 void Histogram::compute_impl()
+{
+  if (m_per_bin) {
+    compute_per_bin();
+  } else {
+    compute_single_pass();
+  }
+
+  // TODO: use device-side MPI calls
+  // TODO: the dev ptr causes problems; revisit this later
+  // TODO: doing cuda-aware MPI allreduce would be ~10% faster
+  Kokkos::fence();
+  const auto& histogram_layout = m_diagnostic_output.get_header().get_identifier().get_layout();
+  m_diagnostic_output.sync_to_host();
+  m_comm.all_reduce(m_diagnostic_output.template get_internal_view_data<Real, Host>(),
+                      histogram_layout.size(), MPI_SUM);
+  m_diagnostic_output.sync_to_dev();
+}
+
+void Histogram::compute_single_pass()
+{
+  const auto& field = m_fields_in.at(m_field_name);
+  auto field_layout = field.get_header().get_identifier().get_layout();
+  auto histogram_layout = m_diagnostic_output.get_header().get_identifier().get_layout();
+  const int num_bins = histogram_layout.dim(0);
+
+  auto bin_values_view = m_bin_values.get_view<const Real *>();
+  auto histogram_view = m_diagnostic_output.get_view<Real *>();
+  using RangePolicy = Kokkos::RangePolicy<Field::device_t::execution_space>;
+  using cmask1d_t = Field::view_dev_t<const int*>;
+  using cmask2d_t = Field::view_dev_t<const int**>;
+  using cmask3d_t = Field::view_dev_t<const int***>;
+
+  // Each entry lands in exactly one bin, so do a single pass over the field,
+  // and scatter-add into the histogram (atomics on GPU, per-thread copies on host)
+  m_diagnostic_output.deep_copy(sp(0.0));
+  auto histogram_scatter = Kokkos::Experimental::create_scatter_view(histogram_view);
+
+  bool masked = field.has_valid_mask();
+  switch (field_layout.rank())
+  {
+    case 1: {
+      const int d1 = field_layout.dim(0);
+      auto field_view = field.get_view<const Real *>();
+      auto mask_view = masked ? field.get_valid_mask().get_view<const int*>() : cmask1d_t{};
+      Kokkos::parallel_for("compute_histogram_" + field.name(), RangePolicy(0,d1),
+          KOKKOS_LAMBDA(const int i) {
+            if (masked and mask_view(i)==0)
+              return;
+            const int bin_i = find_bin(bin_values_view,num_bins,field_view(i));
+            if (bin_i>=0) {
+              auto histogram = histogram_scatter.access();
+              histogram(bin_i) += sp(1.0);
+            }
+          });
+    } break;
+    case 2: {
+      const int d1 = field_layout.dim(0);
+      const int d2 = field_layout.dim(1);
+      auto field_view = field.get_view<const Real **>();
+      auto mask_view = masked ? field.get_valid_mask().get_view<const int**>() : cmask2d_t{};
+      Kokkos::parallel_for("compute_histogram_" + field.name(), RangePolicy(0,d1*d2),
+          KOKKOS_LAMBDA(const int ind) {
+            const int i1 = ind / d2;
+            const int i2 = ind % d2;
+            if (masked and mask_view(i1,i2)==0)
+              return;
+            const int bin_i = find_bin(bin_values_view,num_bins,field_view(i1,i2));
+            if (bin_i>=0) {
+              auto histogram = histogram_scatter.access();
+              histogram(bin_i) += sp(1.0);
+            }
+          });
+    } break;
+    case 3: {
+      const int d1 = field_layout.dim(0);
+      const int d2 = field_layout.dim(1);
+      const int d3 = field_layout.dim(2);
+      auto field_view = field.get_view<const Real ***>();
+      auto mask_view = masked ? field.get_valid_mask().get_view<const int***>() : cmask3d_t{};
+      Kokkos::parallel_for("compute_histogram_" + field.name(), RangePolicy(0,d1*d2*d3),
+          KOKKOS_LAMBDA(const int ind) {
+            const int i1 = ind / (d2*d3);
+            const int ind2 = ind % (d2*d3);
+            const int i2 = ind2 / d3;
+            const int i3 = ind2 % d3;
+            if (masked and mask_view(i1,i2,i3)==0)
+              return;
+            const int bin_i = find_bin(bin_values_view,num_bins,field_view(i1,i2,i3));
+            if (bin_i>=0) {
+              auto histogram = histogram_scatter.access();
+              histogram(bin_i) += sp(1.0);
+            }
+          });
+    } break;
+
+    default:
+      EKAT_ERROR_MSG("Error! Unsupported field rank for histogram.\n");
+  }
+
+  Kokkos::Experimental::contribute(histogram_view, histogram_scatter);
+}
+
+void Histogram::compute_per_bin()
 {
   const auto& field = m_fields_in.at(m_field_name);
   auto field_layout = field.get_header().get_identifier().get_layout();
@@ -154,15 +290,6 @@ void Histogram::compute_impl()
     default:
       EKAT_ERROR_MSG("Error! Unsupported field rank for histogram.\n");
   }
-
-  // TODO: use device-side MPI calls
-  // TODO: the dev ptr causes problems; revisit this later
-  // TODO: doing cuda-aware MPI allreduce would be ~10% faster
-  Kokkos::fence();
-  m_diagnostic_output.sync_to_host();
-  m_comm.all_reduce(m_diagnostic_output.template get_internal_view_data<Real, Host>(),
-                      histogram_layout.size(), MPI_SUM);
-  m_diagnostic_output.sync_to_dev();
 }
 
 } // namespace scream
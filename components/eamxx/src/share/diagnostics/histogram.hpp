@@ -16,6 +16,9 @@ namespace scream {
  * Notes:
  *  - we do add a bin (-inf,100) and (500,inf)  before/after the provided ones, to catch the tails.
  *  - the bins endpoints MUST be listed in strictly increasing order (we error out if they are not).
+ *  - by default, the field is traversed once, finding each entry's bin with a binary search
+ *    and scatter-adding into the histogram. Setting the parameter "algorithm" to "per_bin"
+ *    uses one reduction over the whole field per bin instead (mostly for benchmarking).
  */
 
 class Histogram : public AbstractDiagnostic {
@@ -35,9 +38,15 @@ public:
   void initialize_impl();
   void compute_impl();
 
+  void compute_single_pass ();
+  void compute_per_bin ();
+
 protected:
   std::string m_field_name;
 
+  // Whether to use one reduction per bin rather than a single pass over the field
+  bool m_per_bin;
+
   std::vector<Real> m_bin_reals;
   Field m_bin_values;
 };
@@ -0,0 +1,121 @@
+// This is a small program to benchmark the Histogram diagnostic, comparing the
+// default single-pass algorithm with the one-reduction-per-bin algorithm
+// (see the "algorithm" parameter of Histogram).
+//
+// Usage: histogram_bench [ncols [nlevs [nreps]]]
+
+#include "share/diagnostics/register_diagnostics.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/grid/point_grid.hpp"
+#include "share/core/eamxx_session.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using namespace scream;
+
+// Evenly spaced bin edges in (lb,ub), as a Histogram bin configuration string
+std::string bin_configuration (const int nbins, const Real lb, const Real ub)
+{
+  std::string config;
+  // The diag adds the two tail bins, so nbins-1 edges give nbins bins
+  for (int i=0; i<nbins-1; ++i) {
+    config += (i>0 ? "_" : "") + std::to_string(lb + (ub-lb)*i/(nbins-2));
+  }
+  return config;
+}
+
+// Time the diag computation (in seconds, averaged over nreps)
+double time_diag (AbstractDiagnostic& diag, Field& f, const util::TimeStamp& t0, const int nreps)
+{
+  double t = 0;
+  for (int rep=0; rep<nreps; ++rep) {
+    // Change the time stamp, to trigger the diag recalculation
+    const auto ts = t0 + (rep+1);
+    f.get_header().get_tracking().update_time_stamp(ts);
+    Kokkos::fence();
+    const auto start = std::chrono::steady_clock::now();
+    diag.compute(ts);
+    Kokkos::fence();
+    const auto stop = std::chrono::steady_clock::now();
+    t += std::chrono::duration<double>(stop-start).count();
+  }
+  return t / nreps;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+  using namespace ShortFieldTagsNames;
+
+  const int ncols = argc>1 ? std::stoi(argv[1]) : 2048;
+  const int nlevs = argc>2 ? std::stoi(argv[2]) : 128;
+  const int nreps = argc>3 ? std::stoi(argv[3]) : 10;
+
+  int nerr = 0;
+  MPI_Init(&argc,&argv);
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    ekat::Comm comm(MPI_COMM_WORLD);
+    util::TimeStamp t0({2024, 1, 1}, {0, 0, 0});
+
+    auto grid = create_point_grid("physics",ncols*comm.size(),nlevs,comm);
+
+    FieldIdentifier fid("T_mid", grid->get_3d_scalar_layout(LEV), ekat::units::K, grid->name());
+    Field T_mid(fid,true);
+    randomize_uniform(T_mid, 1234, 150, 350);
+    T_mid.get_header().get_tracking().update_time_stamp(t0);
+
+    register_diagnostics();
+    auto& diag_factory = DiagnosticFactory::instance();
+
+    if (comm.am_i_root()) {
+      std::cout << "Histogram benchmark: " << ncols << " cols, " << nlevs << " levs, "
+                << nreps << " reps, " << comm.size() << " ranks\n";
+      std::cout << std::setw(8)  << "bins"
+                << std::setw(16) << "per bin [ms]"
+                << std::setw(18) << "single pass [ms]"
+                << std::setw(10) << "speedup"
+                << std::setw(8)  << "same" << "\n";
+    }
+
+    for (int nbins : {4, 16, 64, 128, 256}) {
+      ekat::ParameterList params;
+      params.set("grid_name", grid->name());
+      params.set<std::string>("field_name", "T_mid");
+      params.set<std::string>("bin_configuration", bin_configuration(nbins,150,350));
+
+      params.set<std::string>("algorithm", "per_bin");
+      auto per_bin = diag_factory.create("Histogram", comm, params, grid);
+      params.set<std::string>("algorithm", "single_pass");
+      auto single_pass = diag_factory.create("Histogram", comm, params, grid);
+
+      per_bin->set_input_field(T_mid);
+      per_bin->initialize();
+      single_pass->set_input_field(T_mid);
+      single_pass->initialize();
+
+      const double t_per_bin     = time_diag(*per_bin,T_mid,t0,nreps);
+      const double t_single_pass = time_diag(*single_pass,T_mid,t0,nreps);
+      const bool same = views_are_equal(per_bin->get(),single_pass->get());
+      nerr += same ? 0 : 1;
+
+      if (comm.am_i_root()) {
+        std::cout << std::setw(8)  << nbins
+                  << std::setw(16) << std::fixed << std::setprecision(3) << 1e3*t_per_bin
+                  << std::setw(18) << 1e3*t_single_pass
+                  << std::setw(10) << std::setprecision(2) << t_per_bin/t_single_pass
+                  << std::setw(8)  << (same ? "yes" : "NO") << "\n";
+        std::cout.unsetf(std::ios::fixed);
+      }
+    }
+  }
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+
+  return nerr;
+}
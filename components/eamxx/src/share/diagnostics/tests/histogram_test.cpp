@@ -173,6 +173,46 @@ TEST_CASE("histogram") {
   diag3->compute(t0);
   auto diag3_field = diag3->get();
   REQUIRE(views_are_equal(diag3_field, diag3m_field));
+
+  // The per-bin algorithm must give the same answer as the (default) single pass one
+  params.set<std::string>("algorithm", "blah");
+  REQUIRE_THROWS(diag_factory.create("Histogram", comm,
+                                     params, grid)); // Invalid algorithm
+  params.set<std::string>("algorithm", "per_bin");
+  auto diag3p = diag_factory.create("Histogram", comm, params, grid);
+  diag3p->set_input_field(qc3);
+  diag3p->initialize();
+  diag3p->compute(t0);
+  REQUIRE(views_are_equal(diag3p->get(), diag3m_field));
+
+  // Masked entries must not be counted, with either algorithm
+  auto& qc3_mask = qc3.create_valid_mask();
+  randomize_discrete(qc3_mask, seed++, std::vector<int>{0, 1});
+  auto qc3_mask_h = qc3_mask.get_view<const int ***, Host>();
+  diag3m_field.deep_copy(sp(0.0));
+  for (int bin_i = 0; bin_i < num_bins; bin_i++) {
+    for (int i = 0; i < ncols; i++) {
+      for (int j = 0; j < dim3; j++) {
+        for (int k = 0; k < nlevs; k++) {
+          if (qc3_mask_h(i,j,k)!=0 &&
+              bin_values[bin_i] <= qc3_view_h(i,j,k) && qc3_view_h(i,j,k) < bin_values[bin_i+1])
+            diag3m_view_h(bin_i) += sp(1.0);
+        }
+      }
+    }
+  }
+  comm.all_reduce(diag3m_field.template get_internal_view_data<Real, Host>(),
+    diag3m_layout.size(), MPI_SUM);
+  diag3m_field.sync_to_dev();
+
+  for (std::string algorithm : {"single_pass", "per_bin"}) {
+    params.set<std::string>("algorithm", algorithm);
+    auto diag4 = diag_factory.create("Histogram", comm, params, grid);
+    diag4->set_input_field(qc3);
+    diag4->initialize();
+    diag4->compute(t0);
+    REQUIRE(views_are_equal(diag4->get(), diag3m_field));
+  }
 }
 
 } // namespace scream
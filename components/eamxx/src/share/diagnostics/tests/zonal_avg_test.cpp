@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "share/diagnostics/register_diagnostics.hpp"
+#include "share/diagnostics/zonal_avg.hpp"
 #include "share/physics/physics_constants.hpp"
 #include "share/field/field_utils.hpp"
 #include "share/grid/point_grid.hpp"
@@ -181,6 +182,36 @@ TEST_CASE("zonal_avg") {
   diag3->compute(t0);
   auto diag3_field = diag3->get();
   REQUIRE(views_are_equal(diag3_field, diag3m_field));
+
+  // All diags share the same engine. When qc1 and qc3 change, evaluating diag1
+  // also computes the zonal sums of qc3, so diag3 needs no extra evaluation
+  auto engine = ZonalAvgEngine::get(comm, grid, nlats);
+  const Real zavg3 = sp(3.0);
+  qc1.deep_copy(zavg2);
+  qc3.deep_copy(zavg3);
+  t0 += 1;
+  qc1.get_header().get_tracking().update_time_stamp(t0);
+  qc3.get_header().get_tracking().update_time_stamp(t0);
+  const int nbatches = engine->num_batches();
+  diag1->compute(t0);
+  REQUIRE(engine->num_batches() == nbatches + 1);
+  diag3->compute(t0);
+  REQUIRE(engine->num_batches() == nbatches + 1);
+  // qc2 did not change, so diag2 was not recomputed
+  diag2->compute(t0);
+  REQUIRE(engine->num_batches() == nbatches + 1);
+
+  diag1_field.sync_to_host();
+  diag3_field.sync_to_host();
+  auto diag3_view_host = diag3_field.get_view<const Real ***, Host>();
+  for (int nlat = 0; nlat < nlats; nlat++) {
+    REQUIRE_THAT(diag1_view_host(nlat), Catch::Matchers::WithinRel(zavg2, tol));
+    for (int j = 0; j < dim4; j++) {
+      for (int k = 0; k < nlevs; k++) {
+        REQUIRE_THAT(diag3_view_host(nlat, j, k), Catch::Matchers::WithinRel(zavg3, tol));
+      }
+    }
+  }
 }
 
 } // namespace scream
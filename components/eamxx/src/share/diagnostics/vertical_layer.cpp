@@ -1,5 +1,6 @@
 #include "vertical_layer.hpp"
 
+#include "share/field/field_workspace_arena.hpp"
 #include "share/physics/physics_constants.hpp"
 #include "share/physics/eamxx_common_physics_functions.hpp"
 #include "share/util/eamxx_column_ops.hpp"
@@ -87,12 +88,12 @@ void VerticalLayer::initialize_impl ()
   } else if (m_is_interface_layout) {
     auto fl = m_grid->get_3d_scalar_layout(LEV);
     FieldIdentifier fid ("tmp_mid",fl,none,m_grid->name());
-    m_tmp_midpoint = Field(fid,true);
+    m_tmp_midpoint = Field(fid);
     m_tmp_interface = m_diagnostic_output;
   } else {
     auto fl = m_grid->get_3d_scalar_layout(ILEV);
     FieldIdentifier fid ("tmp_int",fl,none,m_grid->name());
-    m_tmp_interface = Field(fid,true);
+    m_tmp_interface = Field(fid);
     m_tmp_midpoint = m_diagnostic_output;
   }
 }
@@ -123,9 +124,14 @@ void VerticalLayer::compute_impl()
 
   constexpr Real g = scream::physics::Constants<Real>::gravit.value;
 
-  // Alias correct view for diagnostic output and for tmp class views
-  auto tmp_mid = m_tmp_midpoint.get_view<Real**>();
-  auto tmp_int = m_tmp_interface.get_view<Real**>();
+  // Alias correct view for diagnostic output and for tmp class views.
+  // Temporaries that do not alias the output are only needed here, so use the workspace arena
+  FieldWorkspaceArena::Scope scope(ArenaLifetime::ProcessRun);
+  auto get_tmp = [&](const Field& f) {
+    return f.is_allocated() ? f : scope.get_field(f);
+  };
+  auto tmp_mid = get_tmp(m_tmp_midpoint).get_view<Real**>();
+  auto tmp_int = get_tmp(m_tmp_interface).get_view<Real**>();
 
   // Define the lambda, then dispatch the ||for
   auto lambda = KOKKOS_LAMBDA(const MemberType& team) {
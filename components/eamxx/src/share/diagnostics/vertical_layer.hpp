@@ -34,7 +34,9 @@ public:
 protected:
   void initialize_impl ();
 
-  // Temporaries to use for calculation of dz, z_int, and z_mid
+  // Temporaries to use for calculation of dz, z_int, and z_mid. If not aliasing
+  // the diagnostic output, they are not allocated, and compute_impl gets them
+  // from the workspace arena.
   Field m_tmp_interface;
   Field m_tmp_midpoint;
 
@@ -5,115 +5,369 @@
 #include <ekat_math_utils.hpp>
 #include <ekat_team_policy_utils.hpp>
 
+#include <map>
+
 namespace scream {
 
-// Utility to compute the contraction of a field along its column dimension.
-// This is equivalent to f_out = einsum('i,i...k->...k', weight, f_in).
-// The implementation is such that:
-// - all Field objects must be allocated
-// - the first dimension for field and weight and second dimension for
-//     bin_to_cols is for the columns (COL)
-// - the first dimension for result and bin_to_cols is for the zonal bins (CMP,"bin")
-// - field and result must be the same dimension, up to 3
-void compute_zonal_sum(const Field &result, const Field &field, const Field &weight,
-                       const Field &bin_to_cols, const ekat::Comm *comm)
+std::shared_ptr<ZonalAvgEngine>
+ZonalAvgEngine::get (const ekat::Comm& comm,
+                     const std::shared_ptr<const AbstractGrid>& grid,
+                     const int num_zonal_bins)
+{
+  // Engines are kept alive by the diags using them. Once all such diags
+  // are destroyed, the engine goes away, and will be rebuilt if needed.
+  using key_t = std::pair<const AbstractGrid*,int>;
+  static std::map<key_t,std::weak_ptr<ZonalAvgEngine>> engines;
+
+  auto& e = engines[key_t(grid.get(),num_zonal_bins)];
+  auto engine = e.lock();
+  if (not engine) {
+    engine = std::make_shared<ZonalAvgEngine>(comm,grid,num_zonal_bins);
+    e = engine;
+  }
+  return engine;
+}
+
+ZonalAvgEngine::
+ZonalAvgEngine (const ekat::Comm& comm,
+                const std::shared_ptr<const AbstractGrid>& grid,
+                const int num_zonal_bins)
+ : m_comm (comm)
+ , m_grid (grid)
+ , m_num_zonal_bins (num_zonal_bins)
+{
+  EKAT_REQUIRE_MSG (num_zonal_bins>0,
+      "Error! Invalid number of zonal bins.\n"
+      " - number of zonal bins: " + std::to_string(num_zonal_bins) + "\n");
+
+  using RangePolicy = Kokkos::RangePolicy<Field::device_t::execution_space>;
+  using TeamPolicy  = Kokkos::TeamPolicy<Field::device_t::execution_space>;
+  using TeamMember  = typename TeamPolicy::member_type;
+  using TPF         = ekat::TeamPolicyFactory<typename KT::ExeSpace>;
+
+  const int ncols = m_grid->get_num_local_dofs();
+  const int nbins = m_num_zonal_bins;
+  const Real lat_delta = sp(180.0) / nbins;
+
+  // Find the bin of each column directly from its latitude. Bin i contains
+  // lat_lower(i) <= lat < lat_upper(i), where the last bin is extended past 90,
+  // so that the north pole is included. Columns outside all bins get -1.
+  auto lat = m_grid->get_geometry_data("lat").get_view<const Real*>();
+  view_1d<int> col_bin ("col_bin",ncols);
+  Kokkos::parallel_for("find_zonal_bin_of_columns",RangePolicy(0,ncols),
+      KOKKOS_LAMBDA(const int icol) {
+        const Real l = lat(icol);
+        int bin = static_cast<int>(Kokkos::floor((l+sp(90.0))/lat_delta));
+        bin = bin<0 ? 0 : (bin>nbins-1 ? nbins-1 : bin);
+        // Guard against roundoff in the division: make sure l is in [lower,upper)
+        auto lower = [&](const int i) { return sp(-90.0) + i*lat_delta; };
+        auto upper = [&](const int i) { return i<nbins-1 ? lower(i)+lat_delta : sp(90.0 + 0.5*lat_delta); };
+        if (l<lower(bin) and bin>0) --bin;
+        else if (l>=upper(bin) and bin<nbins-1) ++bin;
+        col_bin(icol) = (lower(bin)<=l and l<upper(bin)) ? bin : -1;
+      });
+
+  // Counting sort of the columns by bin (stable, so cols in each bin stay sorted)
+  auto col_bin_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),col_bin);
+  m_bin_offsets = view_1d<int>("bin_offsets",nbins+1);
+  auto bin_offsets_h = Kokkos::create_mirror_view(m_bin_offsets);
+  Kokkos::deep_copy(bin_offsets_h,0);
+  for (int icol=0; icol<ncols; ++icol) {
+    if (col_bin_h(icol)>=0) {
+      ++bin_offsets_h(col_bin_h(icol)+1);
+    }
+  }
+  m_max_cols_per_bin = 0;
+  for (int ibin=0; ibin<nbins; ++ibin) {
+    m_max_cols_per_bin = std::max(m_max_cols_per_bin,bin_offsets_h(ibin+1));
+    bin_offsets_h(ibin+1) += bin_offsets_h(ibin);
+  }
+  m_bin_cols = view_1d<int>("bin_cols",bin_offsets_h(nbins));
+  auto bin_cols_h = Kokkos::create_mirror_view(m_bin_cols);
+  std::vector<int> pos (bin_offsets_h.data(),bin_offsets_h.data()+nbins);
+  for (int icol=0; icol<ncols; ++icol) {
+    if (col_bin_h(icol)>=0) {
+      bin_cols_h(pos[col_bin_h(icol)]++) = icol;
+    }
+  }
+  Kokkos::deep_copy(m_bin_offsets,bin_offsets_h);
+  Kokkos::deep_copy(m_bin_cols,bin_cols_h);
+
+  // Compute the zonal area, and the area scaled by it, to be used as weight for unmasked fields
+  m_area = m_grid->get_geometry_data("area");
+  m_scaled_area = m_area.clone("scaled_area");
+  m_scaled_area.deep_copy(0);
+
+  auto area        = m_area.get_view<const Real*>();
+  auto scaled_area = m_scaled_area.get_view<Real*>();
+  auto offsets     = m_bin_offsets;
+  auto cols        = m_bin_cols;
+  view_1d<Real> zonal_area ("zonal_area",nbins);
+  auto policy = TPF::get_default_team_policy(nbins,m_max_cols_per_bin);
+  Kokkos::parallel_for("compute_zonal_area",policy,
+      KOKKOS_LAMBDA(const TeamMember& tm) {
+        const int ibin = tm.league_rank();
+        Real sum = 0;
+        Kokkos::parallel_reduce(Kokkos::TeamVectorRange(tm,offsets(ibin),offsets(ibin+1)),
+            [&](const int j, Real& val) {
+              val += area(cols(j));
+            },sum);
+        Kokkos::single(Kokkos::PerTeam(tm),[&]{
+          zonal_area(ibin) = sum;
+        });
+      });
+  auto zonal_area_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),zonal_area);
+  m_comm.all_reduce(zonal_area_h.data(),nbins,MPI_SUM);
+  Kokkos::deep_copy(zonal_area,zonal_area_h);
+
+  Kokkos::parallel_for("scale_area_by_zonal_area",RangePolicy(0,ncols),
+      KOKKOS_LAMBDA(const int icol) {
+        const int ibin = col_bin(icol);
+        if (ibin>=0) {
+          scaled_area(icol) = area(icol) / zonal_area(ibin);
+        }
+      });
+  Kokkos::fence();
+}
+
+int ZonalAvgEngine::
+add_field (const Field& field, const Field& sum, const Field& area_sum)
+{
+  using namespace ShortFieldTagsNames;
+
+  const auto& fid = field.get_header().get_identifier();
+  const auto& fl  = fid.get_layout();
+  EKAT_REQUIRE_MSG (fl.rank()>=1 and fl.rank()<=3 and fl.tags()[0]==COL,
+      "Error! ZonalAvgEngine requires a field with layout (COL[,d1[,d2]]).\n"
+      " - field name  : " + fid.name() + "\n"
+      " - field layout: " + fl.to_string() + "\n");
+
+  const bool masked = field.has_valid_mask();
+  auto check_output = [&](const Field& f) {
+    const auto& l = f.get_header().get_identifier().get_layout();
+    EKAT_REQUIRE_MSG (l.size()==m_num_zonal_bins*fl.clone().strip_dim(0).size() and
+                      f.get_header().get_alloc_properties().contiguous(),
+        "Error! Invalid output field in ZonalAvgEngine::add_field.\n"
+        " - input field : " + fid.name() + "\n"
+        " - output field: " + f.name() + "\n"
+        " - output layout: " + l.to_string() + "\n");
+  };
+  check_output(sum);
+  if (masked) {
+    check_output(area_sum);
+  }
+
+  Entry e;
+  e.field = field;
+  e.sum = sum;
+  if (masked) {
+    e.area_sum = area_sum;
+  }
+
+  // Reuse a slot previously freed by remove_field, if any
+  for (int id=0; id<static_cast<int>(m_entries.size()); ++id) {
+    if (not m_entries[id].active) {
+      m_entries[id] = e;
+      return id;
+    }
+  }
+  m_entries.push_back(e);
+  return m_entries.size()-1;
+}
+
+void ZonalAvgEngine::remove_field (const int id)
+{
+  EKAT_REQUIRE_MSG (id>=0 and id<static_cast<int>(m_entries.size()) and m_entries[id].active,
+      "Error! Invalid entry id in ZonalAvgEngine::remove_field.\n"
+      " - id: " + std::to_string(id) + "\n");
+  m_entries[id] = Entry();
+  m_entries[id].active = false;
+}
+
+void ZonalAvgEngine::update (const int id)
+{
+  EKAT_REQUIRE_MSG (id>=0 and id<static_cast<int>(m_entries.size()) and m_entries[id].active,
+      "Error! Invalid entry id in ZonalAvgEngine::update.\n"
+      " - id: " + std::to_string(id) + "\n");
+
+  auto stale = [](const Entry& e) {
+    return not e.computed or e.field.get_header().get_tracking().get_time_stamp()!=e.last_ts;
+  };
+
+  auto& me = m_entries[id];
+  if (stale(me)) {
+    // Batch this entry with all the other ones that are stale, and whose diags
+    // consumed their last result (i.e., they are likely to be evaluated too).
+    // Entries of diags that are not evaluated regularly are left alone,
+    // so that we don't keep doing work nobody uses.
+    std::vector<int> ids;
+    for (int i=0; i<static_cast<int>(m_entries.size()); ++i) {
+      const auto& e = m_entries[i];
+      if (i==id or (e.active and e.consumed and stale(e) and
+                    e.field.get_header().get_tracking().get_time_stamp().is_valid())) {
+        ids.push_back(i);
+      }
+    }
+    compute_batch(ids);
+  }
+  me.consumed = true;
+}
+
+void ZonalAvgEngine::compute_batch (const std::vector<int>& ids)
 {
-  auto result_layout = result.get_header().get_identifier().get_layout();
-  auto bin_to_cols_layout = bin_to_cols.get_header().get_identifier().get_layout();
-  const int num_zonal_bins = bin_to_cols_layout.dim(0);
-  const int max_ncols_per_bin = bin_to_cols_layout.dim(1);
-
-  auto weight_view = weight.get_view<const Real *>();
-  auto bin_to_cols_view = bin_to_cols.get_view<const Int **>();
-  using KT         = ekat::KokkosTypes<DefaultDevice>;
+  // Assign each entry its portion of the fused buffer
+  int size = 0;
+  for (int id : ids) {
+    auto& e = m_entries[id];
+    e.offset = size;
+    size += e.sum.get_header().get_identifier().get_layout().size();
+    if (e.field.has_valid_mask()) {
+      size += e.area_sum.get_header().get_identifier().get_layout().size();
+    }
+  }
+  if (static_cast<int>(m_fused.size())<size) {
+    m_fused = view_1d<Real>("zonal_avg_fused_sums",size);
+  }
+
+  // Describe each entry of the batch, so that a single kernel can compute all local sums.
+  // Flatten non-COL dims: entry (bin,k) of the result is stored at offset+bin*K+k,
+  // which matches the row-major layout of the diag output
   using TeamPolicy = Kokkos::TeamPolicy<Field::device_t::execution_space>;
   using TeamMember = typename TeamPolicy::member_type;
   using TPF        = ekat::TeamPolicyFactory<typename KT::ExeSpace>;
-  using cmask1d_t = Field::view_dev_t<const int*>;
-  using cmask2d_t = Field::view_dev_t<const int**>;
-  using cmask3d_t = Field::view_dev_t<const int***>;
-
-  bool masked = field.has_valid_mask();
-  switch (result_layout.rank()) {
-  case 1: {
-    auto field_view        = field.get_view<const Real *>();
-    auto result_view       = result.get_view<Real *>();
-    TeamPolicy team_policy = TPF::get_default_team_policy(num_zonal_bins, max_ncols_per_bin);
-    auto mask_view = masked ? field.get_valid_mask().get_view<const int*>() : cmask1d_t{};
-    Kokkos::parallel_for(
-        "compute_zonal_sum_" + field.name(), team_policy,
-        KOKKOS_LAMBDA(const TeamMember &tm) {
-          const int bin_i = tm.league_rank();
-          Kokkos::parallel_reduce(
-              Kokkos::TeamVectorRange(tm, 1, 1+bin_to_cols_view(bin_i,0)),
-              [&](int lcol_j, Real &val) {
-                const int col_i = bin_to_cols_view(bin_i, lcol_j);
-                if (not masked or mask_view(col_i)!=0)
-                  val += weight_view(col_i) * field_view(col_i);
-              },
-              result_view(bin_i));
-        });
-  } break;
-  case 2: {
-    const int d1           = result_layout.dim(1);
-    auto field_view        = field.get_view<const Real **>();
-    auto result_view       = result.get_view<Real **>();
-    TeamPolicy team_policy = TPF::get_default_team_policy(num_zonal_bins * d1, max_ncols_per_bin);
-    auto mask_view = masked ? field.get_valid_mask().get_view<const int**>() : cmask2d_t{};
-    Kokkos::parallel_for(
-        "compute_zonal_sum_" + field.name(), team_policy,
-        KOKKOS_LAMBDA(const TeamMember &tm) {
-          const int idx        = tm.league_rank();
-          const int d1_i       = idx / num_zonal_bins;
-          const int bin_i      = idx % num_zonal_bins;
-          Kokkos::parallel_reduce(
-              Kokkos::TeamVectorRange(tm, 1, 1+bin_to_cols_view(bin_i,0)),
-              [&](int lcol_j, Real &val) {
-                const int col_i = bin_to_cols_view(bin_i, lcol_j);
-                if (not masked or mask_view(col_i,d1_i)!=0)
-                  val += weight_view(col_i) * field_view(col_i, d1_i);
-              },
-              result_view(bin_i, d1_i));
-        });
-  } break;
-  case 3: {
-    const int d1           = result_layout.dim(1);
-    const int d2           = result_layout.dim(2);
-    auto field_view        = field.get_view<const Real ***>();
-    auto result_view       = result.get_view<Real ***>();
-    TeamPolicy team_policy = TPF::get_default_team_policy(num_zonal_bins * d1 * d2, max_ncols_per_bin);
-    auto mask_view = masked ? field.get_valid_mask().get_view<const int***>() : cmask3d_t{};
-    Kokkos::parallel_for(
-        "compute_zonal_sum_" + field.name(), team_policy, KOKKOS_LAMBDA(const TeamMember &tm) {
-          const int idx        = tm.league_rank();
-          const int d1_i       = idx / (num_zonal_bins * d2);
-          const int idx2       = idx % (num_zonal_bins * d2);
-          const int d2_i       = idx2 / num_zonal_bins;
-          const int bin_i      = idx2 % num_zonal_bins;
-          Kokkos::parallel_reduce(
-              Kokkos::TeamVectorRange(tm, 1, 1+bin_to_cols_view(bin_i,0)),
-              [&](int lcol_j, Real &val) {
-                const int col_i = bin_to_cols_view(bin_i, lcol_j);
-                if (not masked or mask_view(col_i,d1_i, d2_i)!=0)
-                  val += weight_view(col_i) * field_view(col_i, d1_i, d2_i);
-              },
-              result_view(bin_i, d1_i, d2_i));
-        });
-  } break;
-  default:
-    EKAT_ERROR_MSG("Error! Unsupported field rank for zonal averages.\n");
+
+  const int nbins    = m_num_zonal_bins;
+  const int nentries = ids.size();
+  if (static_cast<int>(m_batch.size())<nentries) {
+    m_batch = view_1d<BatchEntry>("zonal_avg_batch",nentries);
   }
+  auto batch_h = Kokkos::create_mirror_view(m_batch);
+
+  // Data pointer and strides of (COL[,d1[,d2]]) field f
+  auto get_data = [](const Field& f, auto*& data, int& s0, int& s1) {
+    using T = std::remove_const_t<std::remove_reference_t<decltype(*data)>>;
+    switch (f.rank()) {
+      case 1:
+        data = f.get_view<const T*>().data();
+        s0 = 1; s1 = 0;
+        break;
+      case 2:
+      {
+        auto v = f.get_view<const T**>();
+        data = v.data();
+        s0 = v.stride(0); s1 = 1;
+        break;
+      }
+      case 3:
+      {
+        auto v = f.get_view<const T***>();
+        data = v.data();
+        s0 = v.stride(0); s1 = v.stride(1);
+        break;
+      }
+    }
+  };
+
+  int nteams = 0;
+  for (int i=0; i<nentries; ++i) {
+    const auto& e  = m_entries[ids[i]];
+    const auto& fl = e.field.get_header().get_identifier().get_layout();
+    const bool masked = e.field.has_valid_mask();
+
+    auto& b = batch_h(i);
+    get_data(e.field,b.f,b.f_s0,b.f_s1);
+    b.mask = nullptr;
+    b.m_s0 = b.m_s1 = 0;
+    if (masked) {
+      get_data(e.field.get_valid_mask(),b.mask,b.m_s0,b.m_s1);
+    }
+    b.weight = masked ? m_area.get_view<const Real*>().data() : m_scaled_area.get_view<const Real*>().data();
+    b.K  = fl.clone().strip_dim(0).size();
+    b.d2 = fl.rank()==3 ? fl.dim(2) : 1;
+    b.offset = e.offset;
+    b.first_team = nteams;
+    nteams += nbins*b.K;
+  }
+  Kokkos::deep_copy(Kokkos::subview(m_batch,Kokkos::make_pair(0,nentries)),
+                    Kokkos::subview(batch_h,Kokkos::make_pair(0,nentries)));
+
+  auto batch   = m_batch;
+  auto offsets = m_bin_offsets;
+  auto cols    = m_bin_cols;
+  auto sums    = m_fused;
+  auto policy  = TPF::get_default_team_policy(nteams,m_max_cols_per_bin);
+  Kokkos::parallel_for("compute_zonal_sums",policy,
+      KOKKOS_LAMBDA(const TeamMember& tm) {
+        // Find the entry this team works on (batches are small, so a linear search is fine)
+        const int team = tm.league_rank();
+        int ie = 0;
+        while (ie<nentries-1 and batch(ie+1).first_team<=team) {
+          ++ie;
+        }
+        const auto& b = batch(ie);
+
+        const int idx  = team - b.first_team;
+        const int ibin = idx / b.K;
+        const int k    = idx % b.K;
+        const int i1   = k / b.d2;
+        const int i2   = k % b.d2;
+        const int fk   = i1*b.f_s1 + i2;
+        const int mk   = i1*b.m_s1 + i2;
+        const bool masked = b.mask!=nullptr;
+
+        const auto beg = offsets(ibin);
+        const auto end = offsets(ibin+1);
+
+        Real sum = 0;
+        Kokkos::parallel_reduce(Kokkos::TeamVectorRange(tm,beg,end),
+            [&](const int j, Real& val) {
+              const int icol = cols(j);
+              if (not masked or b.mask[icol*b.m_s0+mk]!=0)
+                val += b.weight[icol] * b.f[icol*b.f_s0+fk];
+            },sum);
+        Real area_sum = 0;
+        if (masked) {
+          Kokkos::parallel_reduce(Kokkos::TeamVectorRange(tm,beg,end),
+              [&](const int j, Real& val) {
+                const int icol = cols(j);
+                if (b.mask[icol*b.m_s0+mk]!=0)
+                  val += b.weight[icol];
+              },area_sum);
+        }
+        Kokkos::single(Kokkos::PerTeam(tm),[&]{
+          sums(b.offset+idx) = sum;
+          if (masked)
+            sums(b.offset+nbins*b.K+idx) = area_sum;
+        });
+      });
 
-  if (comm) {
-    // TODO: use device-side MPI calls
-    // TODO: the dev ptr causes problems; revisit this later
-    // TODO: doing cuda-aware MPI allreduce would be ~10% faster
-    Kokkos::fence();
-    result.sync_to_host();
-    comm->all_reduce(result.template get_internal_view_data<Real, Host>(), result_layout.size(),
-                     MPI_SUM);
-    result.sync_to_dev();
+  // A single global reduction for all entries
+  Kokkos::fence();
+  auto fused = Kokkos::subview(m_fused,Kokkos::make_pair(0,size));
+  auto fused_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),fused);
+  m_comm.all_reduce(fused_h.data(),size,MPI_SUM);
+
+  // Unpack into the entries output fields
+  using hview_t = Kokkos::View<Real*,Kokkos::HostSpace,Kokkos::MemoryUnmanaged>;
+  auto unpack = [&](const Field& f, const int offset) {
+    const int n = f.get_header().get_identifier().get_layout().size();
+    hview_t dst (f.get_internal_view_data<Real,Host>(),n);
+    Kokkos::deep_copy(dst,Kokkos::subview(fused_h,Kokkos::make_pair(offset,offset+n)));
+    f.sync_to_dev();
+    return offset+n;
+  };
+  for (int id : ids) {
+    auto& e = m_entries[id];
+    const int offset = unpack(e.sum,e.offset);
+    if (e.field.has_valid_mask()) {
+      unpack(e.area_sum,offset);
+    }
+    e.last_ts  = e.field.get_header().get_tracking().get_time_stamp();
+    e.computed = true;
+    e.consumed = false;
   }
+
+  ++m_num_batches;
 }
 
 ZonalAvg::ZonalAvg(const ekat::Comm &comm, const ekat::ParameterList &params,
@@ -124,10 +378,13 @@ ZonalAvg::ZonalAvg(const ekat::Comm &comm, const ekat::ParameterList &params,
   m_num_zonal_bins = std::stoi(params.get<std::string>("number_of_zonal_bins"));
 
   m_field_in_names.push_back(m_field_name);
-  m_lat       = m_grid->get_geometry_data("lat");
+}
 
-  // Area will be used as weight in the zonal sum
-  m_area = grid->get_geometry_data("area");
+ZonalAvg::~ZonalAvg()
+{
+  if (m_engine) {
+    m_engine->remove_field(m_engine_id);
+  }
 }
 
 void ZonalAvg::initialize_impl()
@@ -146,130 +403,42 @@ void ZonalAvg::initialize_impl()
       " - field name  : " + field_id.name() + "\n"
       " - field layout: " + field_layout.to_string() + "\n");
 
-  FieldLayout bins_layout({CMP}, {m_num_zonal_bins}, {"bin"});
-
-  // allocate column counter
-  FieldIdentifier ncols_per_bin_id("number of columns per bin",
-      bins_layout, ekat::units::none, m_grid->name(), DataType::IntType);
-  Field ncols_per_bin(ncols_per_bin_id);
-  ncols_per_bin.allocate_view();
-  ncols_per_bin.deep_copy(0);
-
-  // count how many columns are in each zonal bin
-  using KT         = ekat::KokkosTypes<DefaultDevice>;
-  using TeamPolicy = Kokkos::TeamPolicy<Field::device_t::execution_space>;
-  using TeamMember = typename TeamPolicy::member_type;
-  using TPF        = ekat::TeamPolicyFactory<typename KT::ExeSpace>;
-  const int ncols      = field_layout.dim(COL);
-  const Real lat_delta = sp(180.0) / m_num_zonal_bins;
-  auto lat_view    = m_lat.get_view<const Real *>();
-  auto ncols_per_bin_view = ncols_per_bin.get_view<Int *>();
-  const int num_zonal_bins = m_num_zonal_bins; // for use inside lambdas
-  TeamPolicy team_policy = TPF::get_default_team_policy(m_num_zonal_bins, ncols);
-  Kokkos::parallel_for("count_columns_per_zonal_bin_" + field.name(),
-      team_policy, KOKKOS_LAMBDA(const TeamMember &tm) {
-        const int bin_i      = tm.league_rank();
-        const Real lat_lower = sp(-90.0) + bin_i * lat_delta;
-        const Real lat_upper = (bin_i < num_zonal_bins-1)
-          ? lat_lower + lat_delta : sp(90.0 + 0.5*lat_delta);
-        Kokkos::parallel_reduce(Kokkos::TeamVectorRange(tm, ncols),
-            [&](int col_i, Int &val) {
-              if ((lat_lower <= lat_view(col_i)) && (lat_view(col_i) < lat_upper))
-                val++;
-            },
-            ncols_per_bin_view(bin_i));
-      });
-
-  // determine maximum number of columns per bin & allocate bin to column map
-  using RangePolicy     = Kokkos::RangePolicy<Field::device_t::execution_space>;
-  Int max_ncols_per_bin = 0;
-  Kokkos::parallel_reduce(RangePolicy(0, m_num_zonal_bins),
-      KOKKOS_LAMBDA(int bin_i, Int &val) {
-        val = ncols_per_bin_view(bin_i) > val ? ncols_per_bin_view(bin_i) : val;
-      },
-      Kokkos::Max<Int>(max_ncols_per_bin));
-  FieldLayout bin_to_cols_layout = bins_layout.clone().append_dim(COL, 1+max_ncols_per_bin);
-  FieldIdentifier bin_to_cols_id("columns in each zonal bin",
-    bin_to_cols_layout, ekat::units::none, m_grid->name() , DataType::IntType);
-  m_bin_to_cols = Field(bin_to_cols_id);
-  m_bin_to_cols.allocate_view();
-
-  // compute bin to column map, where the (i,j)-th entry is such that
-  //   - for j=0, the entry is the number of columns in the i-th zonal bin
-  //   - for j>0, the entry is a column index in the i-th zonal bin
-  auto bin_to_cols_view = m_bin_to_cols.get_view<Int **>();
-  Kokkos::parallel_for("assign_columns_to_zonal_bins_" + field.name(),
-      RangePolicy(0, m_num_zonal_bins), KOKKOS_LAMBDA(int bin_i) {
-        const Real lat_lower = sp(-90.0) + bin_i * lat_delta;
-        const Real lat_upper = (bin_i < num_zonal_bins-1)
-          ? lat_lower + lat_delta : sp(90.0 + 0.5*lat_delta);
-        bin_to_cols_view(bin_i, 0) = 0;
-        for (int col_i=0; col_i < ncols; col_i++)
-        {
-          if ((lat_lower <= lat_view(col_i)) && (lat_view(col_i) < lat_upper))
-          {
-            bin_to_cols_view(bin_i, 0) += 1;
-            bin_to_cols_view(bin_i, bin_to_cols_view(bin_i,0)) = col_i;
-          }
-        }
-      });
-
   // Create the diagnostic
   auto diag_name = m_field_name + "_zonal_avg_" + std::to_string(m_num_zonal_bins) + "_bins";
   auto diagnostic_layout = field_layout.clone().strip_dim(COL).prepend_dim(CMP, m_num_zonal_bins, "bin");
   auto diagnostic_id = field_id.clone(diag_name).reset_layout(diagnostic_layout);
   m_diagnostic_output = Field(diagnostic_id,true);
 
-  if (not field.has_valid_mask()) {
-    m_ones = m_area.clone("ones");
-    m_ones.deep_copy(1);
-    // It's not nondimensional, but we're just using it as a scaling factor field
-    FieldIdentifier zonal_area_fid ("zonal area",bins_layout,ekat::units::none,m_grid->name());
-    m_zonal_area = Field(zonal_area_fid,true);
-    compute_zonal_sum(m_zonal_area,m_ones,m_area,m_bin_to_cols,&m_comm);
-
-    // Create a copy of area which is scaled by 1 / zonal area
-    m_scaled_area = m_area.clone("scaled_area", CloneFlags::CopyData);
-    auto zonal_area_view  = m_zonal_area.get_view<const Real *>();
-    auto scaled_area_view = m_scaled_area.get_view<Real *>();
-    Kokkos::parallel_for("scale_area_by_zonal_area_" + field.name(),
-        team_policy, KOKKOS_LAMBDA(const TeamMember &tm) {
-          const int bin_i = tm.league_rank();
-          Kokkos::parallel_for(
-            Kokkos::TeamVectorRange(tm, 1, 1+bin_to_cols_view(bin_i,0)),
-              [&](int lcol_j) {
-                const int col_i = bin_to_cols_view(bin_i, lcol_j);
-                scaled_area_view(col_i) /= zonal_area_view(bin_i);
-              });
-        });
-  } else {
-    m_ones = field.clone("ones");
-    m_ones.deep_copy(1);
-    m_ones.set_valid_mask(field.get_valid_mask());
+  // The engine writes the zonal sums here. We cannot use the diag output directly,
+  // since the engine may compute the sums before this diag is evaluated.
+  m_zonal_sum = m_diagnostic_output.clone("zonal_sum");
+  if (field.has_valid_mask()) {
     m_zonal_area = m_diagnostic_output.clone("zonal_area");
     m_diagnostic_output.create_valid_mask();
     m_diagnostic_output.get_header().set_may_be_filled(true);
   }
+
+  m_engine = ZonalAvgEngine::get(m_comm,m_grid,m_num_zonal_bins);
+  m_engine_id = m_engine->add_field(field,m_zonal_sum,m_zonal_area);
 }
 
 void ZonalAvg::compute_impl()
 {
-  const auto &field = m_fields_in.begin()->second;
-
-  if (field.has_valid_mask()) {
-    // Compute masked field zonal sum, masked area zonal sum, and divide
-    compute_zonal_sum(m_diagnostic_output, field, m_area, m_bin_to_cols, &m_comm);
-    compute_zonal_sum(m_zonal_area,m_ones,m_area,m_bin_to_cols,&m_comm);
+  // This may also compute the sums of other zonal averages on this grid
+  m_engine->update(m_engine_id);
 
+  if (m_fields_in.at(m_field_name).has_valid_mask()) {
+    // Divide masked field zonal sum by masked area zonal sum
     auto& dmask = m_diagnostic_output.get_valid_mask();
     compute_mask(m_zonal_area,0,Comparison::NE,dmask);
+    m_diagnostic_output.deep_copy(m_zonal_sum);
     m_diagnostic_output.scale_inv(m_zonal_area,dmask);
 
     // TODO: remove when IO stops relying on mask=0 entries being already set to FillValue
     m_diagnostic_output.deep_copy(constants::fill_value<Real>,dmask,true);
   } else {
-    // Compute field zonal sum using scaled area as weight
-    compute_zonal_sum(m_diagnostic_output, field, m_scaled_area, m_bin_to_cols, &m_comm);
+    // Field zonal sum was computed using scaled area as weight
+    m_diagnostic_output.deep_copy(m_zonal_sum);
   }
 }
 
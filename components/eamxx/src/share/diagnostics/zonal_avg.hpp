@@ -2,8 +2,118 @@
 #define EAMXX_ZONAL_AVERAGE_HPP
 
 #include "share/diagnostics/abstract_diagnostic.hpp"
+#include "share/util/eamxx_time_stamp.hpp"
+
+#include <memory>
+#include <vector>
 
 namespace scream {
+
+/*
+ * A helper class that computes the (area-weighted) zonal sums needed by
+ * ZonalAvg diagnostics. All ZonalAvg diagnostics defined on the same grid and
+ * with the same number of bins share one engine (see ZonalAvgEngine::get), so that
+ *   - the column->bin map and the zonal areas are computed only once,
+ *   - when one diag needs to be evaluated, all the other registered diags whose
+ *     input changed are evaluated too, and the global reduction for all of them
+ *     is done with a single MPI_Allreduce on a fused buffer.
+ * Columns are sorted by bin (CSR-like storage), so that each (bin,entry) sum
+ * is a deterministic team reduction over the columns of that bin only.
+ * The local sums of all entries of a batch are computed by a single kernel,
+ * with one team per (entry,bin,non-COL index) triplet.
+ * Results are stored in fields owned by each diag, so evaluating a diag
+ * ahead of time does not alter its output field.
+ */
+
+class ZonalAvgEngine {
+public:
+  // Get the engine for this grid and number of bins, creating it if needed
+  static std::shared_ptr<ZonalAvgEngine>
+  get (const ekat::Comm& comm,
+       const std::shared_ptr<const AbstractGrid>& grid,
+       const int num_zonal_bins);
+
+  ZonalAvgEngine (const ekat::Comm& comm,
+                  const std::shared_ptr<const AbstractGrid>& grid,
+                  const int num_zonal_bins);
+
+  // Register an input field, along with the fields where the zonal sums are stored.
+  // If the input field is masked, sum contains the zonal sum of area*field and
+  // area_sum the zonal sum of area over valid entries. Otherwise, sum contains the
+  // zonal sum of (area/zonal_area)*field, and area_sum is not used.
+  // Returns an id to be used in the other methods.
+  int add_field (const Field& field, const Field& sum, const Field& area_sum);
+
+  // Stop tracking a field (its diag is being destroyed)
+  void remove_field (const int id);
+
+  // Ensure the zonal sums of the given entry are up to date with its input field.
+  // If they are not, all stale entries are recomputed together.
+  void update (const int id);
+
+  int num_zonal_bins () const { return m_num_zonal_bins; }
+
+  // Number of batched evaluations performed so far (for testing purposes)
+  int num_batches () const { return m_num_batches; }
+
+#ifndef KOKKOS_ENABLE_CUDA
+protected:
+#endif
+  // Compute the zonal sums of the given entries, and store them in their sum fields
+  void compute_batch (const std::vector<int>& ids);
+
+protected:
+  using KT = KokkosTypes<DefaultDevice>;
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+
+  // What the fused kernel needs to know about an entry of the batch. Entry (icol,i1,i2)
+  // of the input field (and of its mask) is stored at icol*s0+i1*s1+i2.
+  struct BatchEntry {
+    const Real* f;
+    const int*  mask;       // nullptr if the field is not masked
+    const Real* weight;
+    int K, d2;              // Size of non-COL dims, and of the last one (if rank 3)
+    int f_s0, f_s1;
+    int m_s0, m_s1;
+    int offset;             // Offset of the entry in the fused buffer
+    int first_team;         // League rank of the first team working on this entry
+  };
+
+  struct Entry {
+    Field field;
+    Field sum;
+    Field area_sum;
+    int   offset = 0;            // Offset of this entry in the fused buffer
+    util::TimeStamp last_ts;     // Input field time stamp at last evaluation
+    bool  computed = false;      // Whether it was ever computed
+    bool  consumed = true;       // Whether the diag read the last result
+    bool  active   = true;
+  };
+
+  ekat::Comm                          m_comm;
+  std::shared_ptr<const AbstractGrid> m_grid;
+  int                                 m_num_zonal_bins;
+
+  // Columns sorted by bin: cols of bin i are m_bin_cols(m_bin_offsets(i):m_bin_offsets(i+1))
+  view_1d<int>  m_bin_offsets;
+  view_1d<int>  m_bin_cols;
+  int           m_max_cols_per_bin;
+
+  Field m_area;
+  Field m_scaled_area;    // area / zonal_area
+
+  std::vector<Entry> m_entries;
+
+  // Device buffer where all sums of a batch are computed before the global reduction
+  view_1d<Real> m_fused;
+
+  // Description of the entries of the current batch
+  view_1d<BatchEntry> m_batch;
+
+  int m_num_batches = 0;
+};
+
 /*
  * This diagnostic will calculate area-weighted zonal averages of a field across
  * the COL tag dimension producing an N dimensional field, where the COL tag
@@ -21,6 +131,8 @@ public:
   ZonalAvg(const ekat::Comm &comm, const ekat::ParameterList &params,
            const std::shared_ptr<const AbstractGrid> &grid);
 
+  ~ZonalAvg();
+
   // The name of the diagnostic
   std::string name() const { return "ZonalAvg"; }
 
@@ -36,18 +148,15 @@ protected:
   std::string m_field_name;
   int m_num_zonal_bins;
 
-  Field m_lat;
-  Field m_bin_to_cols;
+  // Shared with all ZonalAvg diags on the same grid with the same number of bins
+  std::shared_ptr<ZonalAvgEngine> m_engine;
+  int m_engine_id = -1;
 
-  // Weight field if input is NOT masked
-  Field m_scaled_area;
-
-  // Weight field if input IS masked
-  Field m_area;
+  // Zonal sums computed by the engine
+  Field m_zonal_sum;
 
-  // Fields used to compute masked area zonal sum at runtime if field is masked
+  // Masked area zonal sum (only used if field is masked)
   Field m_zonal_area;
-  Field m_ones;
 };
 
 } // namespace scream
@@ -1,5 +1,6 @@
 #include "share/field/field.hpp"
 #include "share/util/eamxx_utils.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 
 #include <bitset>
 
@@ -422,6 +423,25 @@ void Field::allocate_view ()
 
   m_data->d_view = decltype(m_data->d_view)(id.name(),view_dim);
   m_data->h_view = Kokkos::create_mirror_view(m_data->d_view);
+  m_data->mem_token = MemoryTracker::instance().track(view_dim);
+}
+
+void Field::allocate_view_from_buffer (char* buffer)
+{
+  EKAT_REQUIRE_MSG(!is_allocated(), "Error! View was already allocated.\n");
+  EKAT_REQUIRE_MSG(buffer!=nullptr,
+      "Error! Invalid buffer pointer.\n"
+      " - field name: " + name() + "\n");
+
+  const auto& layout = m_header->get_identifier().get_layout();
+  auto& alloc_prop   = m_header->get_alloc_properties();
+  alloc_prop.commit(layout);
+
+  // Wrap the buffer in an (unmanaged) view of the correct size.
+  // Note: the memory is accounted for by whoever owns the buffer
+  const auto view_dim = alloc_prop.get_alloc_size();
+  m_data->d_view = decltype(m_data->d_view)(buffer,view_dim);
+  m_data->h_view = Kokkos::create_mirror_view(m_data->d_view);
 }
 
 bool Field::has_valid_mask () const {
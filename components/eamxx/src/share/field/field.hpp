@@ -76,6 +76,9 @@ private:
     view_dev_t<DT,MT>   d_view;
     view_host_t<DT,MT>  h_view;
 
+    // Keeps the allocation accounted for in the MemoryTracker, until the data is released
+    std::shared_ptr<void> mem_token;
+
     template<typename Device>
     const std::enable_if_t<std::is_same_v<Device,device_t>,view_dev_t<DT,MT>>& get_view() const {
       return d_view;
@@ -287,6 +290,13 @@ public:
   void min (const Field& x) const;
   void min (const Field& x, const Field& mask) const;
 
+  // Evaluate a field expression (e.g., a*x + y/z) in a single kernel, and store it in this field.
+  // See share/field/field_expression.hpp (which must be included to use these methods).
+  template<typename Expr>
+  void assign (const Expr& e) const;
+  template<typename Expr>
+  void assign (const Expr& e, const Field& mask) const;
+
   // Returns a subview of this field, slicing at entry k along dimension idim
   // NOTES:
   //   - the output field stores *the same* 1d view as this field. In order
@@ -339,6 +349,10 @@ public:
   // Allocate the actual view
   void allocate_view ();
 
+  // Rather than allocating a view, use the given device memory, which must be at
+  // least get_alloc_size() bytes long, and must outlive this field (and its aliases).
+  void allocate_view_from_buffer (char* buffer);
+
   // Create contiguous helper field for running sync_to_host
   // and sync_to_device with non-contiguous fields
   void initialize_contiguous_helper_field () {
@@ -0,0 +1,408 @@
+#ifndef SCREAM_FIELD_EXPRESSION_HPP
+#define SCREAM_FIELD_EXPRESSION_HPP
+
+#include "share/field/field.hpp"
+#include "share/util/eamxx_universal_constants.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * Lazy arithmetic expressions of fields
+ *
+ * Chaining Field methods, like
+ *
+ *   f.deep_copy(y);
+ *   f.scale_inv(z);
+ *   f.update(x,a,b);
+ *
+ * launches one kernel per call, each making a full pass over the memory of f
+ * (and of its rhs). With the operators in this file, the same can be written as
+ *
+ *   f.assign(a*x + b*y/z);
+ *
+ * The rhs is NOT evaluated when it is built: it is simply a (compile-time) tree,
+ * which stores the fields and scalars involved. The whole tree is evaluated by
+ * Field::assign, with a single kernel, reading each operand once.
+ *
+ * Supported operations are +, -, *, / (and unary -) between fields, scalars,
+ * and other expressions, as well as expr::max(l,r) and expr::min(l,r).
+ * All fields must have data type Real, and layouts congruent to the lhs.
+ *
+ * Mask and fill value semantics are the same as in the Field::update methods:
+ *  - f.assign(e,mask) only modifies f where mask!=0 (the mask must have IntType);
+ *  - if a field operand may contain fill values (see FieldHeader::may_be_filled),
+ *    entries where that operand equals constants::fill_value are left untouched
+ *    in the lhs, as in update_fill_aware.
+ * Note: the lhs can appear in the rhs, e.g., f.assign(2*f+x), since the expression
+ * is evaluated pointwise.
+ */
+
+namespace expr {
+
+// Base class for all expression nodes (only used for type detection)
+struct ExprBase {};
+
+template<typename T>
+constexpr bool is_expr_v = std::is_base_of_v<ExprBase,T>;
+
+// Types that can appear as an operand in an expression
+template<typename T>
+constexpr bool is_operand_v = std::is_same_v<T,Field> or std::is_arithmetic_v<T> or is_expr_v<T>;
+
+// ----------------- Operations ----------------- //
+
+struct Plus {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l + r; }
+};
+struct Minus {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l - r; }
+};
+struct Times {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l * r; }
+};
+struct Divide {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l / r; }
+};
+struct Max {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l>r ? l : r; }
+};
+struct Min {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real l, const Real r) { return l<r ? l : r; }
+};
+struct Negate {
+  KOKKOS_INLINE_FUNCTION static Real apply (const Real v) { return -v; }
+};
+
+// ----------------- Leaves ----------------- //
+
+// The device counterpart of a FieldLeaf, for a field of rank N
+template<int N>
+struct BoundField : public ExprBase {
+  using view_t = Field::strided_view_dev_t<Field::data_nd_t<const Real,N>>;
+
+  template<typename... Idx>
+  KOKKOS_INLINE_FUNCTION
+  Real eval (bool& filled, Idx... indices) const {
+    const Real v = view.access(indices...);
+    if (fill_aware and v==constants::fill_value<Real>) {
+      filled = true;
+    }
+    return v;
+  }
+
+  view_t  view;
+  bool    fill_aware;
+};
+
+struct FieldLeaf : public ExprBase {
+  explicit FieldLeaf (const Field& f) : field(f) {}
+
+  void collect (std::vector<Field>& fields) const { fields.push_back(field); }
+
+  template<int N>
+  BoundField<N> bind () const {
+    BoundField<N> b;
+    b.view = field.get_strided_view<Field::data_nd_t<const Real,N>>();
+    b.fill_aware = field.get_header().may_be_filled();
+    return b;
+  }
+
+  Field field;
+};
+
+struct ScalarLeaf : public ExprBase {
+  ScalarLeaf () = default;
+  explicit ScalarLeaf (const Real s) : value(s) {}
+
+  void collect (std::vector<Field>&) const {}
+
+  template<int N>
+  ScalarLeaf bind () const { return *this; }
+
+  template<typename... Idx>
+  KOKKOS_INLINE_FUNCTION
+  Real eval (bool&, Idx...) const { return value; }
+
+  Real value;
+};
+
+// ----------------- Inner nodes ----------------- //
+
+template<typename Op, typename L, typename R>
+struct BinaryExpr : public ExprBase {
+  BinaryExpr () = default;
+  BinaryExpr (const L& l, const R& r) : lhs(l), rhs(r) {}
+
+  void collect (std::vector<Field>& fields) const {
+    lhs.collect(fields);
+    rhs.collect(fields);
+  }
+
+  template<int N>
+  auto bind () const {
+    using bound_l = decltype(lhs.template bind<N>());
+    using bound_r = decltype(rhs.template bind<N>());
+    return BinaryExpr<Op,bound_l,bound_r>(lhs.template bind<N>(),rhs.template bind<N>());
+  }
+
+  template<typename... Idx>
+  KOKKOS_INLINE_FUNCTION
+  Real eval (bool& filled, Idx... indices) const {
+    return Op::apply(lhs.eval(filled,indices...),rhs.eval(filled,indices...));
+  }
+
+  L lhs;
+  R rhs;
+};
+
+template<typename Op, typename E>
+struct UnaryExpr : public ExprBase {
+  UnaryExpr () = default;
+  explicit UnaryExpr (const E& e) : arg(e) {}
+
+  void collect (std::vector<Field>& fields) const { arg.collect(fields); }
+
+  template<int N>
+  auto bind () const {
+    using bound_e = decltype(arg.template bind<N>());
+    return UnaryExpr<Op,bound_e>(arg.template bind<N>());
+  }
+
+  template<typename... Idx>
+  KOKKOS_INLINE_FUNCTION
+  Real eval (bool& filled, Idx... indices) const {
+    return Op::apply(arg.eval(filled,indices...));
+  }
+
+  E arg;
+};
+
+// ----------------- Expression builders ----------------- //
+
+// Wrap an operand into an expression node
+inline FieldLeaf as_expr (const Field& f) { return FieldLeaf(f); }
+
+template<typename T>
+std::enable_if_t<std::is_arithmetic_v<T>,ScalarLeaf>
+as_expr (const T s) { return ScalarLeaf(static_cast<Real>(s)); }
+
+template<typename E>
+std::enable_if_t<is_expr_v<E>,const E&>
+as_expr (const E& e) { return e; }
+
+template<typename T>
+using expr_t = std::decay_t<decltype(as_expr(std::declval<const T&>()))>;
+
+// At least one of the operands must be a field or an expression
+template<typename L, typename R>
+using enable_if_operands_t =
+  std::enable_if_t<is_operand_v<L> and is_operand_v<R> and
+                   not (std::is_arithmetic_v<L> and std::is_arithmetic_v<R>),int>;
+
+template<typename Op, typename L, typename R>
+BinaryExpr<Op,expr_t<L>,expr_t<R>>
+make_binary (const L& l, const R& r) {
+  return BinaryExpr<Op,expr_t<L>,expr_t<R>>(as_expr(l),as_expr(r));
+}
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto operator+ (const L& l, const R& r) { return make_binary<Plus>(l,r); }
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto operator- (const L& l, const R& r) { return make_binary<Minus>(l,r); }
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto operator* (const L& l, const R& r) { return make_binary<Times>(l,r); }
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto operator/ (const L& l, const R& r) { return make_binary<Divide>(l,r); }
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto max (const L& l, const R& r) { return make_binary<Max>(l,r); }
+
+template<typename L, typename R, enable_if_operands_t<L,R> = 0>
+auto min (const L& l, const R& r) { return make_binary<Min>(l,r); }
+
+template<typename E, std::enable_if_t<std::is_same_v<E,Field> or is_expr_v<E>,int> = 0>
+auto operator- (const E& e) { return UnaryExpr<Negate,expr_t<E>>(as_expr(e)); }
+
+} // namespace expr
+
+// Make the operators visible for expressions whose operands are all Field objects,
+// since ADL would only look for them in namespace scream.
+using expr::operator+;
+using expr::operator-;
+using expr::operator*;
+using expr::operator/;
+
+namespace details {
+
+template<int N, typename Expr, bool Masked>
+struct AssignExprHelper {
+
+  using exec_space = typename Field::kt_dev::ExeSpace;
+
+  using lhs_view_t  = Field::strided_view_dev_t<Field::data_nd_t<Real,N>>;
+  using mask_view_t = Field::strided_view_dev_t<Field::data_nd_t<const int,N>>;
+
+  template<int M>
+  using MDRange = Kokkos::MDRangePolicy<
+                    exec_space,
+                    Kokkos::Rank<M,Kokkos::Iterate::Right,Kokkos::Iterate::Right>
+                  >;
+
+  void run (const std::vector<int>& dims) const {
+    if constexpr (N==0) {
+      Kokkos::RangePolicy<exec_space> policy(0,1);
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==1) {
+      Kokkos::RangePolicy<exec_space> policy(0,dims[0]);
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==2) {
+      MDRange<2> policy({0,0},{dims[0],dims[1]});
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==3) {
+      MDRange<3> policy({0,0,0},{dims[0],dims[1],dims[2]});
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==4) {
+      MDRange<4> policy({0,0,0,0},{dims[0],dims[1],dims[2],dims[3]});
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==5) {
+      MDRange<5> policy({0,0,0,0,0},{dims[0],dims[1],dims[2],dims[3],dims[4]});
+      Kokkos::parallel_for(policy,*this);
+    } else if constexpr (N==6) {
+      MDRange<6> policy({0,0,0,0,0,0},{dims[0],dims[1],dims[2],dims[3],dims[4],dims[5]});
+      Kokkos::parallel_for(policy,*this);
+    } else {
+      EKAT_ERROR_MSG ("Unsupported rank! Should be in [0,6].\n");
+    }
+  }
+
+  template<typename... Args>
+  KOKKOS_INLINE_FUNCTION
+  void operator() (Args... indices) const {
+    if constexpr (Masked) {
+      if (mask.access(indices...)==0)
+        return;
+    }
+    bool filled = false;
+    const Real v = expr.eval(filled,indices...);
+    if (not filled)
+      lhs.access(indices...) = v;
+  }
+
+  lhs_view_t  lhs;
+  mask_view_t mask;
+  Expr        expr;
+};
+
+template<int N, bool Masked, typename Expr>
+void assign_expr (const Field& lhs, const Expr& e, const Field* mask)
+{
+  using bound_t = decltype(e.template bind<N>());
+  using lhs_dt  = Field::data_nd_t<Real,N>;
+  using mask_dt = Field::data_nd_t<const int,N>;
+
+  AssignExprHelper<N,bound_t,Masked> helper;
+  helper.lhs  = lhs.get_strided_view<lhs_dt>();
+  helper.expr = e.template bind<N>();
+  if constexpr (Masked) {
+    helper.mask = mask->get_strided_view<mask_dt>();
+  }
+  helper.run(lhs.get_header().get_identifier().get_layout().dims());
+}
+
+template<bool Masked, typename Expr>
+void assign_impl (const std::string& caller, const Field& lhs, const Expr& e, const Field* mask)
+{
+  const auto& l = lhs.get_header().get_identifier().get_layout();
+
+  EKAT_REQUIRE_MSG (not lhs.is_read_only(),
+      "[" + caller + "] Error! Cannot modify field, as it is read-only.\n"
+      " - field name: " + lhs.name() + "\n");
+  EKAT_REQUIRE_MSG (lhs.is_allocated(),
+      "[" + caller + "] Error! Lhs field is not yet allocated.\n"
+      " - field name: " + lhs.name() + "\n");
+  EKAT_REQUIRE_MSG (lhs.data_type()==get_data_type<Real>(),
+      "[" + caller + "] Error! Field expressions only support Real fields.\n"
+      " - lhs name: " + lhs.name() + "\n"
+      " - lhs data type: " + e2str(lhs.data_type()) + "\n");
+
+  std::vector<Field> operands;
+  e.collect(operands);
+  for (const auto& f : operands) {
+    EKAT_REQUIRE_MSG (f.is_allocated(),
+        "[" + caller + "] Error! Rhs field is not yet allocated.\n"
+        " - field name: " + f.name() + "\n");
+    EKAT_REQUIRE_MSG (f.data_type()==get_data_type<Real>(),
+        "[" + caller + "] Error! Field expressions only support Real fields.\n"
+        " - lhs name: " + lhs.name() + "\n"
+        " - rhs name: " + f.name() + "\n"
+        " - rhs data type: " + e2str(f.data_type()) + "\n");
+    const auto& f_l = f.get_header().get_identifier().get_layout();
+    EKAT_REQUIRE_MSG (l.congruent(f_l),
+        "[" + caller + "] Error! Incompatible fields layouts.\n"
+        " - rhs name: " + f.name() + "\n"
+        " - lhs name: " + lhs.name() + "\n"
+        " - rhs layout: " + f_l.to_string() + "\n"
+        " - lhs layout: " + l.to_string() + "\n");
+  }
+
+  if constexpr (Masked) {
+    EKAT_REQUIRE_MSG (mask->is_allocated(),
+        "[" + caller + "] Error! Mask field was not yet allocated.\n"
+        " - mask name: " + mask->name() + "\n");
+    EKAT_REQUIRE_MSG (mask->data_type()==DataType::IntType,
+        "[" + caller + "] Error! Mask data type MUST be IntType.\n"
+        " - mask name: " + mask->name() + "\n"
+        " - mask data type: " + e2str(mask->data_type()) + "\n");
+    const auto& m_l = mask->get_header().get_identifier().get_layout();
+    EKAT_REQUIRE_MSG (l.congruent(m_l),
+        "[" + caller + "] Error! Incompatible mask layout.\n"
+        " - lhs name: " + lhs.name() + "\n"
+        " - mask name: " + mask->name() + "\n"
+        " - lhs layout: " + l.to_string() + "\n"
+        " - mask layout: " + m_l.to_string() + "\n");
+  }
+
+  switch (l.rank()) {
+    case 0: assign_expr<0,Masked>(lhs,e,mask); break;
+    case 1: assign_expr<1,Masked>(lhs,e,mask); break;
+    case 2: assign_expr<2,Masked>(lhs,e,mask); break;
+    case 3: assign_expr<3,Masked>(lhs,e,mask); break;
+    case 4: assign_expr<4,Masked>(lhs,e,mask); break;
+    case 5: assign_expr<5,Masked>(lhs,e,mask); break;
+    case 6: assign_expr<6,Masked>(lhs,e,mask); break;
+    default:
+      EKAT_ERROR_MSG ("[" + caller + "] Error! Rank not supported.\n"
+          " - lhs name: " + lhs.name() + "\n"
+          " - lhs rank: " + std::to_string(l.rank()) + "\n");
+  }
+  Kokkos::fence();
+}
+
+} // namespace details
+
+template<typename Expr>
+void Field::assign (const Expr& e) const
+{
+  static_assert (expr::is_operand_v<Expr>,
+      "Error! Field::assign requires a field, a scalar, or a field expression.\n");
+  details::assign_impl<false>("Field::assign",*this,expr::as_expr(e),nullptr);
+}
+
+template<typename Expr>
+void Field::assign (const Expr& e, const Field& mask) const
+{
+  static_assert (expr::is_operand_v<Expr>,
+      "Error! Field::assign requires a field, a scalar, or a field expression.\n");
+  details::assign_impl<true>("Field::assign (masked)",*this,expr::as_expr(e),&mask);
+}
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_EXPRESSION_HPP
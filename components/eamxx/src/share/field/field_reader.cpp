@@ -73,28 +73,65 @@ void FieldReader::read (const int time_index)
     setup_internals ();
 
   for (const auto& [f, f_io] : ekat::zip(m_fields,m_io_fields)) {
-    switch (f_io.data_type()) {
-      case DataType::DoubleType:
-        scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<double,Host>(),time_index);
-        break;
-      case DataType::FloatType:
-        scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<float,Host>(),time_index);
-        break;
-      case DataType::IntType:
-        scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<int,Host>(),time_index);
-        break;
-      default:
-        EKAT_ERROR_MSG (
-            "Error! Unsupported/unrecognized data type while reading field from file.\n"
-            " - file name : " + m_filename + "\n"
-            " - field name: " + f.name() + "\n");
-    }
+    read_var_to_host(f,f_io,time_index);
 
     f_io.sync_to_dev();
     f.deep_copy(f_io); // If f_io is aliasing f, this is a no-op
   }
 }
 
+void FieldReader::prepare_read ()
+{
+  // Since all vars are read before syncing to device, io fields cannot be shared
+  if (not m_distinct_io_fields) {
+    m_distinct_io_fields = true;
+    m_reader_state |= NEW_FIELDS;
+  }
+
+  if (m_reader_state!=CLEAN)
+    setup_internals ();
+}
+
+void FieldReader::read_to_host (const int time_index)
+{
+  EKAT_REQUIRE_MSG (m_reader_state==CLEAN and m_distinct_io_fields,
+      "[FieldReader::read_to_host] Error! Reader internals are not setup. Call prepare_read first.\n"
+      " - file name: " + m_filename + "\n");
+
+  for (const auto& [f, f_io] : ekat::zip(m_fields,m_io_fields)) {
+    read_var_to_host(f,f_io,time_index);
+  }
+}
+
+void FieldReader::sync_to_device ()
+{
+  for (const auto& [f, f_io] : ekat::zip(m_fields,m_io_fields)) {
+    f_io.sync_to_dev();
+    f.deep_copy(f_io); // If f_io is aliasing f, this is a no-op
+  }
+}
+
+void FieldReader::
+read_var_to_host (const Field& f, const Field& f_io, const int time_index)
+{
+  switch (f_io.data_type()) {
+    case DataType::DoubleType:
+      scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<double,Host>(),time_index);
+      break;
+    case DataType::FloatType:
+      scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<float,Host>(),time_index);
+      break;
+    case DataType::IntType:
+      scorpio::read_var(m_filename,f.name(),f_io.get_internal_view_data<int,Host>(),time_index);
+      break;
+    default:
+      EKAT_ERROR_MSG (
+          "Error! Unsupported/unrecognized data type while reading field from file.\n"
+          " - file name : " + m_filename + "\n"
+          " - field name: " + f.name() + "\n");
+  }
+}
+
 void FieldReader::clean_up ()
 {
   if (m_filename!="")
@@ -251,6 +288,9 @@ void FieldReader::setup_internals ()
       const auto& fid    = fh.get_identifier();
       const auto& layout = fid.get_layout();
       auto key = e2str(fid.data_type()) + "_" + ekat::join(layout.dims(),"_");
+      if (m_distinct_io_fields) {
+        key += "_" + f.name();
+      }
       if (fh.get_parent() or fap.get_padding()>0) {
         auto it = io_map.try_emplace(key,fid.clone(key),true);
         m_io_fields.push_back(it.first->second.alias(f.name(),m_tag_rename));
@@ -34,6 +34,17 @@ public:
   // Read fields that were required via parameter list.
   void read (const int time_index = -1);
 
+  // The same as read, but split in phases, so that the file reads can be done on the
+  // scorpio async thread (see scorpio::enqueue_async):
+  //  - prepare_read: setup internal structures (if needed). Must be called on the main thread.
+  //  - read_to_host: read data from file into the host views of the fields. Does not perform
+  //                  any scorpio setup, nor launch any kernel, so it can be run asynchronously.
+  //  - sync_to_device: copy the data to device (and into the input fields, if needed).
+  //                    Must be called on the main thread, after read_to_host is done.
+  void prepare_read ();
+  void read_to_host (const int time_index = -1);
+  void sync_to_device ();
+
   // Cleans up the reader and closes scorpio stuff
   // NOTE: mostly useful for tests, when scorpio::finalize_session is in the same scope
   //       as the reader, and we MUST close all files before finalizing scorpio
@@ -50,6 +61,8 @@ protected:
   // Called lazily at the beginning of read if m_reader_state!=CLEAN
   void setup_internals ();
 
+  void read_var_to_host (const Field& f, const Field& f_io, const int time_index);
+
   std::string         m_filename;
 
   // Entries in m_io_fields may alias entries in m_fields if there is no padding, they are not subfields,
@@ -64,6 +77,10 @@ protected:
 
   std::map<std::string,Field> m_layout_to_io_field;
 
+  // If true, io fields (if needed) are never shared among fields with the same layout.
+  // This is needed if we read all vars before syncing them to device (see prepare_read).
+  bool m_distinct_io_fields = false;
+
   // If the input file has non-standard names, we store them here, so we can alias the fields
   std::map<std::string, std::string> m_tag_rename;
 
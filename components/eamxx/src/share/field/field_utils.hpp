@@ -82,6 +82,13 @@ void compute_mask (const Field& x, const ScalarWrapper value, Comparison CMP, co
 Field compute_mask (const Field& x, const ScalarWrapper value, Comparison CMP);
 void compute_mask (const Field& lhs, const Field& rhs, Comparison CMP, const Field& mask);
 
+// Keep only nsb explicit mantissa bits of each entry of src (rounding to nearest), and store
+// the result in tgt (src and tgt can be the same field). This is the 'BitRound' quantization,
+// which makes the data much more compressible, with a relative error bounded by 2^-(nsb+1).
+// Fill values, inf and nan entries are not modified. Fields must be contiguous, and have
+// the same floating point data type and size (but tgt can be, e.g., a reshape of src).
+void bit_round (const Field& src, const Field& tgt, const int nsb);
+
 // Transpose a field layout
 void transpose (const Field& src, const Field& tgt);
 Field transpose (const Field& src);
@@ -0,0 +1,215 @@
+#include "share/field/field_workspace_arena.hpp"
+
+#include <ekat_assert.hpp>
+
+#include <algorithm>
+
+namespace scream
+{
+
+namespace {
+// The lane used by this thread, and the number of scopes (of any lifetime) it has open
+thread_local void* thread_lane = nullptr;
+thread_local int   thread_num_scopes = 0;
+} // anonymous namespace
+
+FieldWorkspaceArena& FieldWorkspaceArena::instance ()
+{
+  static FieldWorkspaceArena arena;
+  static bool hook_registered = false;
+  if (not hook_registered) {
+    // The arena is a static object, which would be destroyed after Kokkos is finalized
+    Kokkos::push_finalize_hook([](){
+      arena.clear();
+      hook_registered = false;
+    });
+    hook_registered = true;
+  }
+  return arena;
+}
+
+// ------------------------ Scope ------------------------ //
+
+FieldWorkspaceArena::Scope::
+Scope (const ArenaLifetime lifetime)
+ : m_arena (FieldWorkspaceArena::instance())
+ , m_lifetime (lifetime)
+{
+  m_stack = &m_arena.acquire_lane().get_stack(m_lifetime);
+  ++thread_num_scopes;
+
+  auto& s = *m_stack;
+  m_mark.chunk      = s.curr;
+  m_mark.chunk_used = s.chunks.empty() ? 0 : s.chunks[s.curr].used;
+  m_mark.in_use     = s.in_use;
+  m_depth = ++s.depth;
+}
+
+FieldWorkspaceArena::Scope::
+~Scope ()
+{
+  auto& s = *m_stack;
+
+  // Scopes are stack-like, so they must be destroyed in reverse order of creation.
+  // Throwing from a destructor would terminate the program anyway, so use an assert.
+  EKAT_ASSERT_MSG (s.depth==m_depth,
+      "[FieldWorkspaceArena::Scope] Error! Scopes must be destroyed in reverse order of creation.\n");
+
+  // Return the memory to the arena. Chunks after the mark are now empty.
+  for (int i=m_mark.chunk+1; i<static_cast<int>(s.chunks.size()); ++i) {
+    s.chunks[i].used = 0;
+  }
+  if (not s.chunks.empty()) {
+    s.chunks[m_mark.chunk].used = m_mark.chunk_used;
+  }
+  s.curr   = m_mark.chunk;
+  s.in_use = m_mark.in_use;
+  --s.depth;
+
+  // If the stack is empty, replace the chunks with one chunk large enough for the high-water mark
+  if (s.depth==0 and s.chunks.size()>1) {
+    s.chunks.clear();
+    s.chunks.emplace_back();
+    s.chunks[0].data = view_1d("FieldWorkspaceArena::"+e2str(m_lifetime),s.high_water);
+    s.chunks[0].mem_token = MemoryTracker::instance().track(s.high_water,"FieldWorkspaceArena::"+e2str(m_lifetime));
+    s.curr = 0;
+  }
+
+  if (--thread_num_scopes==0) {
+    m_arena.release_lane();
+  }
+}
+
+Field FieldWorkspaceArena::Scope::
+get_field (const FieldIdentifier& fid, const int pack_size)
+{
+  Field f(fid);
+  f.get_header().get_alloc_properties().request_allocation(pack_size);
+  return get_field(f);
+}
+
+Field FieldWorkspaceArena::Scope::
+get_field (const Field& f)
+{
+  const auto& fid = f.get_header().get_identifier();
+  Field tmp(fid);
+  tmp.get_header().get_alloc_properties().request_allocation(f.get_header().get_alloc_properties());
+  tmp.get_header().get_alloc_properties().commit(fid.get_layout());
+  const auto nbytes = tmp.get_header().get_alloc_properties().get_alloc_size();
+  tmp.allocate_view_from_buffer(m_arena.allocate(*m_stack,m_lifetime,nbytes));
+  return tmp;
+}
+
+// ------------------------ FieldWorkspaceArena ------------------------ //
+
+FieldWorkspaceArena::Lane&
+FieldWorkspaceArena::acquire_lane ()
+{
+  if (thread_lane==nullptr) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_lanes.begin(),m_lanes.end(),[](const Lane& l) { return not l.taken; });
+    auto& lane = it!=m_lanes.end() ? *it : m_lanes.emplace_back();
+    lane.taken = true;
+    thread_lane = &lane;
+  }
+  return *static_cast<Lane*>(thread_lane);
+}
+
+void FieldWorkspaceArena::release_lane ()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  static_cast<Lane*>(thread_lane)->taken = false;
+  thread_lane = nullptr;
+}
+
+char* FieldWorkspaceArena::
+allocate (Stack& s, const ArenaLifetime lifetime, const long long num_bytes)
+{
+  EKAT_REQUIRE_MSG (s.depth>0,
+      "[FieldWorkspaceArena::allocate] Error! Memory can only be requested from within a scope.\n"
+      " - lifetime: " + e2str(lifetime) + "\n");
+
+  const long long size = std::max(((num_bytes + alignment - 1) / alignment) * alignment, alignment);
+
+  auto fits = [&](const Chunk& c) {
+    return c.used + size <= static_cast<long long>(c.data.size());
+  };
+  if (s.chunks.empty() or not fits(s.chunks[s.curr])) {
+    if (not s.chunks.empty()) {
+      ++s.curr;
+    }
+    if (s.curr==static_cast<int>(s.chunks.size()) or not fits(s.chunks[s.curr])) {
+      // Chunks after the current one are empty, and too small: drop them, and make a new
+      // chunk, at least as large as all the previous ones (to limit the number of chunks)
+      long long capacity = 0;
+      for (int i=0; i<s.curr; ++i) {
+        capacity += s.chunks[i].data.size();
+      }
+      s.chunks.resize(s.curr);
+      auto& c = s.chunks.emplace_back();
+      c.data = view_1d("FieldWorkspaceArena::"+e2str(lifetime),std::max(size,capacity));
+      c.mem_token = MemoryTracker::instance().track(c.data.size(),"FieldWorkspaceArena::"+e2str(lifetime));
+    }
+  }
+
+  auto& c = s.chunks[s.curr];
+  char* ptr = c.data.data() + c.used;
+  c.used += size;
+  s.in_use += size;
+  s.high_water = std::max(s.high_water,s.in_use);
+  return ptr;
+}
+
+template<typename F>
+long long FieldWorkspaceArena::
+sum_over_lanes (const ArenaLifetime lifetime, F&& f) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  long long sum = 0;
+  for (const auto& lane : m_lanes) {
+    sum += f(lane.get_stack(lifetime));
+  }
+  return sum;
+}
+
+long long FieldWorkspaceArena::
+get_bytes_in_use (const ArenaLifetime lifetime) const
+{
+  return sum_over_lanes(lifetime,[](const Stack& s) { return s.in_use; });
+}
+
+long long FieldWorkspaceArena::
+get_high_water_bytes (const ArenaLifetime lifetime) const
+{
+  return sum_over_lanes(lifetime,[](const Stack& s) { return s.high_water; });
+}
+
+long long FieldWorkspaceArena::
+get_allocated_bytes (const ArenaLifetime lifetime) const
+{
+  return sum_over_lanes(lifetime,[](const Stack& s) {
+    long long bytes = 0;
+    for (const auto& c : s.chunks) {
+      bytes += c.data.size();
+    }
+    return bytes;
+  });
+}
+
+int FieldWorkspaceArena::get_num_lanes () const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lanes.size();
+}
+
+void FieldWorkspaceArena::clear ()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto& lane : m_lanes) {
+    EKAT_REQUIRE_MSG (not lane.taken,
+        "[FieldWorkspaceArena::clear] Error! Cannot clear the arena while scopes are open.\n");
+  }
+  m_lanes.clear();
+}
+
+} // namespace scream
@@ -0,0 +1,155 @@
+#ifndef EAMXX_FIELD_WORKSPACE_ARENA_HPP
+#define EAMXX_FIELD_WORKSPACE_ARENA_HPP
+
+#include "share/field/field.hpp"
+#include "share/core/eamxx_types.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace scream
+{
+
+// How long the memory drawn from the arena is needed. Each lifetime has its own
+// stack, so that scopes of different lifetimes do not need to be nested.
+enum class ArenaLifetime {
+  ProcessRun,   // Temporaries of a single run/compute/remap call
+  OutputStep    // Temporaries of a single output step (e.g., I/O helper fields)
+};
+
+inline std::string e2str (const ArenaLifetime lt) {
+  switch (lt) {
+    case ArenaLifetime::ProcessRun: return "ProcessRun";
+    case ArenaLifetime::OutputStep: return "OutputStep";
+    default: return "INVALID";
+  }
+}
+
+/*
+ * A stack-like arena of device memory, to be used for temporary fields.
+ *
+ * Rather than keeping their own (permanent) helper fields, remappers, diagnostics,
+ * and I/O helpers open a Scope, and get their temporaries from it. The memory is
+ * returned to the arena when the scope is destroyed, so that the next client can
+ * reuse it. The memory needed by the arena is the high-water mark of the temporaries
+ * in use at the same time, rather than the sum of all temporaries.
+ *
+ * Atm procs may run concurrently on different threads (see the parallel schedule of
+ * AtmosphereProcessGroup), so scopes opened on different threads cannot share a stack.
+ * Each thread gets its own set of stacks (a "lane") when it opens its first scope, and
+ * gives it back when its last scope is closed, so that lanes are reused by the next
+ * threads, rather than being tied to (short lived) threads.
+ *
+ * The memory is organized in chunks. If a request does not fit in the current chunk,
+ * a new chunk is allocated. When all scopes of a lifetime are closed, the chunks
+ * are replaced by a single chunk as large as the high-water mark, so that, after
+ * the first few steps, no more allocations happen.
+ *
+ * Fields obtained from a scope must NOT be used after the scope is destroyed.
+ */
+
+class FieldWorkspaceArena {
+  struct Stack;
+
+public:
+
+  static FieldWorkspaceArena& instance ();
+
+  class Scope {
+  public:
+    explicit Scope (const ArenaLifetime lifetime);
+    ~Scope ();
+
+    Scope (const Scope&) = delete;
+    Scope& operator= (const Scope&) = delete;
+
+    // Create a field with the given identifier, using memory from the arena
+    Field get_field (const FieldIdentifier& fid, const int pack_size = 1);
+
+    // Create a field with the same identifier and alloc requests as f
+    // (which does not need to be allocated)
+    Field get_field (const Field& f);
+
+  private:
+    struct Mark {
+      int         chunk;
+      long long   chunk_used;
+      long long   in_use;
+    };
+
+    FieldWorkspaceArena&  m_arena;
+    ArenaLifetime         m_lifetime;
+    Mark                  m_mark;
+    int                   m_depth;
+    Stack*                m_stack;
+  };
+
+  // Number of bytes currently handed out, and max number of bytes ever handed out at the same time.
+  // These are summed over all lanes, and should not be called while other threads use the arena.
+  long long get_bytes_in_use (const ArenaLifetime lifetime) const;
+  long long get_high_water_bytes (const ArenaLifetime lifetime) const;
+
+  // Number of bytes currently allocated in the arena (summed over all lanes)
+  long long get_allocated_bytes (const ArenaLifetime lifetime) const;
+
+  // Number of lanes, i.e., the max number of threads that used the arena at the same time
+  int get_num_lanes () const;
+
+  // Release all memory (there must be no open scopes)
+  void clear ();
+
+  // Allocations are rounded up to a multiple of this, so that fields are suitably aligned for packs
+  static constexpr long long alignment = 128;
+
+private:
+  FieldWorkspaceArena () = default;
+
+  using view_1d = KokkosTypes<DefaultDevice>::view_1d<char>;
+
+  struct Chunk {
+    view_1d     data;
+    long long   used = 0;
+    MemoryTracker::token_t  mem_token;
+  };
+
+  struct Stack {
+    std::vector<Chunk>  chunks;
+    int                 curr = 0;
+    int                 depth = 0;    // Number of open scopes
+    long long           in_use = 0;
+    long long           high_water = 0;
+  };
+
+  // The stacks used by one thread at a time
+  struct Lane {
+    Stack   process_run;
+    Stack   output_step;
+    bool    taken = false;
+
+    Stack& get_stack (const ArenaLifetime lifetime) {
+      return lifetime==ArenaLifetime::ProcessRun ? process_run : output_step;
+    }
+    const Stack& get_stack (const ArenaLifetime lifetime) const {
+      return lifetime==ArenaLifetime::ProcessRun ? process_run : output_step;
+    }
+  };
+
+  // Get the lane of the calling thread (acquiring a free one if needed), and release it
+  Lane& acquire_lane ();
+  void release_lane ();
+
+  char* allocate (Stack& s, const ArenaLifetime lifetime, const long long num_bytes);
+
+  template<typename F>
+  long long sum_over_lanes (const ArenaLifetime lifetime, F&& f) const;
+
+  // A list, so that references to lanes are not invalidated when adding lanes
+  std::list<Lane>     m_lanes;
+  mutable std::mutex  m_mutex;
+};
+
+} // namespace scream
+
+#endif // EAMXX_FIELD_WORKSPACE_ARENA_HPP
@@ -0,0 +1,105 @@
+// This is a small program to benchmark fused field expressions (see field_expression.hpp),
+// comparing them with the equivalent chain of Field::deep_copy/update/scale calls.
+// The reported bandwidth is computed from the minimum amount of memory traffic of the
+// operation (i.e., reading each operand and writing the result once).
+//
+// Usage: field_expression_bench [ncols [nlevs [nreps]]]
+
+#include "share/field/field_expression.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/core/eamxx_session.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace scream;
+
+// Time a function (in seconds, averaged over nreps, after one warmup call)
+double time_it (const std::function<void()>& f, const int nreps)
+{
+  f();
+  Kokkos::fence();
+  const auto start = std::chrono::steady_clock::now();
+  for (int rep=0; rep<nreps; ++rep) {
+    f();
+  }
+  Kokkos::fence();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop-start).count() / nreps;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+  using namespace ShortFieldTagsNames;
+
+  const int ncols = argc>1 ? std::stoi(argv[1]) : 2048;
+  const int nlevs = argc>2 ? std::stoi(argv[2]) : 128;
+  const int nreps = argc>3 ? std::stoi(argv[3]) : 100;
+
+  MPI_Init(&argc,&argv);
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    FieldIdentifier fid("f", {{COL,LEV},{ncols,nlevs}}, ekat::units::K, "physics");
+    FieldIdentifier mid("m", {{COL,LEV},{ncols,nlevs}}, ekat::units::none, "physics", DataType::IntType);
+    Field x(fid,true), y(fid,true), z(fid,true), f(fid,true), tmp(fid,true), mask(mid,true);
+    randomize_uniform(x, 1234, -1, 1);
+    randomize_uniform(y, 1235, -1, 1);
+    randomize_uniform(z, 1236,  1, 2);
+    compute_mask(x,Real(0),Comparison::GT,mask);
+
+    const Real a = 2, b = 0.5;
+
+    struct Case {
+      std::string name;
+      int nfields; // Number of Real fields read/written by the fused expression (masks not counted)
+      std::function<void()> chained;
+      std::function<void()> fused;
+    };
+    std::vector<Case> cases = {
+      {"f = x + y", 3,
+        [&]{ f.deep_copy(x); f.update(y,1,1); },
+        [&]{ f.assign(x + y); }},
+      {"f = a*x + b*y/z", 4,
+        [&]{ f.deep_copy(y); f.scale_inv(z); f.update(x,a,b); },
+        [&]{ f.assign(a*x + b*(y/z)); }},
+      {"f = (f + x)/z (masked)", 4,
+        [&]{ f.update(x,1,1,mask); f.scale_inv(z,mask); },
+        [&]{ f.assign((f + x)/z,mask); }},
+      {"f = max(x,y) - min(x,z)", 4,
+        [&]{ tmp.deep_copy(x); tmp.min(z); f.deep_copy(x); f.max(y); f.update(tmp,-1,1); },
+        [&]{ f.assign(expr::max(x,y) - expr::min(x,z)); }},
+    };
+
+    std::cout << "Field expression benchmark: " << ncols << " cols, " << nlevs << " levs, "
+              << nreps << " reps\n";
+    std::cout << std::setw(26) << "expression"
+              << std::setw(14) << "chained [us]"
+              << std::setw(12) << "fused [us]"
+              << std::setw(16) << "chained [GB/s]"
+              << std::setw(14) << "fused [GB/s]"
+              << std::setw(10) << "speedup" << "\n";
+    for (const auto& c : cases) {
+      const double t_chained = time_it(c.chained,nreps);
+      const double t_fused   = time_it(c.fused,nreps);
+      const double gb = 1e-9*c.nfields*ncols*nlevs*sizeof(Real);
+      std::cout << std::setw(26) << c.name
+                << std::setw(14) << std::fixed << std::setprecision(1) << 1e6*t_chained
+                << std::setw(12) << 1e6*t_fused
+                << std::setw(16) << gb/t_chained
+                << std::setw(14) << gb/t_fused
+                << std::setw(10) << std::setprecision(2) << t_chained/t_fused << "\n";
+      std::cout.unsetf(std::ios::fixed);
+    }
+  }
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+
+  return 0;
+}
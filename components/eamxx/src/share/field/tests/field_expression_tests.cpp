@@ -0,0 +1,180 @@
+#include <catch2/catch.hpp>
+
+#include "share/field/field_expression.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/core/eamxx_setup_random_test.hpp"
+
+#include <limits>
+
+namespace {
+
+using namespace scream;
+
+// Check that two Real fields are equal up to roundoff (the order of operations,
+// and the possible contraction in FMA, may differ between fused and unfused code)
+void check_close (const Field& f1, const Field& f2)
+{
+  f1.sync_to_host();
+  f2.sync_to_host();
+  auto v1 = f1.get_strided_view<const Real***,Host>();
+  auto v2 = f2.get_strided_view<const Real***,Host>();
+  const Real tol = 10*std::numeric_limits<Real>::epsilon();
+  for (size_t i=0; i<v1.extent(0); ++i) {
+    for (size_t j=0; j<v1.extent(1); ++j) {
+      for (size_t k=0; k<v1.extent(2); ++k) {
+        REQUIRE (v1(i,j,k)==Approx(v2(i,j,k)).epsilon(tol).margin(tol));
+      }
+    }
+  }
+}
+
+TEST_CASE ("field_expression") {
+  using namespace ekat::units;
+  using namespace ShortFieldTagsNames;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  int seed = get_random_test_seed();
+
+  const int ncol = 3;
+  const int ncmp = 2;
+  const int nlev = 7;
+
+  std::vector<FieldTag> tags = {COL, CMP, LEV};
+  std::vector<int>      dims = {ncol,ncmp,nlev};
+
+  FieldIdentifier fid ("f", {tags,dims}, kg, "some_grid");
+  FieldIdentifier mid ("m", {tags,dims}, kg, "some_grid", DataType::IntType);
+
+  Field x (fid), y (fid), z (fid);
+  x.allocate_view();
+  y.allocate_view();
+  z.allocate_view();
+  randomize_uniform (x,seed++,-1,1);
+  randomize_uniform (y,seed++,-1,1);
+  randomize_uniform (z,seed++,1,2);
+
+  const Real a = 2.5;
+  const Real b = -0.5;
+
+  SECTION ("arithmetic") {
+    Field f1 = x.clone();
+    Field f2 = x.clone();
+
+    // f = a*x + b*y/z
+    f1.deep_copy(y);
+    f1.scale_inv(z);
+    f1.update(x,a,b);
+    f2.assign(a*x + b*(y/z));
+    check_close(f1,f2);
+
+    // f = max(x,y) - min(x,z)
+    f1.deep_copy(x);
+    f1.max(y);
+    Field tmp = x.clone();
+    tmp.min(z);
+    f1.update(tmp,-1,1);
+    f2.assign(expr::max(x,y) - expr::min(x,z));
+    check_close(f1,f2);
+
+    // The lhs can appear in the rhs: f = -(2*f + 1)
+    f1.update(f1,0,-2,-1);
+    f2.assign(-(2*f2 + 1));
+    check_close(f1,f2);
+
+    // A field or a scalar are valid expressions too
+    f2.assign(x);
+    REQUIRE (views_are_equal(f2,x));
+    f1.deep_copy(3);
+    f2.assign(3);
+    REQUIRE (views_are_equal(f2,f1));
+  }
+
+  SECTION ("subfields") {
+    // Strided lhs and rhs
+    Field f1 = x.clone();
+    Field f2 = x.clone();
+    f1.deep_copy(0);
+    f2.deep_copy(0);
+    auto x0 = x.subfield(CMP,0);
+    auto y1 = y.subfield(CMP,1);
+    f1.subfield(CMP,1).deep_copy(x0);
+    f1.subfield(CMP,1).update(y1,a,b);
+    f2.subfield(CMP,1).assign(b*x0 + a*y1);
+    check_close(f1,f2);
+  }
+
+  SECTION ("masked") {
+    Field mask (mid);
+    mask.allocate_view();
+    compute_mask(x,Real(0),Comparison::GT,mask);
+
+    Field f1 = z.clone(CloneFlags::CopyData);
+    Field f2 = z.clone(CloneFlags::CopyData);
+
+    // Only where x>0
+    f1.update(y,a,b,mask);
+    f2.assign(b*f2 + a*y,mask);
+    check_close(f1,f2);
+
+    // Where mask=0, the lhs is untouched
+    Field f3 = z.clone(CloneFlags::CopyData);
+    f3.deep_copy(y,mask);
+    f2.assign(y,mask);
+    REQUIRE (views_are_equal(f2,f3));
+  }
+
+  SECTION ("fill_aware") {
+    constexpr auto fv = constants::fill_value<Real>;
+
+    Field one = x.clone();
+    one.deep_copy(1);
+
+    // x is filled everywhere, but the rhs is not fill-aware, so fv is just a number
+    Field xf = x.clone();
+    xf.deep_copy(fv);
+    Field f = x.clone();
+    f.assign(0*xf + 1);
+    REQUIRE (views_are_equal(f,one));
+
+    // If the operand may be filled, entries where it is filled are ignored, like in update
+    xf.get_header().set_may_be_filled(true);
+    f.assign(xf + y);
+    REQUIRE (views_are_equal(f,one));
+
+    // Only the filled entries are skipped
+    Field mask (mid);
+    mask.allocate_view();
+    compute_mask(y,Real(0),Comparison::GT,mask);
+    xf.deep_copy(x);
+    xf.deep_copy(fv,mask);
+    Field f1 = x.clone();
+    f1.deep_copy(1);
+    f1.update(xf,a,0);
+    f.deep_copy(1);
+    f.assign(a*xf);
+    REQUIRE (views_are_equal(f,f1));
+  }
+
+  SECTION ("errors") {
+    Field f = x.clone();
+
+    // Read-only lhs
+    REQUIRE_THROWS (x.get_const().assign(y+z));
+
+    // Non-Real operand
+    Field fi (mid);
+    fi.allocate_view();
+    REQUIRE_THROWS (f.assign(x+fi));
+
+    // Incompatible layouts
+    FieldIdentifier fid2 ("g", {{COL,LEV},{ncol,nlev}}, kg, "some_grid");
+    Field g (fid2);
+    g.allocate_view();
+    REQUIRE_THROWS (f.assign(x+g));
+
+    // Mask must be int
+    REQUIRE_THROWS (f.assign(x+y,z));
+  }
+}
+
+} // anonymous namespace
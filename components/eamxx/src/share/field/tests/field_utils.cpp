@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 #include <numeric>
+#include <limits>
+#include <cmath>
 
 #include "share/field/field_identifier.hpp"
 #include "share/field/field_header.hpp"
@@ -428,4 +430,69 @@ TEST_CASE ("transpose") {
   }
 }
 
+TEST_CASE ("bit_round") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  int seed = get_random_test_seed();
+
+  const int ncols = 5;
+  const int nlevs = 16;
+  constexpr auto fv = constants::fill_value<Real>;
+
+  FieldIdentifier fid  ("foo", {{COL,LEV},{ncols,nlevs}}, ekat::units::K, "some_grid");
+  FieldIdentifier fidi ("foo", {{COL,LEV},{ncols,nlevs}}, ekat::units::K, "some_grid", DataType::IntType);
+
+  Field x (fid), q (fid);
+  x.allocate_view();
+  q.allocate_view();
+  randomize_uniform(x, seed++, -1e3, 1e3);
+
+  // Add a few fill values
+  x.sync_to_host();
+  auto x_h = x.get_view<Real**,Host>();
+  for (int icol=0; icol<ncols; ++icol) {
+    x_h(icol,icol) = fv;
+  }
+  x.sync_to_device();
+
+  SECTION ("exceptions") {
+    Field xi (fidi);
+    xi.allocate_view();
+    REQUIRE_THROWS (bit_round(x,q,0));                // invalid nsb
+    REQUIRE_THROWS (bit_round(xi,xi,7));              // unsupported data type
+    REQUIRE_THROWS (bit_round(x,x.get_const(),7));    // read-only target
+    REQUIRE_THROWS (bit_round(x.subfield(COL,0),q.subfield(COL,0),7)); // subfields
+  }
+
+  SECTION ("accuracy") {
+    for (int nsb : {3, 7, 10, 23}) {
+      bit_round(x,q,nsb);
+      x.sync_to_host();
+      q.sync_to_host();
+      auto q_h = q.get_view<const Real**,Host>();
+      const Real tol = std::pow(Real(2),-(nsb+1));
+      for (int icol=0; icol<ncols; ++icol) {
+        for (int ilev=0; ilev<nlevs; ++ilev) {
+          if (x_h(icol,ilev)==fv) {
+            REQUIRE (q_h(icol,ilev)==fv);
+          } else {
+            REQUIRE (std::abs(q_h(icol,ilev)-x_h(icol,ilev))<=tol*std::abs(x_h(icol,ilev)));
+          }
+        }
+      }
+
+      // Rounding already rounded data does nothing (also tests src==tgt)
+      Field q2 = q.clone();
+      bit_round(q2,q2,nsb);
+      REQUIRE (views_are_equal(q,q2));
+    }
+
+    // If nsb is at least the mantissa size, nothing changes
+    bit_round(x,q,std::numeric_limits<Real>::digits);
+    REQUIRE (views_are_equal(x,q));
+  }
+}
+
 } // anonymous namespace
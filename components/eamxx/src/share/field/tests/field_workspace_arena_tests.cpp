@@ -0,0 +1,185 @@
+#include <catch2/catch.hpp>
+
+#include "share/field/field_workspace_arena.hpp"
+#include "share/field/field_utils.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+TEST_CASE ("field_workspace_arena") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+  using namespace ekat::units;
+
+  constexpr auto PR = ArenaLifetime::ProcessRun;
+  constexpr auto OS = ArenaLifetime::OutputStep;
+
+  auto& arena = FieldWorkspaceArena::instance();
+
+  FieldIdentifier fid1 ("f1", {{COL,LEV},{3,13}}, m/s, "some_grid");
+  FieldIdentifier fid2 ("f2", {{COL},{5}}, m/s, "some_grid");
+
+  // Number of bytes taken by f in the arena
+  auto arena_bytes = [](const Field& f) {
+    constexpr auto a = FieldWorkspaceArena::alignment;
+    const auto nbytes = f.get_header().get_alloc_properties().get_alloc_size();
+    return ((nbytes + a - 1) / a) * a;
+  };
+
+  REQUIRE (arena.get_bytes_in_use(PR)==0);
+  REQUIRE (arena.get_bytes_in_use(OS)==0);
+
+  const Real* f2_data;
+  long long f1_bytes, f2_bytes;
+  {
+    FieldWorkspaceArena::Scope outer(PR);
+    auto f1 = outer.get_field(fid1,4);
+    REQUIRE (f1.is_allocated());
+    REQUIRE (f1.get_header().get_alloc_properties().get_last_extent()==16);
+    f1.deep_copy(1.0);
+    f1_bytes = arena_bytes(f1);
+    {
+      FieldWorkspaceArena::Scope inner(PR);
+      auto f2 = inner.get_field(fid2);
+      f2.deep_copy(2.0);
+      f2_data = f2.get_internal_view_data<Real>();
+      f2_bytes = arena_bytes(f2);
+      REQUIRE (arena.get_bytes_in_use(PR)==f1_bytes+f2_bytes);
+
+      // Different lifetimes use different stacks, and scopes of different
+      // lifetimes do not need to be nested
+      FieldWorkspaceArena::Scope os(OS);
+      auto f3 = os.get_field(f1);
+      REQUIRE (f3.get_header().get_alloc_properties().get_last_extent()==16);
+      REQUIRE (arena.get_bytes_in_use(OS)==f1_bytes);
+      f3.deep_copy(3.0);
+
+      // Fields do not overlap
+      REQUIRE (field_max(f1).as<Real>()==1.0);
+      REQUIRE (field_min(f1).as<Real>()==1.0);
+      REQUIRE (field_max(f2).as<Real>()==2.0);
+      REQUIRE (field_min(f2).as<Real>()==2.0);
+    }
+    REQUIRE (arena.get_bytes_in_use(PR)==f1_bytes);
+    REQUIRE (arena.get_bytes_in_use(OS)==0);
+
+    // Cannot release memory while scopes are open
+    REQUIRE_THROWS (arena.clear());
+
+    // The memory of the inner scope is reused
+    auto f4 = outer.get_field(fid2);
+    REQUIRE (f4.get_internal_view_data<Real>()==f2_data);
+  }
+  REQUIRE (arena.get_bytes_in_use(PR)==0);
+  REQUIRE (arena.get_high_water_bytes(PR)==f1_bytes+f2_bytes);
+  REQUIRE (arena.get_high_water_bytes(OS)==f1_bytes);
+
+  // Once all scopes are closed, the arena has a single chunk, as large as the high-water mark
+  REQUIRE (arena.get_allocated_bytes(PR)==f1_bytes+f2_bytes);
+  {
+    FieldWorkspaceArena::Scope s(PR);
+    auto f1 = s.get_field(fid1,4);
+    auto f2 = s.get_field(fid2);
+    REQUIRE (f2.get_internal_view_data<Real>()==f1.get_internal_view_data<Real>()+f1_bytes/sizeof(Real));
+    REQUIRE (arena.get_allocated_bytes(PR)==f1_bytes+f2_bytes);
+  }
+
+  arena.clear();
+  REQUIRE (arena.get_allocated_bytes(PR)==0);
+  REQUIRE (arena.get_allocated_bytes(OS)==0);
+}
+
+TEST_CASE ("field_workspace_arena_threads") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+  using namespace ekat::units;
+
+  constexpr auto PR = ArenaLifetime::ProcessRun;
+
+  auto& arena = FieldWorkspaceArena::instance();
+  arena.clear();
+
+  FieldIdentifier fid1 ("f1", {{COL,LEV},{3,13}}, m/s, "some_grid");
+  FieldIdentifier fid2 ("f2", {{COL,LEV},{3,26}}, m/s, "some_grid");
+
+  // Threads signal each other by advancing the stage
+  std::mutex mtx;
+  std::condition_variable cv;
+  int stage = 0;
+  auto wait_for = [&](const int s) {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock,[&]{ return stage>=s; });
+  };
+  auto advance_to = [&](const int s) {
+    std::lock_guard<std::mutex> lock(mtx);
+    stage = s;
+    cv.notify_all();
+  };
+
+  // Fill f with val (on host, so that no kernel is launched from the threads),
+  // and count the entries not equal to val
+  auto fill = [](const Field& f, const Real val) {
+    auto data = f.get_internal_view_data<Real,Host>();
+    for (int i=0; i<f.get_header().get_identifier().get_layout().size(); ++i) {
+      data[i] = val;
+    }
+  };
+  auto num_diffs = [](const Field& f, const Real val) {
+    auto data = f.get_internal_view_data<Real,Host>();
+    int n = 0;
+    for (int i=0; i<f.get_header().get_identifier().get_layout().size(); ++i) {
+      n += data[i]!=val;
+    }
+    return n;
+  };
+
+  // Thread 0 opens a scope, then thread 1 does. Thread 0 closes its scope while
+  // thread 1 still uses its field, and thread 1 then gets more memory from its scope.
+  // Sharing one stack, this would overwrite the field of thread 1.
+  std::vector<int> num_bad(2,0);
+  std::thread t0([&]{
+    {
+      FieldWorkspaceArena::Scope scope(PR);
+      auto f = scope.get_field(fid1);
+      fill(f,0);
+      advance_to(1);
+      wait_for(2);
+      num_bad[0] = num_diffs(f,0);
+    }
+    advance_to(3);
+  });
+  std::thread t1([&]{
+    wait_for(1);
+    FieldWorkspaceArena::Scope scope(PR);
+    auto f = scope.get_field(fid1);
+    fill(f,1);
+    advance_to(2);
+    wait_for(3);
+    auto g = scope.get_field(fid2);
+    fill(g,-1);
+    num_bad[1] = num_diffs(f,1);
+  });
+  t0.join();
+  t1.join();
+
+  REQUIRE (num_bad[0]==0);
+  REQUIRE (num_bad[1]==0);
+  REQUIRE (arena.get_num_lanes()==2);
+  REQUIRE (arena.get_bytes_in_use(PR)==0);
+
+  // Lanes are given back when the last scope on a thread is closed, so later threads reuse them
+  std::thread t2([&]{
+    FieldWorkspaceArena::Scope scope(PR);
+    scope.get_field(fid1);
+  });
+  t2.join();
+  REQUIRE (arena.get_num_lanes()==2);
+
+  arena.clear();
+  REQUIRE (arena.get_num_lanes()==0);
+}
+
+} // anonymous namespace
@@ -0,0 +1,110 @@
+#include "share/field/field_utils.hpp"
+#include "share/util/eamxx_universal_constants.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace scream {
+
+namespace impl {
+
+template<typename ST>
+void bit_round (const Field& src, const Field& tgt, const int nsb)
+{
+  using UT = std::conditional_t<sizeof(ST)==8,std::uint64_t,std::uint32_t>;
+  using KT = Field::kt_dev;
+  using range_t = typename KT::RangePolicy;
+
+  static_assert (sizeof(UT)==sizeof(ST), "Error! Unexpected size of floating point type.\n");
+
+  // Number of explicitly stored mantissa bits
+  constexpr int mant_bits = std::numeric_limits<ST>::digits - 1;
+  if (nsb>=mant_bits) {
+    // Nothing to drop
+    if (src.get_internal_view_data<const ST>()!=tgt.get_internal_view_data<const ST>()) {
+      tgt.deep_copy(src);
+    }
+    return;
+  }
+
+  // Round to nearest (ties to even) at the last kept bit, then zero out the dropped ones.
+  // A carry may propagate into the exponent, which is the correct rounding behavior.
+  const int drop = mant_bits - nsb;
+  const UT half_m1 = (UT(1) << (drop-1)) - 1;
+  const UT mask = ~((UT(1) << drop) - 1);
+
+  // Fill values must be preserved exactly, or readers would no longer recognize them
+  constexpr auto fv = constants::fill_value<ST>;
+
+  const int size = src.get_header().get_identifier().get_layout().size();
+  const ST* x = src.get_internal_view_data<const ST>();
+  ST* y = tgt.get_internal_view_data<ST>();
+  Kokkos::parallel_for("bit_round",range_t(0,size),KOKKOS_LAMBDA(const int i) {
+    const ST v = x[i];
+    if (v==fv or not Kokkos::isfinite(v)) {
+      y[i] = v;
+      return;
+    }
+    UT bits = Kokkos::bit_cast<UT>(v);
+    bits += half_m1 + ((bits >> drop) & 1);
+    bits &= mask;
+    y[i] = Kokkos::bit_cast<ST>(bits);
+  });
+  Kokkos::fence();
+}
+
+} // namespace impl
+
+void bit_round (const Field& src, const Field& tgt, const int nsb)
+{
+  const auto& src_id = src.get_header().get_identifier();
+  const auto& tgt_id = tgt.get_header().get_identifier();
+
+  EKAT_REQUIRE_MSG (nsb>=1,
+      "Error! Invalid number of significant bits for bit rounding.\n"
+      " - src field name: " + src.name() + "\n"
+      " - number of significant bits: " + std::to_string(nsb) + "\n");
+  EKAT_REQUIRE_MSG (src.is_allocated() and tgt.is_allocated(),
+      "Error! Input fields must be allocated.\n"
+      " - src field name: " + src.name() + "\n"
+      " - tgt field name: " + tgt.name() + "\n");
+  EKAT_REQUIRE_MSG (not tgt.is_read_only(),
+      "Error! Cannot bit round into a read-only field.\n"
+      " - tgt field name: " + tgt.name() + "\n");
+  EKAT_REQUIRE_MSG (src_id.data_type()==tgt_id.data_type(),
+      "Error! Input fields must have the same data type.\n"
+      " - src field name: " + src.name() + "\n"
+      " - tgt field name: " + tgt.name() + "\n"
+      " - src field type: " + e2str(src_id.data_type()) + "\n"
+      " - tgt field type: " + e2str(tgt_id.data_type()) + "\n");
+  EKAT_REQUIRE_MSG (src_id.get_layout().size()==tgt_id.get_layout().size(),
+      "Error! Input fields must have the same number of entries.\n"
+      " - src field name: " + src.name() + "\n"
+      " - tgt field name: " + tgt.name() + "\n"
+      " - src field layout: " + src_id.get_layout().to_string() + "\n"
+      " - tgt field layout: " + tgt_id.get_layout().to_string() + "\n");
+  // Note: subfields are excluded, since the internal data pointer is that of the parent
+  auto is_contiguous = [](const Field& f) {
+    return f.get_header().get_alloc_properties().contiguous() and
+           f.get_header().get_parent()==nullptr;
+  };
+  EKAT_REQUIRE_MSG (is_contiguous(src) and is_contiguous(tgt),
+      "Error! Bit rounding is only supported for contiguous fields (with no parent).\n"
+      " - src field name: " + src.name() + "\n"
+      " - tgt field name: " + tgt.name() + "\n");
+
+  const auto dt = src.data_type();
+  if (dt==DataType::DoubleType) {
+    impl::bit_round<double>(src,tgt,nsb);
+  } else if (dt==DataType::FloatType) {
+    impl::bit_round<float>(src,tgt,nsb);
+  } else {
+    EKAT_ERROR_MSG (
+        "Error! Unsupported data type for bit rounding.\n"
+        " - src field name: " + src.name() + "\n"
+        " - data type: " + e2str(dt) + "\n");
+  }
+}
+
+} // namespace scream
@@ -15,6 +15,8 @@
 namespace scream
 {
 
+class GridGidDirectory;
+
 /*
  * An interface base class for Grid objects
  *
@@ -232,6 +234,10 @@ public:
     get_remote_pids_and_lids(gids_v, pids, lids);
   }
 
+  // The distributed directory of the dofs gids, used to answer ownership queries.
+  // Built (collectively) at the first call, and cached.
+  const GridGidDirectory &get_gid_directory() const;
+
   // Derived classes can override these methods to verify that the
   // dofs have been set to something that satisfies any requirement of the grid type.
   virtual bool
@@ -336,6 +342,7 @@ protected:
 
   // Mutable, for lazy calculation
   mutable std::map<gid_type, int> m_gid2lid;
+  mutable std::shared_ptr<GridGidDirectory> m_gid_directory;
 
   // The MPI comm containing the ranks across which the global mesh is partitioned
   ekat::Comm m_comm;
@@ -0,0 +1,191 @@
+#include "share/grid/grid_gid_directory.hpp"
+
+#include "share/util/eamxx_utils.hpp"
+
+#include <ekat_assert.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace scream
+{
+
+namespace {
+
+// Send to each pid the ints in send_data[pid], and return the ints received
+// from each pid (concatenated), as well as the recv offsets of each pid.
+void exchange (const std::vector<std::vector<int>>& send_data,
+               std::vector<int>& recv_data,
+               std::vector<int>& recv_offsets,
+               const ekat::Comm& comm)
+{
+  const int nranks = comm.size();
+
+  std::vector<int> send_counts(nranks), send_offsets(nranks+1,0);
+  for (int pid=0; pid<nranks; ++pid) {
+    send_counts[pid] = send_data[pid].size();
+    send_offsets[pid+1] = send_offsets[pid] + send_counts[pid];
+  }
+  std::vector<int> send_buf(send_offsets[nranks]);
+  for (int pid=0; pid<nranks; ++pid) {
+    std::copy(send_data[pid].begin(),send_data[pid].end(),send_buf.begin()+send_offsets[pid]);
+  }
+
+  std::vector<int> recv_counts(nranks);
+  check_mpi_call(MPI_Alltoall(send_counts.data(),1,MPI_INT,
+                              recv_counts.data(),1,MPI_INT,comm.mpi_comm()),
+                 "[GridGidDirectory] MPI_Alltoall (counts)");
+
+  recv_offsets.assign(nranks+1,0);
+  for (int pid=0; pid<nranks; ++pid) {
+    recv_offsets[pid+1] = recv_offsets[pid] + recv_counts[pid];
+  }
+  recv_data.resize(recv_offsets[nranks]);
+  check_mpi_call(MPI_Alltoallv(send_buf.data(),send_counts.data(),send_offsets.data(),MPI_INT,
+                               recv_data.data(),recv_counts.data(),recv_offsets.data(),MPI_INT,
+                               comm.mpi_comm()),
+                 "[GridGidDirectory] MPI_Alltoallv (data)");
+}
+
+} // anonymous namespace
+
+GridGidDirectory::
+GridGidDirectory (const gid_type* gids, const int num_local_gids, const ekat::Comm& comm)
+ : m_comm (comm)
+{
+  EKAT_REQUIRE_MSG (num_local_gids>=0,
+      "[GridGidDirectory] Error! Number of local gids must be non-negative.\n"
+      " - num_local_gids: " + std::to_string(num_local_gids) + "\n");
+  EKAT_REQUIRE_MSG (num_local_gids==0 or gids!=nullptr,
+      "[GridGidDirectory] Error! Invalid gids pointer.\n");
+
+  const int nranks = m_comm.size();
+
+  // Block-partition the global gid range across ranks
+  gid_type my_min = std::numeric_limits<gid_type>::max();
+  gid_type my_max = std::numeric_limits<gid_type>::min();
+  for (int i=0; i<num_local_gids; ++i) {
+    my_min = std::min(my_min,gids[i]);
+    my_max = std::max(my_max,gids[i]);
+  }
+  m_comm.all_reduce(&my_min,&m_min_gid,1,MPI_MIN);
+  m_comm.all_reduce(&my_max,&m_max_gid,1,MPI_MAX);
+  if (m_min_gid<=m_max_gid) {
+    const long long range = static_cast<long long>(m_max_gid) - m_min_gid + 1;
+    m_block_size = (range + nranks - 1) / nranks;
+  } else {
+    // No gids on any rank
+    m_block_size = 1;
+  }
+
+  // Send (gid,lid) pairs to the home rank of each gid
+  std::vector<std::vector<int>> send_data(nranks);
+  for (int i=0; i<num_local_gids; ++i) {
+    auto& data = send_data[home_pid(gids[i])];
+    data.push_back(gids[i]);
+    data.push_back(i);
+  }
+  std::vector<int> recv_data, recv_offsets;
+  exchange(send_data,recv_data,recv_offsets,m_comm);
+
+  m_entries.reserve(recv_data.size()/2);
+  for (int pid=0; pid<nranks; ++pid) {
+    for (int k=recv_offsets[pid]; k<recv_offsets[pid+1]; k+=2) {
+      m_entries.push_back(Entry{recv_data[k],pid,recv_data[k+1]});
+    }
+  }
+  std::sort(m_entries.begin(),m_entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.gid<b.gid or (a.gid==b.gid and a.pid<b.pid);
+            });
+
+  // Entries are sorted by gid, so duplicates (on the same or on different ranks) are adjacent
+  auto same_gid = [](const Entry& a, const Entry& b) { return a.gid==b.gid; };
+  int my_unique = std::adjacent_find(m_entries.begin(),m_entries.end(),same_gid)==m_entries.end();
+  int unique;
+  m_comm.all_reduce(&my_unique,&unique,1,MPI_PROD);
+  m_all_gids_unique = unique==1;
+}
+
+void GridGidDirectory::
+query (const gid_type* gids, const int num_gids,
+       std::vector<int>& pids,
+       std::vector<int>& lids,
+       std::vector<int>& counts) const
+{
+  const int nranks = m_comm.size();
+
+  pids.assign(num_gids,-1);
+  lids.assign(num_gids,-1);
+  counts.assign(num_gids,0);
+
+  // Only ask once for repeated gids
+  std::vector<gid_type> unique_gids(gids,gids+num_gids);
+  std::sort(unique_gids.begin(),unique_gids.end());
+  unique_gids.erase(std::unique(unique_gids.begin(),unique_gids.end()),unique_gids.end());
+
+  std::vector<std::vector<int>> requests(nranks);
+  for (auto gid : unique_gids) {
+    const int pid = home_pid(gid);
+    if (pid>=0) {
+      requests[pid].push_back(gid);
+    }
+  }
+  std::vector<int> recv_gids, recv_offsets;
+  exchange(requests,recv_gids,recv_offsets,m_comm);
+
+  // Answer the requests: for each gid, reply with (pid,lid,count)
+  auto by_gid = [](const Entry& e, const gid_type gid) { return e.gid<gid; };
+  std::vector<std::vector<int>> replies(nranks);
+  for (int pid=0; pid<nranks; ++pid) {
+    auto& reply = replies[pid];
+    reply.reserve(3*(recv_offsets[pid+1]-recv_offsets[pid]));
+    for (int k=recv_offsets[pid]; k<recv_offsets[pid+1]; ++k) {
+      const auto gid = recv_gids[k];
+      auto it = std::lower_bound(m_entries.begin(),m_entries.end(),gid,by_gid);
+      int count = 0;
+      for (auto e=it; e!=m_entries.end() and e->gid==gid; ++e) {
+        ++count;
+      }
+      reply.push_back(count>0 ? it->pid : -1);
+      reply.push_back(count>0 ? it->lid : -1);
+      reply.push_back(count);
+    }
+  }
+  std::vector<int> answers, answers_offsets;
+  exchange(replies,answers,answers_offsets,m_comm);
+
+  // Replies come in the same order as the requests
+  std::vector<int> found_pid(unique_gids.size(),-1);
+  std::vector<int> found_lid(unique_gids.size(),-1);
+  std::vector<int> found_count(unique_gids.size(),0);
+  std::vector<int> pos(nranks,0);
+  for (int i=0, n=unique_gids.size(); i<n; ++i) {
+    const int pid = home_pid(unique_gids[i]);
+    if (pid<0) {
+      continue;
+    }
+    const int k = answers_offsets[pid] + 3*pos[pid];
+    ++pos[pid];
+    found_pid[i]   = answers[k];
+    found_lid[i]   = answers[k+1];
+    found_count[i] = answers[k+2];
+  }
+
+  for (int i=0; i<num_gids; ++i) {
+    const auto idx = std::lower_bound(unique_gids.begin(),unique_gids.end(),gids[i]) - unique_gids.begin();
+    pids[i]   = found_pid[idx];
+    lids[i]   = found_lid[idx];
+    counts[i] = found_count[idx];
+  }
+}
+
+int GridGidDirectory::home_pid (const gid_type gid) const
+{
+  if (gid<m_min_gid or gid>m_max_gid) {
+    return -1;
+  }
+  return static_cast<int>((static_cast<long long>(gid) - m_min_gid) / m_block_size);
+}
+
+} // namespace scream
@@ -0,0 +1,73 @@
+#ifndef EAMXX_GRID_GID_DIRECTORY_HPP
+#define EAMXX_GRID_GID_DIRECTORY_HPP
+
+#include <ekat_comm.hpp>
+
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A distributed directory of the (gid -> pid,lid) map of a set of dofs
+ * partitioned across the ranks of a communicator.
+ *
+ * Each gid has a "home" rank, obtained by block-partitioning the global
+ * range [min_gid,max_gid] across the ranks of the comm. At construction,
+ * each rank sends its (gid,lid) pairs to the home rank of each gid, with
+ * a single all-to-all exchange. Queries are then answered with one more
+ * all-to-all exchange, by asking the home rank of each requested gid.
+ *
+ * Compared to having each rank broadcast its gids to all other ranks,
+ * this requires O(1) collectives, each moving O(num_local_dofs) data.
+ *
+ * All methods (except the getters) are collective on the comm.
+ */
+
+class GridGidDirectory {
+public:
+  using gid_type = int;
+
+  GridGidDirectory (const gid_type* gids, const int num_local_gids, const ekat::Comm& comm);
+
+  // For each input gid, retrieve the pid and lid of its owner. The output
+  // counts are the number of (pid,lid) entries found for each gid: if 0,
+  // pid/lid are -1; if larger than 1, pid/lid are those of the lowest pid.
+  // Input gids may be repeated.
+  void query (const gid_type* gids, const int num_gids,
+              std::vector<int>& pids,
+              std::vector<int>& lids,
+              std::vector<int>& counts) const;
+
+  // Whether all the gids stored in the directory are unique (across all ranks)
+  bool all_gids_unique () const { return m_all_gids_unique; }
+
+  const ekat::Comm& get_comm () const { return m_comm; }
+
+protected:
+
+  int home_pid (const gid_type gid) const;
+
+  // An entry of the directory
+  struct Entry {
+    gid_type gid;
+    int      pid;
+    int      lid;
+  };
+
+  ekat::Comm  m_comm;
+
+  // Global gid range and size of the block of gids each rank is home of
+  gid_type    m_min_gid;
+  gid_type    m_max_gid;
+  long long   m_block_size;
+
+  // The entries this rank is home of, sorted by (gid,pid)
+  std::vector<Entry>  m_entries;
+
+  bool        m_all_gids_unique;
+};
+
+} // namespace scream
+
+#endif // EAMXX_GRID_GID_DIRECTORY_HPP
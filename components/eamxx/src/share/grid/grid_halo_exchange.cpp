@@ -0,0 +1,409 @@
+#include "grid_halo_exchange.hpp"
+
+#include <ekat_team_policy_utils.hpp>
+
+namespace scream
+{
+
+namespace {
+
+// Access the k-th entry of column icol, where k is the linear index over all
+// non-COL dimensions. We use the layout dims rather than the view extents,
+// since the latter may include padding.
+template<typename ViewT>
+KOKKOS_INLINE_FUNCTION
+typename ViewT::reference_type
+col_entry (const ViewT& v, const int icol, const int k, const int dim2, const int dim3)
+{
+  if constexpr (ViewT::rank==1) {
+    return v(icol);
+  } else if constexpr (ViewT::rank==2) {
+    return v(icol,k);
+  } else if constexpr (ViewT::rank==3) {
+    return v(icol,k/dim2,k%dim2);
+  } else {
+    return v(icol,(k/dim3)/dim2,(k/dim3)%dim2,k%dim3);
+  }
+}
+
+} // anonymous namespace
+
+GridHaloExchange::
+GridHaloExchange (const std::shared_ptr<const GridImportExport>& imp_exp,
+                  const Direction direction,
+                  const int mpi_tag)
+ : m_imp_exp (imp_exp)
+ , m_direction (direction)
+ , m_mpi_tag (mpi_tag)
+{
+  EKAT_REQUIRE_MSG (imp_exp!=nullptr,
+      "Error! Input GridImportExport pointer is null.\n");
+  EKAT_REQUIRE_MSG (direction==Scatter or direction==Gather,
+      "Error! Invalid direction for GridHaloExchange.\n");
+}
+
+GridHaloExchange::~GridHaloExchange ()
+{
+  // Don't leave messages in flight, since they reference our buffers
+  if (m_in_progress) {
+    MPI_Waitall(m_recv_req.size(),m_recv_req.data(),MPI_STATUSES_IGNORE);
+    MPI_Waitall(m_send_req.size(),m_send_req.data(),MPI_STATUSES_IGNORE);
+  }
+  for (auto& req : m_send_req)
+    MPI_Request_free(&req);
+  for (auto& req : m_recv_req)
+    MPI_Request_free(&req);
+}
+
+void GridHaloExchange::
+add_field (const Field& src, const Field& dst)
+{
+  using namespace ShortFieldTagsNames;
+
+  EKAT_REQUIRE_MSG (not m_setup_done,
+      "Error! Cannot add fields to GridHaloExchange after setup() was called.\n");
+
+  EKAT_REQUIRE_MSG (src.is_allocated() and dst.is_allocated(),
+      "Error! GridHaloExchange requires allocated fields.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - dst field: " + dst.name() + "\n");
+  EKAT_REQUIRE_MSG (src.data_type()==DataType::RealType and dst.data_type()==DataType::RealType,
+      "Error! GridHaloExchange only supports Real-valued fields.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - dst field: " + dst.name() + "\n");
+
+  const auto& src_fl = src.get_header().get_identifier().get_layout();
+  const auto& dst_fl = dst.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (src_fl.rank()>=1 and src_fl.rank()<=4,
+      "Error! GridHaloExchange only supports fields of rank 1 to 4.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - src layout: " + src_fl.to_string() + "\n");
+  EKAT_REQUIRE_MSG (src_fl.tag(0)==COL and dst_fl.tag(0)==COL,
+      "Error! GridHaloExchange requires COL to be the first field dimension.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - src layout: " + src_fl.to_string() + "\n"
+      "  - dst field: " + dst.name() + "\n"
+      "  - dst layout: " + dst_fl.to_string() + "\n");
+  EKAT_REQUIRE_MSG (src_fl.clone().strip_dim(0).congruent(dst_fl.clone().strip_dim(0)),
+      "Error! GridHaloExchange src/dst layouts differ in non-COL dimensions.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - src layout: " + src_fl.to_string() + "\n"
+      "  - dst field: " + dst.name() + "\n"
+      "  - dst layout: " + dst_fl.to_string() + "\n");
+
+  const auto unique = m_imp_exp->get_unique_grid();
+  const auto ov     = m_imp_exp->get_overlapped_grid();
+  const auto& src_grid = m_direction==Scatter ? unique : ov;
+  const auto& dst_grid = m_direction==Scatter ? ov : unique;
+  EKAT_REQUIRE_MSG (src_fl.dim(0)==src_grid->get_num_local_dofs(),
+      "Error! GridHaloExchange src field has the wrong number of columns.\n"
+      "  - src field: " + src.name() + "\n"
+      "  - field cols: " + std::to_string(src_fl.dim(0)) + "\n"
+      "  - grid cols : " + std::to_string(src_grid->get_num_local_dofs()) + "\n");
+  EKAT_REQUIRE_MSG (dst_fl.dim(0)==dst_grid->get_num_local_dofs(),
+      "Error! GridHaloExchange dst field has the wrong number of columns.\n"
+      "  - dst field: " + dst.name() + "\n"
+      "  - field cols: " + std::to_string(dst_fl.dim(0)) + "\n"
+      "  - grid cols : " + std::to_string(dst_grid->get_num_local_dofs()) + "\n");
+
+  m_src_fields.push_back(src);
+  m_dst_fields.push_back(dst);
+}
+
+void GridHaloExchange::setup ()
+{
+  EKAT_REQUIRE_MSG (not m_setup_done,
+      "Error! GridHaloExchange::setup() was already called.\n");
+
+  const auto& comm = m_imp_exp->get_unique_grid()->get_comm();
+  const int nranks = comm.size();
+  const bool scatter = m_direction==Scatter;
+
+  // Compute offset of each field when we splice together a col for each
+  const int nfields = m_src_fields.size();
+  m_field_offset.resize(nfields+1,0);
+  for (int i=0; i<nfields; ++i) {
+    const auto& fl = m_src_fields[i].get_header().get_identifier().get_layout();
+    m_field_offset[i+1] = m_field_offset[i] + fl.clone().strip_dim(0).size();
+  }
+  const int total_col_size = m_field_offset.back();
+
+  m_send_pids        = scatter ? m_imp_exp->export_pids() : m_imp_exp->import_pids();
+  m_send_lids        = scatter ? m_imp_exp->export_lids() : m_imp_exp->import_lids();
+  m_send_pid_offsets = scatter ? m_imp_exp->export_pid_offsets() : m_imp_exp->import_pid_offsets();
+  m_recv_pids        = scatter ? m_imp_exp->import_pids() : m_imp_exp->export_pids();
+  m_recv_lids        = scatter ? m_imp_exp->import_lids() : m_imp_exp->export_lids();
+  m_recv_pid_offsets = scatter ? m_imp_exp->import_pid_offsets() : m_imp_exp->export_pid_offsets();
+
+  const int num_sends = scatter ? m_imp_exp->num_exports() : m_imp_exp->num_imports();
+  const int num_recvs = scatter ? m_imp_exp->num_imports() : m_imp_exp->num_exports();
+
+  m_setup_done = true;
+  if (total_col_size==0) {
+    // Nothing to exchange
+    return;
+  }
+
+  // ----------- Create send/recv buffers -------------- //
+
+  m_send_buffer = view_1d<Real>("GridHaloExchange::send_buf",num_sends*total_col_size);
+  m_recv_buffer = view_1d<Real>("GridHaloExchange::recv_buf",num_recvs*total_col_size);
+  m_mpi_send_buffer = Kokkos::create_mirror_view(typename mpi_view_1d<Real>::execution_space(),m_send_buffer);
+  m_mpi_recv_buffer = Kokkos::create_mirror_view(typename mpi_view_1d<Real>::execution_space(),m_recv_buffer);
+
+  // ----------- Create Requests ------------ //
+
+  auto send_offsets_h = scatter ? m_imp_exp->export_pid_offsets_h() : m_imp_exp->import_pid_offsets_h();
+  auto recv_offsets_h = scatter ? m_imp_exp->import_pid_offsets_h() : m_imp_exp->export_pid_offsets_h();
+
+  const auto mpi_comm = comm.mpi_comm();
+  const auto mpi_real = ekat::get_mpi_type<Real>();
+  for (int pid=0; pid<nranks; ++pid) {
+    int ncols_send = send_offsets_h(pid+1)-send_offsets_h(pid);
+    if (ncols_send>0) {
+      auto send_ptr = m_mpi_send_buffer.data() + send_offsets_h(pid)*total_col_size;
+      auto& req = m_send_req.emplace_back();
+      check_mpi_call(MPI_Send_init (send_ptr, ncols_send*total_col_size, mpi_real, pid,
+                                    m_mpi_tag, mpi_comm, &req),
+                     "GridHaloExchange::setup, creating persistent send request.\n");
+    }
+    int ncols_recv = recv_offsets_h(pid+1)-recv_offsets_h(pid);
+    if (ncols_recv>0) {
+      auto recv_ptr = m_mpi_recv_buffer.data() + recv_offsets_h(pid)*total_col_size;
+      auto& req = m_recv_req.emplace_back();
+      check_mpi_call(MPI_Recv_init (recv_ptr, ncols_recv*total_col_size, mpi_real, pid,
+                                    m_mpi_tag, mpi_comm, &req),
+                     "GridHaloExchange::setup, creating persistent recv request.\n");
+    }
+  }
+
+  if (not scatter) {
+    // The gather unpack is a reduction: group recv entries by dst lid,
+    // so that each thread accumulates into a different column
+    const int num_dst_cols = m_imp_exp->get_unique_grid()->get_num_local_dofs();
+    m_recv_idxs_sorted_by_lid = view_1d<int>("recv_idxs_sorted_by_lid",num_recvs);
+    m_recv_lids_offsets       = view_1d<int>("recv_lids_offsets",num_dst_cols+1);
+    auto idxs_h    = Kokkos::create_mirror_view(m_recv_idxs_sorted_by_lid);
+    auto offsets_h = Kokkos::create_mirror_view(m_recv_lids_offsets);
+    auto lids_h    = m_imp_exp->export_lids_h();
+
+    std::vector<int> count (num_dst_cols,0);
+    for (int idx=0; idx<num_recvs; ++idx) {
+      ++count[lids_h[idx]];
+    }
+    offsets_h[0] = 0;
+    for (int lid=0; lid<num_dst_cols; ++lid) {
+      offsets_h[lid+1] = offsets_h[lid] + count[lid];
+    }
+    std::vector<int> pos (offsets_h.data(),offsets_h.data()+num_dst_cols);
+    for (int idx=0; idx<num_recvs; ++idx) {
+      idxs_h[pos[lids_h[idx]]++] = idx;
+    }
+    Kokkos::deep_copy(m_recv_idxs_sorted_by_lid,idxs_h);
+    Kokkos::deep_copy(m_recv_lids_offsets,offsets_h);
+  }
+}
+
+void GridHaloExchange::start ()
+{
+  EKAT_REQUIRE_MSG (m_setup_done,
+      "Error! GridHaloExchange::start() called before setup().\n");
+  EKAT_REQUIRE_MSG (not m_in_progress,
+      "Error! GridHaloExchange::start() called while an exchange is already in progress.\n");
+
+  const auto& comm = m_imp_exp->get_unique_grid()->get_comm();
+
+  // Fire the recv requests right away, so that if some other ranks
+  // is done packing before us, we can start receiving their data
+  if (not m_recv_req.empty()) {
+    check_mpi_call(MPI_Startall(m_recv_req.size(),m_recv_req.data()),
+                   "GridHaloExchange::start, starting persistent recv requests.\n"
+                   "  - recv rank: " + std::to_string(comm.rank()) + "\n");
+  }
+
+  const int nfields = m_src_fields.size();
+  for (int ifield=0; ifield<nfields; ++ifield) {
+    const auto& fl = m_src_fields[ifield].get_header().get_identifier().get_layout();
+    switch (fl.rank()) {
+      case 1: pack_field<1>(ifield); break;
+      case 2: pack_field<2>(ifield); break;
+      case 3: pack_field<3>(ifield); break;
+      case 4: pack_field<4>(ifield); break;
+      default:
+        EKAT_ERROR_MSG ("Unexpected field rank in GridHaloExchange::start.\n"
+            "  - MPI rank  : " + std::to_string(comm.rank()) + "\n"
+            "  - field name: " + m_src_fields[ifield].name() + "\n"
+            "  - field rank: " + std::to_string(fl.rank()) + "\n");
+    }
+  }
+
+  // Ensure all threads are done packing before firing off the sends
+  Kokkos::fence();
+
+  // If MPI does not use dev pointers, we need to deep copy from dev to host
+  if (not MpiOnDev) {
+    Kokkos::deep_copy (m_mpi_send_buffer,m_send_buffer);
+  }
+
+  if (not m_send_req.empty()) {
+    check_mpi_call(MPI_Startall(m_send_req.size(),m_send_req.data()),
+                   "GridHaloExchange::start, starting persistent send requests.\n"
+                   "  - send rank: " + std::to_string(comm.rank()) + "\n");
+  }
+
+  m_in_progress = true;
+}
+
+void GridHaloExchange::finish ()
+{
+  EKAT_REQUIRE_MSG (m_in_progress,
+      "Error! GridHaloExchange::finish() called without a matching start().\n");
+
+  if (not m_recv_req.empty()) {
+    check_mpi_call(MPI_Waitall(m_recv_req.size(),m_recv_req.data(),MPI_STATUSES_IGNORE),
+                   "GridHaloExchange::finish, waiting on persistent recv requests.\n");
+  }
+
+  // If MPI does not use dev pointers, we need to deep copy from host to dev
+  if (not MpiOnDev) {
+    Kokkos::deep_copy (m_recv_buffer,m_mpi_recv_buffer);
+  }
+
+  const int nfields = m_dst_fields.size();
+  for (int ifield=0; ifield<nfields; ++ifield) {
+    const auto& fl = m_dst_fields[ifield].get_header().get_identifier().get_layout();
+    switch (fl.rank()) {
+      case 1: unpack_field<1>(ifield); break;
+      case 2: unpack_field<2>(ifield); break;
+      case 3: unpack_field<3>(ifield); break;
+      case 4: unpack_field<4>(ifield); break;
+      default:
+        EKAT_ERROR_MSG ("Unexpected field rank in GridHaloExchange::finish.\n"
+            "  - field name: " + m_dst_fields[ifield].name() + "\n"
+            "  - field rank: " + std::to_string(fl.rank()) + "\n");
+    }
+  }
+
+  // The send buffer is reused by the next start(), so sends must be complete
+  if (not m_send_req.empty()) {
+    check_mpi_call(MPI_Waitall(m_send_req.size(),m_send_req.data(),MPI_STATUSES_IGNORE),
+                   "GridHaloExchange::finish, waiting on persistent send requests.\n");
+  }
+
+  m_in_progress = false;
+}
+
+template<int N>
+void GridHaloExchange::pack_field (const int ifield)
+{
+  using TeamMember = typename KT::MemberType;
+  using TPF        = ekat::TeamPolicyFactory<typename KT::ExeSpace>;
+  using DT         = typename ekat::DataND<const Real,N>::type;
+
+  const auto& f  = m_src_fields[ifield];
+  const auto& fl = f.get_header().get_identifier().get_layout();
+  const auto v   = f.get_view<DT>();
+
+  const int dim2 = N>2 ? fl.dim(2) : 1;
+  const int dim3 = N>3 ? fl.dim(3) : 1;
+  const int f_col_size = fl.clone().strip_dim(0).size();
+  const int field_offset = m_field_offset[ifield];
+  const int total_col_size = m_field_offset.back();
+
+  const auto pids = m_send_pids;
+  const auto lids = m_send_lids;
+  const auto pids_offsets = m_send_pid_offsets;
+  const auto send_buf = m_send_buffer;
+  const int num_sends = lids.size();
+
+  auto policy = TPF::get_default_team_policy(num_sends,f_col_size);
+  auto pack = KOKKOS_LAMBDA (const TeamMember& team) {
+    const int idx  = team.league_rank();
+    const int pid  = pids(idx);
+    const int icol = lids(idx);
+    const int pid_offset = pids_offsets(pid);
+    const int ncols_send = pids_offsets(pid+1) - pid_offset;
+    const int pos_within_pid = idx - pid_offset;
+    const int offset = pid_offset*total_col_size
+                     + ncols_send*field_offset
+                     + pos_within_pid*f_col_size;
+    auto col_pack = [&](const int k) {
+      send_buf(offset+k) = col_entry(v,icol,k,dim2,dim3);
+    };
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,f_col_size),col_pack);
+  };
+  Kokkos::parallel_for(policy,pack);
+}
+
+template<int N>
+void GridHaloExchange::unpack_field (const int ifield)
+{
+  using TeamMember = typename KT::MemberType;
+  using TPF        = ekat::TeamPolicyFactory<typename KT::ExeSpace>;
+  using DT         = typename ekat::DataND<Real,N>::type;
+
+  auto& f  = m_dst_fields[ifield];
+  const auto& fl = f.get_header().get_identifier().get_layout();
+  const auto v   = f.get_view<DT>();
+
+  const int dim2 = N>2 ? fl.dim(2) : 1;
+  const int dim3 = N>3 ? fl.dim(3) : 1;
+  const int f_col_size = fl.clone().strip_dim(0).size();
+  const int field_offset = m_field_offset[ifield];
+  const int total_col_size = m_field_offset.back();
+
+  const auto pids = m_recv_pids;
+  const auto pids_offsets = m_recv_pid_offsets;
+  const auto recv_buf = m_recv_buffer;
+
+  if (m_direction==Scatter) {
+    const auto lids = m_recv_lids;
+    const int num_recvs = lids.size();
+    auto policy = TPF::get_default_team_policy(num_recvs,f_col_size);
+    auto unpack = KOKKOS_LAMBDA (const TeamMember& team) {
+      const int idx  = team.league_rank();
+      const int pid  = pids(idx);
+      const int icol = lids(idx);
+      const int pid_offset = pids_offsets(pid);
+      const int ncols_recv = pids_offsets(pid+1) - pid_offset;
+      const int pos_within_pid = idx - pid_offset;
+      const int offset = pid_offset*total_col_size
+                       + ncols_recv*field_offset
+                       + pos_within_pid*f_col_size;
+      auto col_unpack = [&](const int k) {
+        col_entry(v,icol,k,dim2,dim3) = recv_buf(offset+k);
+      };
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,f_col_size),col_unpack);
+    };
+    Kokkos::parallel_for(policy,unpack);
+  } else {
+    const auto recv_idxs = m_recv_idxs_sorted_by_lid;
+    const auto lids_offsets = m_recv_lids_offsets;
+    const int num_dst_cols = fl.dim(0);
+    auto policy = TPF::get_default_team_policy(num_dst_cols,f_col_size);
+    auto unpack = KOKKOS_LAMBDA (const TeamMember& team) {
+      const int icol = team.league_rank();
+      const int beg  = lids_offsets(icol);
+      const int end  = lids_offsets(icol+1);
+      auto col_unpack = [&](const int k) {
+        Real sum = 0;
+        for (int pos=beg; pos<end; ++pos) {
+          const int idx = recv_idxs(pos);
+          const int pid = pids(idx);
+          const int pid_offset = pids_offsets(pid);
+          const int ncols_recv = pids_offsets(pid+1) - pid_offset;
+          const int pos_within_pid = idx - pid_offset;
+          const int offset = pid_offset*total_col_size
+                           + ncols_recv*field_offset
+                           + pos_within_pid*f_col_size;
+          sum += recv_buf(offset+k);
+        }
+        col_entry(v,icol,k,dim2,dim3) = sum;
+      };
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,f_col_size),col_unpack);
+    };
+    Kokkos::parallel_for(policy,unpack);
+  }
+}
+
+} // namespace scream
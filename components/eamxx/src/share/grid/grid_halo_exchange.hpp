@@ -0,0 +1,154 @@
+#ifndef EAMXX_GRID_HALO_EXCHANGE_HPP
+#define EAMXX_GRID_HALO_EXCHANGE_HPP
+
+#include "share/grid/grid_import_export.hpp"
+#include "share/field/field.hpp"
+
+#include <mpi.h>
+#include <memory>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A reusable exchange of Field data between the two grids of a GridImportExport.
+ *
+ * Unlike GridImportExport::scatter/gather, this class is meant for hot paths:
+ *   - it operates on Field objects, packing/unpacking on device
+ *   - send/recv buffers and MPI requests are created once, in setup(),
+ *     and the requests are persistent (MPI_Send_init/MPI_Recv_init)
+ *   - the exchange is split-phase (start/finish), so that callers can
+ *     do independent work while messages are in flight
+ *
+ * Two directions are supported:
+ *   - Scatter: src fields live on the unique grid, dst fields on the
+ *              overlapped grid. Each overlapped column receives a copy
+ *              of the owner's data.
+ *   - Gather:  src fields live on the overlapped grid, dst fields on the
+ *              unique grid. Each unique column receives the *sum* of the
+ *              contributions from all overlapped copies of it. Unique
+ *              columns that do not appear in any overlapped grid are set to 0.
+ *
+ * All fields must be Real-valued and have COL as first dimension. src/dst
+ * layouts must match, except for the number of columns. Several fields can be
+ * registered, and are exchanged with a single message per remote rank.
+ *
+ * Usage:
+ *   GridHaloExchange hx(imp_exp,GridHaloExchange::Scatter);
+ *   hx.add_field(f_unique,f_overlapped);
+ *   hx.setup();
+ *   ...
+ *   hx.start();
+ *   // do work not involving the dst fields
+ *   hx.finish();
+ *
+ * src fields can be modified again after start() returns, since data has
+ * already been packed. dst fields must not be accessed until finish() returns.
+ * If two exchanges on the same communicator can be in flight at the same
+ * time, they must use different MPI tags.
+ */
+
+class GridHaloExchange {
+public:
+  enum Direction {
+    Scatter,
+    Gather
+  };
+
+  GridHaloExchange (const std::shared_ptr<const GridImportExport>& imp_exp,
+                    const Direction direction,
+                    const int mpi_tag = 0);
+  GridHaloExchange (const GridHaloExchange&) = delete;
+  ~GridHaloExchange ();
+
+  GridHaloExchange& operator= (const GridHaloExchange&) = delete;
+
+  // Register a pair of fields. Must be called before setup()
+  void add_field (const Field& src, const Field& dst);
+
+  // Create buffers and persistent requests. No more fields can be added afterwards
+  void setup ();
+
+  // Post recvs, pack src fields, and post sends
+  void start ();
+
+  // Wait for recvs, unpack into dst fields, and wait for sends to complete
+  void finish ();
+
+  // Convenience function, equivalent to start()+finish()
+  void exchange () { start(); finish(); }
+
+  Direction direction () const { return m_direction; }
+  int num_fields () const { return m_src_fields.size(); }
+  bool is_setup () const { return m_setup_done; }
+  bool in_progress () const { return m_in_progress; }
+
+#ifndef KOKKOS_ENABLE_CUDA
+protected:
+#endif
+  // These need to be accessible by CUDA lambdas
+  template<int N>
+  void pack_field (const int ifield);
+  template<int N>
+  void unpack_field (const int ifield);
+
+protected:
+
+  static constexpr bool MpiOnDev = SCREAM_MPI_ON_DEVICE;
+
+  using KT = KokkosTypes<DefaultDevice>;
+
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using hview_1d = typename view_1d<T>::host_mirror_type;
+
+  // If MpiOnDev=true, we can pass device pointers to MPI. Otherwise, we need host mirrors.
+  template<typename T>
+  using mpi_view_1d = std::conditional_t<MpiOnDev,view_1d<T>,hview_1d<T>>;
+
+  std::shared_ptr<const GridImportExport>   m_imp_exp;
+  Direction                                 m_direction;
+  int                                       m_mpi_tag;
+
+  std::vector<Field>    m_src_fields;
+  std::vector<Field>    m_dst_fields;
+
+  // Offset of each field when we splice together one col of each.
+  std::vector<int>      m_field_offset;
+
+  // pids/lids/offsets used on the send and recv side. For Scatter, we send
+  // using the export data and recv using the import data. For Gather, it's the opposite.
+  view_1d<int>  m_send_pids;
+  view_1d<int>  m_send_lids;
+  view_1d<int>  m_send_pid_offsets;
+  view_1d<int>  m_recv_pids;
+  view_1d<int>  m_recv_pid_offsets;
+
+  // For Scatter, the dst lid of each recv entry. For Gather, since the unpack is
+  // a reduction, we group recv entries by dst lid instead, so that different
+  // threads never update the same column.
+  view_1d<int>  m_recv_lids;
+  view_1d<int>  m_recv_idxs_sorted_by_lid;
+  view_1d<int>  m_recv_lids_offsets;
+
+  // The send/recv buffers for pack/unpack operations
+  view_1d<Real> m_send_buffer;
+  view_1d<Real> m_recv_buffer;
+
+  // The send/recv buf to feed to MPI (alias the above two if MpiOnDev=true)
+  mpi_view_1d<Real> m_mpi_send_buffer;
+  mpi_view_1d<Real> m_mpi_recv_buffer;
+
+  // Send/recv persistent requests
+  std::vector<MPI_Request>  m_send_req;
+  std::vector<MPI_Request>  m_recv_req;
+
+  bool m_setup_done  = false;
+  bool m_in_progress = false;
+};
+
+} // namespace scream
+
+#endif // EAMXX_GRID_HALO_EXCHANGE_HPP
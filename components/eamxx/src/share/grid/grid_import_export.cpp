@@ -2,6 +2,9 @@
 
 #include "share/field/field_utils.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 namespace scream
 {
 
@@ -9,83 +12,42 @@ GridImportExport::
 GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
                   const std::shared_ptr<const AbstractGrid>& overlapped)
 {
-  EKAT_REQUIRE_MSG (unique!=nullptr, "Error! Input unique grid pointer is null.\n");
-  EKAT_REQUIRE_MSG (overlapped!=nullptr, "Error! Input overlapped grid pointer is null.\n");
-
-  EKAT_REQUIRE_MSG (unique->is_unique(),
-      "Error! GridImportExport unique grid is not unique.\n");
-
-  m_unique = unique;
-  m_overlapped = overlapped;
-  m_comm = unique->get_comm();
+  set_grids(unique,overlapped);
 
-  // Note: we can't use the gids views from the grids, since we need to pass pointers
-  //       to MPI bcast routines, which require pointers to nonconst data.
-  //       Hence, create a clone, and grab a non-const pointer from it.
-  const auto unique_gids_f = unique->get_dofs_gids().clone(CloneFlags::CopyData);
-  const auto overlap_gids_f = overlapped->get_dofs_gids().clone(CloneFlags::CopyData);
-  const auto    gids = unique_gids_f.get_view<gid_type*,Host>();
-  const auto ov_gids = overlap_gids_f.get_view<gid_type*,Host>();
-
-  int num_ov_gids = ov_gids.size();
-
-  gid_type* data;
-  std::vector<gid_type> pid_gids;
-  std::map<int,std::vector<int>> pid2lids;
-  int pos;
+  const auto ov_gids = overlapped->get_dofs_gids().get_view<const gid_type*,Host>();
+  const int num_ov_gids = ov_gids.size();
+  const int nranks = m_comm.size();
 
   // ------------------ Create import structures ----------------------- //
 
-  // Resize output
+  // Locate owner pid and (remote) lid of each overlapped gid (see GridGidDirectory)
+  std::vector<int> remote_pids, remote_lids;
+  unique->get_remote_pids_and_lids(ov_gids,remote_pids,remote_lids);
+  m_num_imports = num_ov_gids;
+
+  // IMPORTANT! Within each PID, we order the list of imports according to the *remote*
+  // ordering. In order for p2p messages to be consistent, the export data must order
+  // the list of exports according to the *local* ordering.
+  std::vector<int> ov_lids(num_ov_gids);
+  std::iota(ov_lids.begin(),ov_lids.end(),0);
+  std::sort(ov_lids.begin(),ov_lids.end(),[&](const int a, const int b) {
+    return remote_pids[a]<remote_pids[b] or
+           (remote_pids[a]==remote_pids[b] and remote_lids[a]<remote_lids[b]);
+  });
+
   m_import_lids = decltype(m_import_lids)("",num_ov_gids);
   m_import_pids = decltype(m_import_pids)("",num_ov_gids);
-
   m_import_lids_h = Kokkos::create_mirror_view(m_import_lids);
   m_import_pids_h = Kokkos::create_mirror_view(m_import_pids);
-  Kokkos::deep_copy(m_import_pids_h,-1);
-
-  // We may have repeated gids. In that case, we want to update
-  // the pids/lids arrays at all indices corresponding to the same gid
-  auto ov_gid2lid = overlapped->get_gid2lid_map();
-
-  // Let each rank bcast its src gids, so that other procs can
-  // check against their dst grid
-  for (int pid=0; pid<m_comm.size(); ++pid) {
-    // Bcast dst gids count for this pid
-    int num_gids_pid = gids.size();
-    m_comm.broadcast(&num_gids_pid,1,pid);
-
-    // Bcast gids
-    if (pid==m_comm.rank()) {
-      data = gids.data();
-    } else {
-      pid_gids.resize(num_gids_pid);
-      data = pid_gids.data();
-    }
-    m_comm.broadcast(data,num_gids_pid,pid);
-
-    // Checks if any of this pid's gids in the dst gids list
-    for (int i=0; i<num_gids_pid; ++i) {
-      auto it = ov_gid2lid.find(data[i]);
-      if (it!=ov_gid2lid.end()) {
-        pid2lids[pid].push_back(it->second);
-        ++m_num_imports;
-      }
-    }
-  }
-  EKAT_REQUIRE_MSG (num_ov_gids==m_num_imports,
-      "Error! Could not locate the owner of one of the dst grid GIDs.\n"
-      "  - rank: " + std::to_string(m_comm.rank()) + "\n"
-      "  - num found: " + std::to_string(m_num_imports) + "\n"
-      "  - num dst gids: " + std::to_string(num_ov_gids) + "\n");
-
-  pos=0;
-  for (const auto& [pid,lids] : pid2lids) {
-    for (auto lid : lids) {
-      m_import_lids_h(pos) = lid;
-      m_import_pids_h(pos) = pid;
-      ++pos;
-    }
+
+  std::vector<int> imp_count (nranks,0);
+  std::vector<int> send_lids (num_ov_gids);
+  for (int pos=0; pos<num_ov_gids; ++pos) {
+    const int lid = ov_lids[pos];
+    m_import_lids_h(pos) = lid;
+    m_import_pids_h(pos) = remote_pids[lid];
+    send_lids[pos] = remote_lids[lid];
+    ++imp_count[remote_pids[lid]];
   }
 
   Kokkos::deep_copy(m_import_lids,m_import_lids_h);
@@ -93,63 +55,90 @@ GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
 
   // ------------------ Create export structures ----------------------- //
 
-  auto gid2lid = unique->get_gid2lid_map();
-
-  // Let each rank bcast its src gids, so that other procs can
-  // check against their dst grid
-  // Note: we don't know a priori how many PIDs will need each
-  // of our dofs, so we cannot insert in the export pids/lids views yet,
-  // and must use a temporary map to store results
-  pid2lids.clear();
-  for (int pid=0; pid<m_comm.size(); ++pid) {
-    // Bcast dst gids count for this pid
-    int num_gids_pid = ov_gids.size();
-    m_comm.broadcast(&num_gids_pid,1,pid);
-
-    // Bcast gids
-    if (pid==m_comm.rank()) {
-      data = ov_gids.data();
-    } else {
-      pid_gids.resize(num_gids_pid);
-      data = pid_gids.data();
-    }
-    m_comm.broadcast(data,num_gids_pid,pid);
-
-    // Checks if any of the src lids is in the list of needs of this pid
-    for (int i=0; i<num_gids_pid; ++i) {
-      auto it = gid2lid.find(data[i]);
-      if (it!=gid2lid.end()) {
-        pid2lids[pid].push_back(it->second);
-        ++m_num_exports;
-      }
-    }
+  // The exports are the transpose of the imports: send to each owner the (owner) lids
+  // we import from it. These are already sorted by lid, as required (see above).
+  std::vector<int> exp_count (nranks);
+  check_mpi_call(MPI_Alltoall(imp_count.data(),1,MPI_INT,exp_count.data(),1,MPI_INT,m_comm.mpi_comm()),
+                 "GridImportExport, exchanging import/export counts");
 
-    // IMPORTANT! When building the import data, within each PID, we order
-    // the list of imports according to the *remote* ordering. In order for
-    // p2p messages to be consistent, the export data must order the
-    // list of exports according to the *local* ordring.
-    std::sort(pid2lids[pid].begin(),pid2lids[pid].end());
+  std::vector<int> imp_offset (nranks,0), exp_offset (nranks,0);
+  for (int pid=1; pid<nranks; ++pid) {
+    imp_offset[pid] = imp_offset[pid-1] + imp_count[pid-1];
+    exp_offset[pid] = exp_offset[pid-1] + exp_count[pid-1];
   }
+  m_num_exports = exp_offset[nranks-1] + exp_count[nranks-1];
 
   m_export_pids = view_d("",m_num_exports);
   m_export_lids = view_d("",m_num_exports);
   m_export_lids_h = Kokkos::create_mirror_view(m_export_lids);
   m_export_pids_h = Kokkos::create_mirror_view(m_export_pids);
 
-  pos=0;
-  for (const auto& [pid,lids] : pid2lids) {
-    for (auto lid : lids) {
-      m_export_lids_h(pos) = lid;
+  check_mpi_call(MPI_Alltoallv(send_lids.data(),imp_count.data(),imp_offset.data(),MPI_INT,
+                               m_export_lids_h.data(),exp_count.data(),exp_offset.data(),MPI_INT,
+                               m_comm.mpi_comm()),
+                 "GridImportExport, exchanging export lids");
+  for (int pid=0; pid<nranks; ++pid) {
+    for (int pos=exp_offset[pid]; pos<exp_offset[pid]+exp_count[pid]; ++pos) {
       m_export_pids_h(pos) = pid;
-      ++pos;
     }
   }
 
   Kokkos::deep_copy(m_export_pids,m_export_pids_h);
   Kokkos::deep_copy(m_export_lids,m_export_lids_h);
 
-  // ------------------ Create offset views ----------------------- //
+  compute_pid_offsets();
+}
+
+GridImportExport::
+GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
+                  const std::shared_ptr<const AbstractGrid>& overlapped,
+                  const std::vector<int>& import_pids,
+                  const std::vector<int>& import_lids,
+                  const std::vector<int>& export_pids,
+                  const std::vector<int>& export_lids)
+{
+  set_grids(unique,overlapped);
+
+  m_num_imports = import_pids.size();
+  m_num_exports = export_pids.size();
+  EKAT_REQUIRE_MSG (m_num_imports==overlapped->get_num_local_dofs(),
+      "Error! Number of imports does not match the number of overlapped grid dofs.\n"
+      "  - num imports: " + std::to_string(m_num_imports) + "\n"
+      "  - num overlapped dofs: " + std::to_string(overlapped->get_num_local_dofs()) + "\n");
+  EKAT_REQUIRE_MSG (import_lids.size()==import_pids.size() and export_lids.size()==export_pids.size(),
+      "Error! Import/export pids and lids must have the same size.\n");
+
+  auto to_views = [](const std::vector<int>& v, view_d& d, view_h& h) {
+    d = view_d("",v.size());
+    h = Kokkos::create_mirror_view(d);
+    std::copy(v.begin(),v.end(),h.data());
+    Kokkos::deep_copy(d,h);
+  };
+  to_views(import_pids,m_import_pids,m_import_pids_h);
+  to_views(import_lids,m_import_lids,m_import_lids_h);
+  to_views(export_pids,m_export_pids,m_export_pids_h);
+  to_views(export_lids,m_export_lids,m_export_lids_h);
+
+  compute_pid_offsets();
+}
+
+void GridImportExport::
+set_grids (const std::shared_ptr<const AbstractGrid>& unique,
+           const std::shared_ptr<const AbstractGrid>& overlapped)
+{
+  EKAT_REQUIRE_MSG (unique!=nullptr, "Error! Input unique grid pointer is null.\n");
+  EKAT_REQUIRE_MSG (overlapped!=nullptr, "Error! Input overlapped grid pointer is null.\n");
+
+  EKAT_REQUIRE_MSG (unique->is_unique(),
+      "Error! GridImportExport unique grid is not unique.\n");
+
+  m_unique = unique;
+  m_overlapped = overlapped;
+  m_comm = unique->get_comm();
+}
 
+void GridImportExport::compute_pid_offsets ()
+{
   // Compute offsets of each pid in import/export views
   m_export_pid_offset = view_d("",m_comm.size()+1);
   m_export_pid_offset_h = Kokkos::create_mirror_view(m_export_pid_offset);
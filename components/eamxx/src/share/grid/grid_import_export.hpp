@@ -39,6 +39,9 @@ namespace scream
  * for ease of use in non-performance critical code.
  * On the other hand, the import/export data (pids/lids) can
  * be used both on host and device, for more efficient pack/unpack methods.
+ * For exchanging Field data in performance critical code, see
+ * GridHaloExchange (grid_halo_exchange.hpp), which uses these views
+ * with device pack/unpack and persistent MPI requests.
  */
 
 class GridImportExport {
@@ -49,6 +52,15 @@ public:
 
   GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
                     const std::shared_ptr<const AbstractGrid>& overlapped);
+
+  // Use precomputed import/export pids/lids (e.g., saved from a previous run).
+  // They must be sorted as the ones computed by the other constructor (see below).
+  GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
+                    const std::shared_ptr<const AbstractGrid>& overlapped,
+                    const std::vector<int>& import_pids,
+                    const std::vector<int>& import_lids,
+                    const std::vector<int>& export_pids,
+                    const std::vector<int>& export_lids);
   ~GridImportExport () = default;
 
   template<typename T>
@@ -61,6 +73,9 @@ public:
                const std::map<int,std::vector<T>>& src,
                      std::map<int,std::vector<T>>& dst) const;
 
+  std::shared_ptr<const AbstractGrid> get_unique_grid () const { return m_unique; }
+  std::shared_ptr<const AbstractGrid> get_overlapped_grid () const { return m_overlapped; }
+
   int num_exports () const { return m_num_exports; }
   int num_imports () const { return m_num_imports; }
 
@@ -83,6 +98,12 @@ protected:
 
   using gid_type = AbstractGrid::gid_type;
 
+  void set_grids (const std::shared_ptr<const AbstractGrid>& unique,
+                  const std::shared_ptr<const AbstractGrid>& overlapped);
+
+  // Compute import/export pid offsets from import/export pids
+  void compute_pid_offsets ();
+
   std::shared_ptr<const AbstractGrid>   m_unique;
   std::shared_ptr<const AbstractGrid>   m_overlapped;
 
@@ -0,0 +1,237 @@
+#include <catch2/catch.hpp>
+
+#include "share/grid/point_grid.hpp"
+#include "share/grid/grid_halo_exchange.hpp"
+#include "share/core/eamxx_setup_random_test.hpp"
+#include "share/core/eamxx_types.hpp"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace {
+
+using namespace scream;
+using namespace scream::ShortFieldTagsNames;
+
+// Create a field of given rank on the given grid. When padding=true, request
+// an allocation pack size that forces padding along the last dimension
+Field create_field (const std::string& name, const AbstractGrid& grid,
+                    const int rank, const bool padding)
+{
+  const auto gn = grid.name();
+  FieldLayout fl;
+  switch (rank) {
+    case 1: fl = grid.get_2d_scalar_layout();           break;
+    case 2: fl = grid.get_3d_scalar_layout(LEV);        break;
+    case 3: fl = grid.get_3d_vector_layout(LEV,2);      break;
+    case 4: fl = grid.get_3d_tensor_layout(LEV,{2,3});  break;
+    default:
+      EKAT_ERROR_MSG ("Unsupported rank in create_field.\n");
+  }
+  Field f(FieldIdentifier(name,fl,ekat::units::none,gn));
+  if (padding) {
+    f.get_header().get_alloc_properties().request_allocation(SCREAM_PACK_SIZE);
+  }
+  f.allocate_view();
+  return f;
+}
+
+// Value for the k-th entry (linear index over non-COL dims) of col with given gid
+Real col_value (const AbstractGrid::gid_type gid, const int k) {
+  return gid*100 + k;
+}
+
+// Fill/read the k-th entry of each col, regardless of field rank
+template<typename Func>
+void for_each_col_entry (const Field& f, Func&& func)
+{
+  const auto& fl = f.get_header().get_identifier().get_layout();
+  const int ncols = fl.dim(0);
+  switch (fl.rank()) {
+    case 1:
+    {
+      auto v = f.get_view<Real*,Host>();
+      for (int i=0; i<ncols; ++i) func(i,0,v(i));
+      break;
+    }
+    case 2:
+    {
+      auto v = f.get_view<Real**,Host>();
+      for (int i=0; i<ncols; ++i)
+        for (int j=0; j<fl.dim(1); ++j)
+          func(i,j,v(i,j));
+      break;
+    }
+    case 3:
+    {
+      auto v = f.get_view<Real***,Host>();
+      for (int i=0; i<ncols; ++i)
+        for (int j=0; j<fl.dim(1); ++j)
+          for (int k=0; k<fl.dim(2); ++k)
+            func(i,j*fl.dim(2)+k,v(i,j,k));
+      break;
+    }
+    case 4:
+    {
+      auto v = f.get_view<Real****,Host>();
+      for (int i=0; i<ncols; ++i)
+        for (int j=0; j<fl.dim(1); ++j)
+          for (int k=0; k<fl.dim(2); ++k)
+            for (int l=0; l<fl.dim(3); ++l)
+              func(i,(j*fl.dim(2)+k)*fl.dim(3)+l,v(i,j,k,l));
+      break;
+    }
+  }
+}
+
+TEST_CASE ("grid_halo_exchange") {
+  using gid_type = AbstractGrid::gid_type;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  auto engine = setup_random_test(&comm);
+
+  const int overlap = 5;
+  const int nldofs  = 10;
+  const int nlevs   = 7;
+  const int ngdofs  = nldofs*comm.size();
+
+  // Create the unique grid
+  auto grid = create_point_grid("src",ngdofs,nlevs,comm);
+  auto gids = grid->get_dofs_gids().get_view<const gid_type*, Host>();
+
+  // For the overlapped grid, shuffle dofs around randomly. Then,
+  // have each rank grab a few extra dofs
+  std::vector<gid_type> all_dofs (ngdofs);
+  if (comm.am_i_root()) {
+    std::iota(all_dofs.data(),all_dofs.data()+all_dofs.size(),0);
+    std::shuffle(all_dofs.data(),all_dofs.data()+ngdofs,engine);
+  }
+  comm.broadcast(all_dofs.data(),ngdofs,comm.root_rank());
+
+  const bool first = comm.rank()==0;
+  const bool last  = comm.rank()==(comm.size()-1);
+  auto start = all_dofs.data() + nldofs*comm.rank();
+  auto end   = start + nldofs;
+  end   += last ? 0 : overlap;
+  start -= first ? 0 : overlap;
+  const int nldofs_ov = nldofs + (first ? 0 : overlap) + (last ? 0 : overlap);
+
+  auto ov_grid = std::make_shared<PointGrid>("ov_grid",nldofs_ov,nlevs,comm);
+  auto ov_gids_field = ov_grid->get_dofs_gids();
+  auto ov_gids = ov_gids_field.get_view<gid_type*,Host>();
+  std::copy (start,end,ov_gids.data());
+  ov_gids_field.sync_to_dev();
+
+  auto imp_exp = std::make_shared<GridImportExport>(grid,ov_grid);
+
+  // Number of ranks that have each gid in the overlapped grid
+  std::map<gid_type,int> gid2count;
+  for (int pid=0; pid<comm.size(); ++pid) {
+    int n = ov_gids.size();
+    comm.broadcast(&n,1,pid);
+    std::vector<gid_type> pid_gids(n);
+    if (pid==comm.rank()) {
+      std::copy(ov_gids.data(),ov_gids.data()+n,pid_gids.begin());
+    }
+    comm.broadcast(pid_gids.data(),n,pid);
+    for (auto g : pid_gids) {
+      ++gid2count[g];
+    }
+  }
+
+  // Fields of all ranks, with and without padding
+  std::vector<Field> unique_fields, ov_fields;
+  for (int rank=1; rank<=4; ++rank) {
+    for (bool padding : {false, true}) {
+      const auto name = "f" + std::to_string(rank) + (padding ? "_padded" : "");
+      unique_fields.push_back(create_field(name,*grid,rank,padding));
+      ov_fields.push_back(create_field(name,*ov_grid,rank,padding));
+    }
+  }
+
+  SECTION ("scatter") {
+    GridHaloExchange hx(imp_exp,GridHaloExchange::Scatter);
+    for (size_t i=0; i<unique_fields.size(); ++i) {
+      hx.add_field(unique_fields[i],ov_fields[i]);
+    }
+    hx.setup();
+    REQUIRE_THROWS (hx.add_field(unique_fields[0],ov_fields[0]));
+    REQUIRE_THROWS (hx.finish());
+
+    // Run twice, to make sure persistent requests can be restarted
+    for (int iter=0; iter<2; ++iter) {
+      for (auto& f : unique_fields) {
+        for_each_col_entry(f,[&](int icol, int k, Real& v) {
+          v = col_value(gids(icol),k) + iter;
+        });
+        f.sync_to_dev();
+      }
+      for (auto& f : ov_fields) {
+        f.deep_copy(-1);
+      }
+
+      hx.start();
+      REQUIRE (hx.in_progress());
+      REQUIRE_THROWS (hx.start());
+
+      // Changing src fields after start should not affect the result
+      for (auto& f : unique_fields) {
+        f.deep_copy(0);
+      }
+
+      hx.finish();
+      REQUIRE (not hx.in_progress());
+
+      for (auto& f : ov_fields) {
+        f.sync_to_host();
+        for_each_col_entry(f,[&](int icol, int k, Real& v) {
+          REQUIRE (v==col_value(ov_gids(icol),k)+iter);
+        });
+      }
+    }
+  }
+
+  SECTION ("gather") {
+    GridHaloExchange hx(imp_exp,GridHaloExchange::Gather);
+    for (size_t i=0; i<unique_fields.size(); ++i) {
+      hx.add_field(ov_fields[i],unique_fields[i]);
+    }
+    hx.setup();
+
+    for (auto& f : ov_fields) {
+      for_each_col_entry(f,[&](int icol, int k, Real& v) {
+        v = col_value(ov_gids(icol),k);
+      });
+      f.sync_to_dev();
+    }
+    for (auto& f : unique_fields) {
+      f.deep_copy(-1);
+    }
+
+    hx.exchange();
+
+    // Each unique col gets the sum of the contributions of all its copies
+    for (auto& f : unique_fields) {
+      f.sync_to_host();
+      for_each_col_entry(f,[&](int icol, int k, Real& v) {
+        const auto gid = gids(icol);
+        REQUIRE (v==gid2count[gid]*col_value(gid,k));
+      });
+    }
+  }
+
+  SECTION ("errors") {
+    GridHaloExchange hx(imp_exp,GridHaloExchange::Scatter);
+    if (comm.size()>1) {
+      // Wrong grid for src/dst (with one rank, the two grids have the same size)
+      REQUIRE_THROWS (hx.add_field(ov_fields[0],unique_fields[0]));
+    }
+    // Mismatching non-COL dims
+    REQUIRE_THROWS (hx.add_field(unique_fields[0],ov_fields[2]));
+    REQUIRE_THROWS (hx.start());
+  }
+}
+
+} // anonymous namespace
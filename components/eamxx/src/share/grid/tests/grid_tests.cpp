@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "share/grid/point_grid.hpp"
+#include "share/grid/grid_gid_directory.hpp"
 #include "share/core/eamxx_setup_random_test.hpp"
 #include "share/core/eamxx_types.hpp"
 
@@ -115,4 +116,73 @@ TEST_CASE ("get_remote_pids_and_lids") {
   }
 }
 
+TEST_CASE ("gid_directory") {
+  using gid_type = AbstractGrid::gid_type;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // Non-contiguous gids, with the last rank also holding a copy of gid 0
+  const int num_local_dofs = 10;
+  const int num_global_dofs = num_local_dofs*comm.size();
+  const int last = comm.size()-1;
+  std::vector<gid_type> my_gids;
+  for (int i=0; i<num_local_dofs; ++i) {
+    my_gids.push_back(2*(comm.rank()*num_local_dofs+i));
+  }
+
+  SECTION ("unique") {
+    GridGidDirectory dir(my_gids.data(),my_gids.size(),comm);
+    REQUIRE (dir.all_gids_unique());
+
+    // Query all gids, plus some that are not in the directory
+    std::vector<gid_type> gids;
+    for (int i=0; i<num_global_dofs; ++i) {
+      gids.push_back(2*i);
+    }
+    gids.push_back(1);
+    gids.push_back(-1);
+    gids.push_back(2*num_global_dofs);
+
+    std::vector<int> pids, lids, counts;
+    dir.query(gids.data(),gids.size(),pids,lids,counts);
+    for (int i=0; i<num_global_dofs; ++i) {
+      REQUIRE (pids[i]==i/num_local_dofs);
+      REQUIRE (lids[i]==i%num_local_dofs);
+      REQUIRE (counts[i]==1);
+    }
+    for (int i=num_global_dofs; i<num_global_dofs+3; ++i) {
+      REQUIRE (pids[i]==-1);
+      REQUIRE (lids[i]==-1);
+      REQUIRE (counts[i]==0);
+    }
+  }
+
+  SECTION ("non_unique") {
+    if (comm.rank()==last) {
+      my_gids.push_back(0);
+    }
+    GridGidDirectory dir(my_gids.data(),my_gids.size(),comm);
+    REQUIRE (not dir.all_gids_unique());
+
+    // The lowest pid holding the gid is returned
+    std::vector<gid_type> gids = {0, 0};
+    std::vector<int> pids, lids, counts;
+    dir.query(gids.data(),gids.size(),pids,lids,counts);
+    for (int i : {0,1}) {
+      REQUIRE (pids[i]==0);
+      REQUIRE (lids[i]==0);
+      REQUIRE (counts[i]==2);
+    }
+
+    // Check the grid as well
+    auto grid = std::make_shared<PointGrid>("grid",my_gids.size(),0,comm);
+    auto dofs = grid->get_dofs_gids();
+    auto dofs_h = dofs.get_view<gid_type*,Host>();
+    std::copy (my_gids.begin(),my_gids.end(),dofs_h.data());
+    dofs.sync_to_dev();
+    REQUIRE (not grid->is_unique());
+    REQUIRE_THROWS (grid->get_owners(gids));
+  }
+}
+
 } // namespace scream
@@ -3,6 +3,7 @@
 #include "share/scorpio_interface/eamxx_scorpio_interface.hpp"
 #include "share/physics/physics_constants.hpp"
 #include "share/util/eamxx_timing.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 #include "share/core/eamxx_config.hpp"
 
 #include <ekat_comm.hpp>
@@ -12,6 +13,7 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <memory>
 
 namespace scream
@@ -50,9 +52,21 @@ void OutputManager::
 setup (const std::shared_ptr<fm_type>& field_mgr,
        const std::set<std::string>& grid_names)
 {
+  // Fields allocated by this stream (diagnostics, remappers, helpers) are accounted to it
+  MemoryTracker::OwnerScope owner("output: " + m_params.name());
+
   // Read input parameters and setup internal data
   setup_internals(field_mgr, grid_names);
 
+  // Register the timers used in the run method
+  const std::string timer_root = m_is_model_restart_output ? "EAMxx::IO::restart" : "EAMxx::IO::standard";
+  m_timers.root                  = register_timer(timer_root);
+  m_timers.stream                = register_timer("EAMxx::IO::" + m_params.name());
+  m_timers.get_new_file          = register_timer(timer_root+"::get_new_file");
+  m_timers.wait_async            = register_timer(timer_root+"::wait_async");
+  m_timers.run_output_streams    = register_timer(timer_root+"::run_output_streams");
+  m_timers.update_snapshot_tally = register_timer(timer_root+"::update_snapshot_tally");
+
   if (not m_output_control.output_enabled()) {
     // If output is not enabled, there's no point in continuing
     return;
@@ -377,9 +391,8 @@ void OutputManager::run(const util::TimeStamp& timestamp)
 
   using namespace scorpio;
 
-  std::string timer_root = m_is_model_restart_output ? "EAMxx::IO::restart" : "EAMxx::IO::standard";
-  start_timer(timer_root);
-  start_timer("EAMxx::IO::" + m_params.name());
+  start_timer(m_timers.root);
+  start_timer(m_timers.stream);
 
   // Check if this is a write step (and what kind)
   // Note: a full checkpoint not only writes globals in the restart file, but also all the history variables.
@@ -409,7 +422,7 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   }
 
   // Create and setup output/checkpoint file(s), if necessary
-  start_timer(timer_root+"::get_new_file");
+  start_timer(m_timers.get_new_file);
   auto setup_output_file = [&](IOControl& control, IOFileSpecs& filespecs) {
     // Check if we need to open a new file
     if (not filespecs.is_open) {
@@ -447,31 +460,42 @@ void OutputManager::run(const util::TimeStamp& timestamp)
     m_atm_logger->info("[EAMxx::output_manager]      FILE: " + filespecs.filename);
   };
 
+  if (m_async_output and is_write_step) {
+    // Cap the memory used by staging buffers, by waiting for old snapshots to be written
+    start_timer(m_timers.wait_async);
+    while (static_cast<int>(m_async_tickets.size())>=m_max_in_flight_snapshots) {
+      scorpio::wait_async(m_async_tickets.front());
+      m_async_tickets.pop_front();
+    }
+    stop_timer(m_timers.wait_async);
+  }
+
+  const double time = timestamp.days_from(m_case_t0);
   if (is_output_step) {
     setup_output_file(m_output_control,m_output_file_specs);
 
     // Update time (must be done _before_ writing fields)
-    update_time(m_output_file_specs.filename,timestamp.days_from(m_case_t0));
+    run_io_op(m_output_file_specs.filename,[fname=m_output_file_specs.filename,time](){ update_time(fname,time); });
   }
   if (is_checkpoint_step) {
     setup_output_file(m_checkpoint_control,m_checkpoint_file_specs);
 
     if (is_full_checkpoint_step) {
       // Update time (must be done _before_ writing fields)
-      update_time(m_checkpoint_file_specs.filename,timestamp.days_from(m_case_t0));
+      run_io_op(m_checkpoint_file_specs.filename,[fname=m_checkpoint_file_specs.filename,time](){ update_time(fname,time); });
     }
   }
-  stop_timer(timer_root+"::get_new_file");
+  stop_timer(m_timers.get_new_file);
 
   // Run the output streams
-  start_timer(timer_root+"::run_output_streams");
+  start_timer(m_timers.run_output_streams);
   const auto& fields_write_filename = is_output_step ? m_output_file_specs.filename : m_checkpoint_file_specs.filename;
   for (auto& it : m_output_streams) {
     // Note: filename only matters if is_output_step || is_full_checkpoint_step=true. In that case, it will definitely point to a valid file name.
     m_atm_logger->debug("[OutputManager]: writing fields from grid " + it->get_io_grid()->name() + "...\n");
     it->run(fields_write_filename,timestamp,is_output_step,is_full_checkpoint_step,m_output_control.nsamples_since_last_write,is_t0_output);
   }
-  stop_timer(timer_root+"::run_output_streams");
+  stop_timer(m_timers.run_output_streams);
 
   if (is_write_step) {
     if (m_time_bnds.size()>0) {
@@ -493,71 +517,85 @@ void OutputManager::run(const util::TimeStamp& timestamp)
       control.compute_next_write_ts();
       control.nsamples_since_last_write = 0;
 
-      if (m_is_model_restart_output) {
-        // Only write nsteps on model restart
-        set_attribute(filespecs.filename,"GLOBAL","nsteps",timestamp.get_num_steps());
-      } else {
-        if (filespecs.ftype==FileType::HistoryRestart) {
-          // Update the date of last write and sample size
-          write_timestamp (filespecs.filename,"last_write",m_output_control.last_write_ts,true);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","num_snapshots_since_last_write",m_output_control.nsamples_since_last_write);
-          if (m_output_file_specs.is_open) {
-            scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_file_num_snaps",m_output_file_specs.storage.num_snapshots_in_file);
-            scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_filename",m_output_file_specs.filename);
-          } else {
-            scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_filename","");
+      // NOTE: all the scorpio calls are done inside this lambda, which captures by value
+      //       all the data it needs, so that it can be run on the async IO thread
+      auto write_globals = [fname            = filespecs.filename,
+                            ftype            = filespecs.ftype,
+                            is_model_restart = m_is_model_restart_output,
+                            nsteps           = timestamp.get_num_steps(),
+                            output_control   = m_output_control,
+                            output_specs     = m_output_file_specs,
+                            avg_type         = m_avg_type,
+                            fp_precision     = m_params.get<std::string>("floating_point_precision"),
+                            globals          = copy_globals(),
+                            time_bnds        = m_time_bnds,
+                            write_time_bnds  = m_time_bnds.size()>0 and
+                                               (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step)]() {
+        if (is_model_restart) {
+          // Only write nsteps on model restart
+          set_attribute(fname,"GLOBAL","nsteps",nsteps);
+        } else {
+          if (ftype==FileType::HistoryRestart) {
+            // Update the date of last write and sample size
+            write_timestamp (fname,"last_write",output_control.last_write_ts,true);
+            scorpio::set_attribute (fname,"GLOBAL","num_snapshots_since_last_write",output_control.nsamples_since_last_write);
+            if (output_specs.is_open) {
+              scorpio::set_attribute (fname,"GLOBAL","last_output_file_num_snaps",output_specs.storage.num_snapshots_in_file);
+              scorpio::set_attribute (fname,"GLOBAL","last_output_filename",output_specs.filename);
+            } else {
+              scorpio::set_attribute (fname,"GLOBAL","last_output_filename","");
+            }
+          }
+          // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
+          // output, and the latter b/c we want to make sure these params don't change across restarts
+          set_attribute(fname,"GLOBAL","averaging_type",e2str(avg_type));
+          set_attribute(fname,"GLOBAL","averaging_frequency_units",output_control.frequency_units);
+          set_attribute(fname,"GLOBAL","averaging_frequency",output_control.frequency);
+          set_attribute(fname,"GLOBAL","file_max_storage_type",e2str(output_specs.storage.type));
+          if (output_specs.storage.type==NumSnaps) {
+            set_attribute(fname,"GLOBAL","max_snapshots_per_file",output_specs.storage.max_snapshots_in_file);
           }
+          set_attribute(fname,"GLOBAL","fp_precision",fp_precision);
         }
-        // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
-        // output, and the latter b/c we want to make sure these params don't change across restarts
-        set_attribute(filespecs.filename,"GLOBAL","averaging_type",e2str(m_avg_type));
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency_units",m_output_control.frequency_units);
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency",m_output_control.frequency);
-        set_attribute(filespecs.filename,"GLOBAL","file_max_storage_type",e2str(m_output_file_specs.storage.type));
-        if (m_output_file_specs.storage.type==NumSnaps) {
-          set_attribute(filespecs.filename,"GLOBAL","max_snapshots_per_file",m_output_file_specs.storage.max_snapshots_in_file);
+
+        // Write all stored globals
+        for (const auto& it : globals) {
+          const auto& name = it.first;
+          const auto& any = it.second;
+          if (any.type()==typeid(int)) {
+            set_attribute(fname,"GLOBAL",name,std::any_cast<const int&>(any));
+          } else if (any.type()==typeid(std::int64_t)) {
+            set_attribute(fname,"GLOBAL",name,std::any_cast<const std::int64_t&>(any));
+          } else if (any.type()==typeid(float)) {
+            set_attribute(fname,"GLOBAL",name,std::any_cast<const float&>(any));
+          } else if (any.type()==typeid(double)) {
+            set_attribute(fname,"GLOBAL",name,std::any_cast<const double&>(any));
+          } else if (any.type()==typeid(std::string)) {
+            set_attribute(fname,"GLOBAL",name,std::any_cast<const std::string&>(any));
+          } else {
+            EKAT_ERROR_MSG (
+                "Error! Invalid concrete type for IO global.\n"
+                " - global name: " + it.first + "\n"
+                " - type id    : " + std::string(any.type().name()) + "\n");
+          }
         }
-        const auto& fp_precision = m_params.get<std::string>("floating_point_precision");
-        set_attribute(filespecs.filename,"GLOBAL","fp_precision",fp_precision);
-      }
 
-      // Write all stored globals
-      for (const auto& it : m_globals) {
-        const auto& name = it.first;
-        const auto& any = *it.second;
-        if (any.type()==typeid(int)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const int&>(any));
-        } else if (any.type()==typeid(std::int64_t)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const std::int64_t&>(any));
-        } else if (any.type()==typeid(float)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const float&>(any));
-        } else if (any.type()==typeid(double)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const double&>(any));
-        } else if (any.type()==typeid(std::string)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const std::string&>(any));
-        } else {
-          EKAT_ERROR_MSG (
-              "Error! Invalid concrete type for IO global.\n"
-              " - global name: " + it.first + "\n"
-              " - type id    : " + std::string(any.type().name()) + "\n");
+        // NOTE: for checkpoint files, unless we write restart data, we did not update time,
+        //       which means we cannot write any variable (the check var.num_records==time.length
+        //       would fail)
+        if (write_time_bnds) {
+          scorpio::write_var(fname, "time_bnds", time_bnds.data());
         }
-      }
+      };
+      run_io_op(filespecs.filename,write_globals);
 
       // We're adding one snapshot to the file
       ++filespecs.storage.num_snapshots_in_file;
 
-      // NOTE: for checkpoint files, unless we write restart data, we did not update time,
-      //       which means we cannot write any variable (the check var.num_records==time.length
-      //       would fail)
-      if (m_time_bnds.size()>0 and
-          (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step)) {
-        scorpio::write_var(filespecs.filename, "time_bnds", m_time_bnds.data());
-      }
-
       close_or_flush_if_needed(filespecs,control);
     };
 
-    start_timer(timer_root+"::update_snapshot_tally");
+    start_timer(m_timers.update_snapshot_tally);
     // Important! Process output file first, and hist restart (if any) second.
     // That's b/c write_global_data will update m_output_control.last_write_ts,
     // which is later written as global data in the hist restart file
@@ -569,21 +607,39 @@ void OutputManager::run(const util::TimeStamp& timestamp)
 
       // Always flush output during checkpoints (assuming we opened it already)
       if (m_output_file_specs.is_open) {
-        scorpio::flush_file (m_output_file_specs.filename);
+        run_io_op(m_output_file_specs.filename,[fname=m_output_file_specs.filename](){ scorpio::flush_file (fname); });
       }
     }
-    stop_timer(timer_root+"::update_snapshot_tally");
+    stop_timer(m_timers.update_snapshot_tally);
     if (is_output_step && m_time_bnds.size()>0) {
       m_time_bnds[0] = m_time_bnds[1];
     }
+
+    if (m_async_output) {
+      if (is_checkpoint_step) {
+        // A restart must find complete files on disk, so don't leave anything in flight
+        start_timer(m_timers.wait_async);
+        scorpio::wait_async();
+        m_async_tickets.clear();
+        stop_timer(m_timers.wait_async);
+      } else {
+        m_async_tickets.push_back(m_last_async_ticket);
+      }
+    }
   }
 
-  stop_timer("EAMxx::IO::" + m_params.name());
-  stop_timer(timer_root);
+  stop_timer(m_timers.stream);
+  stop_timer(m_timers.root);
 }
 /*===============================================================================================*/
 void OutputManager::finalize()
 {
+  // Flush all pending async writes
+  if (m_async_output) {
+    scorpio::wait_async();
+    m_async_tickets.clear();
+  }
+
   // Close any output file still open
   if (m_output_file_specs.is_open) {
     scorpio::release_file (m_output_file_specs.filename);
@@ -610,6 +666,7 @@ void OutputManager::finalize()
   m_checkpoint_file_specs = {};
   m_case_t0 = {};
   m_run_t0 = {};
+  m_async_output = false;
   m_atm_logger = console_logger(ekat::logger::LogLevel::warn);
 }
 
@@ -726,7 +783,24 @@ setup_internals (const std::shared_ptr<fm_type>& field_mgr,
         "Error! Invalid/unsupported value for 'floating_point_precision'.\n"
         "  - input value: " + prec + "\n"
         "  - supported values: float, single, double, real\n");
+
+    // Async output: scorpio calls are done on a helper thread, while the model moves on
+    m_async_output = m_params.get("async_output",false);
+    m_max_in_flight_snapshots = m_params.get("max_in_flight_snapshots",1);
+    EKAT_REQUIRE_MSG (m_max_in_flight_snapshots>0,
+        "Error! Value for 'max_in_flight_snapshots' should be positive.\n");
+    if (m_async_output) {
+      int thread_level;
+      MPI_Query_thread(&thread_level);
+      if (thread_level!=MPI_THREAD_MULTIPLE) {
+        m_atm_logger->warn("[OutputManager::setup] Async output requires MPI_THREAD_MULTIPLE.\n"
+                           "  Falling back to synchronous output for stream " + m_params.name() + ".\n");
+        m_async_output = false;
+      }
+    }
   }
+  // Let the output streams know whether they need to stage data for async writes
+  m_params.set("async_output",m_async_output);
 
   // Output control
   EKAT_REQUIRE_MSG(m_params.isSublist("output_control"),
@@ -866,7 +940,7 @@ setup_file (      IOFileSpecs& filespecs,
 
   // Make all output streams register their dims/vars
   for (auto& it : m_output_streams) {
-    it->setup_output_file(filename,fp_precision,mode);
+    it->setup_output_file(filename,fp_precision,mode,filespecs.is_restart_file());
   }
 
   // If grid data is needed,  also register geo data fields. Skip if file is resumed,
@@ -903,7 +977,7 @@ setup_file (      IOFileSpecs& filespecs,
     m_grid_name_to_geo_data.clear();
 
     for (auto& it : m_geo_data_streams) {
-      it->setup_output_file(filename,fp_precision,mode);
+      it->setup_output_file(filename,fp_precision,mode,filespecs.is_restart_file());
     }
   }
 
@@ -985,11 +1059,32 @@ close_or_flush_if_needed (      IOFileSpecs& file_specs,
   }
 
   if (not file_specs.storage.snapshot_fits(*window_start_ts)) {
-    scorpio::release_file(file_specs.filename);
+    run_io_op(file_specs.filename,[fname=file_specs.filename](){ scorpio::release_file(fname); });
     file_specs.close();
   } else if (file_specs.file_needs_flush()) {
-    scorpio::flush_file (file_specs.filename);
+    run_io_op(file_specs.filename,[fname=file_specs.filename](){ scorpio::flush_file (fname); });
+  }
+}
+
+void OutputManager::
+run_io_op (const std::string& filename, const std::function<void()>& op) const
+{
+  if (m_async_output) {
+    m_last_async_ticket = scorpio::enqueue_async(op,filename);
+  } else {
+    op();
+  }
+}
+
+std::map<std::string,std::any> OutputManager::
+copy_globals () const
+{
+  // Globals are stored by pointer, and their value may change before an async write
+  std::map<std::string,std::any> globals;
+  for (const auto& it : m_globals) {
+    globals[it.first] = *it.second;
   }
+  return globals;
 }
 
 void OutputManager::
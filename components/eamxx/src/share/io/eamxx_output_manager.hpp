@@ -16,6 +16,9 @@
 #include <ekat_comm.hpp>
 #include <ekat_parameter_list.hpp>
 
+#include <deque>
+#include <functional>
+
 namespace scream
 {
 
@@ -113,6 +116,8 @@ public:
   long long res_dep_memory_footprint () const;
 
   bool is_restart () const { return m_is_model_restart_output; }
+  // Whether write steps are done on the async IO thread (set in setup)
+  bool is_async () const { return m_async_output; }
 
   // For debug and testing purposes
   const IOControl&   output_control    () const { return m_output_control;    }
@@ -136,6 +141,12 @@ protected:
   void close_or_flush_if_needed (      IOFileSpecs& file_specs,
                                  const IOControl&   control) const;
 
+  // Run a scorpio operation on the given file, either right away, or on the async IO thread (if async output is on)
+  void run_io_op (const std::string& filename, const std::function<void()>& op) const;
+
+  // Get a copy of the values of the globals
+  std::map<std::string,std::any> copy_globals () const;
+
   // Manage logging of info to atm.log
   void push_to_logger();
 
@@ -171,6 +182,16 @@ protected:
   // Whether this OutputManager handles a model restart file, or normal model output.
   bool m_is_model_restart_output;
 
+  // Ids of the timers used in the run method
+  struct TimerIds {
+    int root                  = -1;
+    int stream                = -1;
+    int get_new_file          = -1;
+    int wait_async            = -1;
+    int run_output_streams    = -1;
+    int update_snapshot_tally = -1;
+  } m_timers;
+
   // Frequency of output and checkpointing
   // See eamxx_io_utils.hpp for details.
   IOControl m_output_control;
@@ -198,6 +219,13 @@ protected:
 
   // If true, we save grid data in output file
   bool m_save_grid_data;
+
+  // If true, scorpio calls of write steps are done on the async IO thread. We cap the
+  // number of write steps whose scorpio calls are still pending, to limit memory usage.
+  bool                    m_async_output = false;
+  int                     m_max_in_flight_snapshots = 1;
+  std::deque<long long>   m_async_tickets;
+  mutable long long       m_last_async_ticket = -1;
 };
 
 } // namespace scream
@@ -1,7 +1,9 @@
 #include "share/io/scorpio_output.hpp"
 
 #include "share/field/field_utils.hpp"
+#include "share/field/field_expression.hpp"
 #include "share/field/field_reader.hpp"
+#include "share/field/field_workspace_arena.hpp"
 #include "share/io/eamxx_io_utils.hpp"
 #include "share/remap/horizontal_remapper.hpp"
 #include "share/remap/vertical_remapper.hpp"
@@ -11,6 +13,8 @@
 #include <ekat_string_utils.hpp>
 #include <ekat_units.hpp>
 
+#include <cmath>
+#include <cstring>
 #include <numeric>
 
 namespace
@@ -44,6 +48,13 @@ get_transposed_helper_name(const scream::FieldLayout& layout, const scream::Data
   return "transposed_" + layout.transpose().to_string() + "_" + e2str(data_type);
 }
 
+// Helper function to get the name of a reduced-precision helper field from a layout and data type
+std::string
+get_quantized_helper_name(const scream::FieldLayout& layout, const scream::DataType data_type)
+{
+  return "quantized_" + layout.to_string() + "_" + e2str(data_type);
+}
+
 // Note: this is also declared in eamxx_scorpio_interface.cpp. Move it somewhere else?
 template <typename T>
 std::string
@@ -112,6 +123,9 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
     m_transpose = params.get<bool>("transpose");
   }
 
+  // Note: the OutputManager already checked that async output can be done
+  m_async_output = params.get("async_output",false);
+
   auto gm = field_mgr->get_grids_manager();
 
   // Figure out what kind of averaging is requested
@@ -124,6 +138,17 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
   // By default, IO is done directly on the field mgr grid
   auto fm_grid = field_mgr->get_grids_manager()->get_grid(grid_name);
 
+  // Per-field precision reduction requests can be at the top level, or in the grid sublist
+  std::vector<ekat::ParameterList> precision_pls;
+  auto add_precision_pls = [&](const ekat::ParameterList& pl) {
+    for (const std::string key : {"significant_bits","significant_digits"}) {
+      if (pl.isSublist(key)) {
+        precision_pls.push_back(pl.sublist(key));
+      }
+    }
+  };
+  add_precision_pls(params);
+
   std::string output_data_layout = "default";
   if (params.isParameter("field_names")) {
     // This simple parameter list option does *not* allow to remap fields
@@ -149,6 +174,7 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
             m_fields_names.clear();
           }
         }
+        add_precision_pls(pl);
         if (pl.isParameter("aliases")) {
           if (pl.isType<vos_t>("aliases")) {
             m_intermediate_aliases = pl.get<vos_t>("aliases");
@@ -199,6 +225,33 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
   // Then we 1) create aliases, and b) create diagnostics, adding alias/diag fields to fm_model
   process_requested_fields ();
 
+  // Now that aliases are resolved, we can find the fields whose precision must be reduced
+  for (const auto& pl : precision_pls) {
+    const bool digits = pl.name()=="significant_digits";
+    for (const auto& fname : m_fields_names) {
+      if (not pl.isParameter(fname)) {
+        continue;
+      }
+      const int n = pl.get<int>(fname);
+      EKAT_REQUIRE_MSG (n>=1,
+          "Error! Invalid number of significant " + std::string(digits ? "digits" : "bits") + ".\n"
+          " - stream name: " + m_stream_name + "\n"
+          " - field name : " + fname + "\n"
+          " - value      : " + std::to_string(n) + "\n");
+      EKAT_REQUIRE_MSG (m_field_to_nsb.count(fname)==0,
+          "Error! Significant bits/digits were specified multiple times for the same field.\n"
+          " - stream name: " + m_stream_name + "\n"
+          " - field name : " + fname + "\n");
+      // Convert decimal digits to bits (rounding up, so we keep at least the requested digits)
+      m_field_to_nsb[fname] = digits ? static_cast<int>(std::ceil(n*std::log2(10.0))) : n;
+    }
+  }
+  m_deflate_level = params.get<int>("compression_level",1);
+  EKAT_REQUIRE_MSG (m_deflate_level>=0 and m_deflate_level<=9,
+      "Error! Invalid compression_level (must be in [0,9]).\n"
+      " - stream name: " + m_stream_name + "\n"
+      " - compression_level: " + std::to_string(m_deflate_level) + "\n");
+
   // Avg count only makes sense if we have
   //  - non-instant output
   //  - we have one between:
@@ -238,6 +291,7 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
     if (params.isParameter("enable_fine_grain_timers")) {
       m_vert_remapper->toggle_timers(params.get<bool>("enable_fine_grain_timers"));
     }
+    m_vert_remap_timer = register_timer("EAMxx::IO::vert_remap");
 
     grid_after_vr = m_vert_remapper->get_tgt_grid();
     fm_after_vr = std::make_shared<FieldManager>(grid_after_vr,RepoState::Closed);
@@ -271,6 +325,7 @@ AtmosphereOutput::AtmosphereOutput(const ekat::Comm &comm, const ekat::Parameter
     if (params.isParameter("enable_fine_grain_timers")) {
       m_horiz_remapper->toggle_timers(params.get<bool>("enable_fine_grain_timers"));
     }
+    m_horiz_remap_timer = register_timer("EAMxx::IO::horiz_remap");
 
     grid_after_hr = m_horiz_remapper->get_tgt_grid();
     fm_after_hr = std::make_shared<FieldManager>(grid_after_hr,RepoState::Closed);
@@ -379,10 +434,21 @@ void AtmosphereOutput::init()
         // We can add a new helper field for this layout and data type
         // Use Units::invalid() since this helper is reused for fields with same layout but different units
         using namespace ekat::units;
+        // Note: helper fields are not allocated here, since they are drawn from the workspace arena in run
         FieldIdentifier fid_helper(helper_name,helper_layout,Units::invalid(),fid.get_grid_name(),data_type);
         Field helper(fid_helper);
         helper.get_header().get_alloc_properties().request_allocation();
-        helper.allocate_view();
+        m_helper_fields[helper_name] = helper;
+      }
+    } else if (m_field_to_nsb.count(fname)==1) {
+      // Reduced-precision output cannot be done in place, since f_out may alias the model
+      // field, or store the accumulated values. Transposed output already has a helper.
+      const auto data_type = fid.data_type();
+      const std::string helper_name = get_quantized_helper_name(layout, data_type);
+      if (m_helper_fields.find(helper_name) == m_helper_fields.end()) {
+        using namespace ekat::units;
+        FieldIdentifier fid_helper(helper_name,layout,Units::invalid(),fid.get_grid_name(),data_type);
+        Field helper(fid_helper);
         m_helper_fields[helper_name] = helper;
       }
     }
@@ -465,9 +531,35 @@ run (const std::string& filename, const util::TimeStamp& ts,
     return;
   }
   Real duration_write = 0.0;  // Record of time spent writing output
+
+  // Helper fields are only needed during this call, so get their memory from the
+  // workspace arena, the first time each of them is needed
+  FieldWorkspaceArena::Scope scope(ArenaLifetime::OutputStep);
+  std::map<std::string,Field> helpers;
+  auto get_helper = [&](const std::string& name) -> Field& {
+    auto it = helpers.find(name);
+    if (it==helpers.end()) {
+      it = helpers.emplace(name,scope.get_field(m_helper_fields.at(name))).first;
+    }
+    return it->second;
+  };
   if (is_write_step) {
     m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file");
     m_atm_logger->info("  file name: " + filename);
+
+    // Grab a staging buffer that is not referenced by any pending async op
+    // (without async output, there is never more than one buffer in the pool)
+    m_staging = nullptr;
+    for (const auto& buf : m_staging_pool) {
+      if (buf.use_count()==1) {
+        m_staging = buf;
+        break;
+      }
+    }
+    if (not m_staging) {
+      m_staging = m_staging_pool.emplace_back(std::make_shared<StagingBuffer>());
+    }
+    m_staging->pending = PendingWrites();
   }
 
   // Update all diagnostics, we need to do this before applying the remapper
@@ -491,15 +583,15 @@ run (const std::string& filename, const util::TimeStamp& ts,
 
   // If needed, remap fields from their grid to the unique grid, for I/O
   if (m_vert_remapper) {
-    start_timer("EAMxx::IO::vert_remap");
+    start_timer(m_vert_remap_timer);
     apply_remap(*m_vert_remapper);
-    stop_timer("EAMxx::IO::vert_remap");
+    stop_timer(m_vert_remap_timer);
   }
 
   if (m_horiz_remapper) {
-    start_timer("EAMxx::IO::horiz_remap");
+    start_timer(m_horiz_remap_timer);
     apply_remap(*m_horiz_remapper);
-    stop_timer("EAMxx::IO::horiz_remap");
+    stop_timer(m_horiz_remap_timer);
   }
 
   auto fm_scorpio = m_field_mgrs[Scorpio];
@@ -558,12 +650,14 @@ run (const std::string& filename, const util::TimeStamp& ts,
           const auto& layout = id.get_layout();
           const auto data_type = id.data_type();
           const std::string helper_name = get_transposed_helper_name(layout, data_type);
-          auto& temp = m_helper_fields.at(helper_name);
+          auto& temp = get_helper(helper_name);
           transpose(count,temp);
           temp.sync_to_host();
-          scorpio::write_var(filename,count.name(),temp.get_internal_view_data<const int,Host>());
+          write_field_data<int>(count.name(),temp,true);
         } else {
-          scorpio::write_var(filename,count.name(),count.get_internal_view_data<const int,Host>());
+          // On output steps of Average, count is modified below (before the writes are flushed)
+          const bool count_changes = output_step and m_avg_type==OutputAvgType::Average;
+          write_field_data<int>(count.name(),count,count_changes);
         }
         auto func_finish = std::chrono::steady_clock::now();
         auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
@@ -607,6 +701,12 @@ run (const std::string& filename, const util::TimeStamp& ts,
         "This indicates the field was marked may_be_filled after output initialization or tracking logic missed it." );
     }
 
+    // On the last step of an average window with no avg count, we can fuse the
+    // accumulation and the division by the steps count in a single kernel.
+    // Note: without avg count tracking, f_in is guaranteed to not contain fill values
+    const bool fused_avg = output_step and m_avg_type==OutputAvgType::Average and
+                           not m_track_avg_cnt and f_out.data_type()==DataType::RealType;
+
     switch (m_avg_type) {
       case OutputAvgType::Instant:
         f_out.deep_copy(f_in);  break; // Note: if f_in aliases f_out, this is a no-op
@@ -615,7 +715,12 @@ run (const std::string& filename, const util::TimeStamp& ts,
       case OutputAvgType::Min:
         f_out.min(f_in);        break;
       case OutputAvgType::Average:
-        f_out.update(f_in,1,1); break;
+        if (fused_avg) {
+          f_out.assign((f_out + f_in) * (Real(1.0) / nsteps_since_last_output));
+        } else {
+          f_out.update(f_in,1,1);
+        }
+        break;
       default:
         EKAT_ERROR_MSG ("Unexpected/unsupported averaging type.\n");
     }
@@ -631,12 +736,16 @@ run (const std::string& filename, const util::TimeStamp& ts,
 
           const auto& mask = avg_count.get_valid_mask();
           f_out.deep_copy(constants::fill_value<Real>,mask);
-        } else {
+        } else if (not fused_avg) {
           // Divide by steps count only when the summation is complete
           f_out.scale(Real(1.0) / nsteps_since_last_output);
         }
       }
 
+      // Reduced precision is only for output files: checkpoints must be exact
+      const auto nsb_it = m_field_to_nsb.find(field_name);
+      const bool quantize = output_step and nsb_it!=m_field_to_nsb.end();
+
       // Write to file
       auto func_start = std::chrono::steady_clock::now();
       if (m_transpose) {
@@ -644,14 +753,24 @@ run (const std::string& filename, const util::TimeStamp& ts,
         const auto& layout = id.get_layout();
         const auto data_type = id.data_type();
         const std::string helper_name = get_transposed_helper_name(layout, data_type);
-        auto& temp = m_helper_fields.at(helper_name);
+        auto& temp = get_helper(helper_name);
         transpose(f_out,temp);
+        if (quantize) {
+          bit_round(temp,temp,nsb_it->second);
+        }
+        temp.sync_to_host();
+        write_field_data<Real>(field_name,temp,true);
+      } else if (quantize) {
+        const auto& id = f_out.get_header().get_identifier();
+        const std::string helper_name = get_quantized_helper_name(id.get_layout(), id.data_type());
+        auto& temp = get_helper(helper_name);
+        bit_round(f_out,temp,nsb_it->second);
         temp.sync_to_host();
-        scorpio::write_var(filename,field_name,temp.get_internal_view_data<const Real,Host>());
+        write_field_data<Real>(field_name,temp,true);
       } else {
         // Bring data to host (only needed for non-transposed output)
         f_out.sync_to_host();
-        scorpio::write_var(filename,field_name,f_out.get_internal_view_data<const Real,Host>());
+        write_field_data<Real>(field_name,f_out,false);
       }
       auto func_finish = std::chrono::steady_clock::now();
       auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
@@ -660,10 +779,68 @@ run (const std::string& filename, const util::TimeStamp& ts,
   }
 
   if (is_write_step) {
+    auto func_start = std::chrono::steady_clock::now();
+    flush_writes(filename);
+    auto func_finish = std::chrono::steady_clock::now();
+    duration_write += std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start).count();
+
     m_atm_logger->info("  Done! Elapsed time: " + std::to_string(duration_write/1000.0) +" seconds");
+
+    // Pending async ops hold their own reference to the staging buffer
+    m_staging = nullptr;
   }
 } // run
 
+template<typename T>
+void AtmosphereOutput::
+write_field_data (const std::string& varname, const Field& f, const bool volatile_data)
+{
+  const T* data = f.get_internal_view_data<const T,Host>();
+
+  // With async output, the data must survive until the write is done. Otherwise,
+  // we only need to copy data that may be overwritten before the end of run
+  // (e.g., transposed data, since helper fields are shared among fields)
+  if (m_async_output or volatile_data) {
+    // Scorpio fields are contiguous, so we can copy the raw data
+    const auto size = f.get_header().get_identifier().get_layout().size();
+    auto& bytes = m_staging->data[varname];
+    bytes.resize(size*sizeof(T));
+    std::memcpy(bytes.data(),data,size*sizeof(T));
+    data = reinterpret_cast<const T*>(bytes.data());
+  }
+
+  auto& pending = m_staging->pending;
+  if constexpr (std::is_same_v<T,int>) {
+    pending.int_names.push_back(varname);
+    pending.int_data.push_back(data);
+  } else {
+    pending.real_names.push_back(varname);
+    pending.real_data.push_back(data);
+  }
+}
+
+void AtmosphereOutput::
+flush_writes (const std::string& filename)
+{
+  // Issue all the writes at once, so that scorpio can aggregate
+  // the writes of vars sharing the same decomposition
+  auto write = [filename,buf=m_staging]() {
+    const auto& pending = buf->pending;
+    if (pending.int_names.size()>0) {
+      scorpio::write_vars(filename,pending.int_names,pending.int_data);
+    }
+    if (pending.real_names.size()>0) {
+      scorpio::write_vars(filename,pending.real_names,pending.real_data);
+    }
+  };
+
+  if (m_async_output) {
+    scorpio::enqueue_async(write,filename);
+  } else {
+    write();
+  }
+}
+
 long long AtmosphereOutput::
 res_dep_memory_footprint () const
 {
@@ -773,7 +950,8 @@ reset_scorpio_fields()
 void AtmosphereOutput::
 register_variables(const std::string& filename,
                    const std::string& fp_precision,
-                   const scorpio::FileMode mode)
+                   const scorpio::FileMode mode,
+                   const bool is_restart_file)
 {
   using namespace ShortFieldTagsNames;
 
@@ -905,6 +1083,17 @@ register_variables(const std::string& filename,
       if (m_transpose) {
         scorpio::set_attribute(filename, field_name, "transposed_output", "true");
       }
+
+      // If the precision of this var is reduced, record it (using the same attribute name that
+      // netcdf uses for BitRound quantization), and enable compression (if the iotype allows it).
+      // Restart files always store the full precision data.
+      if (m_field_to_nsb.count(field_name)==1 and not is_restart_file) {
+        scorpio::set_attribute(filename, field_name, "_QuantizeBitRoundNumberOfSignificantBits",
+                               m_field_to_nsb.at(field_name));
+        if (m_deflate_level>0) {
+          scorpio::set_var_compression(filename, field_name, true, m_deflate_level);
+        }
+      }
     }
   }
 
@@ -973,7 +1162,8 @@ void AtmosphereOutput::set_decompositions(const std::string& filename)
 void AtmosphereOutput::
 setup_output_file(const std::string& filename,
                   const std::string& fp_precision,
-                  const scorpio::FileMode mode)
+                  const scorpio::FileMode mode,
+                  const bool is_restart_file)
 {
   // Register dimensions with netCDF file.
   for (const auto& [dimname,dimlen] : m_dims_len) {
@@ -995,7 +1185,7 @@ setup_output_file(const std::string& filename,
   }
 
   // Register variables with netCDF file.  Must come after dimensions are registered.
-  register_variables(filename,fp_precision,mode);
+  register_variables(filename,fp_precision,mode,is_restart_file);
 
   // Set the offsets of the local dofs in the global vector.
   set_decompositions(filename);
@@ -47,6 +47,13 @@
  *  restart:
  *    filename_prefix:                  STRING                (default: ${filename_prefix})
  *    skip_restart_if_rhist_not_found:  BOOL                  (default: false)
+ *  async_output:                       BOOL                  (default: false)
+ *  max_in_flight_snapshots:            INT                   (default: 1)
+ *  significant_bits:
+ *     FIELD_NAME:                      INT
+ *  significant_digits:
+ *     FIELD_NAME:                      INT
+ *  compression_level:                  INT                   (default: 1)
  *  -----
  *  The meaning of these parameters is the following:
  *  - filename_prefix: the output filename root.
@@ -91,6 +98,19 @@
  *    - skip_restart_if_rhist_not_found: if this is a restarted run and this is true, skip the
  *      hist restart if the proper filename is not found in rpointer. Allows to add a new stream
  *      upon restart.
+ *  - async_output: if true, at write steps the output data is copied in host staging buffers,
+ *    and the scorpio calls are done on a helper thread, while the model moves on.
+ *    Requires MPI to be initialized with MPI_THREAD_MULTIPLE (otherwise, it is ignored).
+ *  - max_in_flight_snapshots: max number of snapshots whose write has not yet completed when
+ *    a new write step starts (only used for async output). Bounds the staging memory.
+ *    Pending writes are always flushed at checkpoint steps and at finalization.
+ *  - significant_bits/significant_digits: reduce the precision of some output fields, keeping
+ *    only the given number of mantissa bits (or enough bits for the given number of decimal
+ *    digits). Data is rounded to nearest on device (BitRound), which makes it much more
+ *    compressible. Can also be specified inside the fields->GRID_NAME sublist. Fill values
+ *    are preserved, and checkpoint (rhist) data is never rounded.
+ *  - compression_level: deflate level (0 means no compression) for reduced-precision fields.
+ *    The shuffle and deflate filters are only used for the NetCDF4 iotypes.
 
  *  Notes:
  *   - you can specify lists with either of the two syntaxes:
@@ -142,7 +162,7 @@ public:
   void init();
   void reset_scorpio_fields();
   void setup_output_file(const std::string &filename, const std::string &fp_precision,
-                         const scorpio::FileMode mode);
+                         const scorpio::FileMode mode, const bool is_restart_file = false);
 
   void init_timestep(const util::TimeStamp &start_of_step);
   void run(const std::string &filename, const util::TimeStamp& ts, const bool output_step, const bool checkpoint_step,
@@ -171,7 +191,7 @@ protected:
 
   // Internal functions
   void register_variables(const std::string &filename, const std::string &fp_precision,
-                          const scorpio::FileMode mode);
+                          const scorpio::FileMode mode, const bool is_restart_file);
   void set_decompositions(const std::string &filename);
   void computes(const util::TimeStamp& ts, const bool allow_invalid_fields);
   void process_requested_fields();
@@ -180,6 +200,17 @@ protected:
   // Tracking the averaging of any filled values:
   void set_avg_cnt_tracking(const FieldIdentifier& fid);
 
+  // Add the host data of a field to the list of pending writes. With async output, or if
+  // the field data may change before the end of run (volatile_data=true), the data is
+  // first copied in a staging buffer.
+  template<typename T>
+  void write_field_data (const std::string& varname, const Field& f, const bool volatile_data);
+
+  // Write all pending data to file, with one scorpio call per data type, which allows
+  // to aggregate the writes of vars with the same decomposition. With async output,
+  // the scorpio calls are enqueued to run on the async IO thread.
+  void flush_writes (const std::string& filename);
+
   // --- Internal variables --- //
   ekat::Comm m_comm;
   bool m_transpose = false;
@@ -212,11 +243,15 @@ protected:
     Scorpio // Output fields to pass to scorpio (may differ from the above in case of packing)
   };
   std::map<Phase, std::shared_ptr<fm_type>> m_field_mgrs;
+  // Helper fields (e.g., for transposed output). They are NOT allocated, since run
+  // gets them from the workspace arena (see FieldWorkspaceArena) during write steps
   std::map<std::string, Field> m_helper_fields;
 
   std::shared_ptr<const grid_type> m_io_grid;
   std::shared_ptr<remapper_type> m_horiz_remapper;
   std::shared_ptr<remapper_type> m_vert_remapper;
+  int m_horiz_remap_timer = -1;
+  int m_vert_remap_timer  = -1;
 
   // How to combine multiple snapshots in the output: instant, Max, Min, Average
   OutputAvgType m_avg_type;
@@ -240,6 +275,10 @@ protected:
 
   static strmap_t<diag_ptr_type> m_diag_repo;
 
+  // Reduced precision output: number of mantissa bits to keep for each field, and deflate level
+  strmap_t<int> m_field_to_nsb;
+  int m_deflate_level = 1;
+
   // Field aliasing support
   strmap_t<std::string> m_alias_to_orig; // Map from alias names to original names (used to set io attribute)
 
@@ -254,6 +293,24 @@ protected:
       console_logger(ekat::logger::LogLevel::warn);
 
   std::string m_stream_name; // used in error msgs to help distinguish which stream this is
+
+  // Writes issued during a write step, to be flushed all together at the end of run
+  struct PendingWrites {
+    strvec_t                  int_names;
+    std::vector<const int*>   int_data;
+    strvec_t                  real_names;
+    std::vector<const Real*>  real_data;
+  };
+
+  // Async output support. A staging buffer is in use until all the async ops
+  // referencing it are done (at which point, they release their shared_ptr copy)
+  struct StagingBuffer {
+    strmap_t<std::vector<char>> data;
+    PendingWrites               pending;
+  };
+  bool m_async_output = false;
+  std::list<std::shared_ptr<StagingBuffer>> m_staging_pool;
+  std::shared_ptr<StagingBuffer>            m_staging;
 };
 
 } // namespace scream
@@ -20,8 +20,13 @@
 #include <ekat_assert.hpp>
 #include <ekat_comm.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 #include <memory>
+#include <type_traits>
 
 namespace scream {
 
@@ -117,7 +122,8 @@ get_fm (const std::shared_ptr<const AbstractGrid>& grid,
 
 // Returns fields after initialization
 void write (const std::string& avg_type, const std::string& freq_units,
-            const int freq, const int seed, const ekat::Comm& comm)
+            const int freq, const int seed, const ekat::Comm& comm,
+            const bool async = false)
 {
   // Create grid
   auto gm = get_gm(comm);
@@ -136,7 +142,8 @@ void write (const std::string& avg_type, const std::string& freq_units,
 
   // Create output params
   ekat::ParameterList om_pl;
-  om_pl.set("filename_prefix",std::string("io_basic"));
+  // The async test runs in a separate executable, so use different files
+  om_pl.set("filename_prefix",std::string(async ? "io_basic_async" : "io_basic"));
   om_pl.set("field_names",fnames);
   om_pl.set("averaging_type", avg_type);
   auto& ctrl_pl = om_pl.sublist("output_control");
@@ -145,6 +152,11 @@ void write (const std::string& avg_type, const std::string& freq_units,
   ctrl_pl.set("save_grid_data",false);
   // Also test writing physics constants to file
   om_pl.set("constants",std::vector<std::string>{"gravit","Rgas"});
+  om_pl.set("async_output",async);
+  if (async) {
+    // Let the model move on while the previous snapshot is still being written
+    om_pl.set("max_in_flight_snapshots",2);
+  }
 
   // While setting this is in practice irrelevant (we would close
   // the file anyways at the end of the run), we can test that the OM closes
@@ -166,6 +178,9 @@ void write (const std::string& avg_type, const std::string& freq_units,
   om.initialize(comm,om_pl,t0,false);
   om.setup(fm,gm->get_grid_names());
 
+  // Make sure we are not silently testing the synchronous fallback
+  REQUIRE (om.is_async()==async);
+
   // Time loop: ensure we always hit 3 output steps
   const int nsteps = num_output_steps*freq;
   auto t = t0;
@@ -193,7 +208,8 @@ void write (const std::string& avg_type, const std::string& freq_units,
 }
 
 void read (const std::string& avg_type, const std::string& freq_units,
-           const int freq, const int seed, const ekat::Comm& comm)
+           const int freq, const int seed, const ekat::Comm& comm,
+           const bool async = false)
 {
   // Only INSTANT writes at t=0
   bool instant = avg_type=="INSTANT";
@@ -215,7 +231,7 @@ void read (const std::string& avg_type, const std::string& freq_units,
   }
 
   // Create reader pl
-  std::string casename = "io_basic";
+  std::string casename = async ? "io_basic_async" : "io_basic";
   auto filename = casename
     + "." + avg_type
     + "." + freq_units
@@ -330,4 +346,132 @@ TEST_CASE ("io_basic") {
   scorpio::finalize_subsystem();
 }
 
+TEST_CASE ("io_basic_async") {
+  std::vector<std::string> avg_type = {
+    "INSTANT",
+    "MAX",
+    "MIN",
+    "AVERAGE"
+  };
+
+  // Async output needs MPI_THREAD_MULTIPLE, which is requested by the test main
+  // of the io_basic_async test (see CMakeLists.txt). Without it, the OM would fall
+  // back to sync output, so there is nothing to test here.
+  int thread_level;
+  MPI_Query_thread(&thread_level);
+  if (thread_level!=MPI_THREAD_MULTIPLE) {
+    WARN ("MPI_THREAD_MULTIPLE not available: skipping the async output test.");
+    return;
+  }
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::init_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  // Async output must produce the same files as sync output
+  const int freq = 5;
+  for (const auto& avg : avg_type) {
+    write(avg,"nsteps",freq,seed,comm,true);
+    read (avg,"nsteps",freq,seed,comm,true);
+  }
+  scorpio::finalize_subsystem();
+}
+
+TEST_CASE ("io_significant_bits") {
+  using namespace ShortFieldTagsNames;
+  using UT = std::conditional_t<sizeof(Real)==8,std::uint64_t,std::uint32_t>;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::init_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  auto gm = get_gm(comm);
+  auto grid = gm->get_grid("point_grid");
+  auto t0 = get_t0();
+
+  // Use values with a full mantissa, so that rounding actually changes them
+  auto fm = get_fm(grid,t0,seed);
+  std::vector<std::string> fnames;
+  for (auto it : fm->get_repo()) {
+    auto& f = *it.second;
+    randomize_uniform(f,seed++,0.01,100);
+    fnames.push_back(f.name());
+  }
+
+  // Fill values must survive the rounding untouched
+  constexpr auto fv = constants::fill_value<Real>;
+  if (grid->get_num_local_dofs()>0) {
+    auto f1 = fm->get_field("f_1");
+    f1.get_view<Real**,Host>()(0,0) = fv;
+    f1.sync_to_dev();
+  }
+
+  // f_0 keeps 10 bits, f_1 keeps 3 digits (i.e., 10 bits), f_2 is at full precision.
+  // Write in 'real' precision, so that the rounding is the only source of error.
+  const int nsb = 10;
+  ekat::ParameterList om_pl;
+  om_pl.set("filename_prefix",std::string("io_significant_bits"));
+  om_pl.set("field_names",fnames);
+  om_pl.set("averaging_type",std::string("INSTANT"));
+  om_pl.set("floating_point_precision",std::string("real"));
+  om_pl.sublist("significant_bits").set("f_0",nsb);
+  om_pl.sublist("significant_digits").set("f_1",3);
+  auto& ctrl_pl = om_pl.sublist("output_control");
+  ctrl_pl.set("frequency_units",std::string("nsteps"));
+  ctrl_pl.set("frequency",1);
+  ctrl_pl.set("save_grid_data",false);
+
+  OutputManager om;
+  om.initialize(comm,om_pl,t0,false);
+  om.setup(fm,gm->get_grid_names());
+  auto t = t0;
+  om.init_timestep(t,1);
+  t += 1;
+  om.run(t);
+  om.finalize();
+
+  // Read back the snapshot written at t0
+  std::vector<Field> fields_in;
+  for (const auto& n : fnames) {
+    fields_in.push_back(fm->get_field(n).clone());
+  }
+  auto filename = "io_significant_bits.INSTANT.nsteps_x1.np"
+                + std::to_string(comm.size()) + "." + t0.to_string() + ".nc";
+  FieldReader reader;
+  reader.set_file_specs(filename);
+  reader.set_dim_decomp(grid->get_partitioned_dim_gids(),comm);
+  reader.set_fields(fields_in);
+  reader.read(0);
+
+  constexpr int mant_bits = std::numeric_limits<Real>::digits - 1;
+  const UT dropped = (UT(1) << (mant_bits-nsb)) - 1;
+  const Real tol = std::pow(Real(2),-(nsb+1));
+  for (const auto& f : fields_in) {
+    const auto& f0 = fm->get_field(f.name());
+    if (f.name()=="f_2") {
+      REQUIRE (views_are_equal(f,f0));
+      continue;
+    }
+    REQUIRE (scorpio::get_attribute<int>(filename,f.name(),"_QuantizeBitRoundNumberOfSignificantBits")==nsb);
+
+    const auto n = f.get_header().get_alloc_properties().get_num_scalars();
+    const auto data  = f.get_internal_view_data<const Real,Host>();
+    const auto data0 = f0.get_internal_view_data<const Real,Host>();
+    for (int i=0; i<n; ++i) {
+      if (data0[i]==fv) {
+        REQUIRE (data[i]==fv);
+        continue;
+      }
+      // The dropped mantissa bits are zero, and the error is at most half a unit in the last kept bit
+      UT bits;
+      std::memcpy(&bits,&data[i],sizeof(Real));
+      REQUIRE ((bits & dropped)==0);
+      REQUIRE (std::abs(data[i]-data0[i])<=tol*std::abs(data0[i]));
+    }
+  }
+  scorpio::finalize_subsystem();
+}
+
 } // anonymous namespace
@@ -190,6 +190,21 @@ void read (const std::string& avg_type, const std::string& freq_units,
     fields.push_back(it.second->clone());
   }
 
+  // For AVERAGE, also read back the avg count of the COL field, which is
+  // written before being clamped to 1 where it is below the threshold
+  auto read_fields = fields;
+  Field count;
+  if (avg_type=="AVERAGE") {
+    using namespace ShortFieldTagsNames;
+    const int nlcols = grid->get_num_local_dofs();
+    FieldIdentifier cid("avg_count_f_"+std::to_string(nlcols)+"_ncol",
+                        FieldLayout({COL},{nlcols}),ekat::units::none,
+                        grid->name(),DataType::IntType);
+    count = Field(cid);
+    count.allocate_view();
+    read_fields.push_back(count);
+  }
+
   // Create reader pl
   std::string casename = "io_filled";
   auto filename = casename
@@ -202,7 +217,7 @@ void read (const std::string& avg_type, const std::string& freq_units,
   FieldReader reader;
   reader.set_file_specs(filename);
   reader.set_dim_decomp(gids,comm);
-  reader.set_fields(fields);
+  reader.set_fields(read_fields);
 
   // We set the value n to each input field for each odd valued timestep and fill_value for each even valued timestep
   // Hence, at output step N = snap*freq, we should get
@@ -245,6 +260,19 @@ void read (const std::string& avg_type, const std::string& freq_units,
         REQUIRE (views_are_equal(f,f0));
       }
     }
+
+    if (count.is_allocated()) {
+      // Number of steps in this output window where fields were not filled (even steps)
+      int expected = 0;
+      for (int k=n*freq+1; k<=(n+1)*freq; ++k) {
+        expected += k%2==0 ? 1 : 0;
+      }
+      count.sync_to_host();
+      auto cnt = count.get_view<const int*,Host>();
+      for (int i=0; i<count.get_header().get_identifier().get_layout().size(); ++i) {
+        REQUIRE (cnt(i)==expected);
+      }
+    }
   }
 
   // Check that the fill value gets appropriately set for each variable
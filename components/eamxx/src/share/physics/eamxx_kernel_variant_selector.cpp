@@ -0,0 +1,96 @@
+#include "eamxx_kernel_variant_selector.hpp"
+
+#include <ekat_assert.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace scream {
+namespace physics {
+
+void KernelVariantSelector::
+setup (const std::string& mode,
+       const int ntune_steps,
+       const Variant default_variant,
+       const ekat::Comm& comm)
+{
+  m_mode = mode;
+  m_comm = comm;
+  m_num_calls = 0;
+  m_best_time[0] = m_best_time[1] = std::numeric_limits<double>::max();
+
+  if (mode=="default") {
+    m_variant = default_variant;
+    m_tuning = false;
+  } else if (mode=="monolithic") {
+    m_variant = Variant::Monolithic;
+    m_tuning = false;
+  } else if (mode=="small_kernels") {
+    m_variant = Variant::SmallKernels;
+    m_tuning = false;
+  } else if (mode=="auto") {
+    EKAT_REQUIRE_MSG (ntune_steps>0,
+        "[KernelVariantSelector] Error! Number of tuning steps must be positive.\n"
+        " - ntune_steps: " + std::to_string(ntune_steps) + "\n");
+    m_ntune_steps = ntune_steps;
+    m_variant = Variant::Monolithic;
+    m_tuning = true;
+  } else {
+    EKAT_ERROR_MSG (
+        "[KernelVariantSelector] Error! Invalid kernel variant mode.\n"
+        " - mode: " + mode + "\n"
+        " - valid modes: default, monolithic, small_kernels, auto\n");
+  }
+}
+
+bool KernelVariantSelector::record_time (const double time)
+{
+  if (not m_tuning) {
+    return false;
+  }
+
+  // Keep the best time, so that one-time costs of the first call(s) don't bias the choice
+  auto& best = m_best_time[static_cast<int>(m_variant)];
+  best = std::min(best,time);
+  ++m_num_calls;
+
+  if (m_num_calls<2*m_ntune_steps) {
+    // Alternate the two variants
+    m_variant = m_variant==Variant::Monolithic ? Variant::SmallKernels : Variant::Monolithic;
+    return false;
+  }
+
+  double global_best[2];
+  m_comm.all_reduce(m_best_time,global_best,2,MPI_MAX);
+  m_best_time[0] = global_best[0];
+  m_best_time[1] = global_best[1];
+
+  m_variant = m_best_time[1]<m_best_time[0] ? Variant::SmallKernels : Variant::Monolithic;
+  m_tuning = false;
+  return true;
+}
+
+std::string KernelVariantSelector::get_tuning_summary () const
+{
+  std::ostringstream ss;
+  if (m_tuning) {
+    ss << "tuning in progress (" << m_num_calls << "/" << 2*m_ntune_steps << " calls)";
+  } else if (m_mode=="auto") {
+    ss << "selected " << variant_name(m_variant)
+       << " (best time over " << m_ntune_steps << " calls, max across ranks:"
+       << " monolithic=" << m_best_time[0]
+       << ", small_kernels=" << m_best_time[1] << ")";
+  } else {
+    ss << "using " << variant_name(m_variant) << " (mode=" << m_mode << ")";
+  }
+  return ss.str();
+}
+
+std::string KernelVariantSelector::variant_name (const Variant v)
+{
+  return v==Variant::Monolithic ? "monolithic" : "small_kernels";
+}
+
+} // namespace physics
+} // namespace scream
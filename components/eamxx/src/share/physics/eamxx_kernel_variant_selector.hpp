@@ -0,0 +1,82 @@
+#ifndef EAMXX_KERNEL_VARIANT_SELECTOR_HPP
+#define EAMXX_KERNEL_VARIANT_SELECTOR_HPP
+
+#include <ekat_comm.hpp>
+
+#include <string>
+
+namespace scream {
+namespace physics {
+
+/*
+ * Runtime selection between the monolithic and the small kernels
+ * implementations of a parametrization (e.g., P3 or SHOC).
+ *
+ * The selection mode can be
+ *  - "default": use the variant chosen at build time (SCREAM_XYZ_SMALL_KERNELS)
+ *  - "monolithic" or "small_kernels": always use that variant
+ *  - "auto": alternate the two variants for the first 2*nsteps calls, timing
+ *    each call, then lock in the variant with the smallest best time. Since
+ *    the slowest rank sets the pace, times are max-reduced across ranks, so
+ *    that all ranks make the same choice.
+ *
+ * Usage: at each call, run the variant returned by get_variant(), then pass
+ * the elapsed time to record_time (only needed while is_tuning() is true).
+ */
+
+class KernelVariantSelector
+{
+public:
+  enum class Variant {
+    Monolithic,
+    SmallKernels
+  };
+
+  KernelVariantSelector () = default;
+
+  void setup (const std::string& mode,
+              const int ntune_steps,
+              const Variant default_variant,
+              const ekat::Comm& comm);
+
+  const std::string& get_mode () const { return m_mode; }
+
+  // The variant to use for the next call
+  Variant get_variant () const { return m_variant; }
+
+  // Whether the small kernels variant may be used at some point
+  // (e.g., to know whether to allocate its temporaries)
+  bool may_use_small_kernels () const {
+    return m_tuning or m_variant==Variant::SmallKernels;
+  }
+
+  bool is_tuning () const { return m_tuning; }
+
+  // Record the time (in any unit) of the call just made. While tuning, this
+  // advances to the next variant to try. Returns true if the tuning just ended.
+  // NOTE: when tuning ends, this method performs an MPI reduction, so it must
+  //       be called on all ranks of the comm.
+  bool record_time (const double time);
+
+  // A description of the tuning outcome, to be logged
+  std::string get_tuning_summary () const;
+
+  static std::string variant_name (const Variant v);
+
+protected:
+
+  std::string   m_mode = "default";
+  Variant       m_variant = Variant::Monolithic;
+
+  bool          m_tuning = false;
+  int           m_ntune_steps = 0;
+  int           m_num_calls = 0;
+  double        m_best_time[2];
+
+  ekat::Comm    m_comm;
+};
+
+} // namespace physics
+} // namespace scream
+
+#endif // EAMXX_KERNEL_VARIANT_SELECTOR_HPP
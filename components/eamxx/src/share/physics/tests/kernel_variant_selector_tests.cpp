@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include "share/physics/eamxx_kernel_variant_selector.hpp"
+
+namespace {
+
+using namespace scream::physics;
+
+TEST_CASE ("kernel_variant_selector") {
+  using Variant = KernelVariantSelector::Variant;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  SECTION ("fixed") {
+    KernelVariantSelector s;
+
+    s.setup("default",0,Variant::SmallKernels,comm);
+    REQUIRE (s.get_variant()==Variant::SmallKernels);
+    REQUIRE (not s.is_tuning());
+
+    s.setup("monolithic",0,Variant::SmallKernels,comm);
+    REQUIRE (s.get_variant()==Variant::Monolithic);
+    REQUIRE (not s.may_use_small_kernels());
+    REQUIRE (not s.record_time(1.0));
+    REQUIRE (s.get_variant()==Variant::Monolithic);
+
+    s.setup("small_kernels",0,Variant::Monolithic,comm);
+    REQUIRE (s.get_variant()==Variant::SmallKernels);
+    REQUIRE (s.may_use_small_kernels());
+  }
+
+  SECTION ("auto") {
+    const int nsteps = 3;
+    for (auto winner : {Variant::Monolithic, Variant::SmallKernels}) {
+      KernelVariantSelector s;
+      s.setup("auto",nsteps,Variant::Monolithic,comm);
+      REQUIRE (s.is_tuning());
+      REQUIRE (s.may_use_small_kernels());
+
+      // The variants alternate during tuning, and the first call of each variant is slow.
+      // The winner is faster only on rank 0, so with more ranks the max-reduced times
+      // are equal, in which case monolithic is kept (on all ranks).
+      Variant expected = Variant::Monolithic;
+      for (int i=0; i<2*nsteps; ++i) {
+        REQUIRE (s.is_tuning());
+        const auto v = s.get_variant();
+        REQUIRE (v==expected);
+        double time = i<2 ? 100.0 : 10.0;
+        if (v==winner) {
+          time = comm.rank()==0 ? time/2 : time;
+        }
+        const bool done = s.record_time(time);
+        REQUIRE (done==(i==2*nsteps-1));
+        expected = expected==Variant::Monolithic ? Variant::SmallKernels : Variant::Monolithic;
+      }
+      REQUIRE (not s.is_tuning());
+      REQUIRE (s.get_variant()==(comm.size()==1 ? winner : Variant::Monolithic));
+
+      // Once tuned, the choice is locked
+      REQUIRE (not s.record_time(0.0));
+      REQUIRE (s.get_variant()==(comm.size()==1 ? winner : Variant::Monolithic));
+    }
+  }
+
+  SECTION ("errors") {
+    KernelVariantSelector s;
+    REQUIRE_THROWS (s.setup("fastest",1,Variant::Monolithic,comm));
+    REQUIRE_THROWS (s.setup("auto",0,Variant::Monolithic,comm));
+  }
+}
+
+} // anonymous namespace
@@ -0,0 +1,177 @@
+#include "share/property_checks/property_check_batch.hpp"
+#include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/field_within_interval_check.hpp"
+
+#include <ekat_team_policy_utils.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace scream
+{
+
+namespace {
+
+template<int N>
+void set_item_data (const Field& f, PropertyCheckBatch::WorkItem& item)
+{
+  using data_t = typename ekat::DataND<const Real,N>::type;
+  auto v = f.get_strided_view<data_t>();
+  item.data = v.data();
+  for (int i=0; i<N; ++i) {
+    item.strides[i] = v.stride(i);
+  }
+}
+
+} // anonymous namespace
+
+void PropertyCheckBatch::add_check (const prop_check_ptr& pc)
+{
+  EKAT_REQUIRE_MSG (pc!=nullptr,
+      "Error! Invalid property check pointer in PropertyCheckBatch::add_check.\n");
+
+  // We can batch checks of the form lb <= f <= ub on a single Real field.
+  // A NaN check is just the interval (-inf,inf), since NaN fails all comparisons.
+  bool batchable = dynamic_cast<const FieldNaNCheck*>(pc.get())!=nullptr or
+                   dynamic_cast<const FieldWithinIntervalCheck*>(pc.get())!=nullptr;
+  if (batchable) {
+    const auto& f = pc->fields().front();
+    batchable = f.data_type()==get_data_type<Real>() and f.rank()>=1 and f.rank()<=6;
+  }
+
+  m_checks.push_back(pc);
+  m_batchable.push_back(batchable);
+  m_passed_mask.resize((m_checks.size()+31)/32,0);
+
+  // Work items need to be rebuilt
+  m_setup_done = false;
+}
+
+int PropertyCheckBatch::num_batched_checks () const
+{
+  int n = 0;
+  for (bool b : m_batchable) {
+    n += b ? 1 : 0;
+  }
+  return n;
+}
+
+void PropertyCheckBatch::setup ()
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+
+  std::vector<WorkItem> items;
+  for (int ic=0; ic<num_checks(); ++ic) {
+    if (not m_batchable[ic]) {
+      continue;
+    }
+    const auto& pc = m_checks[ic];
+    const auto& f  = pc->fields().front();
+    EKAT_REQUIRE_MSG (f.is_allocated(),
+        "Error! PropertyCheckBatch requires fields to be allocated before the first run.\n"
+        "  - Property check name: " + pc->name() + "\n"
+        "  - Field name: " + f.name() + "\n");
+
+    WorkItem item;
+    item.check = ic;
+    item.rank  = f.rank();
+    if (auto fwic = dynamic_cast<const FieldWithinIntervalCheck*>(pc.get())) {
+      item.lb = fwic->lower_bound();
+      item.ub = fwic->upper_bound();
+    } else {
+      item.lb = -inf;
+      item.ub =  inf;
+    }
+
+    const auto& layout = f.get_header().get_identifier().get_layout();
+    for (int i=0; i<item.rank; ++i) {
+      item.extents[i] = layout.dim(i);
+    }
+    switch (item.rank) {
+      case 1: set_item_data<1>(f,item); break;
+      case 2: set_item_data<2>(f,item); break;
+      case 3: set_item_data<3>(f,item); break;
+      case 4: set_item_data<4>(f,item); break;
+      case 5: set_item_data<5>(f,item); break;
+      case 6: set_item_data<6>(f,item); break;
+    }
+
+    // Split large fields in chunks, so that we expose enough parallelism
+    const int size = layout.size();
+    for (int beg=0; beg<size; beg+=s_chunk_size) {
+      item.begin = beg;
+      item.end   = std::min(beg+s_chunk_size,size);
+      items.push_back(item);
+    }
+  }
+
+  m_items = view_1d<WorkItem>("property_check_batch_items",items.size());
+  auto items_h = Kokkos::create_mirror_view(m_items);
+  for (size_t i=0; i<items.size(); ++i) {
+    items_h(i) = items[i];
+  }
+  Kokkos::deep_copy(m_items,items_h);
+
+  m_fail_mask   = view_1d<std::uint32_t>("property_check_batch_fail_mask",m_passed_mask.size());
+  m_fail_mask_h = Kokkos::create_mirror_view(m_fail_mask);
+
+  m_setup_done = true;
+}
+
+void PropertyCheckBatch::run ()
+{
+  if (not m_setup_done) {
+    setup();
+  }
+
+  using TeamPolicy = Kokkos::TeamPolicy<KT::ExeSpace>;
+  using TeamMember = typename TeamPolicy::member_type;
+  using TPF        = ekat::TeamPolicyFactory<KT::ExeSpace>;
+
+  const int nitems = m_items.size();
+  if (nitems>0) {
+    auto items = m_items;
+    auto fail_mask = m_fail_mask;
+    Kokkos::deep_copy(fail_mask,0);
+
+    auto policy = TPF::get_default_team_policy(nitems,s_chunk_size);
+    Kokkos::parallel_for("PropertyCheckBatch::run",policy,
+        KOKKOS_LAMBDA(const TeamMember& team) {
+          const auto& item = items(team.league_rank());
+          int nfail = 0;
+          Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team,item.begin,item.end),
+              [&](const int idx, int& n) {
+                // Unflatten the index, and compute the offset in the (possibly strided) data
+                int offset = 0;
+                int rem = idx;
+                for (int d=item.rank-1; d>=0; --d) {
+                  offset += (rem % item.extents[d])*item.strides[d];
+                  rem /= item.extents[d];
+                }
+                const double v = item.data[offset];
+                if (not (v>=item.lb and v<=item.ub)) {
+                  ++n;
+                }
+              },nfail);
+          if (nfail>0) {
+            Kokkos::single(Kokkos::PerTeam(team),[&]{
+              Kokkos::atomic_or(&fail_mask(item.check/32),std::uint32_t(1) << (item.check%32));
+            });
+          }
+        });
+    Kokkos::deep_copy(m_fail_mask_h,fail_mask);
+  }
+
+  for (size_t w=0; w<m_passed_mask.size(); ++w) {
+    m_passed_mask[w] = nitems>0 ? ~m_fail_mask_h(w) : ~std::uint32_t(0);
+  }
+
+  // Non-batchable checks are never reported as passed
+  for (int ic=0; ic<num_checks(); ++ic) {
+    if (not m_batchable[ic]) {
+      m_passed_mask[ic/32] &= ~(std::uint32_t(1) << (ic%32));
+    }
+  }
+}
+
+} // namespace scream
@@ -0,0 +1,99 @@
+#ifndef SCREAM_PROPERTY_CHECK_BATCH_HPP
+#define SCREAM_PROPERTY_CHECK_BATCH_HPP
+
+#include "share/property_checks/property_check.hpp"
+#include "share/core/eamxx_types.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A class to quickly evaluate a set of property checks
+ *
+ * Running each PC separately means one small parallel_reduce per check,
+ * plus the construction of the result message, even when the check passes.
+ * With many checks per process (e.g., NaN checks on all outputs), that adds up.
+ *
+ * This class instead evaluates all the pointwise checks that it knows how to
+ * handle (FieldNaNCheck, FieldWithinIntervalCheck and derived classes, on Real
+ * fields) with a single kernel over all their fields, and stores the outcome
+ * in a bitmask with one bit per check. No string is built in the process.
+ *
+ * A check that passed in the batch is guaranteed to pass if run separately.
+ * A check that did not pass (or that cannot be batched) must be run separately,
+ * via PropertyCheck::check(), to get the actual result (which may be Pass, Fail,
+ * or Repairable) and the message. Hence, the expected usage is
+ *
+ *   batch.run();
+ *   for (int i=0; i<batch.num_checks(); ++i) {
+ *     if (not batch.passed(i)) {
+ *       auto res_and_msg = checks[i]->check();
+ *       ...
+ *     }
+ *   }
+ */
+
+class PropertyCheckBatch {
+public:
+  using prop_check_ptr = std::shared_ptr<const PropertyCheck>;
+
+  // Add a check. Checks that cannot be batched are accepted too, and
+  // simply are never reported as passed.
+  void add_check (const prop_check_ptr& pc);
+
+  int num_checks () const { return m_checks.size(); }
+  int num_batched_checks () const;
+
+  // Evaluate all batchable checks with one kernel
+  void run ();
+
+  // Whether the i-th check (in order of addition) passed during the last run
+  bool passed (const int i) const {
+    return (m_passed_mask[i/32] >> (i%32)) & 1u;
+  }
+
+  // The bitmask of passed checks, with check i stored in bit i%32 of word i/32
+  const std::vector<std::uint32_t>& passed_mask () const { return m_passed_mask; }
+
+  // Work items processed by one team: a contiguous range of entries of one field
+  struct WorkItem {
+    const Real* data;
+    int  check;
+    int  rank;
+    int  extents[6];
+    int  strides[6];
+    int  begin;
+    int  end;
+    double lb;
+    double ub;
+  };
+
+protected:
+  void setup ();
+
+  using KT = KokkosTypes<DefaultDevice>;
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+
+  // Number of field entries processed by one team
+  static constexpr int s_chunk_size = 4096;
+
+  std::vector<prop_check_ptr> m_checks;
+  std::vector<bool>           m_batchable;
+
+  view_1d<WorkItem>       m_items;
+  view_1d<std::uint32_t>  m_fail_mask;
+  typename view_1d<std::uint32_t>::host_mirror_type m_fail_mask_h;
+
+  std::vector<std::uint32_t>  m_passed_mask;
+
+  bool m_setup_done = false;
+};
+
+} // namespace scream
+
+#endif // SCREAM_PROPERTY_CHECK_BATCH_HPP
@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include "pc_tests_helpers.hpp"
+
+#include "share/property_checks/property_check_batch.hpp"
+#include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/field_lower_bound_check.hpp"
+#include "share/property_checks/field_upper_bound_check.hpp"
+#include "share/property_checks/field_within_interval_check.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/core/eamxx_setup_random_test.hpp"
+
+namespace scream {
+
+// A check that cannot be batched
+class AlwaysPassCheck : public PropertyCheck {
+public:
+  AlwaysPassCheck (const Field& f) { set_fields({f},{false}); }
+  std::string name () const override { return "always pass"; }
+  PropertyType type () const override { return PropertyType::Global; }
+  ResultAndMsg check () const override { return ResultAndMsg{CheckResult::Pass,"",{},{}}; }
+};
+
+TEST_CASE("property_check_batch") {
+  using namespace ShortFieldTagsNames;
+
+  auto seed = get_random_test_seed();
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  const int num_lcols = 2;
+  const int nlevs = 12;
+
+  auto grid = create_test_grid(comm,num_lcols,nlevs);
+
+  // A field large enough to be split in several chunks, and one subfield
+  FieldIdentifier big_fid ("big",grid->get_3d_scalar_layout(LEV).append_dim(CMP,500),
+                           ekat::units::m,grid->name());
+  Field big(big_fid);
+  big.allocate_view();
+  auto f = create_test_field(grid);
+  auto f_sub = f.subfield(CMP,1);
+
+  PropertyCheckBatch batch;
+  std::vector<std::shared_ptr<PropertyCheck>> checks = {
+    std::make_shared<FieldNaNCheck>(f,grid),
+    std::make_shared<FieldWithinIntervalCheck>(f,grid,0,1),
+    std::make_shared<FieldLowerBoundCheck>(f_sub,grid,0),
+    std::make_shared<FieldUpperBoundCheck>(big,grid,1),
+    std::make_shared<AlwaysPassCheck>(f),
+    std::make_shared<FieldNaNCheck>(big,grid),
+  };
+  for (const auto& pc : checks) {
+    batch.add_check(pc);
+  }
+  REQUIRE (batch.num_checks()==6);
+  REQUIRE (batch.num_batched_checks()==5);
+
+  // Verify that checks passing in the batch do pass when run individually
+  auto verify = [&](const std::vector<bool>& expected) {
+    batch.run();
+    for (int i=0; i<batch.num_checks(); ++i) {
+      REQUIRE (batch.passed(i)==expected[i]);
+      if (batch.passed(i)) {
+        REQUIRE (checks[i]->check().result==CheckResult::Pass);
+      }
+    }
+  };
+
+  randomize_uniform(f,seed++,0.01,0.99);
+  randomize_uniform(big,seed++,0.01,0.99);
+  verify({true,true,true,true,false,true});
+
+  // Entry of f outside [0,1] but not in the subfield
+  auto f_0 = f.subfield(CMP,0).subfield(COL,1).subfield(LEV,3);
+  f_0.deep_copy(2);
+  verify({true,false,true,true,false,true});
+
+  // Negative entry in the subfield
+  auto f_1 = f_sub.subfield(COL,0).subfield(LEV,nlevs-1);
+  f_1.deep_copy(-1);
+  verify({true,false,false,true,false,true});
+
+  // NaN in the last chunk of the big field (fails the upper bound check too)
+  auto nan = std::numeric_limits<Real>::quiet_NaN();
+  big.sync_to_host();
+  auto big_h = big.get_view<Real***,Host>();
+  big_h(num_lcols-1,nlevs-1,499) = nan;
+  big.sync_to_dev();
+  verify({true,false,false,false,false,false});
+
+  // Fix everything, and run again
+  randomize_uniform(f,seed++,0.01,0.99);
+  randomize_uniform(big,seed++,0.01,0.99);
+  verify({true,true,true,true,false,true});
+
+  // Checks added after a run are picked up by the next run
+  batch.add_check(std::make_shared<FieldWithinIntervalCheck>(big,grid,0.5,1));
+  batch.run();
+  REQUIRE (batch.num_checks()==7);
+  REQUIRE (not batch.passed(6));
+  REQUIRE (batch.passed(5));
+}
+
+} // namespace scream
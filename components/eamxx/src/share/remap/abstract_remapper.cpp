@@ -1,5 +1,6 @@
 #include "share/remap/abstract_remapper.hpp"
 #include "share/util/eamxx_timing.hpp"
+#include "share/util/eamxx_memory_tracker.hpp"
 
 namespace scream
 {
@@ -100,7 +101,10 @@ void AbstractRemapper::registration_ends ()
 
   // Call derived class impl first. They may register extra/internal fields,
   // so we must keep the repo OPEN until they're done.
-  registration_ends_impl();
+  {
+    MemoryTracker::OwnerScope owner("remapper: " + name());
+    registration_ends_impl();
+  }
 
   for (int i=0; i<m_num_fields; ++i) {
     EKAT_REQUIRE_MSG(m_src_fields[i].is_allocated(),
@@ -116,10 +120,33 @@ void AbstractRemapper::registration_ends ()
   m_state = RepoState::Closed;
 }
 
+void AbstractRemapper::toggle_timers (const bool enable)
+{
+  m_timers_enabled = enable;
+  if (m_timers_enabled) {
+    register_timers();
+  }
+}
+
+void AbstractRemapper::set_name (const std::string& n)
+{
+  m_name = n;
+  if (m_timers_enabled) {
+    // The timers names depend on the remapper name
+    register_timers();
+  }
+}
+
+void AbstractRemapper::register_timers ()
+{
+  m_fwd_timer = register_timer(name()+" fwd");
+  m_bwd_timer = register_timer(name()+" bwd");
+}
+
 void AbstractRemapper::remap_fwd ()
 {
   if (m_timers_enabled)
-    start_timer(name()+" fwd");
+    start_timer(m_fwd_timer);
   EKAT_REQUIRE_MSG(m_state!=RepoState::Open,
       "Error! Cannot perform remapping at this time.\n"
       "       Did you forget to call 'registration_ends'?\n");
@@ -130,13 +157,13 @@ void AbstractRemapper::remap_fwd ()
       "Error! Forward remap IS allowed by this remapper, but some of the tgt fields are read-only\n");
   remap_fwd_impl ();
   if (m_timers_enabled)
-    stop_timer(name()+" fwd");
+    stop_timer(m_fwd_timer);
 }
 
 void AbstractRemapper::remap_bwd ()
 {
   if (m_timers_enabled)
-    start_timer(name()+" bwd");
+    start_timer(m_bwd_timer);
   EKAT_REQUIRE_MSG(m_state!=RepoState::Open,
       "Error! Cannot perform remapping at this time.\n"
       "       Did you forget to call 'registration_ends'?\n");
@@ -147,7 +174,7 @@ void AbstractRemapper::remap_bwd ()
       "Error! Backward remap IS allowed by this remapper, but some of the src fields are read-only\n");
   remap_bwd_impl ();
   if (m_timers_enabled)
-    stop_timer(name()+" bwd");
+    stop_timer(m_bwd_timer);
 }
 
 void AbstractRemapper::
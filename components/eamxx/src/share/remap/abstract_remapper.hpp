@@ -43,7 +43,7 @@ public:
   // Call this to indicate that field registration is complete.
   void registration_ends ();
 
-  void toggle_timers (const bool enable) { m_timers_enabled = enable; }
+  void toggle_timers (const bool enable);
 
   //  ------- Getter methods ------- //
   RepoState get_state () const { return m_state; }
@@ -80,9 +80,13 @@ public:
   }
 
   const std::string& name() const { return m_name; }
-  void set_name (const std::string& n) { m_name = n; }
+  void set_name (const std::string& n);
 protected:
 
+  // Register the timers used by this remapper. Derived classes with their
+  // own timers should override this method (and call the base class one).
+  virtual void register_timers ();
+
   virtual FieldLayout create_layout (const FieldLayout& from_layout,
                                      const grid_ptr_type& to_grid) const;
 
@@ -120,6 +124,8 @@ protected:
   int           m_num_fields = 0;
 
   bool          m_timers_enabled = false;
+  int           m_fwd_timer = -1;
+  int           m_bwd_timer = -1;
 
   std::vector<Field> m_src_fields;
   std::vector<Field> m_tgt_fields;
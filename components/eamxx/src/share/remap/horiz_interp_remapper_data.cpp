@@ -7,8 +7,12 @@
 #include "share/util/eamxx_timing.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <numeric>
 #include <filesystem>
+#include <fstream>
 
 namespace scream {
 
@@ -54,6 +58,29 @@ bool grids_have_same_gids (const std::shared_ptr<const AbstractGrid>& g1,
   return std::equal(h1.data(), h1.data()+n, h2.data());
 }
 
+// 64-bit FNV-1a hash, which can be fed data incrementally
+struct Fnv1aHash {
+  std::uint64_t value = 14695981039346656037ull;
+
+  void update (const void* data, const std::size_t nbytes) {
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    for (std::size_t i=0; i<nbytes; ++i) {
+      value ^= bytes[i];
+      value *= 1099511628211ull;
+    }
+  }
+};
+
+std::string to_hex (const std::uint64_t v) {
+  char buf[17];
+  std::snprintf(buf,sizeof(buf),"%016llx",static_cast<unsigned long long>(v));
+  return buf;
+}
+
+// Header of remap data cache files. The version must be bumped if the content changes
+constexpr char cache_magic[8] = {'E','A','M','X','X','H','R','M'};
+constexpr int  cache_version  = 1;
+
 // Helper fcn to gather the union of sets across MPI ranks
 std::vector<Real> allgatherv_vec (const std::vector<Real>& my_vals, const ekat::Comm& comm)
 {
@@ -85,7 +112,8 @@ std::vector<Real> allgatherv_vec (const std::vector<Real>& my_vals, const ekat::
 void HorizRemapperData::
 build (const std::shared_ptr<const AbstractGrid>& src_grid,
        const std::shared_ptr<const AbstractGrid>& tgt_grid,
-       const std::string& map_file)
+       const std::string& map_file,
+       const std::string& cache_dir)
 {
   std::filesystem::path p(map_file);
   // The "2" stands for "2 grids bld"
@@ -131,28 +159,43 @@ build (const std::shared_ptr<const AbstractGrid>& src_grid,
   m_src_grid = src_grid;
   m_tgt_grid = tgt_grid;
 
-  // Load sparse matrix triplets, splitting evenly across ranks
-  auto triplets = read_mat_triplets(map_file);
+  // The remap data only depends on the map file and on the grids decomposition,
+  // so a previous run with the same ones may have saved it
+  std::string cache_file;
+  if (cache_dir!="") {
+    cache_file = get_cache_file_name(cache_dir,map_file);
+    m_loaded_from_cache = load_from_cache(cache_file);
+  }
 
-  // Gather sparse matrix triplets needed by this rank
-  auto my_triplets = get_my_triplets (triplets);
+  if (not m_loaded_from_cache) {
+    // Load sparse matrix triplets, splitting evenly across ranks
+    auto triplets = read_mat_triplets(map_file);
 
-  // Create aux and ov grids
-  create_ov_grid (my_triplets);
+    // Gather sparse matrix triplets needed by this rank
+    auto my_triplets = get_my_triplets (triplets);
 
-  // Create crs matrix
-  create_crs_matrix_structures (my_triplets);
+    // Create aux and ov grids
+    create_ov_grid (my_triplets);
 
-  if (m_coarsening) {
-    m_imp_exp = std::make_shared<GridImportExport>(tgt_grid,m_overlap_grid);
-  } else {
-    m_imp_exp = std::make_shared<GridImportExport>(src_grid,m_overlap_grid);
+    // Create crs matrix
+    create_crs_matrix_structures (my_triplets);
+
+    if (m_coarsening) {
+      m_imp_exp = std::make_shared<GridImportExport>(tgt_grid,m_overlap_grid);
+    } else {
+      m_imp_exp = std::make_shared<GridImportExport>(src_grid,m_overlap_grid);
+    }
+
+    if (cache_dir!="") {
+      save_to_cache(cache_dir,cache_file);
+    }
   }
   stop_timer ("HRemap2 " + p.filename().string() + " bld");
 }
 void HorizRemapperData::
 build (const std::shared_ptr<const AbstractGrid>& grid,
-       const std::string& map_file)
+       const std::string& map_file,
+       const std::string& cache_dir)
 {
   std::filesystem::path p(map_file);
 
@@ -215,9 +258,9 @@ build (const std::shared_ptr<const AbstractGrid>& grid,
   }
 
   if (built_from_src) {
-    build(grid,gen_grid,map_file);
+    build(grid,gen_grid,map_file,cache_dir);
   } else {
-    build(gen_grid,grid,map_file);
+    build(gen_grid,grid,map_file,cache_dir);
   }
 
   stop_timer ("HRemap1 " + p.filename().string() + " bld");
@@ -394,6 +437,198 @@ create_crs_matrix_structures (std::vector<Triplet>& triplets)
   Kokkos::deep_copy(m_row_offsets,row_offsets_h);
 }
 
+std::string HorizRemapperData::
+get_cache_file_name (const std::string& cache_dir,
+                     const std::string& map_file) const
+{
+  using gid_type = AbstractGrid::gid_type;
+
+  const auto& comm = m_src_grid->get_comm();
+
+  // Key the map file on its size and modification time, which is much cheaper than
+  // hashing its content. Only root queries the file system, then broadcasts the result
+  std::int64_t file_stamp[2] = {0,0};
+  int stat_ok = 1;
+  if (comm.am_i_root()) {
+    std::error_code ec_size, ec_time;
+    const auto size  = std::filesystem::file_size(map_file,ec_size);
+    const auto mtime = std::filesystem::last_write_time(map_file,ec_time);
+    stat_ok = (ec_size or ec_time) ? 0 : 1;
+    if (stat_ok==1) {
+      file_stamp[0] = size;
+      file_stamp[1] = mtime.time_since_epoch().count();
+    }
+  }
+  comm.broadcast(&stat_ok,1,comm.root_rank());
+  EKAT_REQUIRE_MSG (stat_ok==1,
+      "Error! Could not query size and modification time of the map file.\n"
+      " - map file: " + map_file + "\n");
+  MPI_Bcast(file_stamp,2,MPI_INT64_T,comm.root_rank(),comm.mpi_comm());
+  Fnv1aHash file_hash;
+  file_hash.update(file_stamp,sizeof(file_stamp));
+
+  // Hash of the decomposition: hash the gids of src/tgt grids on each rank,
+  // then hash the result of all ranks (in rank order)
+  Fnv1aHash my_hash;
+  auto hash_gids = [&](const AbstractGrid& grid) {
+    const int n = grid.get_num_local_dofs();
+    auto gids_h = grid.get_dofs_gids().get_view<const gid_type*,Host>();
+    my_hash.update(&n,sizeof(int));
+    my_hash.update(gids_h.data(),n*sizeof(gid_type));
+  };
+  hash_gids(*m_src_grid);
+  hash_gids(*m_tgt_grid);
+  std::vector<std::uint64_t> all_hashes(comm.size());
+  MPI_Allgather(&my_hash.value,1,MPI_UINT64_T,all_hashes.data(),1,MPI_UINT64_T,comm.mpi_comm());
+  Fnv1aHash decomp_hash;
+  decomp_hash.update(all_hashes.data(),all_hashes.size()*sizeof(std::uint64_t));
+
+  std::filesystem::path map_path(map_file);
+  std::string fname = "hremap." + map_path.stem().string() + "." + to_hex(file_hash.value)
+                    + "." + to_hex(decomp_hash.value) + ".r" + std::to_string(comm.rank()) + ".bin";
+  return (std::filesystem::path(cache_dir) / fname).string();
+}
+
+bool HorizRemapperData::
+load_from_cache (const std::string& cache_file)
+{
+  using gid_type = AbstractGrid::gid_type;
+
+  const auto& comm = m_src_grid->get_comm();
+
+  std::vector<gid_type> ov_gids;
+  std::vector<int>  row_offsets, col_lids;
+  std::vector<Real> weights;
+  std::vector<int>  import_pids, import_lids, export_pids, export_lids;
+
+  std::ifstream ifs(cache_file,std::ios::binary);
+  auto read_vec = [&](auto& v) {
+    using T = typename std::decay_t<decltype(v)>::value_type;
+    std::int64_t n = -1;
+    ifs.read(reinterpret_cast<char*>(&n),sizeof(n));
+    if (not ifs or n<0) {
+      return false;
+    }
+    v.resize(n);
+    ifs.read(reinterpret_cast<char*>(v.data()),n*sizeof(T));
+    return static_cast<bool>(ifs);
+  };
+
+  bool ok = ifs.good();
+  if (ok) {
+    char magic[8];
+    int version, real_size, coarsening;
+    ifs.read(magic,sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&version),sizeof(int));
+    ifs.read(reinterpret_cast<char*>(&real_size),sizeof(int));
+    ifs.read(reinterpret_cast<char*>(&coarsening),sizeof(int));
+    ok = ifs and std::memcmp(magic,cache_magic,sizeof(magic))==0 and
+         version==cache_version and real_size==sizeof(Real) and
+         coarsening==static_cast<int>(m_coarsening);
+  }
+  ok = ok and read_vec(ov_gids) and read_vec(row_offsets) and read_vec(col_lids) and read_vec(weights)
+          and read_vec(import_pids) and read_vec(import_lids)
+          and read_vec(export_pids) and read_vec(export_lids);
+
+  // Some sanity checks, in case the file is corrupted. Rows are on the ov grid if coarsening
+  const int num_rows = m_coarsening ? ov_gids.size() : m_tgt_grid->get_num_local_dofs();
+  ok = ok and static_cast<int>(row_offsets.size())==num_rows+1
+          and row_offsets.back()==static_cast<int>(col_lids.size())
+          and weights.size()==col_lids.size() and import_pids.size()==ov_gids.size();
+
+  // All ranks must agree, since building from scratch requires collective operations
+  int my_ok = ok ? 1 : 0;
+  int all_ok;
+  comm.all_reduce(&my_ok,&all_ok,1,MPI_MIN);
+  if (all_ok==0) {
+    return false;
+  }
+
+  m_overlap_grid = std::make_shared<PointGrid>("ov_coarse_grid",ov_gids.size(),0,comm);
+  auto gids_h = m_overlap_grid->get_dofs_gids().get_view<gid_type*,Host>();
+  std::copy(ov_gids.begin(),ov_gids.end(),gids_h.data());
+  m_overlap_grid->get_dofs_gids().sync_to_dev();
+
+  auto to_view = [](const auto& v, auto& d) {
+    using view_t = std::decay_t<decltype(d)>;
+    d = view_t("",v.size());
+    auto h = Kokkos::create_mirror_view(d);
+    std::copy(v.begin(),v.end(),h.data());
+    Kokkos::deep_copy(d,h);
+  };
+  to_view(row_offsets,m_row_offsets);
+  to_view(col_lids,m_col_lids);
+  to_view(weights,m_weights);
+
+  auto unique_grid = m_coarsening ? m_tgt_grid : m_src_grid;
+  m_imp_exp = std::make_shared<GridImportExport>(unique_grid,m_overlap_grid,
+                                                 import_pids,import_lids,
+                                                 export_pids,export_lids);
+  return true;
+}
+
+void HorizRemapperData::
+save_to_cache (const std::string& cache_dir, const std::string& cache_file) const
+{
+  using gid_type = AbstractGrid::gid_type;
+
+  const auto& comm = m_src_grid->get_comm();
+
+  if (comm.am_i_root()) {
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir,ec);
+  }
+  comm.barrier();
+
+  std::ofstream ofs(cache_file + ".tmp",std::ios::binary);
+  auto write_ptr = [&](const auto* data, const std::int64_t n) {
+    ofs.write(reinterpret_cast<const char*>(&n),sizeof(n));
+    ofs.write(reinterpret_cast<const char*>(data),n*sizeof(*data));
+  };
+  auto write_view = [&](const auto& v) {
+    auto h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v);
+    write_ptr(h.data(),h.size());
+  };
+
+  const int real_size = sizeof(Real);
+  const int coarsening = m_coarsening;
+  ofs.write(cache_magic,sizeof(cache_magic));
+  ofs.write(reinterpret_cast<const char*>(&cache_version),sizeof(int));
+  ofs.write(reinterpret_cast<const char*>(&real_size),sizeof(int));
+  ofs.write(reinterpret_cast<const char*>(&coarsening),sizeof(int));
+
+  auto ov_gids_h = m_overlap_grid->get_dofs_gids().get_view<const gid_type*,Host>();
+  write_ptr(ov_gids_h.data(),ov_gids_h.size());
+  write_view(m_row_offsets);
+  write_view(m_col_lids);
+  write_view(m_weights);
+  write_view(m_imp_exp->import_pids_h());
+  write_view(m_imp_exp->import_lids_h());
+  write_view(m_imp_exp->export_pids_h());
+  write_view(m_imp_exp->export_lids_h());
+  ofs.close();
+
+  // Write to a tmp file first, so that a crash while writing does not leave a truncated file
+  std::error_code ec;
+  if (ofs) {
+    std::filesystem::rename(cache_file + ".tmp",cache_file,ec);
+  }
+  int my_ok = (ofs and not ec) ? 1 : 0;
+  int all_ok;
+  comm.all_reduce(&my_ok,&all_ok,1,MPI_MIN);
+
+  // The cache is only an optimization: if we could not save it (e.g., the dir is not
+  // writable, or the disk is full), we can still run with the data we just built.
+  // Remove what we wrote though, since a partial cache is useless for the next run
+  if (all_ok==0) {
+    std::filesystem::remove(cache_file + ".tmp",ec);
+    std::filesystem::remove(cache_file,ec);
+    m_logger->warn("[HorizRemapperData] Could not save horizontal remap data to the cache directory.\n"
+                   "  The remap data will be rebuilt from the map file in the next run.\n"
+                   " - cache dir: " + cache_dir + "\n");
+  }
+}
+
 void HorizRemapperData::
 setup_latlon_data(const std::shared_ptr<AbstractGrid>& grid,
                   const std::string& map_file)
@@ -523,7 +758,8 @@ get_data (const std::shared_ptr<const AbstractGrid>& src_grid,
   // destroyed. Either way, we can safely (re-)create the data
 
   auto shared_data = std::make_shared<HorizRemapperData>();
-  shared_data->build(src_grid,tgt_grid,map_file);
+  shared_data->m_logger = m_logger;
+  shared_data->build(src_grid,tgt_grid,map_file,m_cache_dir);
   data = shared_data;
 
   return shared_data;
@@ -553,7 +789,8 @@ get_data (const std::shared_ptr<const AbstractGrid>& grid,
   // destroyed. Either way, we can safely (re-)create the data
 
   auto shared_data = std::make_shared<HorizRemapperData>();
-  shared_data->build(grid,map_file);
+  shared_data->m_logger = m_logger;
+  shared_data->build(grid,map_file,m_cache_dir);
   data = shared_data;
 
   return shared_data;
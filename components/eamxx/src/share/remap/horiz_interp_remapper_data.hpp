@@ -3,6 +3,7 @@
 
 #include "share/grid/abstract_grid.hpp"
 #include "share/grid/grid_import_export.hpp"
+#include "share/util/eamxx_utils.hpp"
 
 #include <memory>
 #include <map>
@@ -35,14 +36,19 @@ public:
   template<typename T>
   using view_1d = typename KT::template view_1d<T>;
 
-  // If src/tgt grids are already avail, use them
+  // If src/tgt grids are already avail, use them.
+  // If cache_dir is not empty, the CRS data and the import/export plan are loaded
+  // from a per-rank file in cache_dir, if one exists for this map file and grids
+  // decomposition. Otherwise, they are computed and saved there for future runs.
   void build (const std::shared_ptr<const AbstractGrid>& src_grid,
               const std::shared_ptr<const AbstractGrid>& tgt_grid,
-              const std::string& map_file);
+              const std::string& map_file,
+              const std::string& cache_dir = "");
 
   // Builds a tgt grid from map_file info, then calls the above one
   void build (const std::shared_ptr<const AbstractGrid>& grid,
-              const std::string& map_file);
+              const std::string& map_file,
+              const std::string& cache_dir = "");
 
   // The CRS matrix data for online interpolation
   view_1d<int>    m_row_offsets;
@@ -60,6 +66,11 @@ public:
   // This will be an overlap version of either the src or tgt grid, depending on whether
   // the remap is fine->coarse or coarse->fine
   std::shared_ptr<AbstractGrid> m_overlap_grid;
+
+  // Whether the data was loaded from the cache dir (see build)
+  bool m_loaded_from_cache = false;
+
+  std::shared_ptr<ekat::logger::LoggerBase> m_logger = console_logger(ekat::logger::LogLevel::warn);
 private:
 
   // Read sparse matrix in triplets form. The triplets are split uniformly across ranks
@@ -77,6 +88,16 @@ private:
   // Not a const ref, since we'll sort the triplets according to
   // how row gids appear in the coarse grid
   void create_crs_matrix_structures (std::vector<Triplet>& triplets);
+
+  // The name of this rank's cache file, which encodes a hash of the map file
+  // size and modification time, and a hash of the src/tgt grids decomposition
+  std::string get_cache_file_name (const std::string& cache_dir,
+                                   const std::string& map_file) const;
+
+  // Load from cache file. Returns false (on all ranks) if any rank could not load its data
+  bool load_from_cache (const std::string& cache_file);
+  // Save to cache file. Failing to save only prints a warning, since the cache is not needed to run
+  void save_to_cache (const std::string& cache_dir, const std::string& cache_file) const;
 };
 
 // A small struct to hold horiz remap data, which can be shared across multiple horiz remappers
@@ -98,10 +119,20 @@ public:
   get_data (const std::shared_ptr<const AbstractGrid>& grid,
             const std::string& map_file);
 
+  // If set, remap data is loaded from/saved to this directory (see HorizRemapperData::build)
+  void set_cache_dir (const std::string& cache_dir) { m_cache_dir = cache_dir; }
+  const std::string& get_cache_dir () const { return m_cache_dir; }
+
+  void set_logger (const std::shared_ptr<ekat::logger::LoggerBase>& logger) { m_logger = logger; }
+
 private:
   HorizRemapperDataRepo () = default;
 
   std::map<std::string,std::weak_ptr<HorizRemapperData>> m_repo;
+
+  std::string m_cache_dir;
+
+  std::shared_ptr<ekat::logger::LoggerBase> m_logger = console_logger(ekat::logger::LogLevel::warn);
 };
 
 } // namespace scream
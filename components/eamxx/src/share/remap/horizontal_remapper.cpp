@@ -4,6 +4,7 @@
 #include "share/grid/point_grid.hpp"
 #include "share/grid/grid_import_export.hpp"
 #include "share/field/field.hpp"
+#include "share/field/field_workspace_arena.hpp"
 #include "share/util/eamxx_timing.hpp"
 
 #include <ekat_team_policy_utils.hpp>
@@ -106,6 +107,28 @@ HorizontalRemapper::
   clean_up();
 }
 
+void HorizontalRemapper::
+set_batch_fields (const bool batch)
+{
+  EKAT_REQUIRE_MSG (m_state!=RepoState::Closed,
+      "[HorizontalRemapper::set_batch_fields] Error! Cannot change batching after registration ends.\n"
+      " - remapper: " + name() + "\n");
+  m_batch_fields = batch;
+}
+
+void HorizontalRemapper::
+register_timers ()
+{
+  AbstractRemapper::register_timers();
+
+  m_matvec_timer        = register_timer(name()+" matvec");
+  m_matvec_masked_timer = register_timer(name()+" matvec masked");
+  m_rescale_timer       = register_timer(name()+" rescale");
+  m_pack_timer          = register_timer(name()+" pack");
+  m_unpack_timer        = register_timer(name()+" unpack");
+  m_setup_mpi_timer     = register_timer(name()+" setup MPI");
+}
+
 void HorizontalRemapper::
 registration_ends_impl ()
 {
@@ -224,6 +247,7 @@ registration_ends_impl ()
   }
 
   create_ov_fields ();
+  create_field_batches ();
   setup_mpi_data_structures ();
 }
 
@@ -249,10 +273,94 @@ void HorizontalRemapper::create_ov_fields ()
 
     auto& ov_f = m_ov_fields.emplace_back(ov_fid);
 
-    // Use same alloc props as fine fields, to allow packing in local_mat_vec
+    // Use same alloc props as fine fields, to allow packing in local_mat_vec.
+    // The memory will be drawn from the workspace arena in remap_fwd_impl, but commit
+    // the alloc props now, so we can query them in create_field_batches.
     const auto pack_size = f.get_header().get_alloc_properties().get_largest_pack_size();
     ov_f.get_header().get_alloc_properties().request_allocation(pack_size);
-    ov_f.allocate_view();
+    ov_f.get_header().get_alloc_properties().commit(layout);
+  }
+}
+
+void HorizontalRemapper::create_field_batches ()
+{
+  m_batched.assign(m_num_fields,0);
+  if (not m_batch_fields) {
+    return;
+  }
+
+  const bool coarsen = m_remap_data->m_coarsening;
+
+  // Number of Real's per column in the allocation of f, or -1 if the data of f
+  // is not a plain (ncols,col_size) array (e.g., if f is a subfield)
+  auto alloc_col_size = [](const Field& f) {
+    const auto& fh = f.get_header();
+    const auto& ap = fh.get_alloc_properties();
+    if (not ap.contiguous() or fh.get_parent()!=nullptr) {
+      return -1;
+    }
+    const auto& fl = fh.get_identifier().get_layout();
+    const int rank = fl.rank();
+    int col_size = rank>1 ? ap.get_last_extent() : 1;
+    for (int i=1; i<rank-1; ++i) {
+      col_size *= fl.dim(i);
+    }
+    return col_size;
+  };
+
+  // Group fields with the same col size. Masked fields need their own kernel
+  std::map<int,std::vector<int>> col_size_to_fields;
+  for (int i=0; i<m_num_fields; ++i) {
+    if (m_needs_remap[i]==0) {
+      continue;
+    }
+    const auto& x = coarsen ? m_src_fields[i] : m_ov_fields[i];
+    const auto& y = coarsen ? m_ov_fields[i] : m_tgt_fields[i];
+    if (m_track_mask and x.has_valid_mask()) {
+      continue;
+    }
+    const int col_size = alloc_col_size(x);
+    if (col_size>0 and alloc_col_size(y)==col_size) {
+      col_size_to_fields[col_size].push_back(i);
+    }
+  }
+
+  for (const auto& [col_size,fields] : col_size_to_fields) {
+    if (fields.size()<2) {
+      // Nothing to gain compared to local_mat_vec
+      continue;
+    }
+    auto& batch = m_field_batches.emplace_back();
+    batch.col_size = col_size;
+    batch.fields = fields;
+    batch.ptrs = view_1d<BatchPtrs>("batch_ptrs",fields.size());
+    batch.ptrs_h = Kokkos::create_mirror_view(batch.ptrs);
+    for (int i : fields) {
+      m_batched[i] = 1;
+    }
+  }
+}
+
+void HorizontalRemapper::set_field_batches_ptrs (const std::vector<Field>& ov_fields)
+{
+  const bool coarsen = m_remap_data->m_coarsening;
+
+  // The ov fields come from the workspace arena, so their data may move between calls
+  for (auto& batch : m_field_batches) {
+    bool changed = false;
+    for (int k=0, nf=batch.fields.size(); k<nf; ++k) {
+      const int i = batch.fields[k];
+      const auto& x = coarsen ? m_src_fields[i] : ov_fields[i];
+      const auto& y = coarsen ? ov_fields[i] : m_tgt_fields[i];
+      const Real* x_ptr = x.get_internal_view_data<Real>();
+            Real* y_ptr = y.get_internal_view_data<Real>();
+      changed |= batch.ptrs_h(k).x!=x_ptr or batch.ptrs_h(k).y!=y_ptr;
+      batch.ptrs_h(k).x = x_ptr;
+      batch.ptrs_h(k).y = y_ptr;
+    }
+    if (changed) {
+      Kokkos::deep_copy(batch.ptrs,batch.ptrs_h);
+    }
   }
 }
 
@@ -269,6 +377,17 @@ void HorizontalRemapper::remap_fwd_impl ()
         "  - recv rank: " + std::to_string(comm.rank()) + "\n");
   }
 
+  // The ov fields are only needed within this call, so draw them from the workspace arena.
+  // Do not store them in m_ov_fields, since their memory is given back when the scope ends.
+  FieldWorkspaceArena::Scope scope(ArenaLifetime::ProcessRun);
+  std::vector<Field> ov_fields(m_num_fields);
+  for (int i=0; i<m_num_fields; ++i) {
+    if (m_needs_remap[i]==1) {
+      ov_fields[i] = scope.get_field(m_ov_fields[i]);
+    }
+  }
+  set_field_batches_ptrs(ov_fields);
+
   // TODO: Add check that if there are mask values they are either 1's or 0's for unmasked/masked.
 
   // Helper function, to establish if a field can be handled with packs
@@ -289,20 +408,27 @@ void HorizontalRemapper::remap_fwd_impl ()
 
   if (not coarsen) {
     // For refining, MPI happens on the src grid
-    pack_and_send();
-    recv_and_unpack();
+    pack_and_send(ov_fields);
+    recv_and_unpack(ov_fields);
   }
 
   // Perform the local mat-vec using the proper fields depending on coarsen
+  for (const auto& batch : m_field_batches) {
+    local_mat_vec_batched(batch);
+  }
   for (int i=0; i<m_num_fields; ++i) {
     if (m_needs_remap[i]==0) {
       // No need to do a mat-vec here. Just deep copy and move on
       m_tgt_fields[i].deep_copy(m_src_fields[i]);
       continue;
     }
+    if (m_batched[i]==1) {
+      // Already done above
+      continue;
+    }
 
-    const auto& x = coarsen ? m_src_fields[i] : m_ov_fields[i];
-    const auto& y = coarsen ? m_ov_fields[i] : m_tgt_fields[i];
+    const auto& x = coarsen ? m_src_fields[i] : ov_fields[i];
+    const auto& y = coarsen ? ov_fields[i] : m_tgt_fields[i];
 
     const bool masked = m_track_mask and x.has_valid_mask();
     if (masked) {
@@ -324,8 +450,8 @@ void HorizontalRemapper::remap_fwd_impl ()
 
   if (coarsen) {
     // For coarsening, MPI happens on the tgt grid
-    pack_and_send ();
-    recv_and_unpack ();
+    pack_and_send (ov_fields);
+    recv_and_unpack (ov_fields);
   }
 
   // Wait for all sends to be completed
@@ -361,7 +487,7 @@ void HorizontalRemapper::
 local_mat_vec (const Field& x, const Field& y) const
 {
   if (m_timers_enabled)
-    start_timer(name()+" matvec");
+    start_timer(m_matvec_timer);
 
   using RangePolicy = typename KT::RangePolicy;
   using MemberType  = typename KT::MemberType;
@@ -479,7 +605,53 @@ local_mat_vec (const Field& x, const Field& y) const
       EKAT_ERROR_MSG("[HorizInterpRemapperBase::local_mat_vec] Error! Fields of rank 4 or greater are not supported.\n");
   }
   if (m_timers_enabled)
-    stop_timer(name()+" matvec");
+    stop_timer(m_matvec_timer);
+}
+
+void HorizontalRemapper::
+local_mat_vec_batched (const FieldBatch& batch) const
+{
+  if (m_timers_enabled)
+    start_timer(m_matvec_timer);
+
+  using MemberType  = typename KT::MemberType;
+  using TPF         = ekat::TeamPolicyFactory<DefaultDevice::execution_space>;
+
+  const auto row_grid = m_remap_data->m_coarsening ? m_remap_data->m_overlap_grid : m_tgt_grid;
+  const int  nrows    = row_grid->get_num_local_dofs();
+
+  auto row_offsets = m_remap_data->m_row_offsets;
+  auto col_lids    = m_remap_data->m_col_lids;
+  auto weights     = m_remap_data->m_weights;
+
+  auto ptrs = batch.ptrs;
+  const int col_size = batch.col_size;
+  const int nfields  = batch.fields.size();
+
+  // Each row of the matrix is loaded once, and applied to the same row of all fields.
+  // Note: the summation order is the same as in local_mat_vec, so results are identical
+  auto policy = TPF::get_default_team_policy(nrows,nfields*col_size);
+  Kokkos::parallel_for(policy,
+                       KOKKOS_LAMBDA(const MemberType& team) {
+    const auto row = team.league_rank();
+
+    const auto beg = row_offsets(row);
+    const auto end = row_offsets(row+1);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,nfields*col_size),
+                        [&](const int idx){
+      const int ifield = idx / col_size;
+      const int j      = idx % col_size;
+      const Real* x = ptrs(ifield).x;
+      Real sum = weights(beg)*x[col_lids(beg)*col_size+j];
+      for (int icol=beg+1; icol<end; ++icol) {
+        sum += weights(icol)*x[col_lids(icol)*col_size+j];
+      }
+      ptrs(ifield).y[row*col_size+j] = sum;
+    });
+  });
+
+  if (m_timers_enabled)
+    stop_timer(m_matvec_timer);
 }
 
 template<int PackSize>
@@ -487,7 +659,7 @@ void HorizontalRemapper::
 rescale_masked_fields (const Field& x, const Field& real_mask) const
 {
   if (m_timers_enabled)
-    start_timer(name()+" rescale");
+    start_timer(m_rescale_timer);
 
   using RangePolicy = typename KT::RangePolicy;
   using MemberType  = typename KT::MemberType;
@@ -610,7 +782,7 @@ rescale_masked_fields (const Field& x, const Field& real_mask) const
     }
   }
   if (m_timers_enabled)
-    stop_timer(name()+" rescale");
+    stop_timer(m_rescale_timer);
 }
 
 template<int PackSize>
@@ -618,7 +790,7 @@ void HorizontalRemapper::
 local_mat_vec_masked (const Field& x, const Field& y) const
 {
   if (m_timers_enabled)
-    start_timer(name()+" matvec masked");
+    start_timer(m_matvec_masked_timer);
 
   using RangePolicy = typename KT::RangePolicy;
   using MemberType  = typename KT::MemberType;
@@ -741,13 +913,13 @@ local_mat_vec_masked (const Field& x, const Field& y) const
     }
   }
   if (m_timers_enabled)
-    stop_timer(name()+" matvec masked");
+    stop_timer(m_matvec_masked_timer);
 }
 
-void HorizontalRemapper::pack_and_send ()
+void HorizontalRemapper::pack_and_send (const std::vector<Field>& ov_fields)
 {
   if (m_timers_enabled)
-    start_timer(name()+" pack");
+    start_timer(m_pack_timer);
 
   using RangePolicy = typename KT::RangePolicy;
   using TeamMember  = typename KT::MemberType;
@@ -767,7 +939,7 @@ void HorizontalRemapper::pack_and_send ()
       // No need to process this field. We'll simply deep copy src->tgt
       continue;
 
-    const auto& f = coarsen ? m_ov_fields[ifield] : m_src_fields[ifield];
+    const auto& f = coarsen ? ov_fields[ifield] : m_src_fields[ifield];
     const auto& fl = f.get_header().get_identifier().get_layout();
     const auto field_offset = m_field_offset[ifield];
     switch (fl.rank()) {
@@ -887,7 +1059,7 @@ void HorizontalRemapper::pack_and_send ()
   }
 
   if (m_timers_enabled)
-    stop_timer(name()+" pack");
+    stop_timer(m_pack_timer);
 
   if (not m_send_req.empty()) {
     int ierr = MPI_Startall(m_send_req.size(),m_send_req.data());
@@ -897,7 +1069,7 @@ void HorizontalRemapper::pack_and_send ()
   }
 }
 
-void HorizontalRemapper::recv_and_unpack ()
+void HorizontalRemapper::recv_and_unpack (const std::vector<Field>& ov_fields)
 {
   if (not m_recv_req.empty()) {
     check_mpi_call(MPI_Waitall(m_recv_req.size(),m_recv_req.data(), MPI_STATUSES_IGNORE),
@@ -905,7 +1077,7 @@ void HorizontalRemapper::recv_and_unpack ()
   }
 
   if (m_timers_enabled)
-    start_timer(name()+" unpack");
+    start_timer(m_unpack_timer);
 
   // If MPI does not use dev pointers, we need to deep copy from host to dev
   if (not MpiOnDev) {
@@ -915,7 +1087,7 @@ void HorizontalRemapper::recv_and_unpack ()
   if (m_remap_data->m_coarsening) {
     recv_and_unpack_coarsen();
   } else {
-    recv_and_unpack_refine();
+    recv_and_unpack_refine(ov_fields);
   }
 }
 
@@ -1074,7 +1246,7 @@ void HorizontalRemapper::recv_and_unpack_coarsen ()
   }
 }
 
-void HorizontalRemapper::recv_and_unpack_refine ()
+void HorizontalRemapper::recv_and_unpack_refine (const std::vector<Field>& ov_fields)
 {
   using RangePolicy = typename KT::RangePolicy;
   using TeamMember  = typename KT::MemberType;
@@ -1093,7 +1265,7 @@ void HorizontalRemapper::recv_and_unpack_refine ()
       // No need to process this field. We'll simply deep copy src->tgt
       continue;
 
-          auto& f  = m_ov_fields[ifield];
+    const auto& f  = ov_fields[ifield];
     const auto& fl = f.get_header().get_identifier().get_layout();
     const auto field_offset = m_field_offset[ifield];
 
@@ -1205,13 +1377,13 @@ void HorizontalRemapper::recv_and_unpack_refine ()
     }
   }
   if (m_timers_enabled)
-    stop_timer(name()+" unpack");
+    stop_timer(m_unpack_timer);
 }
 
 void HorizontalRemapper::setup_mpi_data_structures ()
 {
   if (m_timers_enabled)
-    start_timer(name()+" setup MPI");
+    start_timer(m_setup_mpi_timer);
 
   using namespace ShortFieldTagsNames;
 
@@ -1309,7 +1481,7 @@ void HorizontalRemapper::setup_mpi_data_structures ()
     Kokkos::deep_copy(m_export_lids_offsets,export_lids_offsets_h);
   }
   if (m_timers_enabled)
-    stop_timer(name()+" setup MPI");
+    stop_timer(m_setup_mpi_timer);
 }
 
 void HorizontalRemapper::clean_up ()
@@ -1333,6 +1505,8 @@ void HorizontalRemapper::clean_up ()
   m_tgt_fields.clear();
   m_ov_fields.clear();
   m_needs_remap.clear();
+  m_field_batches.clear();
+  m_batched.clear();
 
   // Reset the state of the base class
   m_state = RepoState::Clean;
@@ -39,9 +39,16 @@ class GridImportExport;
  *    and then have each rank gathering all local contributions for the
  *    entries of the tgt field it owns
  *
- * The class has to create temporaries for the intermediate fields.
- * An obvious future development would be to use some scratch memory
- * for these fields, so to not increase memory pressure.
+ * The class needs temporaries for the intermediate fields, which are only
+ * used during remap_fwd. Hence, their memory is drawn from the workspace arena
+ * (see FieldWorkspaceArena), and returned to it at the end of each remap, so
+ * that it can be reused by other remappers, diagnostics, and I/O helpers.
+ *
+ * Unless disabled (see set_batch_fields), fields that are not masked and have
+ * the same number of entries per column (including padding) are treated as the
+ * columns of a single multi-vector, and remapped with one mat-vec kernel, which
+ * reads the sparse matrix once for all of them. For MPI, all fields are packed
+ * in one contiguous buffer, with one message per remote rank.
  */
 
 class HorizontalRemapper : public AbstractRemapper
@@ -59,12 +66,18 @@ public:
 
   ~HorizontalRemapper ();
 
+  // Whether to remap fields with the same column size in a single mat-vec kernel (default: true).
+  // Must be called before registration ends.
+  void set_batch_fields (const bool batch);
+
 protected:
 
   void registration_ends_impl () override;
 
   void remap_fwd_impl () override;
 
+  void register_timers () override;
+
   // This class uses itself to remap src grid geo data to the tgt grid. But in order
   // to not pollute the remapper for later use, we must be able to clean it up after
   // remapping all the geo data.
@@ -77,18 +90,34 @@ public:
 #endif
   template<int N>
   void local_mat_vec (const Field& f_src, const Field& f_tgt) const;
+
+  // The x/y data of one field in a batch. Fields in a batch are contiguous, with
+  // the same number of Real's per column, so each is a (ncols,col_size) array
+  struct BatchPtrs {
+    const Real* x;
+    Real*       y;
+  };
+  struct FieldBatch {
+    int col_size;
+    std::vector<int> fields;
+    KokkosTypes<DefaultDevice>::view_1d<BatchPtrs> ptrs;
+    KokkosTypes<DefaultDevice>::view_1d<BatchPtrs>::host_mirror_type ptrs_h;
+  };
+  void local_mat_vec_batched (const FieldBatch& batch) const;
   template<int N>
   void local_mat_vec_masked (const Field& f_src, const Field& f_tgt) const;
   template<int N>
   void rescale_masked_fields (const Field& f_tgt, const Field& f_mask) const;
-  void pack_and_send ();
-  void recv_and_unpack ();
-  void recv_and_unpack_refine ();   // For refining, MPI is a "scatter" operation
+  void pack_and_send (const std::vector<Field>& ov_fields);
+  void recv_and_unpack (const std::vector<Field>& ov_fields);
+  void recv_and_unpack_refine (const std::vector<Field>& ov_fields); // For refining, MPI is a "scatter" operation
   void recv_and_unpack_coarsen ();  // For coarsening, MPI is a "reduce" operation
 
 protected:
 
   void create_ov_fields ();
+  void create_field_batches ();
+  void set_field_batches_ptrs (const std::vector<Field>& ov_fields);
   void setup_mpi_data_structures ();
 
   // We need to keep this (and not just its content) so that the weak_ptr in HorizRemapperDataRepo
@@ -99,12 +128,26 @@ protected:
   // Whether we are tracking mask fields
   bool                m_track_mask;
 
-  // Indermediate version of the fields, on the overlap grid
+  // Indermediate version of the fields, on the overlap grid. These are NOT allocated:
+  // they are only templates for the fields drawn from the workspace arena at each remap_fwd call
   std::vector<Field>  m_ov_fields;
 
   // Whether each field needs to be remapped (i.e., has COL tag)
   std::vector<int>    m_needs_remap;
 
+  // Groups of fields to be remapped together in local_mat_vec_batched
+  bool                m_batch_fields = true;
+  std::vector<int>    m_batched;      // Whether each field is in one of the batches
+  std::vector<FieldBatch> m_field_batches;
+
+  // Ids of the fine grain timers
+  int m_matvec_timer        = -1;
+  int m_matvec_masked_timer = -1;
+  int m_rescale_timer       = -1;
+  int m_pack_timer          = -1;
+  int m_unpack_timer        = -1;
+  int m_setup_mpi_timer     = -1;
+
   // ------- MPI-related data structures -------- //
 
   // Offset of each field when we splice together one col of each.
@@ -6,6 +6,9 @@
 #include "share/core/eamxx_setup_random_test.hpp"
 #include "share/field/field_utils.hpp"
 
+#include <filesystem>
+#include <chrono>
+
 namespace scream {
 
 void root_print (const std::string& msg, const ekat::Comm& comm) {
@@ -455,4 +458,124 @@ TEST_CASE("coarsening_remap")
   scorpio::finalize_subsystem();
 }
 
+TEST_CASE("batched_remap")
+{
+  using namespace ShortFieldTagsNames;
+
+  // Fields with the same col size are remapped together, in a single mat-vec kernel.
+  // Check that we get the same answer as with a mat-vec for each field.
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  scorpio::init_subsystem(comm);
+  int seed = get_random_test_seed(&comm);
+
+  std::string filename = "cr_batched_tests_map." + std::to_string(comm.size()) + ".nc";
+
+  const int ngdofs_tgt = 3*comm.size();
+  create_remap_file(filename, ngdofs_tgt);
+  auto src_grid = build_src_grid(comm, ngdofs_tgt+1, seed);
+
+  auto batched   = std::make_shared<HorizontalRemapper>(src_grid,filename);
+  auto per_field = std::make_shared<HorizontalRemapper>(src_grid,filename);
+  per_field->set_batch_fields(false);
+  auto tgt_grid = batched->get_tgt_grid();
+
+  // Two fields for each col size, plus a subfield (which cannot be batched)
+  std::vector<LayoutType> lts = {LayoutType::Scalar2D, LayoutType::Vector2D, LayoutType::Scalar3D};
+  std::vector<Field> src_f, tgt_b, tgt_pf;
+  for (auto lt : lts) {
+    for (int i=0; i<2; ++i) {
+      const auto name = e2str(lt) + std::to_string(i);
+      src_f.push_back(create_field(name,lt,*src_grid,LEV,++seed));
+      tgt_b.push_back(create_field(name,lt,*tgt_grid,LEV));
+      tgt_pf.push_back(create_field(name,lt,*tgt_grid,LEV));
+    }
+  }
+  src_f.push_back(src_f[2].get_component(1));
+  tgt_b.push_back(tgt_b[2].get_component(1).clone());
+  tgt_pf.push_back(tgt_pf[2].get_component(1).clone());
+
+  for (size_t i=0; i<src_f.size(); ++i) {
+    batched->register_field(src_f[i],tgt_b[i]);
+    per_field->register_field(src_f[i],tgt_pf[i]);
+  }
+  batched->registration_ends();
+  per_field->registration_ends();
+  REQUIRE_THROWS (batched->set_batch_fields(false));
+
+  batched->remap_fwd();
+  per_field->remap_fwd();
+  for (size_t i=0; i<src_f.size(); ++i) {
+    REQUIRE (views_are_equal(tgt_b[i],tgt_pf[i]));
+  }
+
+  scorpio::finalize_subsystem();
+}
+
+TEST_CASE("remap_data_cache")
+{
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  scorpio::init_subsystem(comm);
+  int seed = get_random_test_seed(&comm);
+
+  std::string filename = "cr_cache_tests_map." + std::to_string(comm.size()) + ".nc";
+  std::string cache_dir = "hremap_cache_np" + std::to_string(comm.size());
+
+  const int ngdofs_tgt = 3*comm.size();
+  create_remap_file(filename, ngdofs_tgt);
+  auto src_grid = build_src_grid(comm, ngdofs_tgt+1, seed);
+
+  // Start from an empty cache
+  if (comm.am_i_root()) {
+    std::filesystem::remove_all(cache_dir);
+  }
+  comm.barrier();
+
+  HorizRemapperData built, loaded;
+  built.build(src_grid,filename,cache_dir);
+  REQUIRE (not built.m_loaded_from_cache);
+
+  loaded.build(src_grid,filename,cache_dir);
+  REQUIRE (loaded.m_loaded_from_cache);
+
+  auto same = [](const auto& v1, const auto& v2) {
+    auto h1 = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v1);
+    auto h2 = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v2);
+    return h1.size()==h2.size() and std::equal(h1.data(),h1.data()+h1.size(),h2.data());
+  };
+  REQUIRE (same(built.m_row_offsets,loaded.m_row_offsets));
+  REQUIRE (same(built.m_col_lids,loaded.m_col_lids));
+  REQUIRE (same(built.m_weights,loaded.m_weights));
+  REQUIRE (same(built.m_overlap_grid->get_dofs_gids().get_view<const AbstractGrid::gid_type*,Host>(),
+                loaded.m_overlap_grid->get_dofs_gids().get_view<const AbstractGrid::gid_type*,Host>()));
+  REQUIRE (same(built.m_imp_exp->import_pids_h(),loaded.m_imp_exp->import_pids_h()));
+  REQUIRE (same(built.m_imp_exp->import_lids_h(),loaded.m_imp_exp->import_lids_h()));
+  REQUIRE (same(built.m_imp_exp->export_pids_h(),loaded.m_imp_exp->export_pids_h()));
+  REQUIRE (same(built.m_imp_exp->export_lids_h(),loaded.m_imp_exp->export_lids_h()));
+  REQUIRE (same(built.m_imp_exp->import_pid_offsets_h(),loaded.m_imp_exp->import_pid_offsets_h()));
+  REQUIRE (same(built.m_imp_exp->export_pid_offsets_h(),loaded.m_imp_exp->export_pid_offsets_h()));
+
+  // A different decomposition of the src grid must not hit the cache
+  auto shuffled_src_grid = build_src_grid(comm, ngdofs_tgt+1, seed+1);
+  if (comm.size()>1) {
+    HorizRemapperData rebuilt;
+    rebuilt.build(shuffled_src_grid,filename,cache_dir);
+    REQUIRE (not rebuilt.m_loaded_from_cache);
+  }
+
+  // A map file that was modified since the cache was saved must not hit the cache
+  if (comm.am_i_root()) {
+    const auto mtime = std::filesystem::last_write_time(filename);
+    std::filesystem::last_write_time(filename,mtime+std::chrono::seconds(1));
+  }
+  comm.barrier();
+  HorizRemapperData modified;
+  modified.build(src_grid,filename,cache_dir);
+  REQUIRE (not modified.m_loaded_from_cache);
+
+  scorpio::finalize_subsystem();
+}
+
 } // namespace scream
@@ -0,0 +1,159 @@
+// This is a small program to benchmark the HorizontalRemapper when remapping several fields,
+// comparing the batched mat-vec (all fields with the same column size in one kernel) with
+// the per-field mat-vec. The map is a simple 2:1 coarsening, where each tgt column is
+// the average of two consecutive src columns.
+//
+// Usage: horizontal_remapper_bench [ncols [nlevs [nfields [nreps]]]]
+
+#include "share/remap/horizontal_remapper.hpp"
+#include "share/grid/point_grid.hpp"
+#include "share/scorpio_interface/eamxx_scorpio_interface.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/core/eamxx_session.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace scream;
+
+// Time a function (in seconds, averaged over nreps, after one warmup call)
+double time_it (const std::function<void()>& f, const int nreps)
+{
+  f();
+  Kokkos::fence();
+  const auto start = std::chrono::steady_clock::now();
+  for (int rep=0; rep<nreps; ++rep) {
+    f();
+  }
+  Kokkos::fence();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop-start).count() / nreps;
+}
+
+void create_remap_file (const std::string& filename, const int ngdofs_tgt)
+{
+  const int nnz = 2*ngdofs_tgt;
+
+  scorpio::register_file(filename, scorpio::FileMode::Write);
+
+  scorpio::define_dim(filename,"n_a", 2*ngdofs_tgt);
+  scorpio::define_dim(filename,"n_b", ngdofs_tgt);
+  scorpio::define_dim(filename,"n_s", nnz);
+
+  scorpio::define_var(filename,"col",{"n_s"},"int");
+  scorpio::define_var(filename,"row",{"n_s"},"int");
+  scorpio::define_var(filename,"S"  ,{"n_s"},"double");
+
+  scorpio::enddef(filename);
+
+  std::vector<int> col(nnz), row(nnz);
+  std::vector<double> S(nnz,0.5);
+  for (int i=0; i<ngdofs_tgt; ++i) {
+    row[2*i]   = 1 + i;
+    row[2*i+1] = 1 + i;
+    col[2*i]   = 1 + 2*i;
+    col[2*i+1] = 1 + 2*i+1;
+  }
+
+  scorpio::write_var(filename,"row",row.data());
+  scorpio::write_var(filename,"col",col.data());
+  scorpio::write_var(filename,"S",    S.data());
+
+  scorpio::release_file(filename);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+  using namespace ShortFieldTagsNames;
+
+  const int ncols   = argc>1 ? std::stoi(argv[1]) : 8192;
+  const int nlevs   = argc>2 ? std::stoi(argv[2]) : 128;
+  const int nfields = argc>3 ? std::stoi(argv[3]) : 10;
+  const int nreps   = argc>4 ? std::stoi(argv[4]) : 20;
+
+  MPI_Init(&argc,&argv);
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    ekat::Comm comm(MPI_COMM_WORLD);
+    scorpio::init_subsystem(comm);
+
+    const std::string map_file = "horizontal_remapper_bench_map.nc";
+    create_remap_file(map_file,ncols/2);
+    auto src_grid = create_point_grid("src",2*(ncols/2),nlevs,comm,1);
+
+    // Create a remapper, with nfields fields of the given layout types
+    auto create_remapper = [&](const std::vector<LayoutType>& lts, const bool batch) {
+      auto remap = std::make_shared<HorizontalRemapper>(src_grid,map_file);
+      remap->set_batch_fields(batch);
+      const auto tgt_grid = remap->get_tgt_grid();
+      for (int i=0; i<nfields; ++i) {
+        const auto lt = lts[i % lts.size()];
+        const auto name = "f" + std::to_string(i);
+        const auto src_fl = lt==LayoutType::Scalar2D ? src_grid->get_2d_scalar_layout()
+                                                     : src_grid->get_3d_scalar_layout(LEV);
+        const auto tgt_fl = lt==LayoutType::Scalar2D ? tgt_grid->get_2d_scalar_layout()
+                                                     : tgt_grid->get_3d_scalar_layout(LEV);
+        Field src(FieldIdentifier(name,src_fl,ekat::units::none,src_grid->name()));
+        Field tgt(FieldIdentifier(name,tgt_fl,ekat::units::none,tgt_grid->name()));
+        src.get_header().get_alloc_properties().request_allocation(SCREAM_PACK_SIZE);
+        tgt.get_header().get_alloc_properties().request_allocation(SCREAM_PACK_SIZE);
+        src.allocate_view();
+        tgt.allocate_view();
+        randomize_uniform(src,1234+i,-1,1);
+        remap->register_field(src,tgt);
+      }
+      remap->registration_ends();
+      return remap;
+    };
+
+    struct Case {
+      std::string name;
+      std::vector<LayoutType> lts;
+    };
+    std::vector<Case> cases = {
+      {"2d",    {LayoutType::Scalar2D}},
+      {"3d",    {LayoutType::Scalar3D}},
+      {"2d+3d", {LayoutType::Scalar2D, LayoutType::Scalar3D}},
+    };
+
+    if (comm.am_i_root()) {
+      std::cout << "Horizontal remapper benchmark: " << ncols << " src cols, " << nlevs << " levs, "
+                << nfields << " fields, " << comm.size() << " ranks, " << nreps << " reps\n";
+      std::cout << std::setw(10) << "fields"
+                << std::setw(18) << "per-field [us]"
+                << std::setw(16) << "batched [us]"
+                << std::setw(10) << "speedup" << "\n";
+    }
+    for (const auto& c : cases) {
+      auto per_field = create_remapper(c.lts,false);
+      auto batched   = create_remapper(c.lts,true);
+
+      // Report the slowest rank
+      double t_per_field = time_it([&]{ per_field->remap_fwd(); },nreps);
+      double t_batched   = time_it([&]{ batched->remap_fwd(); },nreps);
+      comm.all_reduce(&t_per_field,1,MPI_MAX);
+      comm.all_reduce(&t_batched,1,MPI_MAX);
+
+      if (comm.am_i_root()) {
+        std::cout << std::setw(10) << c.name
+                  << std::setw(18) << std::fixed << std::setprecision(1) << 1e6*t_per_field
+                  << std::setw(16) << 1e6*t_batched
+                  << std::setw(10) << std::setprecision(2) << t_per_field/t_batched << "\n";
+        std::cout.unsetf(std::ios::fixed);
+      }
+    }
+
+    scorpio::finalize_subsystem();
+  }
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+
+  return 0;
+}
@@ -130,6 +130,16 @@ set_pressure (const Field& p, const std::string& src_or_tgt)
   res.first->second &= pack_compatible;
 }
 
+void VerticalRemapper::
+register_timers ()
+{
+  AbstractRemapper::register_timers();
+
+  m_setup_li_timer    = register_timer(name() + " setup LI");
+  m_run_li_timer      = register_timer(name() + " run LI");
+  m_extrapolate_timer = register_timer(name() + " extrapolate");
+}
+
 void VerticalRemapper::
 registration_ends_impl ()
 {
@@ -372,7 +382,7 @@ void VerticalRemapper::remap_fwd_impl ()
 
   // 1. Setup any interp object that was created (if nullptr, no fields need it)
   if (m_timers_enabled)
-    start_timer(name() + " setup LI");
+    start_timer(m_setup_li_timer);
 
   bool src_grid_levp = m_src_grid->get_vkind()==AbstractGrid::VKind::Pressure;
   bool tgt_grid_levp = m_tgt_grid->get_vkind()==AbstractGrid::VKind::Pressure;
@@ -393,7 +403,7 @@ void VerticalRemapper::remap_fwd_impl ()
     setup_lin_interp(li, src_pressure(vtag), tgt_pressure(vtag));
   }
   if (m_timers_enabled)
-    stop_timer(name() + " setup LI");
+    stop_timer(m_setup_li_timer);
 
   // 2. Init all masks fields (if any) to 1 (signaling no masked entries)
   for (auto& [name, mask] : m_masks) {
@@ -482,7 +492,7 @@ apply_vertical_interpolation(const ekat::LinInterp<Real,Packsize>& lin_interp,
                              const Field& p_src, const Field& p_tgt) const
 {
   if (m_timers_enabled)
-    start_timer(name() + " run LI");
+    start_timer(m_run_li_timer);
 
   // Note: if Packsize==1, we grab packs of size 1, which are for sure
   //       compatible with the allocation
@@ -573,7 +583,7 @@ apply_vertical_interpolation(const ekat::LinInterp<Real,Packsize>& lin_interp,
           " - src field rank: " + std::to_string(f_src.rank()) + "\n");
   }
   if (m_timers_enabled)
-    stop_timer(name() + " run LI");
+    stop_timer(m_run_li_timer);
 }
 
 void VerticalRemapper::
@@ -583,7 +593,7 @@ extrapolate (const Field& f_src,
              const Field& p_tgt) const
 {
   if (m_timers_enabled)
-    start_timer(name() + " extrapolate");
+    start_timer(m_extrapolate_timer);
 
   using TPF = ekat::TeamPolicyFactory<DefaultDevice::execution_space>;
 
@@ -737,7 +747,7 @@ extrapolate (const Field& f_src,
           " - src field rank: " + std::to_string(f_src.rank()) + "\n");
   }
   if (m_timers_enabled)
-    stop_timer(name() + " extrapolate");
+    stop_timer(m_extrapolate_timer);
 }
 
 } // namespace scream
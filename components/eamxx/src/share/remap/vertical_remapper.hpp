@@ -58,6 +58,8 @@ protected:
 
   void remap_fwd_impl () override;
 
+  void register_timers () override;
+
 #ifdef KOKKOS_ENABLE_CUDA
 public:
 #endif
@@ -101,6 +103,11 @@ protected:
   ExtrapType            m_etype_top = P0;
   ExtrapType            m_etype_bot = P0;
 
+  // Ids of the fine grain timers
+  int                   m_setup_li_timer    = -1;
+  int                   m_run_li_timer      = -1;
+  int                   m_extrapolate_timer = -1;
+
   // Small struct holding metadata for a field's vertical remapping:
   //  - packs_supported: true if both field and pressure data allow SIMD packing.
   //  - src_vtag/tgt_vtag: the vertical FieldTag for source/target (Invalid for 2D fields).
@@ -9,9 +9,16 @@
 
 #include <pio.h>
 
+#include <algorithm>
 #include <set>
 #include <numeric>
 #include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace scream {
 namespace scorpio {
@@ -24,16 +31,40 @@ struct ScorpioSession
 {
 public:
   static ScorpioSession& instance () {
+    auto& s = unsynced_instance();
+    // Calls from threads other than the async thread must wait for pending async ops,
+    // or else (collective) PIO calls could be interleaved differently on different ranks
+    s.sync_with_async_thread();
+    return s;
+  }
+
+  // Calls that only query the (cached) metadata of an open file make no PIO calls,
+  // so they only need to wait for pending async ops on that file
+  static ScorpioSession& instance (const std::string& filename) {
+    auto& s = unsynced_instance();
+    s.sync_with_async_thread(filename);
+    return s;
+  }
+
+  static ScorpioSession& unsynced_instance () {
     static ScorpioSession s;
     return s;
   }
 
+  ~ScorpioSession () {
+    stop_async_thread();
+  }
+
   template<typename T>
   using strmap_t = std::map<std::string,T>;
 
   strmap_t<PIOFile>                    files;
   strmap_t<std::shared_ptr<PIODecomp>> decomps;
 
+  // The async thread may open/close files while the main thread queries metadata
+  // of other files, so lookups/insertions/removals in the files map must be locked
+  std::mutex                           files_mutex;
+
   int         pio_sysid        = -1;
   int         pio_type_default = -1;
   int         pio_rearranger   = -1;
@@ -41,6 +72,109 @@ public:
 
   ekat::Comm  comm;
 
+  // Async ops are run in FIFO order on a single helper thread
+  std::thread                         async_thread;
+  std::mutex                          async_mutex;
+  std::condition_variable             async_cv;
+  std::deque<std::function<void()>>   async_ops;
+  std::atomic<long long>              async_num_enqueued {0};
+  std::atomic<long long>              async_num_done {0};
+  std::exception_ptr                  async_error;
+  bool                                async_stop = false;
+
+  // Ticket of the last async op on each file, and of the last op not tied to a file
+  std::map<std::string,long long>     async_file_tickets;
+  long long                           async_any_file_ticket = 0;
+
+  static bool& on_async_thread () {
+    static thread_local bool b = false;
+    return b;
+  }
+
+  void sync_with_async_thread () {
+    if (async_num_done==async_num_enqueued or on_async_thread()) {
+      return;
+    }
+    wait_async_ops (async_num_enqueued);
+
+    std::lock_guard<std::mutex> lock(async_mutex);
+    async_file_tickets.clear();
+  }
+
+  void sync_with_async_thread (const std::string& filename) {
+    if (async_num_done==async_num_enqueued or on_async_thread()) {
+      return;
+    }
+    long long ticket = 0;
+    {
+      std::lock_guard<std::mutex> lock(async_mutex);
+      auto it = async_file_tickets.find(filename);
+      ticket = std::max(async_any_file_ticket, it==async_file_tickets.end() ? 0 : it->second);
+    }
+    if (async_num_done<ticket) {
+      wait_async_ops (ticket);
+    }
+  }
+
+  PIOFile* find_file (const std::string& filename) {
+    std::lock_guard<std::mutex> lock(files_mutex);
+    auto it = files.find(filename);
+    return it==files.end() ? nullptr : &it->second;
+  }
+
+  void wait_async_ops (const long long ticket) {
+    std::unique_lock<std::mutex> lock(async_mutex);
+    async_cv.wait(lock,[&]{ return async_num_done>=ticket; });
+    if (async_error) {
+      auto e = async_error;
+      async_error = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+
+  void async_loop () {
+    on_async_thread() = true;
+    std::unique_lock<std::mutex> lock(async_mutex);
+    while (true) {
+      async_cv.wait(lock,[&]{ return async_stop or not async_ops.empty(); });
+      if (async_ops.empty()) {
+        // Stop was requested, and there is nothing left to do
+        break;
+      }
+      auto op = std::move(async_ops.front());
+      async_ops.pop_front();
+      lock.unlock();
+
+      try {
+        op();
+      } catch (...) {
+        std::lock_guard<std::mutex> g(async_mutex);
+        if (not async_error) {
+          async_error = std::current_exception();
+        }
+      }
+      // Release anything captured by the op (e.g., staging buffers) before
+      // signaling its completion, so customers can safely recycle them
+      op = nullptr;
+
+      lock.lock();
+      ++async_num_done;
+      async_cv.notify_all();
+    }
+  }
+
+  void stop_async_thread () {
+    if (async_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(async_mutex);
+        async_stop = true;
+      }
+      async_cv.notify_all();
+      async_thread.join();
+      async_stop = false;
+    }
+  }
+
 private:
 
   ScorpioSession () = default;
@@ -228,15 +362,17 @@ namespace impl {
 
 // Small struct that allows to quickly open a file (in Read mode) if it wasn't open.
 // If the file had to be open, when the struct is deleted, it will release the file.
+// If metadata_only=true, the caller promises to only query the cached metadata of the file
+// (no PIO calls), so that we only need to wait for pending async ops on this file.
 struct PeekFile {
-  PeekFile(const std::string& filename_in) {
+  PeekFile(const std::string& filename_in, const bool metadata_only = false) {
     filename = filename_in;
     was_open = is_file_open(filename);
     if (not was_open) {
       register_file(filename,Read);
     }
-    auto& s = ScorpioSession::instance();
-    file = &s.files[filename];
+    auto& s = metadata_only ? ScorpioSession::instance(filename) : ScorpioSession::instance();
+    file = s.find_file(filename);
   }
 
   ~PeekFile () {
@@ -256,17 +392,19 @@ struct PeekFile {
 };
 
 PIOFile& get_file (const std::string& filename,
-                   const std::string& context)
+                   const std::string& context,
+                   const bool metadata_only = false)
 {
-  auto& s = ScorpioSession::instance();
+  auto& s = metadata_only ? ScorpioSession::instance(filename) : ScorpioSession::instance();
+  auto f = s.find_file(filename);
 
-  EKAT_REQUIRE_MSG (s.files.count(filename)==1,
+  EKAT_REQUIRE_MSG (f!=nullptr,
       "Error! Could not retrieve the file. File not open.\n"
       " - filename: " + filename + "\n"
       "Context:\n"
       " " + context + "\n");
 
-  return s.files.at(filename);
+  return *f;
 }
 
 PIODim& get_dim (const std::string& filename,
@@ -287,9 +425,10 @@ PIODim& get_dim (const std::string& filename,
 
 PIOVar& get_var (const std::string& filename,
                  const std::string& varname,
-                 const std::string& context)
+                 const std::string& context,
+                 const bool metadata_only = false)
 {
-  const auto& f = get_file(filename,context);
+  const auto& f = get_file(filename,context,metadata_only);
   EKAT_REQUIRE_MSG (f.vars.count(varname)==1,
       "Error! Could not retrieve variable. Variable not found.\n"
       " - filename: " + filename + "\n"
@@ -350,7 +489,9 @@ bool is_subsystem_inited () {
 
 void finalize_subsystem ()
 {
+  // Note: instance() waits for all pending async ops (if any)
   auto& s = ScorpioSession::instance();
+  s.stop_async_thread();
 
   // TODO: should we simply return instead? I think trying to finalize twice
   //       *may* be a sign of possible bugs, though with Catch2 testing
@@ -386,6 +527,47 @@ void finalize_subsystem ()
   s.pio_rearranger   = -1;
 }
 
+// ====================== Asynchronous operations ==================== //
+
+long long enqueue_async (const std::function<void()>& op, const std::string& filename)
+{
+  auto& s = ScorpioSession::unsynced_instance();
+  EKAT_REQUIRE_MSG (not ScorpioSession::on_async_thread(),
+      "Error! Cannot enqueue async scorpio ops from the async thread itself.\n");
+
+  std::lock_guard<std::mutex> lock(s.async_mutex);
+  if (not s.async_thread.joinable()) {
+    s.async_thread = std::thread([&s](){ s.async_loop(); });
+  }
+  s.async_ops.push_back(op);
+  const long long ticket = ++s.async_num_enqueued;
+  if (filename=="") {
+    s.async_any_file_ticket = ticket;
+  } else {
+    s.async_file_tickets[filename] = ticket;
+  }
+  s.async_cv.notify_all();
+  return ticket;
+}
+
+void wait_async (const long long ticket)
+{
+  auto& s = ScorpioSession::unsynced_instance();
+  s.wait_async_ops(ticket<0 ? s.async_num_enqueued.load() : ticket);
+}
+
+bool is_async_done (const long long ticket)
+{
+  auto& s = ScorpioSession::unsynced_instance();
+  return s.async_num_done>=ticket;
+}
+
+int get_num_pending_async ()
+{
+  auto& s = ScorpioSession::unsynced_instance();
+  return s.async_num_enqueued - s.async_num_done;
+}
+
 // ========================= File operations ===================== //
 
 void register_file (const std::string& filename,
@@ -393,7 +575,10 @@ void register_file (const std::string& filename,
                     const IOType iotype)
 {
   auto& s = ScorpioSession::instance();
-  auto& f = s.files[filename];
+  auto& f = [&]() -> PIOFile& {
+    std::lock_guard<std::mutex> lock(s.files_mutex);
+    return s.files[filename];
+  }();
   EKAT_REQUIRE_MSG (f.mode==Unset || f.mode==mode,
       "Error! File was already opened with a different mode.\n"
       " - filename: " + filename + "\n"
@@ -534,6 +719,7 @@ void release_file  (const std::string& filename)
   check_scorpio_noerr (err,f.name,"release_file","closefile");
 
   auto& s = ScorpioSession::instance();
+  std::lock_guard<std::mutex> lock(s.files_mutex);
   s.files.erase(filename);
 }
 
@@ -577,11 +763,10 @@ void enddef(const std::string &filename)
 
 bool is_file_open (const std::string& filename, const FileMode mode)
 {
-  auto& s = ScorpioSession::instance();
-  auto it = s.files.find(filename);
-  if (it==s.files.end()) return false;
+  auto f = ScorpioSession::instance(filename).find_file(filename);
+  if (f==nullptr) return false;
 
-  return mode==Unset || (mode & it->second.mode);
+  return mode==Unset || (mode & f->mode);
 }
 
 // =================== Dimensions operations ======================= //
@@ -637,7 +822,7 @@ bool has_dim (const std::string& filename,
               const int length)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   auto it = pf.file->dims.find(dimname);
   if (it==pf.file->dims.end()) {
@@ -653,7 +838,7 @@ bool has_dim (const std::string& filename,
 int get_dimlen (const std::string& filename, const std::string& dimname)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   EKAT_REQUIRE_MSG (has_dim(filename,dimname),
       "Error! Could not inquire dimension length. The dimension is not in the file.\n"
@@ -666,7 +851,7 @@ int get_dimlen (const std::string& filename, const std::string& dimname)
 int get_dimlen_local (const std::string& filename, const std::string& dimname)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   EKAT_REQUIRE_MSG (has_dim(filename,dimname),
       "Error! Could not inquire dimension local length. The dimension is not in the file.\n"
@@ -685,7 +870,7 @@ int get_dimlen_local (const std::string& filename, const std::string& dimname)
 bool has_time_dim (const std::string& filename)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   return pf.file->time_dim!=nullptr;
 }
@@ -697,7 +882,7 @@ int get_time_len (const std::string& filename)
       " - filename: " + filename + "\n");
 
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   return pf.file->time_dim->length;
 }
@@ -705,7 +890,7 @@ int get_time_len (const std::string& filename)
 std::string get_time_name (const std::string& filename)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   EKAT_REQUIRE_MSG (pf.file->time_dim!=nullptr,
       "Error! Could not inquire time dimension name. The time dimension is not in the file.\n"
@@ -837,7 +1022,7 @@ void set_var_decomp (PIOVar& var,
 #endif
 
   if (s.decomps.count(decomp_tag)==0) {
-    auto& f = s.files[filename];
+    auto& f = *s.find_file(filename);
 
     // Final check: the decomposed dims must have been decomposed together (e.g., 2 dims that
     // are part of rank-2 decompositions but NOT with each other are not ok)
@@ -1234,10 +1419,41 @@ void change_var_dtype (const std::string& filename,
   change_var_dtype(var,dtype,filename);
 }
 
+bool set_var_compression (const std::string& filename,
+                          const std::string& varname,
+                          const bool shuffle,
+                          const int deflate_level)
+{
+  auto& f = impl::get_file(filename,"scorpio::set_var_compression");
+  auto& var = impl::get_var(filename,varname,"scorpio::set_var_compression");
+
+  EKAT_REQUIRE_MSG (deflate_level>=0 and deflate_level<=9,
+      "Error! Invalid deflate level.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n"
+      " - deflate level: " + std::to_string(deflate_level) + "\n"
+      " - valid range  : [0,9]\n");
+  EKAT_REQUIRE_MSG (not f.enddef,
+      "Error! Compression filters can only be set while the file is in define mode.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n");
+
+  // Filters are only supported by the netcdf4 (hdf5-based) file formats
+  const int iotype = pio_iotype(f.iotype);
+  if (iotype!=static_cast<int>(PIO_IOTYPE_NETCDF4C) and
+      iotype!=static_cast<int>(PIO_IOTYPE_NETCDF4P)) {
+    return false;
+  }
+
+  int err = PIOc_def_var_deflate(f.ncid,var.ncid,shuffle ? 1 : 0,deflate_level>0 ? 1 : 0,deflate_level);
+  check_scorpio_noerr(err,f.name,"variable",varname,"set_var_compression","def_var_deflate");
+  return true;
+}
+
 bool has_var (const std::string& filename, const std::string& varname)
 {
   // If file wasn't open, open it on the fly. See comment in PeekFile class above.
-  impl::PeekFile pf(filename);
+  impl::PeekFile pf(filename,true);
 
   return pf.file->vars.count(varname)==1;
 }
@@ -1245,7 +1461,7 @@ bool has_var (const std::string& filename, const std::string& varname)
 const PIOVar& get_var (const std::string& filename,
                        const std::string& varname)
 {
-  return impl::get_var(filename,varname,"scorpio::get_var");
+  return impl::get_var(filename,varname,"scorpio::get_var",true);
 }
 
 void define_time (const std::string& filename, const std::string& units, const std::string& time_name)
@@ -1502,6 +1718,93 @@ void write_var (const std::string &filename, const std::string &varname, const T
   check_scorpio_noerr (err,f.name,"variable",varname,"write_var",pioc_func);
 }
 
+template<typename T>
+void write_vars (const std::string &filename,
+                 const std::vector<std::string>& varnames,
+                 const std::vector<const T*>& bufs)
+{
+  EKAT_REQUIRE_MSG (varnames.size()==bufs.size(),
+      "Error! Number of variables and buffers do not match.\n"
+      " - filename: " + filename + "\n"
+      " - num vars: " + std::to_string(varnames.size()) + "\n"
+      " - num bufs: " + std::to_string(bufs.size()) + "\n");
+
+  const auto& f = impl::get_file(filename,"scorpio::write_vars");
+
+  // Group decomposed vars by decomposition and time dependence. We key the groups
+  // with the decomp name (rather than its pointer), so that the order in which
+  // we loop over the groups (and issue collective PIO calls) is the same on all ranks.
+  // Non-decomposed vars are written right away, one at a time.
+  std::map<std::pair<std::string,bool>,std::vector<int>> groups;
+  for (size_t i=0; i<varnames.size(); ++i) {
+    EKAT_REQUIRE_MSG (bufs[i]!=nullptr,
+        "Error! Cannot write in provided pointer. Invalid buffer pointer.\n"
+        " - filename: " + filename + "\n"
+        " - varname : " + varnames[i] + "\n");
+
+    auto& var = impl::get_var(filename,varnames[i],"scorpio::write_vars");
+
+    // If the input pointer type already matches var.dtype, this is a no-op
+    change_var_dtype(var,get_dtype<T>(),filename);
+
+    if (var.decomp) {
+      groups[{var.decomp->name,var.time_dep}].push_back(i);
+    } else {
+      write_var(filename,varnames[i],bufs[i]);
+    }
+  }
+
+  std::vector<T> packed;
+  for (const auto& [key,ids] : groups) {
+    if (ids.size()==1) {
+      write_var(filename,varnames[ids[0]],bufs[ids[0]]);
+      continue;
+    }
+
+    const int nvars = ids.size();
+    const bool time_dep = key.second;
+    const auto& decomp = impl::get_var(filename,varnames[ids[0]],"scorpio::write_vars").decomp;
+    const PIO_Offset arraylen = decomp->offsets.size();
+
+    std::vector<int> varids(nvars), frames(nvars);
+    std::vector<std::string> names(nvars);
+    for (int k=0; k<nvars; ++k) {
+      auto& var = impl::get_var(filename,varnames[ids[k]],"scorpio::write_vars");
+      names[k] = var.name;
+      varids[k] = var.ncid;
+      if (time_dep) {
+        ++var.num_records;
+        EKAT_REQUIRE_MSG (var.num_records==f.time_dim->length,
+            "Error! Number of records for variable does not match time length.\n"
+            " - filename: " + filename + "\n"
+            " - varname : " + var.name + "\n"
+            " - time len: " + std::to_string(f.time_dim->length) + "\n"
+            " - nrecords: " + std::to_string(var.num_records) + "\n");
+        frames[k] = var.num_records-1;
+      }
+    }
+
+    // PIO needs the data of all vars in one contiguous array. If the input buffers
+    // are already laid out back to back, we can skip the copy.
+    const T* array = bufs[ids[0]];
+    bool contiguous = true;
+    for (int k=1; k<nvars; ++k) {
+      contiguous &= bufs[ids[k]]==array+k*arraylen;
+    }
+    if (not contiguous) {
+      packed.resize(nvars*arraylen);
+      for (int k=0; k<nvars; ++k) {
+        std::copy_n(bufs[ids[k]],arraylen,packed.data()+k*arraylen);
+      }
+      array = packed.data();
+    }
+
+    int err = PIOc_write_darray_multi(f.ncid,varids.data(),decomp->ncid,nvars,arraylen,array,
+                                      time_dep ? frames.data() : nullptr,nullptr,false);
+    check_scorpio_noerr (err,f.name,"variables",ekat::join(names,","),"write_vars","write_darray_multi");
+  }
+}
+
 // ========================== READ/WRITE ETI ========================== //
 
 template void read_var<int>       (const std::string&, const std::string&, int*,       const int);
@@ -1516,6 +1819,11 @@ template void write_var<float>     (const std::string&, const std::string&, cons
 template void write_var<double>    (const std::string&, const std::string&, const double*,    const double*);
 template void write_var<char>      (const std::string&, const std::string&, const char*,      const char*);
 
+template void write_vars<int>       (const std::string&, const std::vector<std::string>&, const std::vector<const int*>&);
+template void write_vars<long long> (const std::string&, const std::vector<std::string>&, const std::vector<const long long*>&);
+template void write_vars<float>     (const std::string&, const std::vector<std::string>&, const std::vector<const float*>&);
+template void write_vars<double>    (const std::string&, const std::vector<std::string>&, const std::vector<const double*>&);
+
 // =============== Attributes operations ================== //
 
 bool has_global_attribute (const std::string& filename, const std::string& attname)
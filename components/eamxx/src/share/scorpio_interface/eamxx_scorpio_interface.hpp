@@ -6,6 +6,7 @@
 #include <ekat_comm.hpp>
 #include <ekat_assert.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -69,6 +70,23 @@ void init_subsystem(const ekat::Comm& comm, const int atm_id = 0);
 bool is_subsystem_inited ();
 void finalize_subsystem ();
 
+// =================== Asynchronous operations ================= //
+
+// Scorpio ops can be enqueued to run on a single helper thread, in the order they were
+// enqueued. Scorpio calls made from another thread that call PIO first wait for all pending
+// async ops, so that all ranks issue (collective) PIO calls in the same order. Calls that
+// only query metadata of an open file (e.g., has_var, get_dimlen, is_file_open) only wait
+// for pending ops on that file, which is the filename passed to enqueue_async (if empty,
+// the op is assumed to affect all files).
+// Since the helper thread makes MPI calls, this requires MPI_THREAD_MULTIPLE.
+// enqueue_async returns a ticket, which can be used to wait for that op (and all previous ones).
+// A negative ticket means "wait for all pending ops". Errors thrown by async ops are
+// re-thrown by the next wait.
+long long enqueue_async (const std::function<void()>& op, const std::string& filename = "");
+void wait_async (const long long ticket = -1);
+bool is_async_done (const long long ticket);
+int get_num_pending_async ();
+
 // =================== File operations ================= //
 
 // Opens a file, returns const handle to it (useful for Read mode, to get dims/vars)
@@ -180,6 +198,14 @@ void change_var_dtype (const std::string& filename,
                        const std::string& varname,
                        const std::string& dtype);
 
+// Enable the shuffle/deflate filters for a var (must be called while the file is in define mode).
+// Compression is only available for the NetCDF4 iotypes: for all other iotypes, this is a no-op.
+// Returns true if the filters were actually set.
+bool set_var_compression (const std::string& filename,
+                          const std::string& varname,
+                          const bool shuffle,
+                          const int deflate_level);
+
 // Check that the given variable is in the file.
 bool has_var (const std::string& filename, const std::string& varname);
 
@@ -211,6 +237,16 @@ void read_var (const std::string &filename, const std::string &varname, T* buf,
 template<typename T>
 void write_var (const std::string &filename, const std::string &varname, const T* buf, const T* fillValue = nullptr);
 
+// Write several variables at once. Decomposed variables that share the same decomposition
+// (and time dependence) are written with a single aggregated call, rather than one call per
+// variable, which saves the per-call rearrangement overhead. If the buffers of such variables
+// are stored back to back (in the order of varnames), no additional copy of the data is made.
+// NOTE: ETI in the cpp file for int, long long, float, double.
+template<typename T>
+void write_vars (const std::string &filename,
+                 const std::vector<std::string>& varnames,
+                 const std::vector<const T*>& bufs);
+
 // =============== Attributes operations ================== //
 
 // To specify GLOBAL attributes, pass "GLOBAL" as varname
@@ -275,5 +275,104 @@ TEST_CASE ("joint_decomp") {
   finalize_subsystem ();
 }
 
+TEST_CASE ("write_vars") {
+  using strvec_t = std::vector<std::string>;
+
+  ekat::Comm comm (MPI_COMM_WORLD);
+
+  init_subsystem (comm);
+
+  std::string filename = "scorpio_interface_write_vars_test_np" + std::to_string(comm.size()) + ".nc";
+
+  const int dim1 = 2;
+  const int ldim2 = 3;
+  const int dim2  = ldim2 * comm.size();
+  const int lsize = ldim2*dim1;
+
+  std::vector<offset_t> my_offsets;
+  for (int i=0; i<ldim2; ++i) {
+    my_offsets.push_back(ldim2*comm.rank() + i);
+  }
+
+  // Fill the data of var k at time slice n (var4 is not decomposed, so same data on all ranks)
+  auto fill = [&](double* data, const int k, const int n) {
+    if (k==4) {
+      std::iota (data,data+dim1,1000*n + 100*k);
+    } else {
+      std::iota (data,data+lsize,1000*n + 100*k + comm.rank()*lsize);
+    }
+  };
+
+  // Write phase
+  {
+    register_file (filename,Write);
+    define_dim (filename,"dim1",dim1);
+    define_dim (filename,"dim2",dim2);
+    set_dim_decomp (filename,"dim2",my_offsets);
+    define_time (filename,"some_units");
+
+    // var0,...,var2 share the same decomp. var3 has the same decomp too, but is not time dependent.
+    // var4 is not decomposed.
+    for (int k=0; k<3; ++k) {
+      define_var (filename,"var"+std::to_string(k),{"dim2","dim1"},"double",true);
+    }
+    define_var (filename,"var3",{"dim2","dim1"},"double",false);
+    define_var (filename,"var4",{"dim1"},"double",true);
+    enddef (filename);
+
+    const strvec_t names = {"var0","var1","var2","var3","var4"};
+
+    // First slice: separate buffers
+    update_time (filename,0.0);
+    std::vector<std::vector<double>> bufs(5,std::vector<double>(lsize));
+    std::vector<const double*> ptrs;
+    for (int k=0; k<5; ++k) {
+      fill(bufs[k].data(),k,0);
+      ptrs.push_back(bufs[k].data());
+    }
+    write_vars (filename,names,ptrs);
+
+    // Second slice: the time-dependent decomposed vars are stored back to back
+    update_time (filename,1.0);
+    std::vector<double> contig(3*lsize);
+    ptrs.clear();
+    for (int k=0; k<3; ++k) {
+      fill(contig.data()+k*lsize,k,1);
+      ptrs.push_back(contig.data()+k*lsize);
+    }
+    fill(bufs[4].data(),4,1);
+    ptrs.push_back(bufs[4].data());
+    write_vars (filename,{"var0","var1","var2","var4"},ptrs);
+
+    REQUIRE_THROWS (write_vars (filename,{"var0","var1"},ptrs)); // ERROR: sizes mismatch
+
+    release_file (filename);
+  }
+
+  // Read phase
+  {
+    register_file (filename,Read);
+    set_dim_decomp (filename,"dim2",my_offsets);
+
+    std::vector<double> data(lsize), tgt(lsize);
+    auto check = [&](const int k, const int time_index, const int n) {
+      std::fill (data.begin(),data.end(),0);
+      std::fill (tgt.begin(),tgt.end(),0);
+      read_var (filename,"var"+std::to_string(k),data.data(),time_index);
+      fill(tgt.data(),k,n);
+      REQUIRE (data==tgt);
+    };
+    for (int n=0; n<2; ++n) {
+      for (int k : {0,1,2,4}) {
+        check(k,n,n);
+      }
+    }
+    check(3,-1,0);
+
+    release_file (filename);
+  }
+
+  finalize_subsystem ();
+}
 
 } // namespace scream
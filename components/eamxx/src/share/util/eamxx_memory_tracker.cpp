@@ -0,0 +1,133 @@
+#include "share/util/eamxx_memory_tracker.hpp"
+#include "share/util/eamxx_utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace scream {
+
+namespace {
+// Each thread has its own stack of owners (atm procs may be initialized/run concurrently)
+thread_local std::vector<std::string> owners_stack;
+} // anonymous namespace
+
+MemoryTracker& MemoryTracker::instance ()
+{
+  // Never destroyed: tokens may be released during static destruction
+  static MemoryTracker* tracker = new MemoryTracker();
+  return *tracker;
+}
+
+MemoryTracker::OwnerScope::OwnerScope (const std::string& owner)
+{
+  owners_stack.push_back(owner);
+}
+
+MemoryTracker::OwnerScope::~OwnerScope ()
+{
+  owners_stack.pop_back();
+}
+
+std::string MemoryTracker::current_owner () const
+{
+  return owners_stack.empty() ? "unattributed" : owners_stack.back();
+}
+
+MemoryTracker::token_t
+MemoryTracker::track (const long long num_bytes, const std::string& owner)
+{
+  const auto name = owner.empty() ? current_owner() : owner;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& u = m_usage[name];
+    u.current += num_bytes;
+    u.peak = std::max(u.peak,u.current);
+  }
+  return token_t(nullptr,[name,num_bytes](void*) {
+    MemoryTracker::instance().release(name,num_bytes);
+  });
+}
+
+void MemoryTracker::release (const std::string& owner, const long long num_bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_usage[owner].current -= num_bytes;
+}
+
+std::map<std::string,MemoryTracker::Usage>
+MemoryTracker::get_usage () const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_usage;
+}
+
+std::string MemoryTracker::get_report (const ekat::Comm& comm) const
+{
+  const auto usage = get_usage();
+
+  // Different ranks may have different owners, so first gather the union of all names
+  std::string my_names;
+  for (const auto& [name,u] : usage) {
+    my_names += name + '\n';
+  }
+  int my_len = my_names.size();
+  std::vector<int> lens(comm.size()), offsets(comm.size()+1,0);
+  check_mpi_call(MPI_Allgather(&my_len,1,MPI_INT,lens.data(),1,MPI_INT,comm.mpi_comm()),
+                 "[MemoryTracker::get_report] MPI_Allgather (lengths)");
+  std::partial_sum(lens.begin(),lens.end(),offsets.begin()+1);
+  std::string all_names(offsets.back(),' ');
+  check_mpi_call(MPI_Allgatherv(my_names.data(),my_len,MPI_CHAR,
+                                all_names.data(),lens.data(),offsets.data(),MPI_CHAR,
+                                comm.mpi_comm()),
+                 "[MemoryTracker::get_report] MPI_Allgatherv (names)");
+  std::set<std::string> names;
+  for (size_t beg=0, end; beg<all_names.size(); beg=end+1) {
+    end = all_names.find('\n',beg);
+    names.insert(all_names.substr(beg,end-beg));
+  }
+
+  // Same order of owners on all ranks, so we can reduce arrays
+  const int n = names.size();
+  std::vector<long long> cur(n,0), peak(n,0);
+  int i = 0;
+  for (const auto& name : names) {
+    auto it = usage.find(name);
+    if (it!=usage.end()) {
+      cur[i]  = it->second.current;
+      peak[i] = it->second.peak;
+    }
+    ++i;
+  }
+  std::vector<long long> min_cur(n), max_cur(n), min_peak(n), max_peak(n);
+  comm.all_reduce(cur.data(),min_cur.data(),n,MPI_MIN);
+  comm.all_reduce(cur.data(),max_cur.data(),n,MPI_MAX);
+  comm.all_reduce(peak.data(),min_peak.data(),n,MPI_MIN);
+  comm.all_reduce(peak.data(),max_peak.data(),n,MPI_MAX);
+
+  if (not comm.am_i_root()) {
+    return "";
+  }
+
+  std::vector<std::string> ordered(names.begin(),names.end());
+  std::vector<int> rank(n);
+  std::iota(rank.begin(),rank.end(),0);
+  std::stable_sort(rank.begin(),rank.end(),[&](int a, int b) {
+    return max_peak[a]>max_peak[b];
+  });
+
+  char line[256];
+  std::snprintf(line,sizeof(line),"  %-48s %12s %12s %12s %12s\n",
+                "owner","min cur[MB]","max cur[MB]","min peak[MB]","max peak[MB]");
+  std::string report = line;
+  for (int k : rank) {
+    std::snprintf(line,sizeof(line),"  %-48s %12.2f %12.2f %12.2f %12.2f\n",
+                  ordered[k].c_str(),min_cur[k]/1e6,max_cur[k]/1e6,min_peak[k]/1e6,max_peak[k]/1e6);
+    report += line;
+  }
+  return report;
+}
+
+} // namespace scream
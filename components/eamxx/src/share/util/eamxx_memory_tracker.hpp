@@ -0,0 +1,70 @@
+#ifndef EAMXX_MEMORY_TRACKER_HPP
+#define EAMXX_MEMORY_TRACKER_HPP
+
+#include <ekat_comm.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace scream {
+
+/*
+ * Runtime accounting of device memory, attributed to owners.
+ *
+ * Allocations (e.g., in Field::allocate_view) call track(num_bytes), and keep the
+ * returned token alive for as long as the memory is in use. The bytes are attributed
+ * to the owner passed to track or, if none is given, to the innermost OwnerScope
+ * alive on the calling thread (e.g., set by the atm process being initialized).
+ * Allocations outside any OwnerScope are attributed to "unattributed".
+ *
+ * For each owner, we record the current and the peak number of bytes. Peaks are
+ * per owner, so the sum of the peaks can exceed the overall peak.
+ */
+
+class MemoryTracker {
+public:
+  // The memory is considered released when the last copy of the token is destroyed
+  using token_t = std::shared_ptr<void>;
+
+  struct Usage {
+    long long current = 0;
+    long long peak    = 0;
+  };
+
+  static MemoryTracker& instance ();
+
+  // While alive, allocations on this thread without an explicit owner go to this owner
+  class OwnerScope {
+  public:
+    explicit OwnerScope (const std::string& owner);
+    ~OwnerScope ();
+
+    OwnerScope (const OwnerScope&) = delete;
+    OwnerScope& operator= (const OwnerScope&) = delete;
+  };
+
+  token_t track (const long long num_bytes, const std::string& owner = "");
+
+  // The owner that track would use if none is passed
+  std::string current_owner () const;
+
+  std::map<std::string,Usage> get_usage () const;
+
+  // Table of owners (ranked by max peak) with min/max across ranks of current/peak bytes.
+  // Collective on comm; the table is only returned on the root rank.
+  std::string get_report (const ekat::Comm& comm) const;
+
+private:
+  MemoryTracker () = default;
+
+  void release (const std::string& owner, const long long num_bytes);
+
+  mutable std::mutex            m_mutex;
+  std::map<std::string,Usage>   m_usage;
+};
+
+} // namespace scream
+
+#endif // EAMXX_MEMORY_TRACKER_HPP
@@ -1,9 +1,33 @@
 #include "share/util/eamxx_timing.hpp"
 
+#include <Kokkos_Core.hpp>
 #include <gptl.h>
 
+#include <map>
+#include <vector>
+
 namespace scream {
 
+namespace {
+thread_local bool timers_enabled = true;
+
+struct TimerInfo {
+  std::string name;
+  void* handle = nullptr;  // GPTL stores the timer pointer here on first use
+  bool  fence  = false;
+};
+
+std::vector<TimerInfo>& get_timers () {
+  static std::vector<TimerInfo> timers;
+  return timers;
+}
+
+std::map<std::string,int>& get_timers_ids () {
+  static std::map<std::string,int> ids;
+  return ids;
+}
+}
+
 void init_gptl (bool& was_already_inited) {
 #ifdef SCREAM_CIME_BUILD
   was_already_inited = true;
@@ -17,11 +41,61 @@ void finalize_gptl () {
 }
 
 void start_timer (const std::string& name) {
-  GPTLstart(name.c_str());
+  if (timers_enabled) {
+    GPTLstart(name.c_str());
+  }
 }
 
 void stop_timer (const std::string& name) {
-  GPTLstop(name.c_str());
+  if (timers_enabled) {
+    GPTLstop(name.c_str());
+  }
+}
+
+int register_timer (const std::string& name, const bool fence) {
+  if (not timers_enabled) {
+    return -1;
+  }
+
+  auto& timers = get_timers();
+  auto& ids = get_timers_ids();
+  auto it = ids.find(name);
+  if (it!=ids.end()) {
+    // If any of the users needs a fence, do it
+    timers[it->second].fence |= fence;
+    return it->second;
+  }
+
+  const int id = timers.size();
+  auto& t = timers.emplace_back();
+  t.name  = name;
+  t.fence = fence;
+  ids[name] = id;
+  return id;
+}
+
+void start_timer (const int id) {
+  if (timers_enabled and id>=0) {
+    auto& t = get_timers()[id];
+    if (t.fence) {
+      Kokkos::fence();
+    }
+    GPTLstart_handle(t.name.c_str(),&t.handle);
+  }
+}
+
+void stop_timer (const int id) {
+  if (timers_enabled and id>=0) {
+    auto& t = get_timers()[id];
+    if (t.fence) {
+      Kokkos::fence();
+    }
+    GPTLstop_handle(t.name.c_str(),&t.handle);
+  }
+}
+
+void enable_timers_on_this_thread (const bool enable) {
+  timers_enabled = enable;
 }
 
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname) {
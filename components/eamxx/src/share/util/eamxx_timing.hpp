@@ -15,6 +15,22 @@ void finalize_gptl ();
 void start_timer (const std::string& name);
 void stop_timer (const std::string& name);
 
+// Handle-based timers, for code that runs at every time step. The timer is registered
+// once, and then started/stopped via the returned id, so that we do not build (and
+// have GPTL hash) the timer name at every call. If fence=true, Kokkos is fenced before
+// starting/stopping the timer, so that it includes the kernels launched in between.
+// Registering the same name twice returns the same id. If timers are disabled on this
+// thread, nothing is registered, and -1 is returned; starting/stopping a negative id is
+// a no-op. NOTE: register timers on the main thread (e.g., at initialization).
+int register_timer (const std::string& name, const bool fence = false);
+void start_timer (const int id);
+void stop_timer (const int id);
+
+// GPTL only knows about the threads of the threading model it was built with.
+// Threads spawned by EAMxx itself (e.g., to run atm procs concurrently) must
+// disable timers, or else they would corrupt the timers stack of the main thread.
+void enable_timers_on_this_thread (const bool enable);
+
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname);
 
 } // namespace scream
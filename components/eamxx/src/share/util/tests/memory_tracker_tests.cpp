@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+
+#include "share/util/eamxx_memory_tracker.hpp"
+
+TEST_CASE ("memory_tracker") {
+  using namespace scream;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  auto& tracker = MemoryTracker::instance();
+
+  REQUIRE (tracker.current_owner()=="unattributed");
+
+  MemoryTracker::token_t a, b, c;
+  {
+    MemoryTracker::OwnerScope outer("proc");
+    REQUIRE (tracker.current_owner()=="proc");
+    a = tracker.track(1000*(comm.rank()+1));
+    {
+      // Scopes nest, and the innermost one wins
+      MemoryTracker::OwnerScope inner("remap");
+      REQUIRE (tracker.current_owner()=="remap");
+      b = tracker.track(500);
+    }
+    REQUIRE (tracker.current_owner()=="proc");
+    c = tracker.track(200);
+
+    // An explicit owner overrides the scopes
+    auto d = tracker.track(300,"explicit");
+    REQUIRE (tracker.get_usage()["explicit"].current==300);
+  }
+  REQUIRE (tracker.current_owner()=="unattributed");
+
+  // Memory is released when the last copy of the token goes away
+  auto c_copy = c;
+  c.reset();
+  REQUIRE (tracker.get_usage()["proc"].current==1000*(comm.rank()+1)+200);
+  c_copy.reset();
+
+  auto usage = tracker.get_usage();
+  REQUIRE (usage["proc"].current==1000*(comm.rank()+1));
+  REQUIRE (usage["proc"].peak==1000*(comm.rank()+1)+200);
+  REQUIRE (usage["remap"].current==500);
+  REQUIRE (usage["explicit"].current==0);
+  REQUIRE (usage["explicit"].peak==300);
+
+  // Owners appearing only on some ranks must still be in the (collective) report
+  auto e = tracker.track(100, comm.rank()==comm.size()-1 ? "last_rank_only" : "");
+  auto report = tracker.get_report(comm);
+  if (comm.am_i_root()) {
+    for (const auto& name : {"proc","remap","explicit","last_rank_only"}) {
+      REQUIRE (report.find(name)!=std::string::npos);
+    }
+    // Ranked by max peak, so "proc" comes first
+    REQUIRE (report.find("proc")<report.find("remap"));
+  } else {
+    REQUIRE (report.empty());
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+
+#include "share/util/eamxx_timing.hpp"
+
+#include <gptl.h>
+
+TEST_CASE ("timers_by_id") {
+  using namespace scream;
+
+  bool was_already_inited;
+  init_gptl(was_already_inited);
+
+  // Number of times the timer was started/stopped, according to GPTL
+  auto get_count = [](const std::string& name) {
+    int count, onflg;
+    double wall, usr, sys;
+    long long papi;
+    REQUIRE (GPTLquery(name.c_str(),-1,&count,&onflg,&wall,&usr,&sys,&papi,0)==0);
+    return count;
+  };
+
+  const int id = register_timer("timers_by_id::foo");
+  REQUIRE (id>=0);
+
+  // Registering the same name again yields the same id
+  REQUIRE (register_timer("timers_by_id::foo",true)==id);
+  REQUIRE (register_timer("timers_by_id::bar")!=id);
+
+  for (int i=0; i<3; ++i) {
+    start_timer(id);
+    stop_timer(id);
+  }
+  REQUIRE (get_count("timers_by_id::foo")==3);
+
+  // The id and name APIs refer to the same GPTL timer
+  start_timer("timers_by_id::foo");
+  stop_timer("timers_by_id::foo");
+  REQUIRE (get_count("timers_by_id::foo")==4);
+
+  // A negative id is a no-op
+  REQUIRE_NOTHROW (start_timer(-1));
+  REQUIRE_NOTHROW (stop_timer(-1));
+
+  // With timers disabled, nothing is registered
+  enable_timers_on_this_thread(false);
+  REQUIRE (register_timer("timers_by_id::baz")==-1);
+  enable_timers_on_this_thread(true);
+
+  if (not was_already_inited) {
+    finalize_gptl();
+  }
+}
@@ -4,6 +4,7 @@
  */
 
 #include "create_inference_backend.hpp"
+#include "mlp_inference_backend.hpp"
 #include "stub_inference_backend.hpp"
 
 namespace emulator {
@@ -14,6 +15,8 @@ create_backend(BackendType type, const InferenceConfig &config) {
   switch (type) {
   case BackendType::STUB:
     return std::make_shared<StubBackend>(config);
+  case BackendType::MLP:
+    return std::make_shared<MLPBackend>(config);
   default:
     return std::make_shared<StubBackend>(config);
   }
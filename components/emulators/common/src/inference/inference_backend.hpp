@@ -16,6 +16,7 @@ namespace inference {
  */
 enum class BackendType {
   STUB, ///< No-op backend for testing (no ML dependencies)
+  MLP,  ///< Native CPU multilayer perceptron (no ML dependencies)
 };
 
 /**
@@ -25,6 +26,8 @@ struct InferenceConfig {
   int input_channels = 0;  ///< Number of input features per grid point
   int output_channels = 0; ///< Number of output features per grid point
   bool verbose = false;    ///< Enable verbose output (for debugging)
+  std::string model_path;  ///< Path to model weights (backend-specific format)
+  int num_threads = 0;     ///< Threads used by CPU backends (0 = runtime default)
 };
 
 /**
@@ -63,6 +66,12 @@ public:
    */
   virtual std::string name() const = 0;
 
+  /// Number of input features per sample expected by infer()
+  int input_channels() const { return m_config.input_channels; }
+
+  /// Number of output features per sample produced by infer()
+  int output_channels() const { return m_config.output_channels; }
+
 protected:
   InferenceConfig m_config; ///< Backend configuration
 };
@@ -0,0 +1,386 @@
+/**
+ * @file mlp_inference_backend.cpp
+ * @brief Native CPU multilayer-perceptron inference backend implementation.
+ *
+ * Dense layers are evaluated as small GEMMs over blocks of batch rows.
+ * Weights are stored transposed ([in][out]) so the innermost loop runs
+ * over contiguous output features, and four rows are updated per weight
+ * load to reduce memory traffic on the weight matrix.
+ */
+
+#include "mlp_inference_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace emulator {
+namespace inference {
+
+namespace {
+
+constexpr char mlp_magic[8] = {'E', '3', 'S', 'M', 'M', 'L', 'P', '\0'};
+constexpr std::int32_t mlp_version = 1;
+
+template <typename T> void read_value(std::ifstream &ifs, T &val) {
+  ifs.read(reinterpret_cast<char *>(&val), sizeof(T));
+}
+
+template <typename T> void write_value(std::ofstream &ofs, const T &val) {
+  ofs.write(reinterpret_cast<const char *>(&val), sizeof(T));
+}
+
+void check_layers(const std::vector<DenseLayer> &layers,
+                  const std::string &where) {
+  if (layers.empty()) {
+    throw std::runtime_error("Error! " + where + ": network has no layers.");
+  }
+  for (std::size_t l = 0; l < layers.size(); ++l) {
+    const auto &L = layers[l];
+    const std::string id = where + ": layer " + std::to_string(l);
+    if (L.in_features <= 0 || L.out_features <= 0) {
+      throw std::runtime_error("Error! " + id + " has non-positive size.");
+    }
+    if (l > 0 && L.in_features != layers[l - 1].out_features) {
+      throw std::runtime_error("Error! " + id +
+                               " input width does not match previous "
+                               "layer output width.");
+    }
+    const auto act = static_cast<int>(L.activation);
+    if (act < 0 || act > static_cast<int>(Activation::SIGMOID)) {
+      throw std::runtime_error("Error! " + id + " has unknown activation " +
+                               std::to_string(act) + ".");
+    }
+    if (L.weights.size() !=
+            static_cast<std::size_t>(L.in_features) * L.out_features ||
+        L.bias.size() != static_cast<std::size_t>(L.out_features)) {
+      throw std::runtime_error("Error! " + id +
+                               " weights/bias size does not match its "
+                               "dimensions.");
+    }
+  }
+}
+
+/**
+ * @brief y[r][:] = x[r][:] * W + b for nrows rows (no activation).
+ *
+ * @param x  Input rows  [nrows][in]
+ * @param wt Weights     [in][out]
+ * @param b  Bias        [out]
+ * @param y  Output rows [nrows][out]
+ */
+void dense_rows(const double *x, const double *wt, const double *b, double *y,
+                int nrows, int in, int out) {
+  int r = 0;
+  for (; r + 4 <= nrows; r += 4) {
+    const double *x0 = x + static_cast<std::size_t>(r) * in;
+    const double *x1 = x0 + in;
+    const double *x2 = x1 + in;
+    const double *x3 = x2 + in;
+    double *y0 = y + static_cast<std::size_t>(r) * out;
+    double *y1 = y0 + out;
+    double *y2 = y1 + out;
+    double *y3 = y2 + out;
+    for (int n = 0; n < out; ++n) {
+      y0[n] = b[n];
+      y1[n] = b[n];
+      y2[n] = b[n];
+      y3[n] = b[n];
+    }
+    for (int k = 0; k < in; ++k) {
+      const double a0 = x0[k], a1 = x1[k], a2 = x2[k], a3 = x3[k];
+      const double *w = wt + static_cast<std::size_t>(k) * out;
+      for (int n = 0; n < out; ++n) {
+        const double wn = w[n];
+        y0[n] += a0 * wn;
+        y1[n] += a1 * wn;
+        y2[n] += a2 * wn;
+        y3[n] += a3 * wn;
+      }
+    }
+  }
+  // Remainder rows
+  for (; r < nrows; ++r) {
+    const double *xr = x + static_cast<std::size_t>(r) * in;
+    double *yr = y + static_cast<std::size_t>(r) * out;
+    for (int n = 0; n < out; ++n) {
+      yr[n] = b[n];
+    }
+    for (int k = 0; k < in; ++k) {
+      const double a = xr[k];
+      const double *w = wt + static_cast<std::size_t>(k) * out;
+      for (int n = 0; n < out; ++n) {
+        yr[n] += a * w[n];
+      }
+    }
+  }
+}
+
+void apply_activation(double *y, std::size_t n, Activation act) {
+  switch (act) {
+  case Activation::IDENTITY:
+    break;
+  case Activation::RELU:
+    for (std::size_t i = 0; i < n; ++i) {
+      y[i] = std::max(y[i], 0.0);
+    }
+    break;
+  case Activation::TANH:
+    for (std::size_t i = 0; i < n; ++i) {
+      y[i] = std::tanh(y[i]);
+    }
+    break;
+  case Activation::SIGMOID:
+    for (std::size_t i = 0; i < n; ++i) {
+      y[i] = 1.0 / (1.0 + std::exp(-y[i]));
+    }
+    break;
+  }
+}
+
+} // namespace
+
+std::vector<DenseLayer> read_mlp_model(const std::string &path) {
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs) {
+    throw std::runtime_error("Error! Could not open MLP model file '" + path +
+                             "'.");
+  }
+
+  char magic[8];
+  ifs.read(magic, sizeof(magic));
+  if (!ifs || std::memcmp(magic, mlp_magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Error! '" + path +
+                             "' is not an MLP model file (bad magic).");
+  }
+
+  std::int32_t version = 0, num_layers = 0;
+  read_value(ifs, version);
+  read_value(ifs, num_layers);
+  if (!ifs || version != mlp_version) {
+    throw std::runtime_error("Error! Unsupported MLP model version in '" +
+                             path + "'.");
+  }
+  if (num_layers <= 0) {
+    throw std::runtime_error("Error! MLP model file '" + path +
+                             "' has no layers.");
+  }
+
+  std::vector<DenseLayer> layers(num_layers);
+  for (auto &L : layers) {
+    std::int32_t in = 0, out = 0, act = 0;
+    read_value(ifs, in);
+    read_value(ifs, out);
+    read_value(ifs, act);
+    if (!ifs || in <= 0 || out <= 0) {
+      throw std::runtime_error("Error! Bad layer header in MLP model file '" +
+                               path + "'.");
+    }
+    L.in_features = in;
+    L.out_features = out;
+    L.activation = static_cast<Activation>(act);
+    L.weights.resize(static_cast<std::size_t>(in) * out);
+    L.bias.resize(out);
+    ifs.read(reinterpret_cast<char *>(L.weights.data()),
+             L.weights.size() * sizeof(double));
+    ifs.read(reinterpret_cast<char *>(L.bias.data()),
+             L.bias.size() * sizeof(double));
+    if (!ifs) {
+      throw std::runtime_error("Error! Truncated MLP model file '" + path +
+                               "'.");
+    }
+  }
+
+  check_layers(layers, "read_mlp_model('" + path + "')");
+  return layers;
+}
+
+void write_mlp_model(const std::string &path,
+                     const std::vector<DenseLayer> &layers) {
+  check_layers(layers, "write_mlp_model('" + path + "')");
+
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  if (!ofs) {
+    throw std::runtime_error("Error! Could not open '" + path +
+                             "' for writing.");
+  }
+
+  ofs.write(mlp_magic, sizeof(mlp_magic));
+  write_value(ofs, mlp_version);
+  write_value(ofs, static_cast<std::int32_t>(layers.size()));
+  for (const auto &L : layers) {
+    write_value(ofs, static_cast<std::int32_t>(L.in_features));
+    write_value(ofs, static_cast<std::int32_t>(L.out_features));
+    write_value(ofs, static_cast<std::int32_t>(L.activation));
+    ofs.write(reinterpret_cast<const char *>(L.weights.data()),
+              L.weights.size() * sizeof(double));
+    ofs.write(reinterpret_cast<const char *>(L.bias.data()),
+              L.bias.size() * sizeof(double));
+  }
+  if (!ofs) {
+    throw std::runtime_error("Error! Failed writing MLP model file '" + path +
+                             "'.");
+  }
+}
+
+MLPBackend::MLPBackend(const InferenceConfig &config)
+    : InferenceBackend(config) {
+  if (config.model_path.empty()) {
+    throw std::runtime_error(
+        "Error! MLPBackend requires InferenceConfig::model_path to be set.");
+  }
+  setup(read_mlp_model(config.model_path));
+}
+
+MLPBackend::MLPBackend(const InferenceConfig &config,
+                       std::vector<DenseLayer> layers)
+    : InferenceBackend(config) {
+  check_layers(layers, "MLPBackend");
+  setup(std::move(layers));
+}
+
+void MLPBackend::setup(std::vector<DenseLayer> layers) {
+  const int nin = layers.front().in_features;
+  const int nout = layers.back().out_features;
+  if (m_config.input_channels == 0) {
+    m_config.input_channels = nin;
+  }
+  if (m_config.output_channels == 0) {
+    m_config.output_channels = nout;
+  }
+  if (m_config.input_channels != nin || m_config.output_channels != nout) {
+    throw std::runtime_error(
+        "Error! MLPBackend: model maps " + std::to_string(nin) + " -> " +
+        std::to_string(nout) + " channels, but config requests " +
+        std::to_string(m_config.input_channels) + " -> " +
+        std::to_string(m_config.output_channels) + ".");
+  }
+
+  m_layers.clear();
+  m_layers.reserve(layers.size());
+  m_max_width = 0;
+  for (std::size_t l = 0; l < layers.size(); ++l) {
+    auto &src = layers[l];
+    Layer L;
+    L.in = src.in_features;
+    L.out = src.out_features;
+    L.act = src.activation;
+    L.bias = std::move(src.bias);
+    // Transpose to [in][out] so the innermost loop is unit-stride
+    L.wt.resize(src.weights.size());
+    for (int o = 0; o < L.out; ++o) {
+      for (int i = 0; i < L.in; ++i) {
+        L.wt[static_cast<std::size_t>(i) * L.out + o] =
+            src.weights[static_cast<std::size_t>(o) * L.in + i];
+      }
+    }
+    // The last layer writes straight into the caller's output array
+    if (l + 1 < layers.size()) {
+      m_max_width = std::max(m_max_width, L.out);
+    }
+    m_layers.push_back(std::move(L));
+  }
+
+#ifdef _OPENMP
+  m_num_threads =
+      m_config.num_threads > 0 ? m_config.num_threads : omp_get_max_threads();
+#else
+  m_num_threads = 1;
+#endif
+
+  m_scratch.assign(static_cast<std::size_t>(m_num_threads) * 2 * block_rows *
+                       m_max_width,
+                   0.0);
+
+  if (m_config.verbose) {
+    std::cout << "MLPBackend: " << m_layers.size() << " layers, "
+              << m_config.input_channels << " -> "
+              << m_config.output_channels << " channels, " << m_num_threads
+              << " thread(s)" << std::endl;
+  }
+}
+
+void MLPBackend::run_block(const double *x, double *y, int nrows,
+                           double *scratch) const {
+  double *buf[2] = {scratch,
+                    scratch + static_cast<std::size_t>(block_rows) *
+                                  m_max_width};
+  const double *src = x;
+  const int nlayers = static_cast<int>(m_layers.size());
+  for (int l = 0; l < nlayers; ++l) {
+    const auto &L = m_layers[l];
+    double *dst = (l == nlayers - 1) ? y : buf[l % 2];
+    dense_rows(src, L.wt.data(), L.bias.data(), dst, nrows, L.in, L.out);
+    apply_activation(dst, static_cast<std::size_t>(nrows) * L.out, L.act);
+    src = dst;
+  }
+}
+
+/**
+ * @brief Run the network on a batch of samples.
+ *
+ * @param inputs  Input data [batch_size * input_channels]
+ * @param outputs Output data [batch_size * output_channels]
+ * @param batch_size Number of samples in batch
+ * @return false if the backend has been finalized or arguments are invalid
+ */
+bool MLPBackend::infer(const double *inputs, double *outputs, int batch_size) {
+  if (m_layers.empty() || batch_size < 0) {
+    return false;
+  }
+  if (batch_size == 0) {
+    return true;
+  }
+  if (inputs == nullptr || outputs == nullptr) {
+    return false;
+  }
+
+  const int nin = m_config.input_channels;
+  const int nout = m_config.output_channels;
+  const int nblocks = (batch_size + block_rows - 1) / block_rows;
+  const std::size_t scratch_size =
+      static_cast<std::size_t>(2) * block_rows * m_max_width;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(m_num_threads) \
+    if (nblocks > 1)
+#endif
+  for (int blk = 0; blk < nblocks; ++blk) {
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    const int row0 = blk * block_rows;
+    const int nrows = std::min(block_rows, batch_size - row0);
+    run_block(inputs + static_cast<std::size_t>(row0) * nin,
+              outputs + static_cast<std::size_t>(row0) * nout, nrows,
+              m_scratch.data() + tid * scratch_size);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Release weights and scratch buffers.
+ *
+ * After finalize(), infer() returns false.
+ */
+void MLPBackend::finalize() {
+  m_layers.clear();
+  m_layers.shrink_to_fit();
+  m_scratch.clear();
+  m_scratch.shrink_to_fit();
+}
+
+} // namespace inference
+} // namespace emulator
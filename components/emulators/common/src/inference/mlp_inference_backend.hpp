@@ -0,0 +1,143 @@
+/**
+ * @file mlp_inference_backend.hpp
+ * @brief Native CPU multilayer-perceptron inference backend.
+ */
+
+#ifndef E3SM_EMULATOR_MLP_INFERENCE_BACKEND_HPP
+#define E3SM_EMULATOR_MLP_INFERENCE_BACKEND_HPP
+
+#include "inference_backend.hpp"
+
+#include <string>
+#include <vector>
+
+namespace emulator {
+namespace inference {
+
+/**
+ * @brief Activation applied after a dense layer.
+ *
+ * The integer values are part of the on-disk model format.
+ */
+enum class Activation : int {
+  IDENTITY = 0, ///< y = x
+  RELU = 1,     ///< y = max(x, 0)
+  TANH = 2,     ///< y = tanh(x)
+  SIGMOID = 3,  ///< y = 1 / (1 + exp(-x))
+};
+
+/**
+ * @brief A single dense layer, y = act(W x + b).
+ */
+struct DenseLayer {
+  int in_features = 0;                    ///< Input width
+  int out_features = 0;                   ///< Output width
+  Activation activation = Activation::IDENTITY;
+  std::vector<double> weights;            ///< [out_features * in_features], row-major
+  std::vector<double> bias;               ///< [out_features]
+};
+
+/**
+ * @brief Read a dense network from a binary model file.
+ *
+ * The file uses native endianness and has the layout
+ *
+ *     char    magic[8]      "E3SMMLP" followed by a NUL byte
+ *     int32   version       currently 1
+ *     int32   num_layers
+ *     for each layer:
+ *       int32   in_features
+ *       int32   out_features
+ *       int32   activation  (see Activation)
+ *       float64 weights[out_features * in_features]   row-major
+ *       float64 bias[out_features]
+ *
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+std::vector<DenseLayer> read_mlp_model(const std::string &path);
+
+/**
+ * @brief Write a dense network in the format read by read_mlp_model().
+ *
+ * Mainly useful for tests and for converting models trained elsewhere.
+ *
+ * @throws std::runtime_error if the file cannot be written or the layers
+ *         are inconsistent
+ */
+void write_mlp_model(const std::string &path,
+                     const std::vector<DenseLayer> &layers);
+
+/**
+ * @brief Dense-network backend running entirely on the host.
+ *
+ * Loads weights from InferenceConfig::model_path at construction. Each
+ * call to infer() splits the batch into fixed-size row blocks; a block
+ * is pushed through all layers while its activations stay in cache, and
+ * blocks are distributed across OpenMP threads when available. The inner
+ * loops run over contiguous output features so the compiler can vectorize
+ * them, and several rows share each weight load.
+ *
+ * If input_channels/output_channels are zero in the config they are taken
+ * from the model; otherwise they must match it.
+ *
+ * @see InferenceBackend for the base interface
+ */
+class MLPBackend : public InferenceBackend {
+public:
+  /// Number of batch rows processed together by one thread
+  static constexpr int block_rows = 64;
+
+  /**
+   * @brief Construct and load weights from config.model_path.
+   * @throws std::runtime_error on I/O errors or channel mismatch
+   */
+  explicit MLPBackend(const InferenceConfig &config);
+
+  /**
+   * @brief Construct from layers already in memory.
+   * @throws std::runtime_error on inconsistent layers or channel mismatch
+   */
+  MLPBackend(const InferenceConfig &config, std::vector<DenseLayer> layers);
+
+  ~MLPBackend() override = default;
+
+  /// @copydoc InferenceBackend::infer
+  bool infer(const double *inputs, double *outputs,
+             int batch_size = 1) override;
+
+  /// @copydoc InferenceBackend::finalize
+  void finalize() override;
+
+  /// @copydoc InferenceBackend::name
+  std::string name() const override { return "MLP"; }
+
+  /// Number of dense layers in the loaded network
+  int num_layers() const { return static_cast<int>(m_layers.size()); }
+
+  /// Number of threads used by infer()
+  int num_threads() const { return m_num_threads; }
+
+private:
+  /// Internal per-layer storage, with weights transposed to [in][out]
+  struct Layer {
+    int in = 0;
+    int out = 0;
+    Activation act = Activation::IDENTITY;
+    std::vector<double> wt;
+    std::vector<double> bias;
+  };
+
+  void setup(std::vector<DenseLayer> layers);
+
+  void run_block(const double *x, double *y, int nrows, double *scratch) const;
+
+  std::vector<Layer> m_layers;
+  int m_max_width = 0;         ///< Widest hidden layer
+  int m_num_threads = 1;       ///< Threads used in infer()
+  std::vector<double> m_scratch; ///< Per-thread ping-pong activation buffers
+};
+
+} // namespace inference
+} // namespace emulator
+
+#endif // E3SM_EMULATOR_MLP_INFERENCE_BACKEND_HPP
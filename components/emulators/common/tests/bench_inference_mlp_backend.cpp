@@ -0,0 +1,102 @@
+/**
+ * @file bench_inference_mlp_backend.cpp
+ * @brief Throughput benchmark for the native MLP inference backend.
+ *
+ * Runs a column-wise network on batches sized like per-rank column counts
+ * and reports time per call and columns per second.
+ *
+ * Usage: bench_inference_mlp_backend [num_threads] [ncols ...]
+ */
+
+#include "mlp_inference_backend.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace emulator::inference;
+
+namespace {
+
+DenseLayer random_layer(int in, int out, Activation act, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-0.1, 0.1);
+  DenseLayer L;
+  L.in_features = in;
+  L.out_features = out;
+  L.activation = act;
+  L.weights.resize(static_cast<std::size_t>(in) * out);
+  L.bias.resize(out);
+  for (auto &w : L.weights)
+    w = dist(gen);
+  for (auto &b : L.bias)
+    b = dist(gen);
+  return L;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int num_threads = 0;
+  std::vector<int> ncols_list = {1000, 5000, 20000, 100000};
+  if (argc > 1) {
+    num_threads = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    ncols_list.clear();
+    for (int i = 2; i < argc; ++i) {
+      ncols_list.push_back(std::atoi(argv[i]));
+    }
+  }
+
+  // Column model sized like a typical 2-hidden-layer emulator over
+  // ~8 profile variables on 72 levels
+  const int nin = 8 * 72;
+  const int nhid = 256;
+  const int nout = 4 * 72;
+  std::mt19937 gen(0);
+  std::vector<DenseLayer> layers = {
+      random_layer(nin, nhid, Activation::RELU, gen),
+      random_layer(nhid, nhid, Activation::RELU, gen),
+      random_layer(nhid, nout, Activation::IDENTITY, gen)};
+
+  double flops_per_col = 0;
+  for (const auto &L : layers) {
+    flops_per_col += 2.0 * L.in_features * L.out_features;
+  }
+
+  InferenceConfig config;
+  config.num_threads = num_threads;
+  MLPBackend backend(config, layers);
+
+  std::cout << "MLP " << nin << " -> " << nhid << " -> " << nhid << " -> "
+            << nout << ", threads: " << backend.num_threads() << "\n";
+
+  for (int ncols : ncols_list) {
+    std::vector<double> inputs(static_cast<std::size_t>(ncols) * nin);
+    std::vector<double> outputs(static_cast<std::size_t>(ncols) * nout);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto &x : inputs)
+      x = dist(gen);
+
+    // Warm-up call
+    backend.infer(inputs.data(), outputs.data(), ncols);
+
+    const int nrep = 5;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < nrep; ++rep) {
+      backend.infer(inputs.data(), outputs.data(), ncols);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double secs =
+        std::chrono::duration<double>(t1 - t0).count() / nrep;
+
+    std::cout << "  ncols " << ncols << ": " << secs * 1e3 << " ms/call, "
+              << ncols / secs << " cols/s, "
+              << flops_per_col * ncols / secs * 1e-9 << " GFlop/s\n";
+  }
+
+  backend.finalize();
+  return 0;
+}
@@ -0,0 +1,208 @@
+// Catch2 v2 single header
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "create_inference_backend.hpp"
+#include "mlp_inference_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace emulator {
+namespace inference {
+namespace test {
+
+namespace {
+
+DenseLayer random_layer(int in, int out, Activation act, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  DenseLayer L;
+  L.in_features = in;
+  L.out_features = out;
+  L.activation = act;
+  L.weights.resize(in * out);
+  L.bias.resize(out);
+  for (auto &w : L.weights)
+    w = dist(gen);
+  for (auto &b : L.bias)
+    b = dist(gen);
+  return L;
+}
+
+// Straightforward per-sample evaluation used as reference
+std::vector<double> reference_forward(const std::vector<DenseLayer> &layers,
+                                      const std::vector<double> &inputs,
+                                      int batch_size) {
+  const int nin = layers.front().in_features;
+  const int nout = layers.back().out_features;
+  std::vector<double> outputs(batch_size * nout);
+  for (int s = 0; s < batch_size; ++s) {
+    std::vector<double> x(inputs.begin() + s * nin,
+                          inputs.begin() + (s + 1) * nin);
+    for (const auto &L : layers) {
+      std::vector<double> y(L.out_features);
+      for (int o = 0; o < L.out_features; ++o) {
+        double acc = L.bias[o];
+        for (int i = 0; i < L.in_features; ++i)
+          acc += L.weights[o * L.in_features + i] * x[i];
+        switch (L.activation) {
+        case Activation::RELU:
+          acc = acc > 0 ? acc : 0;
+          break;
+        case Activation::TANH:
+          acc = std::tanh(acc);
+          break;
+        case Activation::SIGMOID:
+          acc = 1.0 / (1.0 + std::exp(-acc));
+          break;
+        default:
+          break;
+        }
+        y[o] = acc;
+      }
+      x = std::move(y);
+    }
+    std::copy(x.begin(), x.end(), outputs.begin() + s * nout);
+  }
+  return outputs;
+}
+
+} // namespace
+
+TEST_CASE("MLPBackend small network by hand", "[mlp_backend]") {
+  // y = relu([[1, -1], [2, 0]] x + [0, -1])
+  DenseLayer L;
+  L.in_features = 2;
+  L.out_features = 2;
+  L.activation = Activation::RELU;
+  L.weights = {1, -1, 2, 0};
+  L.bias = {0, -1};
+
+  InferenceConfig config;
+  MLPBackend backend(config, {L});
+
+  REQUIRE(backend.name() == "MLP");
+  REQUIRE(backend.input_channels() == 2);
+  REQUIRE(backend.output_channels() == 2);
+
+  double inputs[4] = {3, 1, 1, 3};
+  double outputs[4] = {-99, -99, -99, -99};
+  REQUIRE(backend.infer(inputs, outputs, 2));
+
+  REQUIRE(outputs[0] == 2.0);
+  REQUIRE(outputs[1] == 5.0);
+  REQUIRE(outputs[2] == 0.0);
+  REQUIRE(outputs[3] == 1.0);
+}
+
+TEST_CASE("MLPBackend matches reference", "[mlp_backend]") {
+  std::mt19937 gen(1234);
+  std::vector<DenseLayer> layers = {
+      random_layer(7, 33, Activation::RELU, gen),
+      random_layer(33, 17, Activation::TANH, gen),
+      random_layer(17, 5, Activation::SIGMOID, gen),
+      random_layer(5, 3, Activation::IDENTITY, gen)};
+
+  const std::string path = "test_inference_mlp_backend_model.bin";
+  write_mlp_model(path, layers);
+
+  InferenceConfig config;
+  config.input_channels = 7;
+  config.output_channels = 3;
+  config.model_path = path;
+  auto backend = create_backend(BackendType::MLP, config);
+  REQUIRE(backend->name() == "MLP");
+
+  // Batch sizes exercise partial row tiles and partial row blocks
+  for (int batch_size : {1, 3, 4, 5, MLPBackend::block_rows,
+                         MLPBackend::block_rows + 1, 1000}) {
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    std::vector<double> inputs(batch_size * 7);
+    for (auto &x : inputs)
+      x = dist(gen);
+    std::vector<double> outputs(batch_size * 3, 0.0);
+
+    REQUIRE(backend->infer(inputs.data(), outputs.data(), batch_size));
+
+    const auto expected = reference_forward(layers, inputs, batch_size);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      REQUIRE(outputs[i] == Approx(expected[i]).margin(1e-12));
+    }
+  }
+
+  backend->finalize();
+  double x[7] = {}, y[3] = {};
+  REQUIRE_FALSE(backend->infer(x, y));
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("MLPBackend model file round trip", "[mlp_backend]") {
+  std::mt19937 gen(42);
+  std::vector<DenseLayer> layers = {random_layer(3, 4, Activation::TANH, gen),
+                                    random_layer(4, 2, Activation::RELU, gen)};
+
+  const std::string path = "test_inference_mlp_backend_roundtrip.bin";
+  write_mlp_model(path, layers);
+  const auto read = read_mlp_model(path);
+
+  REQUIRE(read.size() == layers.size());
+  for (std::size_t l = 0; l < layers.size(); ++l) {
+    REQUIRE(read[l].in_features == layers[l].in_features);
+    REQUIRE(read[l].out_features == layers[l].out_features);
+    REQUIRE(read[l].activation == layers[l].activation);
+    REQUIRE(read[l].weights == layers[l].weights);
+    REQUIRE(read[l].bias == layers[l].bias);
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("MLPBackend error handling", "[mlp_backend]") {
+  std::mt19937 gen(7);
+  InferenceConfig config;
+
+  SECTION("missing model path") {
+    REQUIRE_THROWS_AS(MLPBackend(config), std::runtime_error);
+  }
+
+  SECTION("nonexistent model file") {
+    config.model_path = "this_file_does_not_exist.bin";
+    REQUIRE_THROWS_AS(MLPBackend(config), std::runtime_error);
+  }
+
+  SECTION("not a model file") {
+    const std::string path = "test_inference_mlp_backend_garbage.bin";
+    {
+      std::ofstream ofs(path, std::ios::binary);
+      ofs << "definitely not a model";
+    }
+    config.model_path = path;
+    REQUIRE_THROWS_AS(MLPBackend(config), std::runtime_error);
+    std::remove(path.c_str());
+  }
+
+  SECTION("inconsistent layer widths") {
+    std::vector<DenseLayer> layers = {
+        random_layer(3, 4, Activation::RELU, gen),
+        random_layer(5, 2, Activation::RELU, gen)};
+    REQUIRE_THROWS_AS(MLPBackend(config, layers), std::runtime_error);
+  }
+
+  SECTION("channel mismatch with config") {
+    config.input_channels = 4;
+    std::vector<DenseLayer> layers = {
+        random_layer(3, 2, Activation::RELU, gen)};
+    REQUIRE_THROWS_AS(MLPBackend(config, layers), std::runtime_error);
+  }
+}
+
+} // namespace test
+} // namespace inference
+} // namespace emulator
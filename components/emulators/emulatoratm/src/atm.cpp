@@ -7,6 +7,7 @@
  */
 
 #include "atm.hpp"
+#include "create_inference_backend.hpp"
 #include "emulator_c_api.hpp"
 #include <algorithm>
 #include <cstring>
@@ -60,6 +61,15 @@ void EmulatorAtm::create_instance(int comm, int comp_id,
         if (key == "grid") {
           // grid name identified
         }
+        if (key == "inference_backend") {
+          m_backend_name = val;
+        }
+        if (key == "model_path") {
+          m_inference_config.model_path = val;
+        }
+        if (key == "inference_threads") {
+          m_inference_config.num_threads = std::stoi(val);
+        }
       }
     }
   }
@@ -144,7 +154,24 @@ void EmulatorAtm::get_cols_area(double *area) const {
 
 void EmulatorAtm::init_impl() {
   // TODO: Load YAML configuration from m_input_file
-  // TODO: Create inference backend
+
+  // Create inference backend
+  inference::BackendType backend_type;
+  if (m_backend_name == "stub") {
+    backend_type = inference::BackendType::STUB;
+  } else if (m_backend_name == "mlp") {
+    backend_type = inference::BackendType::MLP;
+  } else {
+    throw std::runtime_error("Error! Unknown inference_backend '" +
+                             m_backend_name + "' (valid: stub, mlp).");
+  }
+  m_backend = inference::create_backend(backend_type, m_inference_config);
+  m_net_inputs.assign(
+      static_cast<size_t>(m_num_local_cols) * m_backend->input_channels(), 0.0);
+  m_net_outputs.assign(
+      static_cast<size_t>(m_num_local_cols) * m_backend->output_channels(),
+      0.0);
+
   // TODO: Read initial conditions
   // TODO: Set up diagnostic output manager
 
@@ -161,8 +188,8 @@ void EmulatorAtm::run_impl(int dt) {
   // 2. Prepare AI model inputs
   prepare_inputs();
 
-  // 3. TODO: Run AI inference
-  // run_inference(m_fields.net_inputs, m_fields.net_outputs);
+  // 3. Run AI inference
+  run_inference();
 
   // 4. Process AI outputs
   process_outputs();
@@ -176,7 +203,10 @@ void EmulatorAtm::run_impl(int dt) {
 void EmulatorAtm::final_impl() {
   // TODO: Write final restart files
   // TODO: Finalize output manager
-  // TODO: Finalize inference backend
+  if (m_backend) {
+    m_backend->finalize();
+    m_backend.reset();
+  }
 
   // TODO: Deallocate field storage
   std::cout << "emulatoratm c++ side ... bye!" << std::endl;
@@ -199,6 +229,15 @@ void EmulatorAtm::prepare_inputs() {
   // for inference. Handle spatial_mode vs pointwise layout.
 }
 
+void EmulatorAtm::run_inference() {
+  // All local columns go through the backend as one batch
+  if (!m_backend->infer(m_net_inputs.data(), m_net_outputs.data(),
+                        m_num_local_cols)) {
+    throw std::runtime_error("Error! Inference failed in backend '" +
+                             m_backend->name() + "'.");
+  }
+}
+
 void EmulatorAtm::process_outputs() {
   // TODO: Unpack m_fields.net_outputs tensor into field
   // vectors. Handle spatial_mode vs pointwise layout.
@@ -12,6 +12,7 @@
 
 #include "emulator.hpp"
 #include "emulator_c_api.hpp"
+#include "inference_backend.hpp"
 #include <memory>
 #include <string>
 #include <vector>
@@ -120,6 +121,15 @@ private:
   std::string m_input_file;    ///< Path to atm_in config file
   std::string m_log_file;      ///< Path to log file
   int m_run_type = 0;          ///< Run type (startup/continue/branch)
+  std::string m_backend_name = "stub"; ///< Inference backend (stub, mlp)
+  inference::InferenceConfig m_inference_config; ///< Backend settings
+
+  // =========================================================================
+  // Inference
+  // =========================================================================
+  std::shared_ptr<inference::InferenceBackend> m_backend; ///< Inference backend
+  std::vector<double> m_net_inputs;  ///< [ncols * input_channels]
+  std::vector<double> m_net_outputs; ///< [ncols * output_channels]
 
   // =========================================================================
   // Helper methods
@@ -127,6 +137,7 @@ private:
   void import_coupling_fields();
   void export_coupling_fields();
   void prepare_inputs();
+  void run_inference();
   void process_outputs();
 };
 
@@ -71,6 +71,10 @@ struct SimulationParams
   // to >0 for diagnostics.
   int       internal_diagnostics_level = 0;
 
+  // If true, split the elements in boundary/interior ones, and overlap the MPI
+  // boundary exchange of the boundary elements with the computation on interior ones.
+  bool      overlap_bexchange = false;
+
   // Use this member to check whether the struct has been initialized
   bool      params_set = false;
 };
@@ -117,6 +121,7 @@ inline void SimulationParams::print (std::ostream& out) {
   out << "   dp3d_thresh: " << dp3d_thresh << "\n";
   out << "   vtheta_thresh: " << vtheta_thresh << "\n";
   out << "   internal_diagnostics_level: " << internal_diagnostics_level << "\n";
+  out << "   overlap_bexchange: " << (overlap_bexchange ? "yes" : "no") << "\n";
   out << "\n**********************************************************\n";
 }
 
@@ -59,6 +59,7 @@ BoundaryExchange::BoundaryExchange()
   m_cleaned_up = true;
   m_send_pending = false;
   m_recv_pending = false;
+  m_local_pack_pending = false;
 
   m_diagnostics_level = 0;
 }
@@ -360,12 +361,19 @@ void BoundaryExchange::exchange_min_max ()
 #endif
 }
 
+// Whether a connection must be skipped, depending on which connections we are packing
+KOKKOS_INLINE_FUNCTION
+static bool skip_connection (const std::uint8_t sharing, const bool pack_shared, const bool pack_nonshared) {
+  return sharing == etoi(ConnectionSharing::SHARED) ? !pack_shared : !pack_nonshared;
+}
+
 static void
 pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
       const ExecViewUnmanaged<const int*> ucon_ptr,
       const ExecViewUnmanaged<ExecViewManaged<Real[NP][NP]>**> fields_2d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Real*>**> send_2d_buffers,
-      const int num_elems, const int num_2d_fields) {
+      const int num_elems, const int num_2d_fields,
+      const bool pack_shared, const bool pack_nonshared) {
   HOMMEXX_STATIC const ConnectionHelpers helpers;
   const int nconn = ucon.extent_int(0);
   Kokkos::parallel_for(
@@ -374,6 +382,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const int iconn = it / num_2d_fields;
       const int ifield = it % num_2d_fields;
       const auto& info = ucon(iconn);
+      if (skip_connection(info.sharing, pack_shared, pack_nonshared))
+        return;
       const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                 info.sharing_local_remote_iconn :
                                 iconn);
@@ -392,6 +402,7 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const ExecViewUnmanaged<ExecViewManaged<Scalar[NP][NP][NUM_LEV_PACKS]>**> fields_3d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Scalar**>**> send_3d_buffers,
       const int num_elems, const int num_3d_fields,
+      const bool pack_shared, const bool pack_nonshared,
       ExecViewManaged<int*>* nlev_packs_ = nullptr) {
   assert(partial_column == (nlev_packs_ != nullptr));
   if (partial_column) assert(nlev_packs_->extent_int(0) == num_3d_fields);
@@ -411,6 +422,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
         }
         const int iconn = it / (num_3d_fields*NUM_LEV_PACKS);
         const auto& info = ucon(iconn);
+        if (skip_connection(info.sharing, pack_shared, pack_nonshared))
+          return;
         const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                   info.sharing_local_remote_iconn :
                                   iconn);
@@ -442,6 +455,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
         for (int iconn = ucon_ptr(ie); iconn < iconn_end; ++iconn) {
           const auto& info = ucon(iconn);
           assert(info.kind != etoi(ConnectionSharing::MISSING));
+          if (skip_connection(info.sharing, pack_shared, pack_nonshared))
+            continue;
           const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                     info.sharing_local_remote_iconn :
                                     iconn);
@@ -490,45 +505,104 @@ void BoundaryExchange::pack_and_send ()
   }
 
   // ---- Pack ---- //
+  pack_fields(true, true);
+
+  // ---- Send ---- //
+  tstart("be sync_send_buffer");
+  m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
+  tstop("be sync_send_buffer");
+  tstart("be send");
+  if ( ! m_send_requests.empty())
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
+                            m_connectivity->get_comm().mpi_comm());
+
+  // Notify a send is ongoing
+  m_send_pending = true;
+  tstop("be pack_and_send");
+}
+
+void BoundaryExchange::pack_and_send_shared ()
+{
+  tstart("be pack_and_send_shared");
+  // The registration MUST be completed by now
+  // Note: this also implies connectivity and buffers manager are valid
+  assert (m_registration_completed);
+
+  // Check that this object is setup to perform exchange and not exchange_min_max
+  assert (m_exchange_type==MPI_EXCHANGE);
+
+  if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
+    return;
+  }
+
+  // Check that buffers are not locked by someone else, then lock them
+  assert (!m_buffers_manager->are_buffers_busy());
+  m_buffers_manager->lock_buffers();
+
+  if (!m_buffer_views_and_requests_built) {
+    tstart("be build_buffer_views_and_requests");
+    build_buffer_views_and_requests();
+    tstop("be build_buffer_views_and_requests");
+  }
+
+  // The caller will do some work before recv_and_unpack, so start receiving right away
+  if ( ! m_recv_requests.empty())
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_recv_requests.size(), m_recv_requests.data()),
+                            m_connectivity->get_comm().mpi_comm());
+  m_recv_pending = true;
+
+  // ---- Pack (shared connections only) ---- //
+  pack_fields(true, false);
+
+  // ---- Send ---- //
+  tstart("be sync_send_buffer");
+  m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
+  tstop("be sync_send_buffer");
+  tstart("be send");
+  if ( ! m_send_requests.empty())
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
+                            m_connectivity->get_comm().mpi_comm());
+  tstop("be send");
+
+  // Notify a send is ongoing, and that local connections still need to be packed
+  m_send_pending = true;
+  m_local_pack_pending = true;
+  tstop("be pack_and_send_shared");
+}
+
+void BoundaryExchange::pack_fields (const bool pack_shared, const bool pack_nonshared)
+{
   const auto& ucon = m_connectivity->get_d_ucon();
   const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
   // First, pack 2d fields (if any)...
   if (m_num_2d_fields > 0)
     pack(ucon, ucon_ptr, m_2d_fields, m_send_2d_buffers, m_num_elems,
-         m_num_2d_fields);
+         m_num_2d_fields, pack_shared, pack_nonshared);
   // ...then pack 3d fields (if any)...
   if (m_num_3d_fields > 0) {
     if (m_3d_nlev_pack_d.size() > 0)
       pack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                          m_num_elems, m_num_3d_fields, &m_3d_nlev_pack_d);
+                          m_num_elems, m_num_3d_fields, pack_shared, pack_nonshared,
+                          &m_3d_nlev_pack_d);
     else
       pack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                    m_num_elems, m_num_3d_fields);
+                    m_num_elems, m_num_3d_fields, pack_shared, pack_nonshared);
   }
   // ...then pack 3d interface fields (if any)
   if (m_num_3d_int_fields > 0)
     pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
-                    m_num_elems, m_num_3d_int_fields);
+                    m_num_elems, m_num_3d_int_fields, pack_shared, pack_nonshared);
   Kokkos::fence();
-
-  // ---- Send ---- //
-  tstart("be sync_send_buffer");
-  m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
-  tstop("be sync_send_buffer");
-  tstart("be send");
-  if ( ! m_send_requests.empty())
-    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
-                            m_connectivity->get_comm().mpi_comm());
-
-  // Notify a send is ongoing
-  m_send_pending = true;
-  tstop("be pack_and_send");
 }
 
 void BoundaryExchange::recv_and_unpack () {
   recv_and_unpack(nullptr);
 }
 
+void BoundaryExchange::recv_and_unpack (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp) {
+  recv_and_unpack(&rspheremp);
+}
+
 // assume:conn-edges-snwe
 static void
 unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
@@ -708,6 +782,15 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   }
   tstop("be recv_and_unpack book");
 
+  // If the send was started with pack_and_send_shared, local connections still need
+  // to be packed. Do it now, while the shared connections data are in flight.
+  if (m_local_pack_pending) {
+    tstart("be pack local");
+    pack_fields(false, true);
+    m_local_pack_pending = false;
+    tstop("be pack local");
+  }
+
   // ---- Recv ---- //
   tstart("be recv waitall");
   if ( ! m_recv_requests.empty())
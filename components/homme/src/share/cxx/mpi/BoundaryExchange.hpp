@@ -218,6 +218,13 @@ public:
   // Perform the pack_and_send and recv_and_unpack for boundary exchange of 2d/3d fields
   void pack_and_send ();
   void recv_and_unpack ();
+  void recv_and_unpack (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
+
+  // Like pack_and_send, but only pack (and send) the data of shared connections, that is,
+  // the data of elements on the boundary of this rank's domain (see Connectivity::get_num_boundary_elements).
+  // The data of local connections is packed at the beginning of recv_and_unpack, so that
+  // interior elements can still be updated in between the two calls, while messages are in flight.
+  void pack_and_send_shared ();
 
   // Perform the pack_and_send and recv_and_unpack for min/max boundary exchange of 1d fields
   void pack_and_send_min_max ();
@@ -301,6 +308,7 @@ private:
   bool        m_cleaned_up;
   bool        m_send_pending;
   bool        m_recv_pending;
+  bool        m_local_pack_pending;
 
   int         m_num_elems;
 
@@ -311,6 +319,8 @@ private:
     std::vector<int>& h_slot_idx_to_elem_conn_pair,
     std::vector<int>& pids, std::vector<int>& pids_os);
   void free_requests();
+  // Pack fields data of shared and/or non-shared connections into the send buffers
+  void pack_fields (const bool pack_shared, const bool pack_nonshared);
   // Only the impl knows about the raw pointer.
   void exchange(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
 public: // This is semantically private but must be public for nvcc.
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 namespace Homme
 {
@@ -18,6 +19,7 @@ Connectivity::Connectivity ()
  , m_initialized  (false)
  , m_num_local_elements (-1)
  , m_max_corner_elements(-1)
+ , m_num_boundary_elements(0)
 {
   // Nothing to be done here
 }
@@ -136,6 +138,7 @@ void Connectivity::finalize(const bool sanity_check)
   }
 
   setup_ucon();
+  setup_boundary_elements();
 
   m_finalized = true;
 }
@@ -313,6 +316,33 @@ void Connectivity::setup_ucon () {
   }
 }
 
+void Connectivity::setup_boundary_elements () {
+  d_elems_bnd_first = decltype(d_elems_bnd_first)("Elements, boundary first", m_num_local_elements);
+  h_elems_bnd_first = Kokkos::create_mirror_view(d_elems_bnd_first);
+
+  // An element is on the boundary if it has at least one connection shared with another rank.
+  // Keep the lid ordering within each group.
+  std::vector<int> interior;
+  m_num_boundary_elements = 0;
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    bool on_boundary = false;
+    for (int k = h_ucon_ptr(ie); k < h_ucon_ptr(ie+1); ++k) {
+      if (h_ucon(k).sharing == etoi(ConnectionSharing::SHARED)) {
+        on_boundary = true;
+        break;
+      }
+    }
+    if (on_boundary) {
+      h_elems_bnd_first(m_num_boundary_elements++) = ie;
+    } else {
+      interior.push_back(ie);
+    }
+  }
+  std::copy(interior.begin(), interior.end(), h_elems_bnd_first.data() + m_num_boundary_elements);
+
+  Kokkos::deep_copy(d_elems_bnd_first, h_elems_bnd_first);
+}
+
 void Connectivity::clean_up()
 {
   // Cleaning the elements counter
@@ -322,6 +352,9 @@ void Connectivity::clean_up()
   h_ucon = decltype(h_ucon)("", 0);
   d_ucon_ptr = decltype(d_ucon_ptr)("", 0);
   h_ucon_ptr = decltype(h_ucon_ptr)("", 0);
+  d_elems_bnd_first = decltype(d_elems_bnd_first)("", 0);
+  h_elems_bnd_first = decltype(h_elems_bnd_first)("", 0);
+  m_num_boundary_elements = 0;
 
   m_initialized = false;
   m_finalized   = false;
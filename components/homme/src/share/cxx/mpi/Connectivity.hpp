@@ -125,6 +125,14 @@ public:
   int get_num_local_elements     () const { return m_num_local_elements;  }
   int get_max_corner_elements    () const { return m_max_corner_elements; }
 
+  // Local elements ids, sorted so that "boundary" elements (i.e., the ones with at least
+  // one shared connection) come first, followed by "interior" elements (only local connections).
+  // This allows to overlap the MPI exchange of boundary elements data with the
+  // computation on interior elements.
+  int get_num_boundary_elements  () const { return m_num_boundary_elements; }
+  ExecViewUnmanaged<const int*> get_d_elems_bnd_first () const { return d_elems_bnd_first; }
+  HostViewUnmanaged<const int*> get_h_elems_bnd_first () const { return h_elems_bnd_first; }
+
   bool is_initialized () const { return m_initialized; }
   bool is_finalized   () const { return m_finalized;   }
 
@@ -143,6 +151,7 @@ private:
   bool    m_initialized;
 
   int     m_num_local_elements, m_max_corner_elements;
+  int     m_num_boundary_elements;
 
   ConnectionHelpers m_helpers;
 
@@ -156,6 +165,8 @@ private:
   ExecViewManaged<int*>::host_mirror_type h_ucon_ptr;
   ExecViewManaged<int*>             d_ucon_dir_ptr;
   ExecViewManaged<int*>::host_mirror_type h_ucon_dir_ptr;
+  ExecViewManaged<int*>             d_elems_bnd_first;
+  ExecViewManaged<int*>::host_mirror_type h_elems_bnd_first;
   // Helper used to accumulate connections during add_connection phase. Emptied
   // in finalize. l_ is local; r_ is remote.
   struct UConInfo {
@@ -167,6 +178,8 @@ private:
   // In finalize call, construct the unstructured connectivity data using
   // ucon_info.
   void setup_ucon();
+  // In finalize call, sort local elements in boundary/interior ones
+  void setup_boundary_elements();
 };
 
 } // namespace Homme
@@ -92,6 +92,7 @@ struct CaarFunctorImpl {
   const bool          m_theta_hydrostatic_mode;
   const AdvectionForm m_theta_advection_form;
   const bool          m_pgrad_correction;
+  const bool          m_overlap_bexchange;
 
   HybridVCoord          m_hvcoord;
   ElementsState         m_state;
@@ -123,6 +124,14 @@ struct CaarFunctorImpl {
 
   Kokkos::Array<std::shared_ptr<BoundaryExchange>, NUM_TIME_LEVELS> m_bes;
 
+  // If m_overlap_bexchange=true, the pre-exchange kernel is run on boundary elements
+  // first, and on interior ones while the boundary data is in flight. League ranks are
+  // then mapped to elements via the boundary-first ordering of the Connectivity,
+  // starting at m_elems_offset.
+  int                           m_num_bnd_elems;
+  int                           m_elems_offset;
+  ExecViewUnmanaged<const int*> m_elems_bnd_first;
+
   CaarFunctorImpl(const Elements &elements, const Tracers &/* tracers */,
                   const ReferenceElement &ref_FE, const HybridVCoord &hvcoord,
                   const SphereOperators &sphere_ops, const SimulationParams& params)
@@ -131,6 +140,7 @@ struct CaarFunctorImpl {
       , m_theta_hydrostatic_mode(params.theta_hydrostatic_mode)
       , m_theta_advection_form(params.theta_adv_form)
       , m_pgrad_correction(params.pgrad_correction)
+      , m_overlap_bexchange(params.overlap_bexchange)
       , m_hvcoord(hvcoord)
       , m_state(elements.m_state)
       , m_derived(elements.m_derived)
@@ -140,6 +150,8 @@ struct CaarFunctorImpl {
       , m_policy_pre (Homme::get_default_team_policy<ExecSpace,TagPreExchange>(m_num_elems))
       , m_policy_post (0,m_num_elems*NP*NP)
       , m_tu(m_policy_pre)
+      , m_num_bnd_elems(0)
+      , m_elems_offset(0)
   {
     // Initialize equation of state
     m_eos.init(params.theta_hydrostatic_mode,m_hvcoord);
@@ -154,9 +166,12 @@ struct CaarFunctorImpl {
       , m_theta_hydrostatic_mode(params.theta_hydrostatic_mode)
       , m_theta_advection_form(params.theta_adv_form)
       , m_pgrad_correction(params.pgrad_correction)
+      , m_overlap_bexchange(params.overlap_bexchange)
       , m_policy_pre (Homme::get_default_team_policy<ExecSpace,TagPreExchange>(m_num_elems))
       , m_policy_post (0,num_elems*NP*NP)
       , m_tu(m_policy_pre)
+      , m_num_bnd_elems(0)
+      , m_elems_offset(0)
   {}
 
   void setup (const Elements &elements, const Tracers &/*tracers*/,
@@ -323,6 +338,12 @@ struct CaarFunctorImpl {
       }
       be.registration_completed();
     }
+
+    if (m_overlap_bexchange) {
+      const auto& connectivity = *bm_exchange->get_connectivity();
+      m_num_bnd_elems   = connectivity.get_num_boundary_elements();
+      m_elems_bnd_first = connectivity.get_d_elems_bnd_first();
+    }
   }
 
   void set_rk_stage_data (const RKStageData& data) {
@@ -343,18 +364,44 @@ struct CaarFunctorImpl {
 
     set_rk_stage_data(data);
 
-    GPTLstart("caar compute");
-    int nerr;
-    Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
-    Kokkos::fence();
-    GPTLstop("caar compute");
-    if (nerr > 0)
-      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+    if (m_overlap_bexchange) {
+      Errors::runtime_check(m_elems_bnd_first.extent_int(0)==m_num_elems,
+                            "Error! Boundary exchanges overlap requested, but boundary elements were not set.\n");
 
-    GPTLstart("caar_bexchV");
-    m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
-    Kokkos::fence();
-    GPTLstop("caar_bexchV");
+      // Compute boundary elements, and start sending their data...
+      GPTLstart("caar compute");
+      int nerr = run_pre_exchange(0, m_num_bnd_elems);
+      GPTLstop("caar compute");
+
+      GPTLstart("caar_bexchV");
+      m_bes[data.np1]->pack_and_send_shared();
+      GPTLstop("caar_bexchV");
+
+      // ...then compute interior elements while messages are in flight
+      GPTLstart("caar compute");
+      nerr += run_pre_exchange(m_num_bnd_elems, m_num_elems-m_num_bnd_elems);
+      GPTLstop("caar compute");
+      if (nerr > 0)
+        check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+
+      GPTLstart("caar_bexchV");
+      m_bes[data.np1]->recv_and_unpack(m_geometry.m_rspheremp);
+      Kokkos::fence();
+      GPTLstop("caar_bexchV");
+    } else {
+      GPTLstart("caar compute");
+      int nerr;
+      Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
+      Kokkos::fence();
+      GPTLstop("caar compute");
+      if (nerr > 0)
+        check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+
+      GPTLstart("caar_bexchV");
+      m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
+      Kokkos::fence();
+      GPTLstop("caar_bexchV");
+    }
 
     if (!m_theta_hydrostatic_mode) {
       GPTLstart("caar compute");
@@ -367,12 +414,29 @@ struct CaarFunctorImpl {
 
   }
 
+  // Run the pre-exchange kernel on num_elems elements of the boundary-first ordering,
+  // starting at offset. Returns the number of teams that found bad elements.
+  int run_pre_exchange (const int offset, const int num_elems) {
+    int nerr = 0;
+    if (num_elems==0) {
+      return nerr;
+    }
+    m_elems_offset = offset;
+    TeamPolicyType<TagPreExchange> policy (Homme::get_default_team_policy<ExecSpace,TagPreExchange>(num_elems));
+    Kokkos::parallel_reduce("caar loop pre-boundary exchange", policy, *this, nerr);
+    Kokkos::fence();
+    return nerr;
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(const TagPreExchange&, const TeamMember &team, int& nerr) const {
     // In this body, we use '====' to separate sync epochs (delimited by barriers)
     // Note: make sure the same temp is not used within each epoch!
 
     KernelVariables kv(team, m_tu);
+    if (m_overlap_bexchange) {
+      kv.ie = m_elems_bnd_first(m_elems_offset + kv.ie);
+    }
 
     // =========== EPOCH 1 =========== //
     compute_div_vdp(kv);
@@ -72,6 +72,8 @@ void HyperviscosityFunctorImpl::init_params(const SimulationParams& params)
 {
   // Sanity check
   assert(params.params_set);
+
+  m_overlap_bexchange = params.overlap_bexchange;
   // tom_sponge_start is now stored in m_data
   //NOTE: we are missing the part of the block that computes m_nu_scale_top using tom_sponge_start.
   // As of 04/29/2026 we decided not to move this missing computation from
@@ -262,8 +264,29 @@ void HyperviscosityFunctorImpl::init_boundary_exchanges () {
     be->register_field(m_buffers.vtens, 2, 0, nlev);
     be->registration_completed();
   }
+
+  if (m_overlap_bexchange) {
+    const auto& connectivity = *bm_exchange->get_connectivity();
+    m_num_bnd_elems   = connectivity.get_num_boundary_elements();
+    m_elems_bnd_first = connectivity.get_d_elems_bnd_first();
+  }
 }//initBE
 
+template<typename Tag>
+void HyperviscosityFunctorImpl::run_on_elems_subset (const int offset, const int num_elems) const
+{
+  Errors::runtime_check(m_elems_bnd_first.extent_int(0)==m_num_elems,
+                        "Error! Boundary exchanges overlap requested, but boundary elements were not set.\n");
+  if (num_elems==0) {
+    return;
+  }
+  // The kernel reads the offset from the functor, so launch a copy with the offset set
+  auto functor = *this;
+  functor.m_elems_offset = offset;
+  Kokkos::parallel_for(Homme::get_default_team_policy<ExecSpace,Tag>(num_elems), functor);
+  Kokkos::fence();
+}
+
 void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real eta_ave_w)
 {
   m_data.np1 = np1;
@@ -309,14 +332,26 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
     biharmonic_wk_theta ();
     GPTLstop("hvf-bhwk");
 
-    Kokkos::parallel_for(m_policy_pre_exchange, *this);
-    Kokkos::fence();
-
-    // Exchange
     assert (m_be->is_registration_completed());
-    GPTLstart("hvf-bexch");
-    m_be->exchange();
-    GPTLstop("hvf-bexch");
+    if (m_overlap_bexchange) {
+      // Start the exchange of boundary elements, then process interior elements
+      run_on_elems_subset<TagHyperPreExchange>(0, m_num_bnd_elems);
+      GPTLstart("hvf-bexch");
+      m_be->pack_and_send_shared();
+      GPTLstop("hvf-bexch");
+      run_on_elems_subset<TagHyperPreExchange>(m_num_bnd_elems, m_num_elems-m_num_bnd_elems);
+      GPTLstart("hvf-bexch");
+      m_be->recv_and_unpack();
+      GPTLstop("hvf-bexch");
+    } else {
+      Kokkos::parallel_for(m_policy_pre_exchange, *this);
+      Kokkos::fence();
+
+      // Exchange
+      GPTLstart("hvf-bexch");
+      m_be->exchange();
+      GPTLstop("hvf-bexch");
+    }
 
     // Update states
     Kokkos::parallel_for(m_policy_update_states, *this);
@@ -414,14 +449,26 @@ void HyperviscosityFunctorImpl::biharmonic_wk_theta() const
   // For the first laplacian we use a differnt kernel, which uses directly the states
   // at timelevel np1 as inputs, and subtracts the reference states.
   // This way we avoid copying the states to *tens buffers.
-  Kokkos::parallel_for(m_policy_first_laplace, *this);
-  Kokkos::fence();
-
-  // Exchange
   assert (m_be->is_registration_completed());
-  GPTLstart("hvf-bexch");
-  m_be->exchange(m_geometry.m_rspheremp);
-  GPTLstop("hvf-bexch");
+  if (m_overlap_bexchange) {
+    // Start the exchange of boundary elements, then process interior elements
+    run_on_elems_subset<TagFirstLaplaceHV>(0, m_num_bnd_elems);
+    GPTLstart("hvf-bexch");
+    m_be->pack_and_send_shared();
+    GPTLstop("hvf-bexch");
+    run_on_elems_subset<TagFirstLaplaceHV>(m_num_bnd_elems, m_num_elems-m_num_bnd_elems);
+    GPTLstart("hvf-bexch");
+    m_be->recv_and_unpack(m_geometry.m_rspheremp);
+    GPTLstop("hvf-bexch");
+  } else {
+    Kokkos::parallel_for(m_policy_first_laplace, *this);
+    Kokkos::fence();
+
+    // Exchange
+    GPTLstart("hvf-bexch");
+    m_be->exchange(m_geometry.m_rspheremp);
+    GPTLstop("hvf-bexch");
+  }
 
   // Compute second laplacian, tensor or const hv
   const int ne = m_geometry.num_elems();
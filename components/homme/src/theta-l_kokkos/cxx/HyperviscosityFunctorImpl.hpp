@@ -120,12 +120,20 @@ public:
 
   void biharmonic_wk_theta () const;
 
+  // Run the kernel with tag Tag on num_elems elements of the boundary-first
+  // ordering of the elements (see Connectivity), starting at offset.
+  template<typename Tag>
+  void run_on_elems_subset (const int offset, const int num_elems) const;
+
   // first iter of laplace, const hv
   KOKKOS_INLINE_FUNCTION
   void operator() (const TagFirstLaplaceHV&, const TeamMember& team) const {
      using IntColumn = decltype(Homme::subview(m_state.m_w_i,0,0,0,0));
 
     KernelVariables kv(team, m_tu);
+    if (m_overlap_bexchange) {
+      kv.ie = m_elems_bnd_first(m_elems_offset + kv.ie);
+    }
     // Subtract the reference states from the states
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team,NP*NP),
                          [&](const int idx) {
@@ -336,6 +344,9 @@ public:
     using IntColumn = decltype(Homme::subview(m_state.m_w_i,0,0,0,0));
 
     KernelVariables kv(team, m_tu);
+    if (m_overlap_bexchange) {
+      kv.ie = m_elems_bnd_first(m_elems_offset + kv.ie);
+    }
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
                          [&](const int &point_idx) {
       const int igp = point_idx / NP;
@@ -434,6 +445,14 @@ protected:
 
   std::shared_ptr<BoundaryExchange> m_be, m_be_tom, m_be_sgs;
 
+  // If true, the kernels before m_be exchanges are run on boundary elements first, and on
+  // interior elements while the boundary data is in flight. League ranks are then mapped
+  // to elements via the boundary-first ordering of the Connectivity, starting at m_elems_offset.
+  bool                          m_overlap_bexchange = false;
+  int                           m_num_bnd_elems = 0;
+  int                           m_elems_offset = 0;
+  ExecViewUnmanaged<const int*> m_elems_bnd_first;
+
   ExecViewManaged<Scalar[NUM_LEV]> m_nu_scale_top;
   int m_nu_scale_top_ilev_pack_lim;
 }; //HVfunctorImpl
@@ -12,6 +12,7 @@
 #include <random>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 using namespace Homme;
 
@@ -81,6 +82,30 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
   int num_elements = connectivity->get_num_local_elements();
   int rank = connectivity->get_comm().rank();
 
+  // Check the boundary-first ordering of the elements: it must be a permutation of
+  // the local elements, with elements having a shared connection first
+  {
+    const auto h_ucon = connectivity->get_h_ucon();
+    const auto h_ucon_ptr = connectivity->get_h_ucon_ptr();
+    const auto elems = connectivity->get_h_elems_bnd_first();
+    const int num_bnd_elems = connectivity->get_num_boundary_elements();
+    REQUIRE (elems.extent_int(0)==num_elements);
+    std::vector<int> count(num_elements,0);
+    for (int i=0; i<num_elements; ++i) {
+      const int ie = elems(i);
+      REQUIRE ((ie>=0 && ie<num_elements));
+      ++count[ie];
+      bool has_shared = false;
+      for (int k=h_ucon_ptr(ie); k<h_ucon_ptr(ie+1); ++k) {
+        has_shared |= h_ucon(k).sharing==etoi(ConnectionSharing::SHARED);
+      }
+      REQUIRE (has_shared==(i<num_bnd_elems));
+    }
+    for (int ie=0; ie<num_elements; ++ie) {
+      REQUIRE (count[ie]==1);
+    }
+  }
+
   // Create input data arrays
   HostViewManaged<Real*[num_min_max_fields_1d][NUM_PHYSICAL_LEV]> field_min_1d_f90("", num_elements);
   HostViewManaged<Real*[num_min_max_fields_1d][NUM_PHYSICAL_LEV]> field_max_1d_f90("", num_elements);
@@ -302,6 +327,46 @@ TEST_CASE ("Boundary Exchange", "Testing the boundary exchange framework")
     }}}}}}
   }
 
+  // Exchange a copy of the be2 fields through the split shared/local path, used to overlap
+  // communication and computation, and check it gives the same result as the regular exchange
+  {
+    ExecViewManaged<Scalar*[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>   field_3d_split ("", num_elements);
+    ExecViewManaged<Scalar*[NUM_TIME_LEVELS][NP][NP][NUM_LEV_P]> field_3d_int_split ("", num_elements);
+    Kokkos::deep_copy(field_3d_split,     field_3d_cxx);
+    Kokkos::deep_copy(field_3d_int_split, field_3d_int_cxx);
+
+    std::shared_ptr<BoundaryExchange> be4 = std::make_shared<BoundaryExchange>(connectivity,buffers_manager);
+    be4->set_num_fields(0,0,num_scalar_fields_3d,num_scalar_interface_fields_3d);
+    be4->register_field(field_3d_split,1,field_3d_idim);
+    be4->register_field(field_3d_int_split,1,field_3d_idim);
+    be4->registration_completed();
+
+    be2->exchange();
+    be4->pack_and_send_shared();
+    be4->recv_and_unpack();
+
+    Kokkos::deep_copy(field_3d_cxx_host,     field_3d_cxx);
+    Kokkos::deep_copy(field_3d_int_cxx_host, field_3d_int_cxx);
+    auto field_3d_split_host     = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),field_3d_split);
+    auto field_3d_int_split_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),field_3d_int_split);
+    for (int ie=0; ie<num_elements; ++ie) {
+      for (int igp=0; igp<NP; ++igp) {
+        for (int jgp=0; jgp<NP; ++jgp) {
+          for (int ilev=0; ilev<NUM_LEV; ++ilev) {
+            for (int ivec=0; ivec<VECTOR_SIZE; ++ivec) {
+              REQUIRE(compare_answers(field_3d_cxx_host(ie,field_3d_idim,igp,jgp,ilev)[ivec],
+                                      field_3d_split_host(ie,field_3d_idim,igp,jgp,ilev)[ivec]) < test_tolerance);
+          }}
+          for (int ilev=0; ilev<NUM_LEV_P; ++ilev) {
+            for (int ivec=0; ivec<VECTOR_SIZE; ++ivec) {
+              REQUIRE(compare_answers(field_3d_int_cxx_host(ie,field_3d_idim,igp,jgp,ilev)[ivec],
+                                      field_3d_int_split_host(ie,field_3d_idim,igp,jgp,ilev)[ivec]) < test_tolerance);
+          }}
+    }}}
+
+    be4->clean_up();
+  }
+
   // Cleanup
   cleanup_f90();  // Deallocate stuff in the F90 module
   be1->clean_up();
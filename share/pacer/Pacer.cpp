@@ -12,6 +12,10 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unordered_map>
 
 #ifdef PACER_HAVE_KOKKOS
 #include <Kokkos_Core.hpp>
@@ -73,6 +77,78 @@ static bool TimingBarriersEnabled = false;
 /// Flag to determine if automatic Kokkos fences are enabled
 static bool AutoFenceEnabled = false;
 
+/// Flag to track if timing is enabled (see enableTiming/disableTiming)
+static bool TimingEnabled = true;
+
+/// A traced timer interval: NameId indexes TraceNames (negative if
+/// the timer is not traced), times are in seconds since TraceOrigin
+struct TraceEvent {
+    int NameId;
+    double Begin;
+    double End;
+};
+
+/// Flag to determine if event tracing is enabled
+static bool TracingEnabled = false;
+
+/// Tracing level: only timers with level <= TraceLevel are traced
+static int TraceLevel = 0;
+
+/// Trace output: file prefix and whether ranks are merged in one file
+static std::string TracePrefix = "";
+static bool TraceMergeRanks = true;
+
+/// Ring buffer of completed trace events. TraceNext is the next slot
+/// to write, TraceCount the total number of events recorded so far
+/// (events older than the last TraceBuffer.size() are overwritten)
+static std::vector<TraceEvent> TraceBuffer;
+static std::size_t TraceNext = 0;
+static std::size_t TraceCount = 0;
+
+/// Time (MPI_Wtime) at which tracing was first enabled
+static double TraceOrigin = 0;
+
+/// Interned timer names, so that events only store an index
+static std::vector<std::string> TraceNames;
+static std::unordered_map<std::string, int> TraceNameIds;
+
+/// Trace events of open timers, parallel to OpenTimers
+static std::vector<TraceEvent> OpenTraceEvents;
+
+/// Returns the trace event of a timer being started
+/// NameId is negative if the timer is not traced
+static TraceEvent beginTraceEvent(const std::string &TimerName, int Level)
+{
+    TraceEvent Event = {-1, 0.0, 0.0};
+    if (!TracingEnabled || !TimingEnabled || Level > TraceLevel) {
+        return Event;
+    }
+
+    // GPTL timer names include the current prefix, so do the same here
+    const std::string Name = CurrentPrefix + TimerName;
+    auto It = TraceNameIds.find(Name);
+    if (It == TraceNameIds.end()) {
+        It = TraceNameIds.emplace(Name, static_cast<int>(TraceNames.size())).first;
+        TraceNames.push_back(Name);
+    }
+    Event.NameId = It->second;
+    Event.Begin = MPI_Wtime() - TraceOrigin;
+    return Event;
+}
+
+/// Stores the trace event of a timer being stopped in the ring buffer
+static void endTraceEvent(TraceEvent Event)
+{
+    if (Event.NameId < 0) {
+        return;
+    }
+
+    Event.End = MPI_Wtime() - TraceOrigin;
+    TraceBuffer[TraceNext] = Event;
+    TraceNext = (TraceNext + 1) % TraceBuffer.size();
+    ++TraceCount;
+}
+
 /// Check if Pacer is initialized
 /// Returns true if initialized
 inline bool isInitialized(){
@@ -166,6 +242,7 @@ bool start(const std::string &TimerName, int Level)
 
     // Push this timer onto the stack
     OpenTimers.push_back(TimerName);
+    OpenTraceEvents.push_back(beginTraceEvent(TimerName, Level));
 
     return true;
 }
@@ -197,10 +274,13 @@ bool stop(const std::string &TimerName, int Level)
         }
 #endif
 
+        endTraceEvent(OpenTraceEvents[it - OpenTimers.begin()]);
+
         PACER_CHECK_ERROR(GPTLstop(TimerName.c_str()));
 
         // Pop this timer from the stack
         OpenTimers.pop_back();
+        OpenTraceEvents.pop_back();
     }
     else {
         std::cerr << "[WARNING] Pacer: Trying to stop timer: \""
@@ -284,6 +364,8 @@ void setTimingLevel(int Level)
 bool disableTiming()
 {
     PACER_CHECK_ERROR(GPTLdisable());
+
+    TimingEnabled = false;
     
     return true;
 }
@@ -291,6 +373,8 @@ bool disableTiming()
 bool enableTiming()
 {
     PACER_CHECK_ERROR(GPTLenable());
+
+    TimingEnabled = true;
     
     return true;
 }
@@ -327,6 +411,168 @@ bool timingBarrier(const std::string &TimerName, int Level, MPI_Comm Comm)
     return Ok;
 }
 
+/// Enables event tracing of timers active when Level >= timer level
+/// Collective over the Pacer communicator, so that all ranks
+/// share (approximately) the same time origin
+bool enableTracing(const std::string &TraceFilePrefix, int Level,
+                   std::size_t BufferSize /* = 100000 */, bool MergeRanks /* = true */)
+{
+    PACER_CHECK_INIT();
+
+    if (BufferSize == 0) {
+        std::cerr << "[ERROR] Pacer: Trace buffer size must be positive." << std::endl;
+        return false;
+    }
+
+    // Set the time origin the first time only, so that tracing
+    // can be paused and resumed without shifting the timeline
+    if (TraceBuffer.empty()) {
+        MPI_Barrier(InternalComm);
+        TraceOrigin = MPI_Wtime();
+    }
+
+    // Changing the buffer size discards the events recorded so far
+    if (TraceBuffer.size() != BufferSize) {
+        TraceBuffer.assign(BufferSize, TraceEvent{-1, 0.0, 0.0});
+        TraceNext = 0;
+        TraceCount = 0;
+    }
+
+    TracePrefix = TraceFilePrefix;
+    TraceLevel = Level;
+    TraceMergeRanks = MergeRanks;
+    TracingEnabled = true;
+
+    return true;
+}
+
+/// Pauses event tracing; events already recorded are still written at finalize
+void disableTracing()
+{
+    TracingEnabled = false;
+}
+
+/// Appends Str to Out as a quoted and escaped JSON string
+static void appendJsonString(std::ostringstream &Out, const std::string &Str)
+{
+    Out << '"';
+    for (const char C : Str) {
+        if (C == '"' || C == '\\') {
+            Out << '\\' << C;
+        }
+        else if (static_cast<unsigned char>(C) < 0x20) {
+            Out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << static_cast<int>(C) << std::dec << std::setfill(' ');
+        }
+        else {
+            Out << C;
+        }
+    }
+    Out << '"';
+}
+
+/// Returns the trace events of this rank as a comma-separated list of
+/// trace-event JSON objects (in microseconds, using the rank as pid)
+static std::string traceEventsToJson()
+{
+    std::ostringstream Out;
+    Out << std::fixed << std::setprecision(3);
+
+    // Metadata, so that each rank shows as a separate labeled process
+    Out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << MyRank
+        << ",\"tid\":0,\"args\":{\"name\":\"rank " << MyRank << "\"}},\n"
+        << "{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" << MyRank
+        << ",\"tid\":0,\"args\":{\"sort_index\":" << MyRank << "}}";
+
+    const std::size_t BufferSize = TraceBuffer.size();
+    const std::size_t NumEvents = std::min(TraceCount, BufferSize);
+    if (TraceCount > BufferSize) {
+        Out << ",\n{\"name\":\"process_labels\",\"ph\":\"M\",\"pid\":" << MyRank
+            << ",\"tid\":0,\"args\":{\"labels\":\"" << TraceCount - BufferSize
+            << " oldest events dropped\"}}";
+    }
+
+    // Oldest event first
+    const std::size_t First = TraceCount > BufferSize ? TraceNext : 0;
+    for (std::size_t N = 0; N < NumEvents; ++N) {
+        const TraceEvent &Event = TraceBuffer[(First + N) % BufferSize];
+        Out << ",\n{\"name\":";
+        appendJsonString(Out, TraceNames[Event.NameId]);
+        Out << ",\"ph\":\"X\",\"pid\":" << MyRank << ",\"tid\":0"
+            << ",\"ts\":" << 1e6 * Event.Begin
+            << ",\"dur\":" << 1e6 * (Event.End - Event.Begin) << "}";
+    }
+
+    return Out.str();
+}
+
+/// Writes the trace events of all ranks in trace-event JSON format
+/// Output Files: TracePrefix.trace.json (merged)
+/// or TracePrefix.trace.<MyRank>.json (per rank)
+static bool writeTrace()
+{
+    const std::string Events = traceEventsToJson();
+    const std::string Header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const std::string Footer = "\n]}\n";
+
+    // Let rank 0 report the overall number of dropped events
+    unsigned long long NumDropped = TraceCount > TraceBuffer.size() ?
+                                    TraceCount - TraceBuffer.size() : 0;
+    unsigned long long TotNumDropped = 0;
+    MPI_Reduce(&NumDropped, &TotNumDropped, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0,
+               InternalComm);
+    if ( (MyRank == 0) && (TotNumDropped > 0) ) {
+        std::cerr << "[WARNING] Pacer: " << TotNumDropped << " trace event(s) were dropped"
+            << " due to the trace buffer size (" << TraceBuffer.size() << ")." << std::endl;
+    }
+
+    if ( TraceMergeRanks == false ) {
+        const std::string TraceFileName = TracePrefix + ".trace." + std::to_string(MyRank) + ".json";
+        std::ofstream File(TraceFileName);
+        File << Header << Events << Footer;
+        if (!File) {
+            std::cerr << "[ERROR] Pacer: Unable to write trace file " << TraceFileName << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Gather the events of all ranks on rank 0
+    int NumRanks;
+    MPI_Comm_size(InternalComm, &NumRanks);
+    int MySize = static_cast<int>(Events.size());
+    std::vector<int> Sizes(MyRank == 0 ? NumRanks : 0);
+    MPI_Gather(&MySize, 1, MPI_INT, Sizes.data(), 1, MPI_INT, 0, InternalComm);
+
+    std::vector<int> Offsets(Sizes.size(), 0);
+    std::vector<char> AllEvents;
+    if (MyRank == 0) {
+        for (int Rank = 1; Rank < NumRanks; ++Rank)
+            Offsets[Rank] = Offsets[Rank - 1] + Sizes[Rank - 1];
+        AllEvents.resize(Offsets.back() + Sizes.back());
+    }
+    MPI_Gatherv(Events.data(), MySize, MPI_CHAR, AllEvents.data(), Sizes.data(),
+                Offsets.data(), MPI_CHAR, 0, InternalComm);
+
+    if (MyRank == 0) {
+        const std::string TraceFileName = TracePrefix + ".trace.json";
+        std::ofstream File(TraceFileName);
+        File << Header;
+        for (int Rank = 0; Rank < NumRanks; ++Rank) {
+            if (Rank > 0)
+                File << ",\n";
+            File.write(AllEvents.data() + Offsets[Rank], Sizes[Rank]);
+        }
+        File << Footer;
+        if (!File) {
+            std::cerr << "[ERROR] Pacer: Unable to write trace file " << TraceFileName << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /// Prints timing statistics and global summary files
 /// Output Files: TimerFilePrefix.timing.<MyRank>
 /// TimerFilePrefix.summary
@@ -353,6 +599,7 @@ bool print(const std::string &TimerFilePrefix, bool PrintAllRanks /*= = false */
 
 /// Cleans up Pacer
 /// Issues warning if any timers are still open
+/// Writes the event trace files if tracing was enabled
 bool finalize()
 {
     PACER_CHECK_INIT();
@@ -366,12 +613,26 @@ bool finalize()
             std::cerr << '\t' << Timer << std::endl;
     }
     OpenTimers.clear();
+    OpenTraceEvents.clear();
+
+    // Write the event trace (timers still open are not included)
+    bool TraceOk = true;
+    if (!TraceBuffer.empty())
+        TraceOk = writeTrace();
+
+    // Clear tracing state
+    TracingEnabled = false;
+    TraceBuffer.clear();
+    TraceNext = 0;
+    TraceCount = 0;
+    TraceNames.clear();
+    TraceNameIds.clear();
 
     // Clear Pacer state and free communicator
     IsInitialized = false;
     MPI_Comm_free(&InternalComm);
 
-    return true;
+    return TraceOk;
 }
 
 }
@@ -12,6 +12,7 @@
 #define PACER_H
 
 #include <mpi.h>
+#include <cstddef>
 #include <string>
 
 namespace Pacer {
@@ -73,6 +74,19 @@ namespace Pacer {
     /// Disables timing barriers
     void disableTimingBarriers();
 
+    /// Enables event tracing of timers active when Level >= timer level
+    /// Each rank records begin/end times of its timers into a ring buffer
+    /// holding the last BufferSize events (older events are dropped).
+    /// At finalize, events are written in Chrome trace-event JSON format,
+    /// which can be loaded in Perfetto (ui.perfetto.dev) or chrome://tracing
+    /// Output Files: TraceFilePrefix.trace.json (MergeRanks = true)
+    /// or TraceFilePrefix.trace.<MyRank>.json (MergeRanks = false)
+    bool enableTracing(const std::string &TraceFilePrefix, int Level,
+                       std::size_t BufferSize = 100000, bool MergeRanks = true);
+
+    /// Pauses event tracing; events already recorded are still written at finalize
+    void disableTracing();
+
     /// Prints timing statistics and global summary files
     /// Output Files: TimerFilePrefix.timing.<MyRank>
     /// TimerFilePrefix.summary
@@ -81,6 +95,7 @@ namespace Pacer {
 
     /// Cleans up Pacer
     /// Issues warning if any timers are still open
+    /// Writes the event trace files if tracing was enabled
     bool finalize();
 
 }
@@ -6,8 +6,9 @@
 // This test exercises basic timer functionality
 // with the Pacer API.
 //
-// This test program should create two files:
-// test.timing.0 and test.summary
+// This test program should create three files:
+// pacer_test.timing.0, pacer_test.summary and
+// pacer_test.trace.json (viewable in Perfetto or chrome://tracing)
 // It is also expected to issue couple of warnings
 // to illustrate likely scenarios where a timer is
 // not started/stopped properly.
@@ -33,6 +34,12 @@ int main(int argc, char **argv){
     Pacer::setPrefix("Omega:");
     Pacer::setTimingLevel(1);
 
+    // Record a timeline of timers with level <= 1, keeping at most the
+    // last 1000 events per rank. The trace is written during finalize.
+    // Optional arguments: buffer size (default 100000) and whether all
+    // ranks are merged in one file (default true)
+    Pacer::enableTracing("pacer_test", 1, 1000);
+
     Pacer::start("run_loop", 1);
 
     float tmp = 1;